@@ -0,0 +1,56 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "../src/slalib.h"
+
+/*
+ * Loops over composite library routines, for sla-kernel-bench. This file is compiled twice: as part of the benchmark,
+ * against the library, and as part of the `sla_outline` library, together with copies of the routines and of the
+ * functions they depend on, in which the small functions defined in `slalib.h` are not inlined (see
+ * bench/CMakeLists.txt); the `sla` namespace is then renamed to `sla_outline`.
+ */
+
+namespace sla {
+
+/// Precesses `n` FK5 positions from J2000 to J2050 with sla::preces(); stores RAs to `result`.
+void composite_preces(int n, const double* ra, const double* dec, double* result) {
+    for (int i = 0; i < n; i++) {
+        Spherical<double> pos = {ra[i], dec[i]};
+        preces(CAT_FK5, 2000.0, 2050.0, pos);
+        result[i] = pos.get_ra();
+    }
+}
+
+/// Applies proper motion to `n` positions with sla::pm(); stores RAs to `result`.
+void composite_pm(int n, const double* ra, const double* dec, double* result) {
+    for (int i = 0; i < n; i++) {
+        Spherical<double> pos;
+        pm({ra[i], dec[i]}, {1.0e-6, -2.0e-7}, 0.1, 20.0, 2000.0, 2050.0, pos);
+        result[i] = pos.get_ra();
+    }
+}
+
+/// Converts `n` positions to ecliptic coordinates with sla::eqecl(); stores longitudes to `result`.
+void composite_eqecl(int n, const double* ra, const double* dec, double* result) {
+    for (int i = 0; i < n; i++) {
+        Spherical<double> pos;
+        eqecl({ra[i], dec[i]}, 51544.5 + i * 1.0e-3, pos);
+        result[i] = pos.get_longitude();
+    }
+}
+
+} // sla
@@ -0,0 +1,157 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#include "../src/slalib.h"
+
+/*
+ * Throughput benchmark for the small vector and matrix functions defined inline in `slalib.h`.
+ *
+ * The first part runs the same composite loop (rotate a vector, normalize it, wrap an angle derived from it, and take
+ * its dot product with a reference vector) twice: calling the functions directly, so that the compiler can inline and
+ * vectorize them, and calling them through opaque pointers, which is how every call went when each of them lived in
+ * its own module. The second part does the same for library routines that are built on top of those functions: it
+ * times each routine as built in the library, and as built in a copy of the routine in which calls to the small
+ * functions are not inlined (see `composite.cc` and bench/CMakeLists.txt).
+ *
+ * Usage: sla-kernel-bench [<number of vectors>]
+ */
+
+namespace sla {
+
+// loops over composite routines, defined in composite.cc
+void composite_preces(int n, const double* ra, const double* dec, double* result);
+void composite_pm(int n, const double* ra, const double* dec, double* result);
+void composite_eqecl(int n, const double* ra, const double* dec, double* result);
+
+} // sla
+
+namespace sla_outline {
+
+// the same loops over copies of the routines that call small functions out of line
+void composite_preces(int n, const double* ra, const double* dec, double* result);
+void composite_pm(int n, const double* ra, const double* dec, double* result);
+void composite_eqecl(int n, const double* ra, const double* dec, double* result);
+
+} // sla_outline
+
+namespace sla {
+
+// keeps results "alive" so that calls could not be optimized out
+static volatile double sink;
+
+// out-of-line instances of the inline functions; pointers are volatile, so the calls cannot be inlined
+static void (*volatile opaque_dmxv)(const Matrix<double>, const Vector<double>, Vector<double>) = dmxv;
+static double (*volatile opaque_dvn)(const Vector<double>, Vector<double>) = dvn;
+static double (*volatile opaque_dvdv)(const Vector<double>, const Vector<double>) = dvdv;
+static double (*volatile opaque_dranrm)(double) = dranrm;
+
+// runs `func()` `nruns` times, and returns the best time in nanoseconds per item
+template <typename F>
+static double best_time(int nitems, int nruns, F func) {
+    double best = 1.0e30;
+    for (int run = 0; run < nruns; run++) {
+        const auto start = std::chrono::steady_clock::now();
+        func();
+        const auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / nitems);
+    }
+    return best;
+}
+
+static void kernel_bench(int n) {
+    constexpr int NRUNS = 5;
+    std::vector<double> ra(n), dec(n);
+    std::vector<Vector<double>> vecs(n);
+    for (int i = 0; i < n; i++) {
+        ra[i] = 6.283185307179586 * (i * 0.618033988749895 - std::floor(i * 0.618033988749895));
+        dec[i] = std::asin(2.0 * i / n - 1.0);
+        dcs2c({ra[i], dec[i]}, vecs[i]);
+    }
+    Matrix<double> rmat;
+    prec(2000.0, 2050.0, rmat);
+    const Vector<double> ref = {0.6, 0.0, 0.8};
+
+    std::printf("Composite loop over %d vectors (dmxv, dvn, dranrm, dvdv), ns per vector:\n", n);
+    const double t_inline = best_time(n, NRUNS, [&] {
+        double acc = 0.0;
+        for (int i = 0; i < n; i++) {
+            Vector<double> rotated, unit;
+            dmxv(rmat, vecs[i], rotated);
+            acc += dvn(rotated, unit);
+            acc += dranrm(10.0 * unit[0]);
+            acc += dvdv(unit, ref);
+        }
+        sink = acc;
+    });
+    const double t_opaque = best_time(n, NRUNS, [&] {
+        double acc = 0.0;
+        for (int i = 0; i < n; i++) {
+            Vector<double> rotated, unit;
+            opaque_dmxv(rmat, vecs[i], rotated);
+            acc += opaque_dvn(rotated, unit);
+            acc += opaque_dranrm(10.0 * unit[0]);
+            acc += opaque_dvdv(unit, ref);
+        }
+        sink = acc;
+    });
+    std::printf("  %-20s %10.2f\n  %-20s %10.2f\n  %-20s %10.2fx\n",
+        "inline", t_inline, "out-of-line", t_opaque, "speedup", t_opaque / t_inline);
+
+    std::printf("Composite library routines, ns per call:\n");
+    std::printf("  %-20s %10s %12s %10s\n", "", "inline", "out-of-line", "speedup");
+    using Routine = void (*)(int, const double*, const double*, double*);
+    const struct {
+        const char* name;
+        Routine inlined;
+        Routine outlined;
+    } routines[] = {
+        {"preces", composite_preces, sla_outline::composite_preces},
+        {"pm", composite_pm, sla_outline::composite_pm},
+        {"eqecl", composite_eqecl, sla_outline::composite_eqecl}
+    };
+    std::vector<double> result(n);
+    for (const auto& routine: routines) {
+        const double t_inlined = best_time(n, NRUNS, [&] {
+            routine.inlined(n, ra.data(), dec.data(), result.data());
+            sink = result[n - 1];
+        });
+        const double t_outlined = best_time(n, NRUNS, [&] {
+            routine.outlined(n, ra.data(), dec.data(), result.data());
+            sink = result[n - 1];
+        });
+        std::printf("  %-20s %10.2f %12.2f %9.2fx\n", routine.name, t_inlined, t_outlined, t_outlined / t_inlined);
+    }
+}
+
+} // sla
+
+/// Benchmark entry point.
+int main(int argc, char** argv) {
+    const int n = argc > 1? std::atoi(argv[1]): 1000000;
+    if (n <= 0) {
+        std::puts("Usage: sla-kernel-bench [<number of vectors>]");
+        return 1;
+    }
+    sla::kernel_bench(n);
+    return 0;
+}
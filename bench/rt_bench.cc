@@ -0,0 +1,144 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+#include "../src/slalib.h"
+
+/*
+ * Latency benchmark for the functions used in telescope pointing loops.
+ *
+ * Every function is called many times with arguments spread over their whole useful range, each call is timed
+ * individually, and the resulting distribution is reported as median, 99th, 99.99th percentiles, and maximum (in
+ * nanoseconds; timer overhead is included). Optional background threads keep the other cores busy to simulate a
+ * loaded control computer.
+ *
+ * Usage: sla-rt-bench [<calls per function> [<number of load threads>]]
+ */
+
+namespace sla {
+
+// keeps results "alive" so that calls could not be optimized out
+static volatile double sink;
+
+// set to `true` to stop load threads
+static std::atomic<bool> stop_load(false);
+
+// background load: keeps FPU and caches busy
+static void load_thread() {
+    std::vector<double> buffer(1 << 20);
+    double acc = 0.0;
+    while (!stop_load.load(std::memory_order_relaxed)) {
+        for (double& value: buffer) {
+            value = std::sin(value + acc);
+            acc += value;
+        }
+    }
+    sink = acc;
+}
+
+// times `ncalls` calls of `func(i)` and prints latency distribution
+template <typename F>
+static void measure(const char* name, int ncalls, F func) {
+    std::vector<double> latencies(ncalls);
+    for (int i = 0; i < ncalls; i++) {
+        const auto start = std::chrono::steady_clock::now();
+        func(i);
+        const auto end = std::chrono::steady_clock::now();
+        latencies[i] = std::chrono::duration<double, std::nano>(end - start).count();
+    }
+    std::sort(latencies.begin(), latencies.end());
+    auto percentile = [&] (double p) -> double {
+        return latencies[std::min(ncalls - 1, (int) (p / 100.0 * ncalls))];
+    };
+    std::printf("%-10s %12.0f %12.0f %12.0f %12.0f\n", name,
+        percentile(50.0), percentile(99.0), percentile(99.99), latencies[ncalls - 1]);
+}
+
+static void rt_bench(int ncalls) {
+    constexpr double PI = 3.1415926535897932384626433832795;
+    // fraction of the range covered by call `i`
+    auto frac = [ncalls] (int i) -> double { return (double) i / ncalls; };
+
+    std::printf("%-10s %12s %12s %12s %12s\n", "function", "p50, ns", "p99, ns", "p99.99, ns", "max, ns");
+    measure("refro_rt", ncalls, [&] (int i) {
+        sink = refro_rt(frac(i) * 1.62, 2000.0, 278.0, 700.0, 0.5, i % 2? 0.55: 1000.0, 0.4, 0.0065);
+    });
+    measure("refro", ncalls, [&] (int i) {
+        sink = refro(frac(i) * 1.62, 2000.0, 278.0, 700.0, 0.5, i % 2? 0.55: 1000.0, 0.4, 0.0065, 1.0e-8);
+    });
+    measure("refco_rt", ncalls, [&] (int i) {
+        double refa, refb;
+        refco_rt(frac(i) * 4000.0, 250.0 + frac(i) * 50.0, 700.0, 0.5, 0.55, 0.4, 0.0065, refa, refb);
+        sink = refa + refb;
+    });
+    measure("altaz", ncalls, [&] (int i) {
+        AltazMount am;
+        altaz({frac(i) * 2.0 * PI - PI, 1.2 - frac(i) * 2.4}, 0.4, am);
+        sink = am.get_azimuth();
+    });
+    measure("de2h", ncalls, [&] (int i) {
+        double azimuth, elevation;
+        de2h({frac(i) * 2.0 * PI - PI, 1.2 - frac(i) * 2.4}, 0.4, azimuth, elevation);
+        sink = azimuth + elevation;
+    });
+    measure("dh2e", ncalls, [&] (int i) {
+        Spherical<double> dir;
+        dh2e(frac(i) * 2.0 * PI, frac(i) * PI - PI / 2.0, 0.4, dir);
+        sink = dir.get_ha();
+    });
+    measure("unpcd", ncalls, [&] (int i) {
+        double x = frac(i) * 0.1, y = 0.05 - frac(i) * 0.1;
+        unpcd(i % 2? 178.585: -333.0, x, y);
+        sink = x + y;
+    });
+    measure("nutc", ncalls, [&] (int i) {
+        double psi, eps, eps0;
+        nutc(40000.0 + frac(i) * 30000.0, psi, eps, eps0);
+        sink = psi + eps + eps0;
+    });
+}
+
+} // sla
+
+/// Benchmark entry point.
+int main(int argc, char** argv) {
+    const int ncalls = argc > 1? std::atoi(argv[1]): 100000;
+    const int nload = argc > 2? std::atoi(argv[2]): (int) std::thread::hardware_concurrency() - 1;
+    if (ncalls <= 0) {
+        std::puts("Usage: sla-rt-bench [<calls per function> [<number of load threads>]]");
+        return 1;
+    }
+    std::vector<std::thread> load;
+    for (int i = 0; i < nload; i++) {
+        load.emplace_back(sla::load_thread);
+    }
+    std::printf("Latency of %d calls per function, %d load thread(s):\n", ncalls, (int) load.size());
+    sla::rt_bench(ncalls);
+    sla::stop_load = true;
+    for (auto& thread: load) {
+        thread.join();
+    }
+    return 0;
+}
@@ -16,6 +16,8 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
@@ -56,4 +58,48 @@ void addet(const Spherical<double>& dir, double be, Spherical<double>& edir) {
     edir.set_ra(dranrm(edir.get_ra()));
 }
 
+/**
+ * Adds the E-terms (elliptic component of annual aberration) to many pre IAU 1976 mean places of the same epoch to
+ * conform to the old catalogue convention (double precision).
+ *
+ * Results are identical to those of the sla::addet() function, but the E-terms vector is only computed once, and
+ * places are processed in SIMD packs (see `simd.h`). Input and output arrays may be the same.
+ *
+ * @param n Number of places.
+ * @param ra RAs without E-terms (radians).
+ * @param dec Decs without E-terms (radians).
+ * @param be Besselian epoch of mean equator and equinox.
+ * @param era Return value: RAs with E-terms included (radians).
+ * @param edec Return value: Decs with E-terms included (radians).
+ */
+void addet_batch(int n, const double* ra, const double* dec, double be, double* era, double* edec) {
+    // get E-terms vector
+    Vector<double> et;
+    etrms(be, et);
+
+    lane_loop<double>(n, [=, &et](auto tag, int i) {
+        using V = decltype(tag);
+        // spherical to Cartesian, including the E-terms
+        V x, y, z;
+        kernel::cs2c(lane_load<V>(ra + i), lane_load<V>(dec + i), x, y, z);
+        x += et[0];
+        y += et[1];
+        z += et[2];
+
+        // Cartesian to spherical, bringing RA into conventional range
+        V a, b;
+        kernel::cc2s(x, y, z, a, b);
+        lane_store(kernel::ranorm(a), era + i);
+        lane_store(b, edec + i);
+    });
+}
+
+/// Version of sla::addet_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void addet_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, double be, StridedSpan<double> era,
+    StridedSpan<double> edec) {
+    span_tiles(ra.get_size(), [&](int n, auto ra, auto dec, auto era, auto edec) {
+        addet_batch(n, ra, dec, be, era, edec);
+    }, ra, dec, era, edec);
+}
+
 }
@@ -46,4 +46,32 @@ double airmas(double zenith_dist) {
     return 1.0 + seczm1 * (0.9981833 - seczm1 * (0.002875 + 0.0008083 * seczm1));
 }
 
+/**
+ * Inverse of the sla::airmas() function: calculates observed zenith distance at which given air mass is reached.
+ *
+ * @param airmass Air mass, in units of that at the zenith.
+ * @return Observed zenith distance (radians, range: [0..1.52]); if `airmass` is not reached before sla::airmas()
+ *   holds air mass constant (at about 87 degrees), pi is returned.
+ */
+double airmas_zd(double airmass) {
+    constexpr double PI = 3.1415926535897932384626433832795;
+    // zenith distance beyond which air mass is held constant (radians)
+    constexpr double MAX_ZD = 1.52;
+
+    if (airmass >= airmas(MAX_ZD)) {
+        return PI;
+    }
+    // air mass increases monotonically up to the cut-off, so bisection is safe
+    double z_lo = 0.0, z_hi = MAX_ZD;
+    for (int i = 0; i < 60; i++) {
+        const double z = 0.5 * (z_lo + z_hi);
+        if (airmas(z) < airmass) {
+            z_lo = z;
+        } else {
+            z_hi = z;
+        }
+    }
+    return z_lo;
+}
+
 }
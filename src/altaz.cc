@@ -41,7 +41,8 @@ namespace sla {
  *
  * In applications which involve many such calculations, rather than calling the present routine it will be more
  * efficient to use inline code, having previously computed fixed terms such as sine and cosine of latitude, and (for
- * tracking a star) sine and cosine of declination.
+ * tracking a star) sine and cosine of declination; the sla::AltazTracker class does exactly that for a series of
+ * equally spaced hour angles.
  *
  * Original FORTRAN code by P.T. Wallace.
  *
@@ -60,17 +61,29 @@ namespace sla {
  * @param pa_acc Return value: parallactic angle acceleration (radians per radian of `ha` squared).
  */
 void altaz(const Spherical<double>& dir, double phi, AltazMount& am) {
+    altaz_trig(dir.get_ha(), std::sin(dir.get_ha()), std::cos(dir.get_ha()),
+        std::sin(dir.get_dec()), std::cos(dir.get_dec()), std::sin(phi), std::cos(phi), am);
+}
+
+/**
+ * Core of the sla::altaz() function operating on precomputed sines and cosines of hour angle, declination, and
+ * latitude; shared by sla::altaz() and sla::AltazTracker.
+ *
+ * @param ha Hour angle (radians); only used for the parallactic angle at the pole.
+ * @param sin_ha Sine of the hour angle.
+ * @param cos_ha Cosine of the hour angle.
+ * @param sin_dec Sine of the declination.
+ * @param cos_dec Cosine of the declination.
+ * @param sin_phi Sine of the observatory latitude.
+ * @param cos_phi Cosine of the observatory latitude.
+ * @param am Return value: mount parameters (see sla::altaz()).
+ */
+void altaz_trig(double ha, double sin_ha, double cos_ha, double sin_dec, double cos_dec,
+    double sin_phi, double cos_phi, AltazMount& am) {
     constexpr double PI = 3.1415926535897932384626433832795;
     constexpr double PI2 = 6.283185307179586476925286766559;
     constexpr double EPSILON = 1.0e-30;
 
-    // useful functions
-    const double sin_ha = std::sin(dir.get_ha());
-    const double cos_ha = std::cos(dir.get_ha());
-    const double sin_dec = std::sin(dir.get_dec());
-    const double cos_dec = std::cos(dir.get_dec());
-    const double sin_phi = std::sin(phi);
-    const double cos_phi = std::cos(phi);
     const double ch_cd = cos_ha * cos_dec;
     const double sd_cp = sin_dec * cos_phi;
     const double x = -ch_cd * sin_phi + sd_cp;
@@ -89,7 +102,7 @@ void altaz(const Spherical<double>& dir, double phi, AltazMount& am) {
     // parallactic angle
     const double c = cos_dec * sin_phi - cos_ha * sd_cp;
     const double s = sin_ha * cos_phi;
-    const double p_angle = c * c + s * s > 0.0? std::atan2(s, c): PI - dir.get_ha();
+    const double p_angle = c * c + s * s > 0.0? std::atan2(s, c): PI - ha;
 
     // velocities and accelerations (clamped at zenith/nadir)
     if (r_squared < EPSILON) {
@@ -0,0 +1,80 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Sets up a generator of AltAz mount parameters for a star at fixed declination.
+ *
+ * @param dir Hour angle of the first sample and declination (radians); topocentric; not range-checked.
+ * @param phi Observatory latitude (radians); geodetic as opposed to geocentric; not range-checked.
+ * @param step Hour angle increment between consecutive samples (radians); for sidereal tracking, sample interval in
+ *   sidereal seconds multiplied by 2pi/86400.
+ */
+AltazTracker::AltazTracker(const Spherical<double>& dir, double phi, double step) {
+    at_ha = dir.get_ha();
+    at_step = step;
+    at_sin_step = std::sin(step);
+    at_cos_step = std::cos(step);
+    at_sin_dec = std::sin(dir.get_dec());
+    at_cos_dec = std::cos(dir.get_dec());
+    at_sin_phi = std::sin(phi);
+    at_cos_phi = std::cos(phi);
+}
+
+/**
+ * Generates mount parameters for a block of consecutive samples, starting at the current hour angle, and advances
+ * the hour angle past the block.
+ *
+ * Sine and cosine of the hour angle are evaluated directly only once per block; each further sample is obtained by
+ * rotating them by the hour angle step. Rounding errors of the recurrence grow linearly with the sample index, and
+ * stay at the 1e-13 level for blocks of a few thousand samples; longer look-ahead windows should be split into
+ * several calls.
+ *
+ * @param n Number of samples to generate.
+ * @param am Return value: array of `n` elements receiving the mount parameters (see sla::altaz()).
+ */
+void AltazTracker::track(int n, AltazMount* am) {
+    double sin_ha = std::sin(at_ha);
+    double cos_ha = std::cos(at_ha);
+    for (int i = 0; i < n; i++) {
+        altaz_trig(at_ha + i * at_step, sin_ha, cos_ha, at_sin_dec, at_cos_dec, at_sin_phi, at_cos_phi, am[i]);
+
+        // rotate by one step
+        const double sin_next = sin_ha * at_cos_step + cos_ha * at_sin_step;
+        cos_ha = cos_ha * at_cos_step - sin_ha * at_sin_step;
+        sin_ha = sin_next;
+    }
+    at_ha += n * at_step;
+}
+
+/**
+ * Version of sla::AltazTracker::track() that stores samples through a strided span (see sla::StridedSpan); samples are
+ * generated in tiles, each of which starts the rotation recurrence afresh, so results may differ from those of a
+ * single call over an array in the last bits.
+ */
+void AltazTracker::track(StridedSpan<AltazMount> am) {
+    span_tiles(am.get_size(), [this](int n, auto am) {
+        track(n, am);
+    }, am);
+}
+
+}
@@ -0,0 +1,60 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+
+namespace sla {
+
+/**
+ * Apparent to observed place, for optical sources distant from the solar system.
+ *
+ * This function returns zenith distance, hour angle, azimuth, and RA,Dec of an object, as it would be observed at a
+ * given location on Earth, given its geocentric apparent RA,Dec. It computes the star-independent parameters with
+ * sla::aoppa() and then calls sla::aopqk(); see these functions for details. When many places are to be computed for
+ * the same date and site, call sla::aoppa() once and then sla::aopqk() for each place.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param rap Geocentric apparent right ascension (radians).
+ * @param dap Geocentric apparent declination (radians).
+ * @param date UTC date/time (Modified Julian Date, JD-2400000.5).
+ * @param dut Delta UT: UT1-UTC (UTC seconds).
+ * @param elongm Mean longitude of the observer (radians, east positive).
+ * @param phim Mean geodetic latitude of the observer (radians).
+ * @param hm Observer's height above sea level (meters).
+ * @param xp Polar motion x-coordinate (radians).
+ * @param yp Polar motion y-coordinate (radians).
+ * @param tdk Local ambient temperature (K; std=273.15).
+ * @param pmb Local atmospheric pressure (mb; std=1013.25).
+ * @param rh Local relative humidity (in the range 0.0-1.0).
+ * @param wl Effective wavelength (micrometers, e.g. 0.55).
+ * @param tlr Tropospheric lapse rate (K per meter, e.g. 0.0065).
+ * @param aob Return value: observed azimuth (radians: N=0, E=90 degrees).
+ * @param zob Return value: observed zenith distance (radians).
+ * @param hob Return value: observed hour angle (radians).
+ * @param dob Return value: observed declination (radians).
+ * @param rob Return value: observed right ascension (radians).
+ */
+void aop(double rap, double dap, double date, double dut, double elongm, double phim, double hm, double xp, double yp,
+    double tdk, double pmb, double rh, double wl, double tlr,
+    double& aob, double& zob, double& hob, double& dob, double& rob) {
+    AOParams params;
+    aoppa(date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, params);
+    aopqk(rap, dap, params, aob, zob, hob, dob, rob);
+}
+
+}
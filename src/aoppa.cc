@@ -0,0 +1,113 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Precomputes apparent to observed place parameters required by sla::aopqk() and sla::oapqk().
+ *
+ * It is advisable to take great care with units, as even unlikely values of the input parameters are accepted and
+ * processed in accordance with the models used.
+ *
+ * The `date` argument is UTC expressed as an MJD. This is, strictly speaking, improper, because of leap seconds.
+ * However, as long as the delta UT and the UTC are consistent there are no difficulties, except during a leap second.
+ * In this case, the start of the 61st second of the final minute should begin a new MJD day and the old pre-leap
+ * delta UT should continue to be used. As the 61st second completes, the MJD should revert to the start of the day
+ * as, simultaneously, the delta UTC changes by one second to its post-leap new value.
+ *
+ * The delta UT (UT1-UTC) is tabulated in IERS circulars and elsewhere. It increases by exactly one second at the end
+ * of each UTC leap second, introduced in order to keep delta UT within +/- 0.9s.
+ *
+ * IMPORTANT: take care with the longitude sign convention. The longitude required by the present function is east-
+ * positive, in accordance with geographical convention (and right-handed). In particular, note that the longitudes
+ * returned by the sla::obs() function are west-positive, following astronomical usage, and must be reversed in sign
+ * before use in the present function.
+ *
+ * The polar coordinates `xp`,`yp` can be obtained from IERS circulars and equivalent publications. The maximum
+ * amplitude is about 0.3 arcseconds. If `xp`,`yp` values are unavailable, use zeroes. The `xp`,`yp` axes are
+ * directed along the meridians 0 and 90 degrees west respectively.
+ *
+ * The height above sea level of the observing station, `hm`, can be obtained from the sla::obs() function, or from
+ * the Astronomical Almanac. If `pmb` (pressure) is zero, no refraction is computed; otherwise, the pressure is that
+ * at the observer's altitude, not the sea-level value.
+ *
+ * The refraction coefficients are computed for optical/IR wavelengths if `wl` is less than 100 micrometers, and for
+ * radio wavelengths otherwise; the lapse rate `tlr` is typically 0.0065 K per meter.
+ *
+ * The sidereal time is computed by sla::aoppat(), which can be used later to update it for a new date without
+ * recomputing the other (slowly changing) parameters.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date UTC date/time (Modified Julian Date, JD-2400000.5).
+ * @param dut Delta UT: UT1-UTC (UTC seconds).
+ * @param elongm Mean longitude of the observer (radians, east positive).
+ * @param phim Mean geodetic latitude of the observer (radians).
+ * @param hm Observer's height above sea level (meters).
+ * @param xp Polar motion x-coordinate (radians).
+ * @param yp Polar motion y-coordinate (radians).
+ * @param tdk Local ambient temperature (K; std=273.15).
+ * @param pmb Local atmospheric pressure (mb; std=1013.25).
+ * @param rh Local relative humidity (in the range 0.0-1.0).
+ * @param wl Effective wavelength (micrometers, e.g. 0.55).
+ * @param tlr Tropospheric lapse rate (K per meter, e.g. 0.0065).
+ * @param params Return value: star-independent apparent-to-observed place parameters.
+ */
+void aoppa(double date, double dut, double elongm, double phim, double hm, double xp, double yp,
+    double tdk, double pmb, double rh, double wl, double tlr, AOParams& params) {
+    // 2Pi
+    constexpr double D2PI = 6.283185307179586476925287;
+
+    // speed of light (AU per day)
+    constexpr double C = 173.14463331;
+
+    // ratio between solar and sidereal time
+    constexpr double SOLSID = 1.00273790935;
+
+    // observer's location corrected for polar motion
+    double elong, phi, daz;
+    polmo(elongm, phim, xp, yp, elong, phi, daz);
+    params.ao_phi = phi;
+    params.ao_sin_phi = std::sin(phi);
+    params.ao_cos_phi = std::cos(phi);
+
+    // magnitude of the diurnal aberration vector
+    double uau, vau;
+    geoc(phi, hm, uau, vau);
+    params.ao_diurab = D2PI * uau * SOLSID / C;
+
+    // copy the refraction parameters and compute the A & B constants
+    params.ao_height = hm;
+    params.ao_tdk = tdk;
+    params.ao_pmb = pmb;
+    params.ao_rh = rh;
+    params.ao_wl = wl;
+    params.ao_tlr = tlr;
+    refco(hm, tdk, pmb, rh, wl, phi, tlr, 1.0e-10, params.ao_refa, params.ao_refb);
+
+    // longitude + equation of the equinoxes + sidereal equivalent of DUT (ignoring change in equation of the
+    // equinoxes between UTC and TDB)
+    params.ao_elong = elong + eqeqx(date) + dut * SOLSID * D2PI / 86400.0;
+
+    // sidereal time
+    aoppat(date, params);
+}
+
+}
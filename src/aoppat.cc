@@ -20,17 +20,18 @@
 namespace sla {
 
 /**
- * Computes scalar product of two 3-element vectors (double precision).
+ * Recomputes the sidereal time in the apparent to observed place star-independent parameter block.
  *
- * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ * For more information, see sla::aoppa().
  *
- * @param va First vector.
- * @param vb Second vector.
+ * Original FORTRAN code by P.T. Wallace.
  *
- * @return Scalar product va.vb
+ * @param date UTC date/time (Modified Julian Date, JD-2400000.5).
+ * @param params Star-independent apparent-to-observed place parameters, as computed by sla::aoppa(); its `ao_lst`
+ *   member is updated.
  */
-double dvdv(const Vector<double> va, const Vector<double> vb) {
-    return va[0] * vb[0] + va[1] * vb[1] + va[2] * vb[2];
+void aoppat(double date, AOParams& params) {
+    params.ao_lst = gmst(date) + params.ao_elong;
 }
 
 }
@@ -0,0 +1,151 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Quick apparent to observed place (but see note 8, below, for remarks about speed).
+ *
+ * This function returns zenith distance, hour angle, azimuth, and RA,Dec of an object, as it would be observed at a
+ * given location on Earth, given its geocentric apparent RA,Dec.
+ *
+ * Notes:
+ *
+ *   1. This function takes into account refraction, diurnal aberration, and the rotation of the Earth. It is the
+ *      inverse of sla::oapqk(); the star-independent parameters are those computed by sla::aoppa().
+ *
+ *   2. "Observed" Az,El means the position that would be seen by a perfect theodolite located at the observer. This
+ *      is related to the observed HA,Dec via the standard rotation, using the geodetic latitude (corrected for polar
+ *      motion), while the observed HA and RA are related simply through the local apparent ST. "Observed" RA,Dec or
+ *      HA,Dec thus means the position that would be seen by a perfect equatorial located at the observer and with its
+ *      polar axis aligned to the Earth's axis of rotation (n.b. not to the refracted pole). By removing from the
+ *      observed place the effects of atmospheric refraction and diurnal aberration, the geocentric apparent RA,Dec is
+ *      obtained.
+ *
+ *   3. Frequently, mean rather than apparent RA,Dec will be available, for example, because they have been taken
+ *      from a star catalogue. In such cases, the apparent RA,Dec must first be computed.
+ *
+ *   4. Refraction is computed with the two-constant model of sla::refz() (constants from sla::refco()) for zenith
+ *      distances up to about 76 degrees; beyond that, sla::refro() is used, iterating for the observed zenith
+ *      distance. The accuracy is thus limited by the refraction model rather than by the quick algorithm.
+ *
+ *   5. The azimuths etc. used by the present function are with respect to the celestial pole. Corrections to the
+ *      terrestrial pole can be computed using sla::polmo().
+ *
+ *   6. Azimuth is returned in the range 0-2pi; north is zero, and east is +pi/2. The HA is returned in the range
+ *      +/-pi, west is positive.
+ *
+ *   7. Zenith distances greater than about 90 degrees are not reliable, since the refraction models are not
+ *      designed for such conditions.
+ *
+ *   8. The present function takes geocentric apparent RA,Dec for the date of the star-independent parameters, and
+ *      its speed is limited by the trigonometry rather than by the (precomputed) site constants.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param rap Geocentric apparent right ascension (radians).
+ * @param dap Geocentric apparent declination (radians).
+ * @param params Star-independent apparent-to-observed place parameters, as computed by sla::aoppa().
+ * @param aob Return value: observed azimuth (radians: N=0, E=90 degrees).
+ * @param zob Return value: observed zenith distance (radians).
+ * @param hob Return value: observed hour angle (radians).
+ * @param dob Return value: observed declination (radians).
+ * @param rob Return value: observed right ascension (radians).
+ */
+void aopqk(double rap, double dap, const AOParams& params,
+    double& aob, double& zob, double& hob, double& dob, double& rob) {
+    // breakpoint for fast/slow refraction algorithm: ZD greater than arctan(4) (see sla::refco()), or vector Z less
+    // than cosine(arctan(Z)) = 1/sqrt(17)
+    constexpr double ZBREAK = 0.242535625;
+
+    // sin, cos of latitude
+    const double sphi = params.ao_sin_phi;
+    const double cphi = params.ao_cos_phi;
+
+    // local apparent sidereal time
+    const double st = params.ao_lst;
+
+    // apparent RA,Dec to Cartesian -HA,Dec
+    Vector<double> v;
+    dcs2c({rap - st, dap}, v);
+    const double xhd = v[0];
+    const double yhd = v[1];
+    const double zhd = v[2];
+
+    // diurnal aberration
+    const double diurab = params.ao_diurab;
+    const double f = 1.0 - diurab * yhd;
+    const double xhdt = f * xhd;
+    const double yhdt = f * (yhd + diurab);
+    const double zhdt = f * zhd;
+
+    // Cartesian -HA,Dec to Cartesian Az,El (S=0,E=90)
+    const double xaet = sphi * xhdt - cphi * zhdt;
+    const double yaet = yhdt;
+    const double zaet = cphi * xhdt + sphi * zhdt;
+
+    // azimuth (N=0,E=90)
+    const double azobs = (xaet == 0.0 && yaet == 0.0)? 0.0: std::atan2(yaet, -xaet);
+
+    // topocentric zenith distance
+    const double zdt = std::atan2(std::sqrt(xaet * xaet + yaet * yaet), zaet);
+
+    // refraction: fast algorithm using two constant model
+    double zdobs = refz(zdt, params.ao_refa, params.ao_refb);
+
+    // large zenith distance?
+    if (std::cos(zdobs) < ZBREAK) {
+        // yes: use rigorous algorithm (maximum of 10 iterations)
+        double dzd = 10.0;
+        for (int i = 1; std::fabs(dzd) > 1.0e-10 && i <= 10; i++) {
+            // compute refraction using current estimate of observed ZD
+            const double ref = refro(zdobs, params.ao_height, params.ao_tdk, params.ao_pmb, params.ao_rh,
+                params.ao_wl, params.ao_phi, params.ao_tlr, 1.0e-8);
+
+            // remaining discrepancy, and updated estimate
+            dzd = zdobs + ref - zdt;
+            zdobs -= dzd;
+        }
+    }
+
+    // to Cartesian Az/ZD
+    const double ce = std::sin(zdobs);
+    const double xaeo = -std::cos(azobs) * ce;
+    const double yaeo = std::sin(azobs) * ce;
+    const double zaeo = std::cos(zdobs);
+
+    // Cartesian Az/ZD to Cartesian -HA,Dec
+    v[0] = sphi * xaeo + cphi * zaeo;
+    v[1] = yaeo;
+    v[2] = -cphi * xaeo + sphi * zaeo;
+
+    // to spherical -HA,Dec
+    Spherical<double> hd;
+    dcc2s(v, hd);
+
+    // return the results
+    aob = azobs;
+    zob = zdobs;
+    hob = -hd.get_ra();
+    dob = hd.get_dec();
+    rob = dranrm(st + hd.get_ra());
+}
+
+}
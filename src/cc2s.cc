@@ -16,7 +16,8 @@
  *
  */
 #include "slalib.h"
-#include <cmath>
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
@@ -34,12 +35,35 @@ namespace sla {
  *  coordinates are longitude (positive anticlockwise looking from the positive latitude pole) and latitude.
  */
 void cc2s(const Vector<float> cartesian, Spherical<float>& spherical) {
-    const float x = cartesian[0];
-    const float y = cartesian[1];
-    const float z = cartesian[2];
-    const float r = std::sqrt(x * x + y * y);
-    spherical.set_longitude((r == 0.0f) ? 0.0f : std::atan2(y, x));
-    spherical.set_latitude((z == 0.0f) ? 0.0f : std::atan2(z, r));
+    float a, b;
+    kernel::cc2s(cartesian[0], cartesian[1], cartesian[2], a, b);
+    spherical.set_longitude(a);
+    spherical.set_latitude(b);
+}
+
+/**
+ * Converts many vectors from Cartesian to spherical coordinates (single precision); this is a vectorized version of
+ * sla::cc2s().
+ *
+ * @param n Number of vectors.
+ * @param cartesian Vectors to convert.
+ * @param a Output: `n` longitudes (RAs, etc.), in radians.
+ * @param b Output: `n` latitudes (Decs, etc.), in radians.
+ */
+void cc2s_batch(int n, const Vector<float>* cartesian, float* a, float* b) {
+    lane_loop<float>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V a_i, b_i;
+        kernel::cc2s(lane_load<V>(&cartesian[i][0], 3), lane_load<V>(&cartesian[i][1], 3),
+            lane_load<V>(&cartesian[i][2], 3), a_i, b_i);
+        lane_store(a_i, a + i);
+        lane_store(b_i, b + i);
+    });
+}
+
+/// Version of sla::cc2s_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void cc2s_batch(StridedSpan<const Vector<float>> cartesian, StridedSpan<float> a, StridedSpan<float> b) {
+    span_tiles(cartesian.get_size(), [](int n, auto... p) { cc2s_batch(n, p...); }, cartesian, a, b);
 }
 
 }
@@ -0,0 +1,229 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include "dispatch.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace sla {
+
+// number of sources processed between calls to the sink; bounds memory taken by pending matches
+static constexpr int BATCH_SOURCES = 65536;
+
+// margin (radians) added to the radius of cone searches, to make them conservative in the presence of rounding errors
+static constexpr double MARGIN = 1.0e-12;
+
+/// Buffers used by one thread of sla::cross_match(); reused for all groups of sources processed by that thread.
+struct CrossMatchWorkspace {
+    std::vector<SkyCellRange>           xw_ranges;    ///< cells of the reference that may hold matches
+    std::vector<double>                 xw_x;         ///< X coordinates of the candidates
+    std::vector<double>                 xw_y;         ///< Y coordinates of the candidates
+    std::vector<double>                 xw_z;         ///< Z coordinates of the candidates
+    std::vector<int>                    xw_reference; ///< original indices of the candidates in the reference
+    std::vector<double>                 xw_chord2;    ///< squared chord distances from the current source
+    std::vector<std::pair<double, int>> xw_hits;      ///< squared chord distances and indices of matches of a source
+    std::vector<CrossMatch>             xw_matches;   ///< matches pending delivery to the sink
+};
+
+/**
+ * Computes squared chord distances (i.e. squared distances between unit vectors) from a point to candidates.
+ *
+ * @param n Number of candidates.
+ * @param x X coordinates of the candidates.
+ * @param y Y coordinates of the candidates.
+ * @param z Z coordinates of the candidates.
+ * @param vec Unit vector of the point.
+ * @param chord2 Return value: squared chord distances.
+ */
+static SLALIB_KERNEL void cross_match_kernel(int n, const double* x, const double* y, const double* z,
+    const double* vec, double* chord2) {
+    const double vx = vec[0], vy = vec[1], vz = vec[2];
+    for (int i = 0; i < n; i++) {
+        const double dx = x[i] - vx;
+        const double dy = y[i] - vy;
+        const double dz = z[i] - vz;
+        chord2[i] = dx * dx + dy * dy + dz * dz;
+    }
+}
+
+static KernelDispatcher<cross_match_kernel> cross_match_dispatcher("cross_match");
+static const bool cross_match_enlisted = cross_match_dispatcher.enlist();
+
+/**
+ * Finds pairs of points of two catalogues that are within given angular distance from each other. Sources are
+ * processed cell by cell (in the order of cells of their index): for each cell, the reference index is searched once
+ * with a cone enclosing all sources of the cell widened by the match radius, its points are gathered into a
+ * contiguous buffer, and distances from each source to all of them are then computed as chord distances, without
+ * trigonometric functions; separations are only computed for accepted pairs.
+ *
+ * Groups of cells are processed concurrently, and their matches are passed to the sink in batches (always from the
+ * calling thread), so that memory taken by pending matches stays bounded regardless of the sizes of the catalogues.
+ * Matches are delivered in the order of cells of the sources; matches of a source come in ascending order of their
+ * separations (and of their reference indices, for equal separations).
+ *
+ * The depth of the source index should be such that its cells hold a few dozen sources on average (and are not
+ * smaller than the match radius), so that every reference search serves many sources.
+ *
+ * @param sources Index of the source (e.g. detection) catalogue.
+ * @param reference Index of the reference catalogue; may be the same as `sources`, in which case every point
+ *   matches itself, too.
+ * @param radius Match radius (radians).
+ * @param max_matches Maximum number of matches per source: 1 selects only the best (nearest) match, `k` selects up to
+ *   `k` nearest ones, and zero selects all matches within the radius.
+ * @param sink Receiver of matches; may be `nullptr` if only the number of matches is needed.
+ * @param context Value passed to each call of the `sink`.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ * @return Total number of matches.
+ */
+std::int64_t cross_match(const SkyIndex& sources, const SkyIndex& reference, double radius, int max_matches,
+    CrossMatchSink sink, void* context, int nthreads) {
+    assert(radius >= 0.0 && max_matches >= 0);
+    const double chord = 2.0 * std::sin(0.5 * std::min(radius, 3.1415926535897932384626433832795));
+    const double limit2 = chord * chord;
+
+    // groups of sources falling into the same cells
+    const std::vector<std::uint64_t>& cells = sources.si_cells;
+    const int n = (int) cells.size();
+    std::vector<int> groups;
+    for (int i = 0; i < n; i++) {
+        if (i == 0 || cells[i] != cells[i - 1]) {
+            groups.push_back(i);
+        }
+    }
+    const int ngroups = (int) groups.size();
+    groups.push_back(n);
+
+    auto match_group = [&](int group, CrossMatchWorkspace& ws) {
+        const int first = groups[group];
+        const int last = groups[group + 1];
+        const double* vecs = &sources.si_vectors[3 * (std::size_t) first];
+
+        // cone enclosing all sources of the group
+        Vector<double> center = {0.0, 0.0, 0.0};
+        for (int i = 0; i < last - first; i++) {
+            center[0] += vecs[3 * i];
+            center[1] += vecs[3 * i + 1];
+            center[2] += vecs[3 * i + 2];
+        }
+        if (dvn(center, center) == 0.0) {
+            center[0] = vecs[0];
+            center[1] = vecs[1];
+            center[2] = vecs[2];
+        }
+        double spread2 = 0.0;
+        for (int i = 0; i < last - first; i++) {
+            const double dx = vecs[3 * i] - center[0];
+            const double dy = vecs[3 * i + 1] - center[1];
+            const double dz = vecs[3 * i + 2] - center[2];
+            spread2 = std::max(spread2, dx * dx + dy * dy + dz * dz);
+        }
+        const double spread = 2.0 * std::asin(std::min(1.0, 0.5 * std::sqrt(spread2)));
+
+        // candidates from the reference, in cells about as wide as the cone (cells at level L are about 90/2**L
+        // degrees across); finer cells would only split candidates into more ranges
+        const double cone = spread + radius + MARGIN;
+        int level = 0;
+        while (level < reference.si_depth && std::ldexp(1.5707963267948966, -(level + 1)) > cone) {
+            level++;
+        }
+        reference.query_cone(center, cone, ws.xw_ranges, level);
+        ws.xw_x.clear();
+        ws.xw_y.clear();
+        ws.xw_z.clear();
+        ws.xw_reference.clear();
+        const std::vector<std::uint64_t>& rcells = reference.si_cells;
+        for (const SkyCellRange& range: ws.xw_ranges) {
+            const auto begin = std::lower_bound(rcells.begin(), rcells.end(), range.scr_first);
+            const auto end = std::upper_bound(begin, rcells.end(), range.scr_last);
+            for (auto k = (std::size_t) (begin - rcells.begin()); k < (std::size_t) (end - rcells.begin()); k++) {
+                ws.xw_x.push_back(reference.si_vectors[3 * k]);
+                ws.xw_y.push_back(reference.si_vectors[3 * k + 1]);
+                ws.xw_z.push_back(reference.si_vectors[3 * k + 2]);
+                ws.xw_reference.push_back(reference.si_order[k]);
+            }
+        }
+        const int ncandidates = (int) ws.xw_reference.size();
+        if (ncandidates == 0) {
+            return;
+        }
+
+        // matches of each source
+        ws.xw_chord2.resize(ncandidates);
+        for (int i = first; i < last; i++) {
+            cross_match_dispatcher(ncandidates, ws.xw_x.data(), ws.xw_y.data(), ws.xw_z.data(),
+                &sources.si_vectors[3 * (std::size_t) i], ws.xw_chord2.data());
+            ws.xw_hits.clear();
+            for (int j = 0; j < ncandidates; j++) {
+                if (ws.xw_chord2[j] <= limit2) {
+                    ws.xw_hits.emplace_back(ws.xw_chord2[j], ws.xw_reference[j]);
+                }
+            }
+            auto hits_end = ws.xw_hits.end();
+            if (max_matches > 0 && (int) ws.xw_hits.size() > max_matches) {
+                hits_end = ws.xw_hits.begin() + max_matches;
+                std::partial_sort(ws.xw_hits.begin(), hits_end, ws.xw_hits.end());
+            } else {
+                std::sort(ws.xw_hits.begin(), hits_end);
+            }
+            for (auto hit = ws.xw_hits.begin(); hit != hits_end; ++hit) {
+                const double separation = 2.0 * std::asin(std::min(1.0, 0.5 * std::sqrt(hit->first)));
+                ws.xw_matches.push_back({sources.si_order[i], hit->second, separation});
+            }
+        }
+    };
+
+    // batches of groups, each split into one part per thread; parts keep their matches until the batch is done
+    if (nthreads <= 0) {
+        nthreads = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+    std::vector<CrossMatchWorkspace> workspaces(nthreads);
+    std::int64_t total = 0;
+    for (int batch_first = 0; batch_first < ngroups;) {
+        int batch_last = batch_first + 1;
+        while (batch_last < ngroups && groups[batch_last] - groups[batch_first] < BATCH_SOURCES) {
+            batch_last++;
+        }
+        const int nparts = std::min(nthreads, batch_last - batch_first);
+        const int part = (batch_last - batch_first + nparts - 1) / nparts;
+        parallel_for(nparts, nparts, [&](int first, int last) {
+            for (int p = first; p < last; p++) {
+                const int end = std::min(batch_first + (p + 1) * part, batch_last);
+                for (int group = batch_first + p * part; group < end; group++) {
+                    match_group(group, workspaces[p]);
+                }
+            }
+        }, 1);
+        for (int p = 0; p < nparts; p++) {
+            std::vector<CrossMatch>& matches = workspaces[p].xw_matches;
+            if (!matches.empty()) {
+                if (sink != nullptr) {
+                    sink((int) matches.size(), matches.data(), context);
+                }
+                total += (std::int64_t) matches.size();
+                matches.clear();
+            }
+        }
+        batch_first = batch_last;
+    }
+    return total;
+}
+
+} // sla
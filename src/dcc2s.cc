@@ -16,7 +16,8 @@
  *
  */
 #include "slalib.h"
-#include <cmath>
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
@@ -34,12 +35,35 @@ namespace sla {
  *  coordinates are longitude (positive anticlockwise looking from the positive latitude pole) and latitude.
  */
 void dcc2s(const Vector<double> cartesian, Spherical<double>& spherical) {
-    const double x = cartesian[0];
-    const double y = cartesian[1];
-    const double z = cartesian[2];
-    const double r = std::sqrt(x * x + y * y);
-    spherical.set_longitude((r == 0.0)? 0.0: std::atan2(y, x));
-    spherical.set_latitude((z == 0.0)? 0.0: std::atan2(z, r));
+    double a, b;
+    kernel::cc2s(cartesian[0], cartesian[1], cartesian[2], a, b);
+    spherical.set_longitude(a);
+    spherical.set_latitude(b);
+}
+
+/**
+ * Converts many vectors from Cartesian to spherical coordinates (double precision); this is a vectorized version of
+ * sla::dcc2s().
+ *
+ * @param n Number of vectors.
+ * @param cartesian Vectors to convert.
+ * @param a Output: `n` longitudes (RAs, etc.), in radians.
+ * @param b Output: `n` latitudes (Decs, etc.), in radians.
+ */
+void dcc2s_batch(int n, const Vector<double>* cartesian, double* a, double* b) {
+    lane_loop<double>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V a_i, b_i;
+        kernel::cc2s(lane_load<V>(&cartesian[i][0], 3), lane_load<V>(&cartesian[i][1], 3),
+            lane_load<V>(&cartesian[i][2], 3), a_i, b_i);
+        lane_store(a_i, a + i);
+        lane_store(b_i, b + i);
+    });
+}
+
+/// Version of sla::dcc2s_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void dcc2s_batch(StridedSpan<const Vector<double>> cartesian, StridedSpan<double> a, StridedSpan<double> b) {
+    span_tiles(cartesian.get_size(), [](int n, auto... p) { dcc2s_batch(n, p...); }, cartesian, a, b);
 }
 
 }
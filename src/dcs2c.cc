@@ -16,7 +16,8 @@
  *
  */
 #include "slalib.h"
-#include <cmath>
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
@@ -31,10 +32,32 @@ namespace sla {
  *  longitude and latitude, and the z axis at the positive latitude pole.
  */
 void dcs2c(const Spherical<double>& spherical, Vector<double> cartesian) {
-    const double cos_b = std::cos(spherical.get_latitude());
-    cartesian[0] = std::cos(spherical.get_longitude()) * cos_b;
-    cartesian[1] = std::sin(spherical.get_longitude()) * cos_b;
-    cartesian[2] = std::sin(spherical.get_latitude());
+    kernel::cs2c(spherical.get_longitude(), spherical.get_latitude(), cartesian[0], cartesian[1], cartesian[2]);
+}
+
+/**
+ * Converts spherical coordinates of many points to direction cosines (double precision); this is a vectorized version
+ * of sla::dcs2c().
+ *
+ * @param n Number of points.
+ * @param a Longitudes (RAs, etc.) of the points, in radians.
+ * @param b Latitudes (Decs, etc.) of the points, in radians.
+ * @param cartesian Output: `n` 3-component unit vectors.
+ */
+void dcs2c_batch(int n, const double* a, const double* b, Vector<double>* cartesian) {
+    lane_loop<double>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V x, y, z;
+        kernel::cs2c(lane_load<V>(a + i), lane_load<V>(b + i), x, y, z);
+        lane_store(x, &cartesian[i][0], 3);
+        lane_store(y, &cartesian[i][1], 3);
+        lane_store(z, &cartesian[i][2], 3);
+    });
+}
+
+/// Version of sla::dcs2c_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void dcs2c_batch(StridedSpan<const double> a, StridedSpan<const double> b, StridedSpan<Vector<double>> cartesian) {
+    span_tiles(a.get_size(), [](int n, auto... p) { dcs2c_batch(n, p...); }, a, b, cartesian);
 }
 
 }
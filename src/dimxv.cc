@@ -16,34 +16,34 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
 /**
- * Procedure that performs 3D backward unitary transformation (double precision):
+ * Transforms many vectors by the same matrix (double precision); this is a vectorized version of sla::dimxv().
  *
- *   vector vb = (inverse of matrix mat) * vector va
- *
- * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
- *
- * @param mat Input matrix; must be unitary, as this routine assumes that the inverse and transpose are identical.
- * @param va Input vector; may be the same as output.
- * @param vb Output: vector; may be the same as input.
+ * @param mat Transformation matrix; must be unitary.
+ * @param n Number of vectors.
+ * @param va Vectors to transform.
+ * @param vb Output: `n` vectors, each being (inverse of matrix `mat`) * vector from `va`; can be the same array as `va`.
  */
-void dimxv(const Matrix<double> mat, const Vector<double> va, Vector<double> vb) {
-    // inverse of matrix mat * vector va -> vector result
-    Vector<double> result;
-    for (int j = 0; j < 3; j++) {
-        double element = 0.0;
-        for (int i = 0; i < 3; i++) {
-            element += mat[i][j] * va[i];
-        }
-        result[j] = element;
-    }
-    // vector result -> vector vb
-    for (int k = 0; k < 3; k++) {
-        vb[k] = result[k];
-    }
+void dimxv_batch(const Matrix<double> mat, int n, const Vector<double>* va, Vector<double>* vb) {
+    lane_loop<double>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V x, y, z;
+        kernel::imxv(mat, lane_load<V>(&va[i][0], 3), lane_load<V>(&va[i][1], 3), lane_load<V>(&va[i][2], 3),
+            x, y, z);
+        lane_store(x, &vb[i][0], 3);
+        lane_store(y, &vb[i][1], 3);
+        lane_store(z, &vb[i][2], 3);
+    });
+}
+
+/// Version of sla::dimxv_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void dimxv_batch(const Matrix<double> mat, StridedSpan<const Vector<double>> va, StridedSpan<Vector<double>> vb) {
+    span_tiles(va.get_size(), [mat](int n, auto... p) { dimxv_batch(mat, n, p...); }, va, vb);
 }
 
 }
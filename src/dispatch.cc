@@ -0,0 +1,112 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "dispatch.h"
+#include <algorithm>
+
+namespace sla {
+
+/// Highest instruction set level that dispatchers may select (see sla::set_isa_limit()).
+static std::atomic<int> g_isa_limit(ISA_AVX512);
+
+/// Head of the list of enlisted dispatchers.
+static std::atomic<Dispatcher*> g_dispatchers(nullptr);
+
+ISALevel Dispatcher::select_isa() {
+    const ISALevel isa = std::min(cpu_isa_level(), ISALevel(g_isa_limit.load(std::memory_order_relaxed)));
+    d_isa.store(isa, std::memory_order_relaxed);
+    return isa;
+}
+
+bool Dispatcher::enlist() {
+    d_next = g_dispatchers.load();
+    while (!g_dispatchers.compare_exchange_weak(d_next, this)) {}
+    return true;
+}
+
+/**
+ * Highest instruction set level supported by both the CPU and the operating system; on other than x86-64 targets, or
+ * if the library was built with `SLALIB_NO_DISPATCH` defined, always returns ISA_SSE2 (meaning "baseline").
+ *
+ * @return Instruction set level of the CPU.
+ */
+ISALevel cpu_isa_level() {
+#if SLALIB_DISPATCH
+    static const ISALevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq") &&
+            __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512bw")) {
+            return ISA_AVX512;
+        }
+        return __builtin_cpu_supports("avx2")? ISA_AVX2: ISA_SSE2;
+    }();
+    return level;
+#else
+    return ISA_SSE2;
+#endif
+}
+
+/**
+ * Limits instruction sets that functions with run-time dispatch may use (by default, they use the best variant the
+ * CPU supports); variants are selected anew on the next call of each function. Can be used to compare results or
+ * performance of different variants on the same machine; the results are expected to be identical.
+ *
+ * Must not be called while other threads are calling library functions.
+ *
+ * @param limit Highest instruction set level to use.
+ */
+void set_isa_limit(ISALevel limit) {
+    g_isa_limit.store(limit);
+    for (Dispatcher* dispatcher = g_dispatchers.load(); dispatcher != nullptr; dispatcher = dispatcher->d_next) {
+        dispatcher->d_isa.store(-1);
+    }
+}
+
+/**
+ * Reports functions with run-time dispatch that are linked into the program, and the instruction sets of variants
+ * that they use (or will use when first called), in no particular order.
+ *
+ * @param kernels Return value: array of at least `max` elements that receives function names and instruction sets;
+ *   can be `nullptr` if `max` is zero.
+ * @param max Maximum number of functions to report.
+ * @return Total number of functions with run-time dispatch, which may be greater than `max`.
+ */
+int get_dispatched_kernels(KernelISA* kernels, int max) {
+    int count = 0;
+    for (Dispatcher* dispatcher = g_dispatchers.load(); dispatcher != nullptr; dispatcher = dispatcher->d_next) {
+        if (count < max) {
+            kernels[count].ki_kernel = dispatcher->d_kernel;
+            kernels[count].ki_isa = dispatcher->get_isa();
+        }
+        count++;
+    }
+    return count;
+}
+
+/**
+ * Returns printable name of an instruction set level.
+ *
+ * @param level Instruction set level.
+ * @return Lowercase name of the instruction set ("sse2", "avx2", or "avx512").
+ */
+const char* isa_name(ISALevel level) {
+    static const char* const names[ISA_NUM_LEVELS] = {"sse2", "avx2", "avx512"};
+    assert(level >= ISA_SSE2 && level <= ISA_AVX512);
+    return names[level];
+}
+
+} // sla
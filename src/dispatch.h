@@ -0,0 +1,117 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_DISPATCH_H_INCLUDED
+#define SLALIB_DISPATCH_H_INCLUDED
+
+#include "slalib.h"
+#include <atomic>
+
+/*
+ * Run-time selection of instruction sets: hot functions are compiled several times, for the baseline x86-64 target
+ * (SSE2), for AVX2, and for AVX-512; the variant to use is picked at first call, depending on the CPU the program runs
+ * on (see sla::cpu_isa_level() and sla::set_isa_limit()). Only the code generation differs between the variants: the
+ * translation units that define kernels must be compiled with `-ffp-contract=off` (and, by GCC, with
+ * `-fno-tree-slp-vectorize`; see `SLALIB_DISPATCHED_SOURCES` in src/CMakeLists.txt), so that the compiler does not
+ * fuse multiplications and additions in AVX2 and AVX-512 variants, and all variants produce identical results; a new
+ * translation unit that includes this header must be added to that list. Defining `SLALIB_NO_DISPATCH` makes all
+ * functions use their baseline versions.
+ */
+#if !defined(SLALIB_NO_DISPATCH) && defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define SLALIB_DISPATCH 1
+#define SLALIB_TARGET_AVX2 __attribute__((target("avx2")))
+#define SLALIB_TARGET_AVX512 __attribute__((target("avx512f,avx512dq,avx512vl,avx512bw")))
+#define SLALIB_KERNEL inline __attribute__((always_inline))
+#else
+#define SLALIB_DISPATCH 0
+#define SLALIB_TARGET_AVX2
+#define SLALIB_TARGET_AVX512
+#define SLALIB_KERNEL inline
+#endif
+
+namespace sla {
+
+/// Number of instruction set levels (see sla::ISALevel).
+constexpr int ISA_NUM_LEVELS = ISA_AVX512 + 1;
+
+/**
+ * Base class of kernel dispatchers: keeps the instruction set of the variant selected for a kernel, and links all
+ * enlisted dispatchers into a list that sla::get_dispatched_kernels() and sla::set_isa_limit() walk. The constructor
+ * is `constexpr`, so dispatchers defined at namespace scope work even if called during static initialization.
+ */
+class Dispatcher {
+    const char*      d_kernel; ///< name of the library function implemented by the kernel
+    std::atomic<int> d_isa;    ///< instruction set of the selected variant, or -1 if not selected yet
+    Dispatcher*      d_next;   ///< next enlisted dispatcher
+
+    ISALevel select_isa();
+
+protected:
+    constexpr explicit Dispatcher(const char* kernel): d_kernel(kernel), d_isa(-1), d_next(nullptr) {}
+
+    /// Returns instruction set of the variant to use, selecting it on first call.
+    ISALevel get_isa() {
+        const int isa = d_isa.load(std::memory_order_relaxed);
+        return isa >= 0? ISALevel(isa): select_isa();
+    }
+
+public:
+    Dispatcher(const Dispatcher&) = delete;
+    Dispatcher& operator=(const Dispatcher&) = delete;
+
+    /// Adds dispatcher to the list reported by sla::get_dispatched_kernels(); always returns `true`.
+    bool enlist();
+
+    friend void set_isa_limit(ISALevel limit);
+    friend int get_dispatched_kernels(KernelISA* kernels, int max);
+};
+
+/**
+ * Dispatcher of kernel `K`, which should be a `static SLALIB_KERNEL` function holding the body of a library function;
+ * `K` is inlined into one wrapper per instruction set, and the dispatcher forwards calls to one of the wrappers. The
+ * dispatcher is meant to be defined next to the kernel, followed by a call to `enlist()`:
+ *
+ *   static KernelDispatcher<evp_batch_kernel> evp_batch_dispatcher("evp_batch");
+ *   static const bool evp_batch_enlisted = evp_batch_dispatcher.enlist();
+ */
+template <auto K>
+class KernelDispatcher;
+
+template <typename R, typename... A, R (*K)(A...)>
+class KernelDispatcher<K>: public Dispatcher {
+    using Variant = R (*)(A...);
+
+    static R sse2_variant(A... args) { return K(args...); }
+#if SLALIB_DISPATCH
+    SLALIB_TARGET_AVX2 static R avx2_variant(A... args) { return K(args...); }
+    SLALIB_TARGET_AVX512 static R avx512_variant(A... args) { return K(args...); }
+    static constexpr Variant kd_variants[ISA_NUM_LEVELS] = {sse2_variant, avx2_variant, avx512_variant};
+#else
+    static constexpr Variant kd_variants[ISA_NUM_LEVELS] = {sse2_variant, sse2_variant, sse2_variant};
+#endif
+
+public:
+    constexpr explicit KernelDispatcher(const char* kernel): Dispatcher(kernel) {}
+
+    R operator()(A... args) {
+        return kd_variants[get_isa()](args...);
+    }
+};
+
+} // sla
+
+#endif // SLALIB_DISPATCH_H_INCLUDED
@@ -16,6 +16,9 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "dispatch.h"
+#include <algorithm>
 #include <cmath>
 
 namespace sla {
@@ -49,6 +52,14 @@ namespace sla {
  * @param pv Return value: Moon {x,y,z},{xdot,ydot,zdot}, mean equator and equinox of date (AU, AU/s).
  */
 void dmoon(double date, VectorPV<double>& pv) {
+    dmoon_batch(1, &date, &pv);
+}
+
+/// Body of sla::dmoon_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void dmoon_batch_kernel(int n, const double* dates, VectorPV<double>* pv) {
+    // number of dates processed together
+    constexpr int CHUNK = 32;
+
     // degrees, arcseconds and seconds of time to radians
     constexpr double DEGREES_2_RADIANS = 0.0174532925199432957692369;
     constexpr double ARCSECONDS_2_RADIANS = 4.848136811095359935899141e-6;
@@ -77,47 +88,40 @@ void dmoon(double date, VectorPV<double>& pv) {
     constexpr double ELP1 = 481267.8831;
     constexpr double ELP2 = -0.001133;
     constexpr double ELP3 = 0.0000019;
-    double elp, delp;
 
     // Sun's mean anomaly
     constexpr double EM0 = 358.475833;
     constexpr double EM1 = 35999.0498;
     constexpr double EM2 = -0.000150;
     constexpr double EM3 = -0.0000033;
-    double em, dem;
 
     // Moon's mean anomaly
     constexpr double EMP0 = 296.104608;
     constexpr double EMP1 = 477198.8491;
     constexpr double EMP2 = 0.009192;
     constexpr double EMP3 = 0.0000144;
-    double emp, demp;
 
     // Moon's mean elongation
     constexpr double D0 = 350.737486;
     constexpr double D1 = 445267.1142;
     constexpr double D2 = -0.001436;
     constexpr double D3 = 0.0000019;
-    double d, dd;
 
     // mean distance of the Moon from its ascending node
     constexpr double F0 = 11.250889;
     constexpr double F1 = 483202.0251;
     constexpr double F2 = -0.003211;
     constexpr double F3 = -0.0000003;
-    double f, df;
 
     // longitude of the Moon's ascending node
     constexpr double OM0 = 259.183275;
     constexpr double OM1 = -1934.1420;
     constexpr double OM2 = 0.002078;
     constexpr double OM3 = 0.0000022;
-    double om, dom;
 
     // coefficients for (dimensionless) e factor
     constexpr double E1 = -0.002495;
     constexpr double E2 = -0.00000752;
-    double e, de, esq, desq;
 
     // coefficients for periodic variations etc.
     constexpr double PAC = 0.000233;
@@ -279,7 +283,7 @@ void dmoon(double date, VectorPV<double>& pv) {
 
     // parallax
     constexpr int NP = 31;
-    double TP[NP]{
+    static const double TP[NP] = {
         +0.950724, +0.051818, +0.009531, +0.007843, +0.002824,
         +0.000857, +0.000533, +0.000401, +0.000320, -0.000271,
         -0.000264, -0.000198, +0.000173, +0.000167, -0.000111,
@@ -323,209 +327,240 @@ void dmoon(double date, VectorPV<double>& pv) {
         {-1, -1, +4, +0, 1}
     };
 
-    // centuries since J1900
-    double t = (date - 15019.5) / 36525.0;
-
-    /*
-     * Fundamental arguments (radians) and derivatives (radians per
-     * Julian century) for the current epoch.
-     */
-
-    // Moon's mean longitude
-    elp = DEGREES_2_RADIANS * std::fmod(ELP0 + (ELP1 + (ELP2 + ELP3 * t) * t) * t, 360.0);
-    delp = DEGREES_2_RADIANS * (ELP1 + (2.0 * ELP2 + 3.0 * ELP3 * t) * t);
-
-    // Sun's mean anomaly
-    em = DEGREES_2_RADIANS * std::fmod(EM0 + (EM1 + (EM2 + EM3 * t) * t) * t, 360.0);
-    dem = DEGREES_2_RADIANS * (EM1 + (2.0 * EM2 + 3.0 * EM3 * t) * t);
-
-    // Moon's mean anomaly
-    emp = DEGREES_2_RADIANS * std::fmod(EMP0 + (EMP1 + (EMP2 + EMP3 * t) * t) * t, 360.0);
-    demp = DEGREES_2_RADIANS * (EMP1 + (2.0 * EMP2 + 3.0 * EMP3 * t) * t);
-
-    // Moon's mean elongation
-    d = DEGREES_2_RADIANS * std::fmod(D0 + (D1 + (D2 + D3 * t) * t) * t, 360.0);
-    dd = DEGREES_2_RADIANS * (D1 + (2.0 * D2 + 3.0 * D3 * t) * t);
-
-    // mean distance of the Moon from its ascending node
-    f = DEGREES_2_RADIANS * std::fmod(F0 + (F1 + (F2 + F3 * t) * t) * t, 360.0);
-    df = DEGREES_2_RADIANS * (F1 + (2.0 * F2 + 3.0 * F3 * t) * t);
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+        const double* date = dates + base;
+
+        /*
+         * Fundamental arguments (radians) and derivatives (radians per Julian century) for the current epoch, and
+         * e-factor powers (index 0 for terms not depending on e, 1 for e, and 2 for e**2), per date.
+         */
+        double elp[CHUNK], delp[CHUNK], em[CHUNK], dem[CHUNK], emp[CHUNK], demp[CHUNK];
+        double d[CHUNK], dd[CHUNK], f[CHUNK], df[CHUNK], dom[CHUNK];
+        double sin_om[CHUNK], cos_om[CHUNK], sin_wom[CHUNK], cos_wom[CHUNK], dwom[CHUNK];
+        double en[3][CHUNK], den[3][CHUNK];
+        for (int j = 0; j < count; j++) {
+            // centuries since J1900
+            const double t = (date[j] - 15019.5) / 36525.0;
+
+            // Moon's mean longitude
+            elp[j] = DEGREES_2_RADIANS * std::fmod(ELP0 + (ELP1 + (ELP2 + ELP3 * t) * t) * t, 360.0);
+            delp[j] = DEGREES_2_RADIANS * (ELP1 + (2.0 * ELP2 + 3.0 * ELP3 * t) * t);
+
+            // Sun's mean anomaly
+            em[j] = DEGREES_2_RADIANS * std::fmod(EM0 + (EM1 + (EM2 + EM3 * t) * t) * t, 360.0);
+            dem[j] = DEGREES_2_RADIANS * (EM1 + (2.0 * EM2 + 3.0 * EM3 * t) * t);
+
+            // Moon's mean anomaly
+            emp[j] = DEGREES_2_RADIANS * std::fmod(EMP0 + (EMP1 + (EMP2 + EMP3 * t) * t) * t, 360.0);
+            demp[j] = DEGREES_2_RADIANS * (EMP1 + (2.0 * EMP2 + 3.0 * EMP3 * t) * t);
+
+            // Moon's mean elongation
+            d[j] = DEGREES_2_RADIANS * std::fmod(D0 + (D1 + (D2 + D3 * t) * t) * t, 360.0);
+            dd[j] = DEGREES_2_RADIANS * (D1 + (2.0 * D2 + 3.0 * D3 * t) * t);
+
+            // mean distance of the Moon from its ascending node
+            f[j] = DEGREES_2_RADIANS * std::fmod(F0 + (F1 + (F2 + F3 * t) * t) * t, 360.0);
+            df[j] = DEGREES_2_RADIANS * (F1 + (2.0 * F2 + 3.0 * F3 * t) * t);
+
+            // longitude of the Moon's ascending node
+            const double om = DEGREES_2_RADIANS * std::fmod(OM0 + (OM1 + (OM2 + OM3 * t) * t) * t, 360.0);
+            dom[j] = DEGREES_2_RADIANS * (OM1 + (2.0 * OM2 + 3.0 * OM3 * t) * t);
+            sin_om[j] = std::sin(om);
+            cos_om[j] = std::cos(om);
+            const double dom_cos_om = dom[j] * cos_om[j];
+
+            // add the periodic variations
+            double theta = DEGREES_2_RADIANS * (PA0 + PA1 * t);
+            const double wa = std::sin(theta);
+            const double dwa = DEGREES_2_RADIANS * PA1 * std::cos(theta);
+            theta = DEGREES_2_RADIANS * (PE0 + (PE1 + PE2 * t) * t);
+            const double wb = PEC * std::sin(theta);
+            const double dwb = DEGREES_2_RADIANS * PEC * (PE1 + 2.0 * PE2 * t) * std::cos(theta);
+            elp[j] = elp[j] + DEGREES_2_RADIANS * (PAC * wa + wb + PFC * sin_om[j]);
+            delp[j] = delp[j] + DEGREES_2_RADIANS * (PAC * dwa + dwb + PFC * dom_cos_om);
+            em[j] = em[j] + DEGREES_2_RADIANS * PBC * wa;
+            dem[j] = dem[j] + DEGREES_2_RADIANS * PBC * dwa;
+            emp[j] = emp[j] + DEGREES_2_RADIANS * (PCC * wa + wb + PGC * sin_om[j]);
+            demp[j] = demp[j] + DEGREES_2_RADIANS * (PCC * dwa + dwb + PGC * dom_cos_om);
+            d[j] = d[j] + DEGREES_2_RADIANS * (PDC * wa + wb + PHC * sin_om[j]);
+            dd[j] = dd[j] + DEGREES_2_RADIANS * (PDC * dwa + dwb + PHC * dom_cos_om);
+            const double wom = om + DEGREES_2_RADIANS * (PJ0 + PJ1 * t);
+            dwom[j] = dom[j] + DEGREES_2_RADIANS * PJ1;
+            sin_wom[j] = std::sin(wom);
+            cos_wom[j] = std::cos(wom);
+            f[j] = f[j] + DEGREES_2_RADIANS * (wb + PIC * sin_om[j] + PJC * sin_wom[j]);
+            df[j] = df[j] + DEGREES_2_RADIANS * (dwb + PIC * dom_cos_om + PJC * dwom[j] * cos_wom[j]);
+
+            // e-factor, and square
+            const double e = 1.0 + (E1 + E2 * t) * t;
+            const double de = E1 + 2.0 * E2 * t;
+            en[0][j] = 1.0;
+            den[0][j] = 0.0;
+            en[1][j] = e;
+            den[1][j] = de;
+            en[2][j] = e * e;
+            den[2][j] = 2.0 * e * de;
+        }
 
-    // longitude of the Moon's ascending node
-    om = DEGREES_2_RADIANS * std::fmod(OM0 + (OM1 + (OM2 + OM3 * t) * t) * t, 360.0);
-    dom = DEGREES_2_RADIANS * (OM1 + (2.0 * OM2 + 3.0 * OM3 * t) * t);
-    const double sin_om = std::sin(om);
-    const double cos_om = std::cos(om);
-    const double dom_cos_om = dom * cos_om;
-
-    // add the periodic variations
-    double theta = DEGREES_2_RADIANS * (PA0 + PA1 * t);
-    const double wa = std::sin(theta);
-    const double dwa = DEGREES_2_RADIANS * PA1 * std::cos(theta);
-    theta = DEGREES_2_RADIANS * (PE0 + (PE1 + PE2 * t) * t);
-    const double wb = PEC * std::sin(theta);
-    const double dwb = DEGREES_2_RADIANS * PEC * (PE1 + 2.0 * PE2 * t) * std::cos(theta);
-    elp = elp + DEGREES_2_RADIANS * (PAC * wa + wb + PFC * sin_om);
-    delp = delp + DEGREES_2_RADIANS * (PAC * dwa + dwb + PFC * dom_cos_om);
-    em = em + DEGREES_2_RADIANS * PBC * wa;
-    dem = dem + DEGREES_2_RADIANS * PBC * dwa;
-    emp = emp + DEGREES_2_RADIANS * (PCC * wa + wb + PGC * sin_om);
-    demp = demp + DEGREES_2_RADIANS * (PCC * dwa + dwb + PGC * dom_cos_om);
-    d = d + DEGREES_2_RADIANS * (PDC * wa + wb + PHC * sin_om);
-    dd = dd + DEGREES_2_RADIANS * (PDC * dwa + dwb + PHC * dom_cos_om);
-    const double wom = om + DEGREES_2_RADIANS * (PJ0 + PJ1 * t);
-    const double dwom = dom + DEGREES_2_RADIANS * PJ1;
-    const double sin_wom = std::sin(wom);
-    const double cos_wom = std::cos(wom);
-    f = f + DEGREES_2_RADIANS * (wb + PIC * sin_om + PJC * sin_wom);
-    df = df + DEGREES_2_RADIANS * (dwb + PIC * dom_cos_om + PJC * dwom * cos_wom);
-
-    // e-factor, and square
-    e = 1.0 + (E1 + E2 * t) * t;
-    de = E1 + 2.0 * E2 * t;
-    esq = e * e;
-    desq = 2.0 * e * de;
+        /*
+         *  Series expansions; terms are in the outer loops, so that the inner loops run over dates.
+         */
 
-    /*
-     *  Series expansions.
-     */
-    int n, i;
+        // longitude
+        double v[CHUNK], dv[CHUNK];
+        for (int j = 0; j < count; j++) {
+            v[j] = 0.0;
+            dv[j] = 0.0;
+        }
+        for (int k = NL - 1; k >= 0; k--) {
+            const double coeff = TL[k];
+            const double emn = (double) ITL[k][0];
+            const double empn = (double) ITL[k][1];
+            const double dn = (double) ITL[k][2];
+            const double fn = (double) ITL[k][3];
+            const double* e_k = en[ITL[k][4]];
+            const double* de_k = den[ITL[k][4]];
+            for (int j = 0; j < count; j++) {
+                const double theta = emn * em[j] + empn * emp[j] + dn * d[j] + fn * f[j];
+                const double dtheta = emn * dem[j] + empn * demp[j] + dn * dd[j] + fn * df[j];
+                const double ftheta = std::sin(theta);
+                v[j] += coeff * ftheta * e_k[j];
+                dv[j] += coeff * (std::cos(theta) * dtheta * e_k[j] + ftheta * de_k[j]);
+            }
+        }
+        double el[CHUNK], del[CHUNK];
+        for (int j = 0; j < count; j++) {
+            el[j] = elp[j] + DEGREES_2_RADIANS * v[j];
+            del[j] = (delp[j] + DEGREES_2_RADIANS * dv[j]) / SECONDS_PER_JCENTURY;
+        }
 
-    // longitude
-    double v = 0.0;
-    double dv = 0.0;
-    double coeff, emn, empn, dn, fn, en, den, dtheta, ftheta;
-    for (n = NL - 1; n >= 0; n--) {
-        coeff = TL[n];
-        emn = (double) ITL[n][0];
-        empn = (double) ITL[n][1];
-        dn = (double) ITL[n][2];
-        fn = (double) ITL[n][3];
-        i = ITL[n][4];
-        if (i == 0) {
-            en = 1.0;
-            den = 0.0;
-        } else if (i == 1) {
-            en = e;
-            den = de;
-        } else {
-            en = esq;
-            den = desq;
+        // latitude
+        for (int j = 0; j < count; j++) {
+            v[j] = 0.0;
+            dv[j] = 0.0;
+        }
+        for (int k = NB - 1; k >= 0; k--) {
+            const double coeff = TB[k];
+            const double emn = (double) ITB[k][0];
+            const double empn = (double) ITB[k][1];
+            const double dn = (double) ITB[k][2];
+            const double fn = (double) ITB[k][3];
+            const double* e_k = en[ITB[k][4]];
+            const double* de_k = den[ITB[k][4]];
+            for (int j = 0; j < count; j++) {
+                const double theta = emn * em[j] + empn * emp[j] + dn * d[j] + fn * f[j];
+                const double dtheta = emn * dem[j] + empn * demp[j] + dn * dd[j] + fn * df[j];
+                const double ftheta = std::sin(theta);
+                v[j] += coeff * ftheta * e_k[j];
+                dv[j] += coeff * (std::cos(theta) * dtheta * e_k[j] + ftheta * de_k[j]);
+            }
+        }
+        double b[CHUNK], db[CHUNK];
+        for (int j = 0; j < count; j++) {
+            const double bf = 1.0 - CW1 * cos_om[j] - CW2 * cos_wom[j];
+            const double dbf = CW1 * dom[j] * sin_om[j] + CW2 * dwom[j] * sin_wom[j];
+            b[j] = DEGREES_2_RADIANS * v[j] * bf;
+            db[j] = DEGREES_2_RADIANS * (dv[j] * bf + v[j] * dbf) / SECONDS_PER_JCENTURY;
         }
-        theta = emn * em + empn * emp + dn * d + fn * f;
-        dtheta = emn * dem + empn * demp + dn * dd + fn * df;
-        ftheta = std::sin(theta);
-        v += coeff * ftheta * en;
-        dv += coeff * (std::cos(theta) * dtheta * en + ftheta * den);
-    }
-    const double el = elp + DEGREES_2_RADIANS * v;
-    const double del = (delp + DEGREES_2_RADIANS * dv) / SECONDS_PER_JCENTURY;
 
-    // latitude
-    v = 0.0;
-    dv = 0.0;
-    for (n = NB - 1; n >= 0; n--) {
-        coeff = TB[n];
-        emn = (double) ITB[n][0];
-        empn = (double) ITB[n][1];
-        dn = (double) ITB[n][2];
-        fn = (double) ITB[n][3];
-        i = ITB[n][4];
-        if (i == 0) {
-            en = 1.0;
-            den = 0.0;
-        } else if (i == 1) {
-            en = e;
-            den = de;
-        } else {
-            en = esq;
-            den = desq;
+        // parallax
+        for (int j = 0; j < count; j++) {
+            v[j] = 0.0;
+            dv[j] = 0.0;
+        }
+        for (int k = NP - 1; k >= 0; k--) {
+            const double coeff = TP[k];
+            const double emn = (double) ITP[k][0];
+            const double empn = (double) ITP[k][1];
+            const double dn = (double) ITP[k][2];
+            const double fn = (double) ITP[k][3];
+            const double* e_k = en[ITP[k][4]];
+            const double* de_k = den[ITP[k][4]];
+            for (int j = 0; j < count; j++) {
+                const double theta = emn * em[j] + empn * emp[j] + dn * d[j] + fn * f[j];
+                const double dtheta = emn * dem[j] + empn * demp[j] + dn * dd[j] + fn * df[j];
+                const double ftheta = std::cos(theta);
+                v[j] += coeff * ftheta * e_k[j];
+                dv[j] += coeff * (-std::sin(theta) * dtheta * e_k[j] + ftheta * de_k[j]);
+            }
         }
-        theta = emn * em + empn * emp + dn * d + fn * f;
-        dtheta = emn * dem + empn * demp + dn * dd + fn * df;
-        ftheta = std::sin(theta);
-        v += coeff * ftheta * en;
-        dv += coeff * (std::cos(theta) * dtheta * en + ftheta * den);
-    }
-    const double bf = 1.0 - CW1 * cos_om - CW2 * cos_wom;
-    const double dbf = CW1 * dom * sin_om + CW2 * dwom * sin_wom;
-    const double b = DEGREES_2_RADIANS * v * bf;
-    const double db = DEGREES_2_RADIANS * (dv * bf + v * dbf) / SECONDS_PER_JCENTURY;
 
-    // parallax
-    v = 0.0;
-    dv = 0.0;
-    for (n = NP - 1; n >= 0; n--) {
-        coeff = TP[n];
-        emn = (double) ITP[n][0];
-        empn = (double) ITP[n][1];
-        dn = (double) ITP[n][2];
-        fn = (double) ITP[n][3];
-        i = ITP[n][4];
-        if (i == 0) {
-            en = 1.0;
-            den = 0.0;
-        } else if (i == 1) {
-            en = e;
-            den = de;
-        } else {
-            en = esq;
-            den = desq;
+        /*
+         * Transformation into final form.
+         */
+        for (int j = 0; j < count; j++) {
+            const double p = DEGREES_2_RADIANS * v[j];
+            const double dp = DEGREES_2_RADIANS * dv[j] / SECONDS_PER_JCENTURY;
+
+            // parallax to distance (AU, AU/sec)
+            const double sin_p = std::sin(p);
+            const double r = EARTH_RADIUS_AU / sin_p;
+            const double dr = -r * dp * std::cos(p) / sin_p;
+
+            // longitude, latitude to x,y,z (AU)
+            const double sel = std::sin(el[j]);
+            const double cel = std::cos(el[j]);
+            const double sb = std::sin(b[j]);
+            const double cb = std::cos(b[j]);
+            const double rcb = r * cb;
+            const double rbd = r * db[j];
+            const double w = rbd * sb - cb * dr;
+            const double x = rcb * cel;
+            const double y = rcb * sel;
+            const double z = r * sb;
+            const double xd = -y * del[j] - w * cel;
+            const double yd = x * del[j] - w * sel;
+            const double zd = rbd * cb + sb * dr;
+
+            // Julian centuries since J2000
+            const double t = (date[j] - 51544.5) / 36525.0;
+
+            // Fricke equinox correction
+            const double epj = 2000.0 + t * 100.0;
+            const double eqcor = SECONDS_2_RADIANS * (0.035 + 0.00085 * (epj - JEPOCH_B1950));
+
+            // mean obliquity (IAU 1976)
+            const double eps = ARCSECONDS_2_RADIANS * (84381.448 + (-46.8150 + (-0.00059 + 0.001813 * t) * t) * t);
+
+            // to the equatorial system, mean of date, FK5 system
+            const double sin_eps = std::sin(eps);
+            const double cos_eps = std::cos(eps);
+            const double es = eqcor * sin_eps;
+            const double ec = eqcor * cos_eps;
+            VectorPV<double>& result = pv[base + j];
+            result.set_x(x - ec * y + es * z);
+            result.set_y(eqcor * x + y * cos_eps - z * sin_eps);
+            result.set_z(y * sin_eps + z * cos_eps);
+            result.set_dx(xd - ec * yd + es * zd);
+            result.set_dy(eqcor * xd + yd * cos_eps - zd * sin_eps);
+            result.set_dz(yd * sin_eps + zd * cos_eps);
         }
-        theta = emn * em + empn * emp + dn * d + fn * f;
-        dtheta = emn * dem + empn * demp + dn * dd + fn * df;
-        ftheta = std::cos(theta);
-        v += coeff * ftheta * en;
-        dv += coeff * (-std::sin(theta) * dtheta * en + ftheta * den);
     }
-    const double p = DEGREES_2_RADIANS * v;
-    const double dp = DEGREES_2_RADIANS * dv / SECONDS_PER_JCENTURY;
+}
 
-    /*
-     * Transformation into final form.
-     */
+static KernelDispatcher<dmoon_batch_kernel> dmoon_batch_dispatcher("dmoon_batch");
+static const bool dmoon_batch_enlisted = dmoon_batch_dispatcher.enlist();
+
+/**
+ * Calculates approximate geocentric positions and velocities of the Moon for many dates (double precision).
+ *
+ * Results are identical to those of the sla::dmoon() function (which is implemented as a batch of one date). Dates
+ * are processed in chunks, with series terms in the outer loops and dates in the inner ones; inner loops are free
+ * of branches and cross-iteration dependencies, so compilers can vectorize them across dates.
+ *
+ * @param n Number of dates.
+ * @param dates TDB (Barycentric Dynamical Time; loosely ET) as Modified Julian Dates (JD-2400000.5).
+ * @param pv Return value: array of `n` elements receiving Moon {x,y,z},{xdot,ydot,zdot}, mean equator and equinox of
+ *   date (AU, AU/s).
+ */
+void dmoon_batch(int n, const double* dates, VectorPV<double>* pv) {
+    dmoon_batch_dispatcher(n, dates, pv);
+}
 
-    // parallax to distance (AU, AU/sec)
-    const double sin_p = std::sin(p);
-    const double r = EARTH_RADIUS_AU / sin_p;
-    const double dr = -r * dp * std::cos(p) / sin_p;
-
-    // longitude, latitude to x,y,z (AU)
-    const double sel = std::sin(el);
-    const double cel = std::cos(el);
-    const double sb = std::sin(b);
-    const double cb = std::cos(b);
-    const double rcb = r * cb;
-    const double rbd = r * db;
-    const double w = rbd * sb - cb * dr;
-    const double x = rcb * cel;
-    const double y = rcb * sel;
-    const double z = r * sb;
-    const double xd = -y * del - w * cel;
-    const double yd = x * del - w * sel;
-    const double zd = rbd * cb + sb * dr;
-
-    // Julian centuries since J2000
-    t = (date - 51544.5) / 36525.0;
-
-    // Fricke equinox correction
-    const double epj = 2000.0 + t * 100.0;
-    const double eqcor = SECONDS_2_RADIANS * (0.035 + 0.00085 * (epj - JEPOCH_B1950));
-
-    // mean obliquity (IAU 1976)
-    const double eps = ARCSECONDS_2_RADIANS * (84381.448 + (-46.8150 + (-0.00059 + 0.001813 * t) * t) * t);
-
-    // to the equatorial system, mean of date, FK5 system
-    const double sin_eps = std::sin(eps);
-    const double cos_eps = std::cos(eps);
-    const double es = eqcor * sin_eps;
-    const double ec = eqcor * cos_eps;
-    pv.set_x(x - ec * y + es * z);
-    pv.set_y(eqcor * x + y * cos_eps - z * sin_eps);
-    pv.set_z(y * sin_eps + z * cos_eps);
-    pv.set_dx(xd - ec * yd + es * zd);
-    pv.set_dy(eqcor * xd + yd * cos_eps - zd * sin_eps);
-    pv.set_dz(yd * sin_eps + zd * cos_eps);
+/// Version of sla::dmoon_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void dmoon_batch(StridedSpan<const double> dates, StridedSpan<VectorPV<double>> pv) {
+    span_tiles(dates.get_size(), [](int n, auto... p) { dmoon_batch(n, p...); }, dates, pv);
 }
 
 }
@@ -16,26 +16,28 @@
  *
  */
 #include "slalib.h"
-#include "f77_utils.h"
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
 /**
- * Normalizes angle into range +/- pi  (double precision).
+ * Normalizes many angles into range +/- pi (double precision); this is a vectorized version of sla::drange().
  *
- * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
- *
- * @param angle The angle in radians.
- * @return The `angle` expressed in the +/- pi.
+ * @param n Number of angles.
+ * @param angles The angles in radians.
+ * @param result Output: `n` angles expressed in the +/- pi range; can be the same array as `angles`.
  */
-double drange(double angle) {
-    constexpr double PI = 3.141592653589793238462643;
-    constexpr double PI2 = 6.283185307179586476925287;
-    double result = std::fmod(angle, PI2);
-    if (std::fabs(result) >= PI) {
-        result -= f_sign(PI2, angle);
-    }
-    return result;
+void drange_batch(int n, const double* angles, double* result) {
+    lane_loop<double>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        lane_store(kernel::range(lane_load<V>(angles + i)), result + i);
+    });
+}
+
+/// Version of sla::drange_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void drange_batch(StridedSpan<const double> angles, StridedSpan<double> result) {
+    span_tiles(angles.get_size(), [](int n, auto... p) { drange_batch(n, p...); }, angles, result);
 }
 
 }
@@ -16,25 +16,28 @@
  *
  */
 #include "slalib.h"
-#include <cmath>
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
 /**
- * Normalize angle into range 0-2*pi (double precision).
+ * Normalizes many angles into range 0-2*pi (double precision); this is a vectorized version of sla::dranrm().
  *
- * Original FORTRAN code by P.T. Wallace.
- *
- * @param angle The angle in radians.
- * @return The `angle` expressed in the range 0-2*pi .
+ * @param n Number of angles.
+ * @param angles The angles in radians.
+ * @param result Output: `n` angles expressed in the range 0-2*pi; can be the same array as `angles`.
  */
-double dranrm(double angle) {
-    constexpr double A2PI = 6.283185307179586476925287;
-    double result = std::fmod(angle, A2PI);
-    if (result < 0.0) {
-        result += A2PI;
-    }
-    return result;
+void dranrm_batch(int n, const double* angles, double* result) {
+    lane_loop<double>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        lane_store(kernel::ranorm(lane_load<V>(angles + i)), result + i);
+    });
+}
+
+/// Version of sla::dranrm_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void dranrm_batch(StridedSpan<const double> angles, StridedSpan<double> result) {
+    span_tiles(angles.get_size(), [](int n, auto... p) { dranrm_batch(n, p...); }, angles, result);
 }
 
 }
@@ -16,6 +16,8 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
 #include <cmath>
 
 namespace sla {
@@ -33,38 +35,48 @@ namespace sla {
  * @return A `TPPStatus` constant.
  */
 TPPStatus ds2tp(const Spherical<double>& point, const Spherical<double>& tangent, double& xi, double& eta) {
-    constexpr double TINY = 1e-6;
+    const double denom = kernel::s2tp(point.get_ra(), point.get_dec(),
+        tangent.get_ra(), std::sin(tangent.get_dec()), std::cos(tangent.get_dec()), xi, eta);
+    return kernel::s2tp_status(denom);
+}
 
-    // trig functions
+/**
+ * Projects many points onto the same tangent plane (double precision); this is a vectorized version of
+ * sla::ds2tp().
+ *
+ * @param n Number of points.
+ * @param ra Right ascensions of the points to be projected.
+ * @param dec Declinations of the points to be projected.
+ * @param tangent Spherical coordinates of tangent point.
+ * @param xi Output: `n` rectangular coordinates on tangent plane.
+ * @param eta Output: `n` rectangular coordinates on tangent plane.
+ * @param status Output: `n` `TPPStatus` constants.
+ */
+void ds2tp_batch(int n, const double* ra, const double* dec, const Spherical<double>& tangent, double* xi, double* eta,
+    TPPStatus* status) {
+    const double tra = tangent.get_ra();
     const double sin_tdec = std::sin(tangent.get_dec());
-    const double sin_dec = std::sin(point.get_dec());
     const double cos_tdec = std::cos(tangent.get_dec());
-    const double cos_dec = std::cos(point.get_dec());
-    const double ra_diff = point.get_ra() - tangent.get_ra();
-    const double sin_ra_diff = std::sin(ra_diff);
-    const double cos_ra_diff = std::cos(ra_diff);
-
-    // reciprocal of star vector length to tangent plane
-    double denom = sin_dec * sin_tdec + cos_dec * cos_tdec * cos_ra_diff;
-
-    // handle vectors too far from axis
-    TPPStatus status;
-    if (denom > TINY) {
-        status = TPP_OK;
-    } else if (denom >= 0.0) {
-        status = TPP_TOO_FAR;
-        denom = TINY;
-    } else if (denom > -TINY) {
-        status = TPP_ASTAR_ON_TP;
-        denom = -TINY;
-    } else {
-        status = TPP_ASTAR_TOO_FAR;
-    }
+    lane_loop<double>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V xi_i, eta_i;
+        const V denom = kernel::s2tp(lane_load<V>(ra + i), lane_load<V>(dec + i), tra, sin_tdec, cos_tdec, xi_i, eta_i);
+        lane_store(xi_i, xi + i);
+        lane_store(eta_i, eta + i);
+        double denoms[LaneTraits<V>::width];
+        lane_store(denom, denoms);
+        for (int j = 0; j < LaneTraits<V>::width; j++) {
+            status[i + j] = kernel::s2tp_status(denoms[j]);
+        }
+    });
+}
 
-    // compute tangent plane coordinates (even in dubious cases)
-    xi = cos_dec * sin_ra_diff / denom;
-    eta = (sin_dec * cos_tdec - cos_dec * sin_tdec * cos_ra_diff) / denom;
-    return status;
+/// Version of sla::ds2tp_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void ds2tp_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, const Spherical<double>& tangent,
+    StridedSpan<double> xi, StridedSpan<double> eta, StridedSpan<TPPStatus> status) {
+    span_tiles(ra.get_size(), [&](int n, auto ra, auto dec, auto xi, auto eta, auto status) {
+        ds2tp_batch(n, ra, dec, tangent, xi, eta, status);
+    }, ra, dec, xi, eta, status);
 }
 
 }
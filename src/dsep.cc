@@ -16,6 +16,8 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
@@ -29,13 +31,36 @@ namespace sla {
  * @return The angle, in radians, between the two points; it is always positive.
  */
 double dsep(const Spherical<double>& sa, const Spherical<double>& sb) {
-    // convert coordinates from spherical to Cartesian
-    Vector<double> va, vb;
-    dcs2c(sa, va);
+    return kernel::sep(sa.get_ra(), sa.get_dec(), sb.get_ra(), sb.get_dec());
+}
+
+/**
+ * Calculates angles between many points and one other point on a sphere (double precision); this is a vectorized
+ * version of sla::dsep().
+ *
+ * @param n Number of points.
+ * @param ra Longitudes (RAs, etc.) of the points (radians).
+ * @param dec Latitudes (Decs, etc.) of the points (radians).
+ * @param sb Spherical coordinates of the other point (radians).
+ * @param sep Output: `n` angles, in radians, between the points and `sb`; they are always positive.
+ */
+void dsep_batch(int n, const double* ra, const double* dec, const Spherical<double>& sb, double* sep) {
+    Vector<double> vb;
     dcs2c(sb, vb);
+    lane_loop<double>(n, [=, &vb](auto tag, int i) {
+        using V = decltype(tag);
+        V x, y, z;
+        kernel::cs2c(lane_load<V>(ra + i), lane_load<V>(dec + i), x, y, z);
+        lane_store(kernel::sepv(x, y, z, V(vb[0]), V(vb[1]), V(vb[2])), sep + i);
+    });
+}
 
-    // calculate and return angle between the vectors
-    return dsepv(va, vb);
+/// Version of sla::dsep_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void dsep_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, const Spherical<double>& sb,
+    StridedSpan<double> sep) {
+    span_tiles(ra.get_size(), [&](int n, auto ra, auto dec, auto sep) {
+        dsep_batch(n, ra, dec, sb, sep);
+    }, ra, dec, sep);
 }
 
 }
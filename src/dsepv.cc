@@ -16,7 +16,6 @@
  *
  */
 #include "slalib.h"
-#include <cmath>
 
 namespace sla {
 
@@ -33,16 +32,7 @@ namespace sla {
  * @return The angle, in radians, between the two vectors; it is always positive.
  */
 double dsepv(const Vector<double> va, const Vector<double> vb) {
-    // modulus of cross product = sine multiplied by the two moduli
-    Vector<double> v1_x_v2, wv;
-    dvxv(va, vb, v1_x_v2);
-    const double s = dvn(v1_x_v2, wv);
-
-    // dot product = cosine multiplied by the two moduli.
-    const double c = dvdv(va, vb);
-
-    // angle between the vectors
-    return s != 0.0 || c != 0.0? std::atan2(s,c): 0.0;
+    return kernel::sepv(va[0], va[1], va[2], vb[0], vb[1], vb[2]);
 }
 
 }
@@ -16,10 +16,22 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "lanes.h"
+#include "dispatch.h"
 #include <cmath>
 
 namespace sla {
 
+static constexpr float TWO_PI = 6.28318530718f;
+
+// mean orbital speed of Earth, AU/s
+static constexpr float orbital_speed = 1.9913e-7;
+
+// mean Earth:EMB (Earth-Moon barycenter) distance and speed, AU and AU/s
+static constexpr float emb_dist = 3.12e-5;
+static constexpr float emb_speed = 8.31e-11;
+
 /**
  * Calculates approximate heliocentric position and velocity of the Earth (single precision).
  *
@@ -42,15 +54,6 @@ namespace sla {
  *   part is in AU; velocity part is in AU/sec.
  */
 void earth(int year, int day, float fraction, VectorPV<float>& pv) {
-    constexpr float TWO_PI = 6.28318530718f;
-
-    // mean orbital speed of Earth, AU/s
-    constexpr float orbital_speed = 1.9913e-7;
-
-    // mean Earth:EMB (Earth-Moon barycenter) distance and speed, AU and AU/s
-    constexpr float emb_dist = 3.12e-5;
-    constexpr float emb_speed = 8.31e-11;
-
     // whole years & fraction of year, and years since J1900.0
     auto year_since_1900 = (const float) (year - 1900);
     const int y4 = ((year % 4) + 4) % 4;
@@ -103,4 +106,87 @@ void earth(int year, int day, float fraction, VectorPV<float>& pv) {
     pv.set_dz(w2 * sin_eps0);
 }
 
+/// Body of sla::earth_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void earth_batch_kernel(int n, const int* years, const int* days, const float* fractions,
+    VectorPV<float>* pv) {
+    for (int j = 0; j < n; j++) {
+        // whole years & fraction of year, and years since J1900.0
+        const int year = years[j];
+        const auto year_since_1900 = (float) (year - 1900);
+        const int y4 = ((year % 4) + 4) % 4;
+        const float yf = ((float) (4 * (days[j] - 1 / (y4 + 1)) - y4 - 2) + 4.0f * fractions[j]) / 1461.0f;
+        const float t = year_since_1900 + yf;
+
+        // geometric mean longitude of Sun, mean longitude of perihelion, and mean anomaly
+        const float elm = lane_fmod(4.881628f + TWO_PI * yf + 0.00013420f * t, TWO_PI);
+        const float gamma = 4.908230f + 3.0005e-4f * t;
+        const float em = elm - gamma;
+
+        // mean obliquity, and eccentricity
+        const float eps0 = 0.40931975f - 2.27e-6f * t;
+        const float e = 0.016751f - 4.2e-7f * t;
+        const float e_squared = e * e;
+
+        // true anomaly
+        float sin_em, cos_em;
+        lane_sincos(em, sin_em, cos_em);
+        const float sin_2em = 2.0f * sin_em * cos_em;
+        const float v = em + 2.0f * e * sin_em + 1.25f * e_squared * sin_2em;
+
+        // true ecliptic longitude, and true distance
+        float sin_v, cos_v;
+        lane_sincos(v, sin_v, cos_v);
+        const float elt = v + gamma;
+        const float r = (1.0f - e_squared) / (1.0f + e * cos_v);
+
+        // Moon's mean longitude
+        const float elmm = lane_fmod(4.72f + 83.9971f * t, TWO_PI);
+
+        // useful functions
+        float sin_elt, cos_elt, sin_eps0, cos_eps0, sin_gamma, cos_gamma, sin_elmm, cos_elmm;
+        lane_sincos(elt, sin_elt, cos_elt);
+        lane_sincos(eps0, sin_eps0, cos_eps0);
+        lane_sincos(gamma, sin_gamma, cos_gamma);
+        lane_sincos(elmm, sin_elmm, cos_elmm);
+        const float w1 = -r * sin_elt;
+        const float w2 = -orbital_speed * (cos_elt + e * cos_gamma);
+
+        // Earth position and velocity
+        VectorPV<float>& result = pv[j];
+        result.set_x(-r * cos_elt - emb_dist * cos_elmm);
+        result.set_y((w1 - emb_dist * sin_elmm) * cos_eps0);
+        result.set_z(w1 * sin_eps0);
+        result.set_dx(orbital_speed * (sin_elt + e * sin_gamma) + emb_speed * sin_elmm);
+        result.set_dy((w2 - emb_speed * cos_elmm) * cos_eps0);
+        result.set_dz(w2 * sin_eps0);
+    }
+}
+
+static KernelDispatcher<earth_batch_kernel> earth_batch_dispatcher("earth_batch");
+static const bool earth_batch_enlisted = earth_batch_dispatcher.enlist();
+
+/**
+ * Calculates approximate heliocentric positions and velocities of the Earth for many dates (single precision).
+ *
+ * Implements the same model as the sla::earth() function; the loop over dates is free of branches and library calls
+ * (sine and cosine are computed by an inlined polynomial), so compilers can vectorize it. Results agree with those
+ * of sla::earth() to within a few float ulps.
+ *
+ * @param n Number of dates.
+ * @param years Years (see sla::earth()).
+ * @param days Days in years (1 = January 1-st).
+ * @param fractions Fractions of days.
+ * @param pv Return value: array of `n` elements receiving Earth position and velocity vectors; represent mean
+ *   equator and equinox of date; position parts are in AU; velocity parts are in AU/sec.
+ */
+void earth_batch(int n, const int* years, const int* days, const float* fractions, VectorPV<float>* pv) {
+    earth_batch_dispatcher(n, years, days, fractions, pv);
+}
+
+/// Version of sla::earth_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void earth_batch(StridedSpan<const int> years, StridedSpan<const int> days, StridedSpan<const float> fractions,
+    StridedSpan<VectorPV<float>> pv) {
+    span_tiles(years.get_size(), [](int n, auto... p) { earth_batch(n, p...); }, years, days, fractions, pv);
+}
+
 }
@@ -0,0 +1,295 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include "spans.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sla {
+
+// maximum barycentric errors of sla::evp() with respect to JPL DE96: position (km) and velocity (mm/s)
+static constexpr double EVP_POS_ERR = 6900.0;
+static constexpr double EVP_VEL_ERR = 420.0;
+
+// maximum errors of sla::epv() with respect to JPL DE405 over 1900-2100: position (km) and velocity (mm/s)
+static constexpr double EPV_POS_ERR = 13.4;
+static constexpr double EPV_VEL_ERR = 5.0;
+
+// astronomical unit (km), and AU/day to mm/s conversion factor
+static constexpr double AU_KM = 149597870.7;
+static constexpr double AUD_2_MMS = AU_KM * 1.0e6 / 86400.0;
+
+/**
+ * Stores position and velocity vectors into a position-velocity vector.
+ *
+ * @param pos Position.
+ * @param vel Velocity.
+ * @param scale Scale factor for the velocity.
+ * @param pv Return value: position and velocity.
+ */
+static void set_pv(const Vector<double> pos, const Vector<double> vel, double scale, VectorPV<double>& pv) {
+    pv.set_x(pos[0]);
+    pv.set_y(pos[1]);
+    pv.set_z(pos[2]);
+    pv.set_dx(vel[0] * scale);
+    pv.set_dy(vel[1] * scale);
+    pv.set_dz(vel[2] * scale);
+}
+
+/**
+ * Creates Earth ephemeris of required accuracy, without a table.
+ *
+ * The sla::evp() function is used when it meets both accuracies: its maximum errors are 6900 km in position and 0.42
+ * m/s in velocity (sla::evp() vectors are referred to the mean equator and equinox of J2000, which differs from BCRS
+ * by a small fraction of these errors). Otherwise, interpolation in the table is used for dates it covers, provided
+ * that its verified interpolation errors added to the errors of sla::epv() itself (13.4 km and 5 mm/s over 1900-2100)
+ * still meet the accuracies; sla::epv() is used in all remaining cases, including those where even sla::epv() does
+ * not meet the accuracies.
+ *
+ * @param pos_accuracy Required position accuracy (km).
+ * @param vel_accuracy Required velocity accuracy (mm/s).
+ */
+EarthEphemeris::EarthEphemeris(double pos_accuracy, double vel_accuracy):
+    ee_pos_accuracy(pos_accuracy), ee_vel_accuracy(vel_accuracy), ee_start(0.0), ee_step(0.0), ee_nodes(0),
+    ee_pos_err(0.0), ee_vel_err(0.0) {
+}
+
+/**
+ * Builds table of sla::epv() results, replacing existing one (if any).
+ *
+ * Table is interpolated with cubic Hermite polynomials, using positions and velocities at both ends of an interval.
+ * The interpolation is verified against sla::epv() at quarter points of every interval; three times the largest
+ * deviations found become error bounds of the table. With default step of half a day, the bounds are about 0.03 km
+ * and 2 mm/s (actual errors are about five times smaller); building the table takes four sla::epv() evaluations per
+ * node, so it pays off when the table is to be used for more dates than that.
+ *
+ * @param start First date to be covered by the table, TDB Modified Julian Date.
+ * @param end Last date to be covered by the table, TDB Modified Julian Date.
+ * @param step Interval between table nodes (days).
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ * @return `true` if the table was built, `false` if arguments were invalid (existing table is then discarded).
+ */
+bool EarthEphemeris::tabulate(double start, double end, double step, int nthreads) {
+    ee_nodes = 0;
+    ee_table.clear();
+    if (!(end > start && step > 0.0 && (end - start) / step < 1.0e8)) {
+        return false;
+    }
+    const int nodes = (int) std::ceil((end - start) / step) + 1;
+    ee_start = start;
+    ee_step = step;
+    ee_table.resize((std::size_t) nodes * 12);
+
+    // sla::epv() at table nodes
+    double* table = ee_table.data();
+    parallel_for(nodes, nthreads, [=](int first, int last) {
+        for (int i = first; i < last; i++) {
+            double* node = table + (std::size_t) i * 12;
+            epv(start + i * step, node, node + 3, node + 6, node + 9);
+        }
+    });
+    ee_nodes = nodes;
+
+    // verification at quarter points of every interval
+    std::vector<double> pos_err(nodes - 1, 0.0), vel_err(nodes - 1, 0.0);
+    parallel_for(nodes - 1, nthreads, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            for (int q = 1; q <= 3; q++) {
+                const double date = start + (i + q / 4.0) * step;
+                Vector<double> hpos, hvelo, bpos, bvelo;
+                epv(date, hpos, hvelo, bpos, bvelo);
+                VectorPV<double> hpv, bpv;
+                interpolate(date, hpv, bpv);
+                for (int k = 0; k < 3; k++) {
+                    pos_err[i] = std::max(pos_err[i], std::abs(hpv.get_position()[k] - hpos[k]));
+                    pos_err[i] = std::max(pos_err[i], std::abs(bpv.get_position()[k] - bpos[k]));
+                    vel_err[i] = std::max(vel_err[i], std::abs(hpv.get_velocity()[k] - hvelo[k]));
+                    vel_err[i] = std::max(vel_err[i], std::abs(bpv.get_velocity()[k] - bvelo[k]));
+                }
+            }
+        }
+    });
+    ee_pos_err = 3.0 * std::sqrt(3.0) * AU_KM * *std::max_element(pos_err.begin(), pos_err.end());
+    ee_vel_err = 3.0 * std::sqrt(3.0) * AUD_2_MMS * *std::max_element(vel_err.begin(), vel_err.end());
+    return true;
+}
+
+/**
+ * Interpolates table of sla::epv() results; the date must be covered by the table.
+ *
+ * @param date TDB Modified Julian Date.
+ * @param hpv Return value: heliocentric Earth position and velocity (AU, AU/day).
+ * @param bpv Return value: barycentric Earth position and velocity (AU, AU/day).
+ */
+void EarthEphemeris::interpolate(double date, VectorPV<double>& hpv, VectorPV<double>& bpv) const {
+    // interval, and normalized time within it
+    const double x = (date - ee_start) / ee_step;
+    const int i = std::min(std::max((int) x, 0), ee_nodes - 2);
+    const double s = x - i;
+    const double* n0 = ee_table.data() + (std::size_t) i * 12;
+    const double* n1 = n0 + 12;
+
+    // Hermite basis functions and their derivatives
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = (s3 - 2.0 * s2 + s) * ee_step;
+    const double h01 = 3.0 * s2 - 2.0 * s3;
+    const double h11 = (s3 - s2) * ee_step;
+    const double d00 = (6.0 * s2 - 6.0 * s) / ee_step;
+    const double d10 = 3.0 * s2 - 4.0 * s + 1.0;
+    const double d11 = 3.0 * s2 - 2.0 * s;
+
+    // position and velocity components: 0..2 heliocentric, 3..5 barycentric
+    double pos[6], vel[6];
+    for (int c = 0; c < 6; c++) {
+        const int k = (c / 3) * 6 + c % 3;
+        pos[c] = h00 * n0[k] + h10 * n0[k + 3] + h01 * n1[k] + h11 * n1[k + 3];
+        vel[c] = d00 * (n0[k] - n1[k]) + d10 * n0[k + 3] + d11 * n1[k + 3];
+    }
+    set_pv(pos, vel, 1.0, hpv);
+    set_pv(pos + 3, vel + 3, 1.0, bpv);
+}
+
+/**
+ * Returns backend to be used for the given date.
+ *
+ * @param date TDB Modified Julian Date.
+ * @return Cheapest backend meeting required accuracy; sla::EE_EPV if none does.
+ */
+EEBackend EarthEphemeris::get_backend(double date) const {
+    if (ee_pos_accuracy >= EVP_POS_ERR && ee_vel_accuracy >= EVP_VEL_ERR) {
+        return EE_EVP;
+    }
+    if (ee_nodes > 0 && date >= ee_start && date <= ee_start + (ee_nodes - 1) * ee_step &&
+        ee_pos_accuracy >= EPV_POS_ERR + ee_pos_err && ee_vel_accuracy >= EPV_VEL_ERR + ee_vel_err) {
+        return EE_TABLE;
+    }
+    return EE_EPV;
+}
+
+/**
+ * Returns maximum position error of a backend.
+ *
+ * @param backend Backend.
+ * @return Maximum position error (km); for sla::EE_TABLE, it is only valid after the table has been built.
+ */
+double EarthEphemeris::get_position_error(EEBackend backend) const {
+    switch (backend) {
+        case EE_EVP:
+            return EVP_POS_ERR;
+        case EE_TABLE:
+            return EPV_POS_ERR + ee_pos_err;
+        default:
+            return EPV_POS_ERR;
+    }
+}
+
+/**
+ * Returns maximum velocity error of a backend.
+ *
+ * @param backend Backend.
+ * @return Maximum velocity error (mm/s); for sla::EE_TABLE, it is only valid after the table has been built.
+ */
+double EarthEphemeris::get_velocity_error(EEBackend backend) const {
+    switch (backend) {
+        case EE_EVP:
+            return EVP_VEL_ERR;
+        case EE_TABLE:
+            return EPV_VEL_ERR + ee_vel_err;
+        default:
+            return EPV_VEL_ERR;
+    }
+}
+
+/**
+ * Calculates Earth position and velocity, heliocentric and barycentric, using the cheapest backend that meets
+ * required accuracy.
+ *
+ * @param date TDB Modified Julian Date.
+ * @param hpv Return value: heliocentric Earth position and velocity, BCRS (AU, AU/day).
+ * @param bpv Return value: barycentric Earth position and velocity, BCRS (AU, AU/day).
+ * @return Backend that has been used.
+ */
+EEBackend EarthEphemeris::get(double date, VectorPV<double>& hpv, VectorPV<double>& bpv) const {
+    const EEBackend backend = get_backend(date);
+    Vector<double> hpos, hvelo, bpos, bvelo;
+    switch (backend) {
+        case EE_EVP:
+            evp(date, 2000.0, bvelo, bpos, hvelo, hpos);
+            set_pv(hpos, hvelo, 86400.0, hpv);
+            set_pv(bpos, bvelo, 86400.0, bpv);
+            break;
+        case EE_TABLE:
+            interpolate(date, hpv, bpv);
+            break;
+        default:
+            epv(date, hpos, hvelo, bpos, bvelo);
+            set_pv(hpos, hvelo, 1.0, hpv);
+            set_pv(bpos, bvelo, 1.0, bpv);
+    }
+    return backend;
+}
+
+/**
+ * Calculates Earth positions and velocities, heliocentric and barycentric, for many dates, using the cheapest
+ * backend that meets required accuracy for each date; dates served by sla::evp() are processed by sla::evp_batch().
+ *
+ * @param n Number of dates.
+ * @param dates TDB Modified Julian Dates.
+ * @param hpv Return value: array of `n` heliocentric Earth positions and velocities, BCRS (AU, AU/day).
+ * @param bpv Return value: array of `n` barycentric Earth positions and velocities, BCRS (AU, AU/day).
+ * @param backends Return value: array of `n` backends that have been used; can be `nullptr`.
+ */
+void EarthEphemeris::get(int n, const double* dates, VectorPV<double>* hpv, VectorPV<double>* bpv,
+    EEBackend* backends) const {
+    std::vector<int> evp_index;
+    std::vector<double> evp_dates;
+    for (int i = 0; i < n; i++) {
+        const EEBackend backend = get_backend(dates[i]);
+        if (backend == EE_EVP) {
+            evp_index.push_back(i);
+            evp_dates.push_back(dates[i]);
+        } else {
+            get(dates[i], hpv[i], bpv[i]);
+        }
+        if (backends != nullptr) {
+            backends[i] = backend;
+        }
+    }
+    const int count = (int) evp_dates.size();
+    if (count > 0) {
+        std::vector<Vector<double>> bvelo(count), bpos(count), hvelo(count), hpos(count);
+        evp_batch(count, evp_dates.data(), 2000.0, bvelo.data(), bpos.data(), hvelo.data(), hpos.data());
+        for (int j = 0; j < count; j++) {
+            set_pv(hpos[j], hvelo[j], 86400.0, hpv[evp_index[j]]);
+            set_pv(bpos[j], bvelo[j], 86400.0, bpv[evp_index[j]]);
+        }
+    }
+}
+
+/// Version of sla::EarthEphemeris::get() that accesses items through strided spans of the same size.
+void EarthEphemeris::get(StridedSpan<const double> dates, StridedSpan<VectorPV<double>> hpv,
+    StridedSpan<VectorPV<double>> bpv, StridedSpan<EEBackend> backends) const {
+    span_tiles(dates.get_size(), [this](int n, auto dates, auto hpv, auto bpv, auto backends) {
+        get(n, dates, hpv, bpv, backends);
+    }, dates, hpv, bpv, backends);
+}
+
+}
@@ -0,0 +1,184 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Transforms conventional osculating orbital elements into "universal" form.
+ *
+ * The elements are with respect to the J2000 ecliptic and equinox. Their meaning depends on the form (`oe_form`
+ * member of the `elements` argument):
+ *
+ *   OEF_MAJOR_PLANET: epoch of elements `oe_epoch` (TT MJD), inclination `oe_orbinc`, longitude of the ascending node
+ *     `oe_anode`, longitude of perihelion `oe_perih`, mean distance `oe_aorq` (AU), eccentricity `oe_e`, mean
+ *     longitude `oe_aorl`, and daily motion `oe_dm` (angles in radians);
+ *   OEF_MINOR_PLANET: epoch of elements `oe_epoch` (TT MJD), inclination `oe_orbinc`, longitude of the ascending node
+ *     `oe_anode`, argument of perihelion `oe_perih`, mean distance `oe_aorq` (AU), eccentricity `oe_e`, and mean
+ *     anomaly `oe_aorl` (angles in radians);
+ *   OEF_COMET: epoch of perihelion `oe_epoch` (TT MJD), inclination `oe_orbinc`, longitude of the ascending node
+ *     `oe_anode`, argument of perihelion `oe_perih`, perihelion distance `oe_aorq` (AU), and eccentricity `oe_e`
+ *     (angles in radians).
+ *
+ * The daily motion of OEF_MAJOR_PLANET elements is used to compute the combined mass of the body and the Sun, and so
+ * allows for the mass of a major planet.
+ *
+ * The universal elements returned by this function are for the specified date `date`, which is also the epoch of the
+ * position and velocity from which they are derived; the accuracy is limited by that of the original elements.
+ *
+ * Reference: H.M.Smart, "Textbook on Spherical Astronomy", sixth edition, Cambridge University Press, 1977.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date Epoch (TT MJD) of osculation.
+ * @param elements Conventional orbital elements.
+ * @param u Return value: universal orbital elements.
+ * @return Status: OES_OK, OES_BAD_FORM, OES_BAD_ECCENTRICITY (negative, greater than 10, or not less than 1 if the
+ *   form is not OEF_COMET), OES_BAD_DISTANCE (not positive), OES_BAD_MOTION (not positive for OEF_MAJOR_PLANET), or
+ *   an error returned by sla::pv2ue() or sla::ue2pv() (numerical error).
+ */
+OEStatus el2ue(double date, const OrbitalElements& elements, UniversalElements& u) {
+    // Gaussian gravitational constant (exact)
+    constexpr double GCON = 0.01720209895;
+
+    // canonical days to seconds
+    constexpr double CD2S = GCON / 86400.0;
+
+    // sin and cos of J2000 mean obliquity (IAU 1976)
+    constexpr double SE = 0.3977771559319137;
+    constexpr double CE = 0.9174820620691818;
+
+    // validate arguments
+    const OEForm jform = elements.oe_form;
+    const double e = elements.oe_e;
+    const double aorq = elements.oe_aorq;
+    if (jform < OEF_MAJOR_PLANET || jform > OEF_COMET) {
+        return OES_BAD_FORM;
+    }
+    if (e < 0.0 || e > 10.0 || (e >= 1.0 && jform != OEF_COMET)) {
+        return OES_BAD_ECCENTRICITY;
+    }
+    if (aorq <= 0.0) {
+        return OES_BAD_DISTANCE;
+    }
+    if (jform == OEF_MAJOR_PLANET && elements.oe_dm <= 0.0) {
+        return OES_BAD_MOTION;
+    }
+
+    /*
+     * Transform elements into standard form:
+     *   pht = epoch of perihelion passage
+     *   argp = argument of perihelion (radians)
+     *   q = perihelion distance (AU)
+     *   cm = combined mass, M+m (mu)
+     */
+    double pht, argp, q, cm;
+    switch (jform) {
+        case OEF_MAJOR_PLANET: {
+            pht = elements.oe_epoch - (elements.oe_aorl - elements.oe_perih) / elements.oe_dm;
+            argp = elements.oe_perih - elements.oe_anode;
+            q = aorq * (1.0 - e);
+            const double w = elements.oe_dm / GCON;
+            cm = w * w * aorq * aorq * aorq;
+            break;
+        }
+        case OEF_MINOR_PLANET:
+            pht = elements.oe_epoch - elements.oe_aorl * std::sqrt(aorq * aorq * aorq) / GCON;
+            argp = elements.oe_perih;
+            q = aorq * (1.0 - e);
+            cm = 1.0;
+            break;
+        default: // OEF_COMET
+            pht = elements.oe_epoch;
+            argp = elements.oe_perih;
+            q = aorq;
+            cm = 1.0;
+    }
+
+    // the universal variable alpha; this is proportional to the total energy of the orbit: -ve for an ellipse, zero
+    // for a parabola, +ve for a hyperbola
+    const double alpha = cm * (e - 1.0) / q;
+
+    // speed at perihelion
+    const double phs = std::sqrt(alpha + 2.0 * cm / q);
+
+    /*
+     * In a Cartesian coordinate system which has the x-axis pointing to perihelion and the z-axis normal to the orbit
+     * (such that the object orbits counter-clockwise as seen from +ve z), the perihelion position and velocity vectors
+     * are:
+     *
+     *   position   [q,0,0]
+     *   velocity   [0,phs,0]
+     *
+     * To express the results in J2000 equatorial coordinates we make a series of four rotations of the Cartesian axes:
+     *
+     *           axis      Euler angle
+     *
+     *     1      z        argument of perihelion
+     *     2      x        inclination
+     *     3      z        longitude of the ascending node
+     *     4      x        J2000 obliquity
+     *
+     * The Euler angles are negative because the rotations are of the coordinate system, not of the position and
+     * velocity.
+     */
+    const double sw = std::sin(argp);
+    const double cw = std::cos(argp);
+    const double si = std::sin(elements.oe_orbinc);
+    const double ci = std::cos(elements.oe_orbinc);
+    const double so = std::sin(elements.oe_anode);
+    const double co = std::cos(elements.oe_anode);
+
+    // position at perihelion (AU)
+    double x = q * cw;
+    double y = q * sw;
+    double z = y * si;
+    y = y * ci;
+    const double px = x * co - y * so;
+    y = x * so + y * co;
+    const double py = y * CE - z * SE;
+    const double pz = y * SE + z * CE;
+
+    // velocity at perihelion (AU per canonical day)
+    x = -phs * sw;
+    y = phs * cw;
+    z = y * si;
+    y = y * ci;
+    const double vx = x * co - y * so;
+    y = x * so + y * co;
+    const double vy = y * CE - z * SE;
+    const double vz = y * SE + z * CE;
+
+    // package the position and velocity (AU and AU/s), and create the universal elements for the perihelion epoch
+    const Vector<double> pos = {px, py, pz};
+    const Vector<double> vel = {vx * CD2S, vy * CD2S, vz * CD2S};
+    VectorPV<double> pv(pos, vel);
+    OEStatus status = pv2ue(pv, pht, cm - 1.0, u);
+
+    // update the epoch to the date, and create the universal elements for the date
+    if (status == OES_OK) {
+        status = ue2pv(date, u, pv);
+    }
+    if (status == OES_OK) {
+        status = pv2ue(pv, date, cm - 1.0, u);
+    }
+    return status;
+}
+
+}
@@ -16,10 +16,146 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "lanes.h"
+#include "dispatch.h"
+#include <algorithm>
 #include <cmath>
 
 namespace sla {
 
+static constexpr double DC2PI = 6.2831853071796;
+static constexpr float CC2PI = 6.283185f;
+static constexpr double DS2R = 0.7272205216643e-4;
+static constexpr double B1950 = 1949.9997904423;
+
+// constants DCFEL[k][i] of fast changing elements
+//   i==0           i==1                  i==2
+static const double DCFEL[8][3] = {
+    {1.7400353e+00, 6.2833195099091e+02,  5.2796e-06},
+    {6.2565836e+00, 6.2830194572674e+02, -2.6180e-06},
+    {4.7199666e+00, 8.3997091449254e+03, -1.9780e-05},
+    {1.9636505e-01, 8.4334662911720e+03, -5.6044e-05},
+    {4.1547339e+00, 5.2993466764997e+01,  5.8845e-06},
+    {4.6524223e+00, 2.1354275911213e+01,  5.6797e-06},
+    {4.2620486e+00, 7.5025342197656e+00,  5.5317e-06},
+    {1.4740694e+00, 3.8377331909193e+00,  5.6093e-06}
+};
+//
+// constants DCEPS[i] and CCSEL[k][i] of slowly changing elements
+//  i==0             i==1            i==2
+static const double DCEPS[3] = {
+    4.093198e-01,   -2.271110e-04,  -2.860401e-08
+};
+static const float CCSEL[17][3] = {
+    {1.675104e-02f, -4.179579e-05f, -1.260516e-07f},
+    {2.220221e-01f,  2.809917e-02f,  1.852532e-05f},
+    {1.589963e+00f,  3.418075e-02f,  1.430200e-05f},
+    {2.994089e+00f,  2.590824e-02f,  4.155840e-06f},
+    {8.155457e-01f,  2.486352e-02f,  6.836840e-06f},
+    {1.735614e+00f,  1.763719e-02f,  6.370440e-06f},
+    {1.968564e+00f,  1.524020e-02f, -2.517152e-06f},
+    {1.282417e+00f,  8.703393e-03f,  2.289292e-05f},
+    {2.280820e+00f,  1.918010e-02f,  4.484520e-06f},
+    {4.833473e-02f,  1.641773e-04f, -4.654200e-07f},
+    {5.589232e-02f, -3.455092e-04f, -7.388560e-07f},
+    {4.634443e-02f, -2.658234e-05f,  7.757000e-08f},
+    {8.997041e-03f,  6.329728e-06f, -1.939256e-09f},
+    {2.284178e-02f, -9.941590e-05f,  6.787400e-08f},
+    {4.350267e-02f, -6.839749e-05f, -2.714956e-07f},
+    {1.348204e-02f,  1.091504e-05f,  6.903760e-07f},
+    {3.106570e-02f, -1.665665e-04f, -1.590188e-07f}
+};
+//
+// constants of the arguments of the short-period perturbations
+// by the planets: DCARGS[k][i]
+//   i==0            i==1
+static const double DCARGS[15][2] = {
+    {5.0974222e+00, -7.8604195454652e+02},
+    {3.9584962e+00, -5.7533848094674e+02},
+    {1.6338070e+00, -1.1506769618935e+03},
+    {2.5487111e+00, -3.9302097727326e+02},
+    {4.9255514e+00, -5.8849265665348e+02},
+    {1.3363463e+00, -5.5076098609303e+02},
+    {1.6072053e+00, -5.2237501616674e+02},
+    {1.3629480e+00, -1.1790629318198e+03},
+    {5.5657014e+00, -1.0977134971135e+03},
+    {5.0708205e+00, -1.5774000881978e+02},
+    {3.9318944e+00,  5.2963464780000e+01},
+    {4.8989497e+00,  3.9809289073258e+01},
+    {1.3097446e+00,  7.7540959633708e+01},
+    {3.5147141e+00,  7.9618578146517e+01},
+    {3.5413158e+00, -5.4868336758022e+02}
+};
+//
+// amplitudes CCAMPS[k][n] of the short-period perturbations
+//    n==0           n==1           n==2           n==3           n==4
+static const float CCAMPS[15][5] = {
+    {-2.279594e-5f,  1.407414e-5f,  8.273188e-6f,  1.340565e-5f, -2.490817e-7f},
+    {-3.494537e-5f,  2.860401e-7f,  1.289448e-7f,  1.627237e-5f, -1.823138e-7f},
+    { 6.593466e-7f,  1.322572e-5f,  9.258695e-6f, -4.674248e-7f, -3.646275e-7f},
+    { 1.140767e-5f, -2.049792e-5f, -4.747930e-6f, -2.638763e-6f, -1.245408e-7f},
+    { 9.516893e-6f, -2.748894e-6f, -1.319381e-6f, -4.549908e-6f, -1.864821e-7f},
+    { 7.310990e-6f, -1.924710e-6f, -8.772849e-7f, -3.334143e-6f, -1.745256e-7f},
+    {-2.603449e-6f,  7.359472e-6f,  3.168357e-6f,  1.119056e-6f, -1.655307e-7f},
+    {-3.228859e-6f,  1.308997e-7f,  1.013137e-7f,  2.403899e-6f, -3.736225e-7f},
+    { 3.442177e-7f,  2.671323e-6f,  1.832858e-6f, -2.394688e-7f, -3.478444e-7f},
+    { 8.702406e-6f, -8.421214e-6f, -1.372341e-6f, -1.455234e-6f, -4.998479e-8f},
+    {-1.488378e-6f, -1.251789e-5f,  5.226868e-7f, -2.049301e-7f,  0.0f},
+    {-8.043059e-6f, -2.991300e-6f,  1.473654e-7f, -3.154542e-7f,  0.0f},
+    { 3.699128e-6f, -3.316126e-6f,  2.901257e-7f,  3.407826e-7f,  0.0f},
+    { 2.550120e-6f, -1.241123e-6f,  9.901116e-8f,  2.210482e-7f,  0.0f},
+    {-6.351059e-7f,  2.341650e-6f,  1.061492e-6f,  2.878231e-7f,  0.0f}
+};
+//
+// constants of the secular perturbations in longitude CCSEC3 and CCSEC[k][n]
+//   n==0           n==1           n==2
+static constexpr float CCSEC3 = -7.757020e-08f;
+static const float CCSEC[4][3] = {
+    {1.289600e-06f, 5.550147e-01f, 2.076942e+00f},
+    {3.102810e-05f, 4.035027e+00f, 3.525565e-01f},
+    {9.124190e-06f, 9.990265e-01f, 2.622706e+00f},
+    {9.793240e-07f, 5.508259e+00f, 1.559103e+01f}
+};
+
+// Sidereal rate DCSLD in longitude, rate CCSGD in mean anomaly
+static constexpr double DCSLD = 1.990987e-07;
+static constexpr float CCSGD = 1.990969e-07f;
+
+// Some constants used in the calculation of the lunar contribution
+static constexpr float CCKM = 3.122140e-05f;
+static constexpr float CCMLD = 2.661699e-06f;
+static constexpr float CCFDI = 2.399485e-07f;
+
+// constants DCARGM[k][i] of the arguments of the perturbations of the motion of the Moon
+//   i==0            i==1
+static const double DCARGM[3][2] = {
+    {5.1679830e+00,  8.3286911095275e+03},
+    {5.4913150e+00, -7.2140632838100e+03},
+    {5.9598530e+00,  1.5542754389685e+04}
+};
+
+//
+// Amplitudes CCAMPM[k][n] of the perturbations of the Moon
+//    n==0          n==1          n==2           n==3
+static const float CCAMPM[3][4] = {
+    { 1.097594e-01, 2.896773e-07, 5.450474e-02,  1.438491e-07},
+    {-2.223581e-02, 5.083103e-08, 1.002548e-02, -2.291823e-08},
+    { 1.148966e-02, 5.658888e-08, 8.249439e-03,  4.063015e-08}
+};
+
+// CCPAMV[k]=a*M*DL/dt (planets), DC1MME=1-MASS(Earth+Moon)
+static const float CCPAMV[4] = {
+    8.326827e-11,1.843484e-11,1.988712e-12,1.881276e-12
+};
+static constexpr double DC1MME = 0.99999696;
+
+// CCPAM[k]=a*M(planets), CCIM=INCLINATION(Moon)
+static const float CCPAM[4] = {
+    4.960906e-3, 2.727436e-3, 8.392311e-4, 1.556861e-3
+};
+static constexpr float CCIM = 8.978749e-2f;
+
 /**
  * Calculates barycentric and heliocentric velocity and position of the Earth (double precision).
  *
@@ -58,138 +194,6 @@ void evp(double date, double deqx,
     const float& e = sorbel[0];
     const float& g = forbel[0];
 
-    constexpr double DC2PI = 6.2831853071796;
-    constexpr float CC2PI = 6.283185f;
-    constexpr double DS2R = 0.7272205216643e-4;
-    constexpr double B1950 = 1949.9997904423;
-
-    // constants DCFEL[k][i] of fast changing elements
-    //   i==0           i==1                  i==2
-    static const double DCFEL[8][3] = {
-        {1.7400353e+00, 6.2833195099091e+02,  5.2796e-06},
-        {6.2565836e+00, 6.2830194572674e+02, -2.6180e-06},
-        {4.7199666e+00, 8.3997091449254e+03, -1.9780e-05},
-        {1.9636505e-01, 8.4334662911720e+03, -5.6044e-05},
-        {4.1547339e+00, 5.2993466764997e+01,  5.8845e-06},
-        {4.6524223e+00, 2.1354275911213e+01,  5.6797e-06},
-        {4.2620486e+00, 7.5025342197656e+00,  5.5317e-06},
-        {1.4740694e+00, 3.8377331909193e+00,  5.6093e-06}
-    };
-    //
-    // constants DCEPS[i] and CCSEL[k][i] of slowly changing elements
-    //  i==0             i==1            i==2
-    static const double DCEPS[3] = {
-        4.093198e-01,   -2.271110e-04,  -2.860401e-08
-    };
-    static const float CCSEL[17][3] = {
-        {1.675104e-02f, -4.179579e-05f, -1.260516e-07f},
-        {2.220221e-01f,  2.809917e-02f,  1.852532e-05f},
-        {1.589963e+00f,  3.418075e-02f,  1.430200e-05f},
-        {2.994089e+00f,  2.590824e-02f,  4.155840e-06f},
-        {8.155457e-01f,  2.486352e-02f,  6.836840e-06f},
-        {1.735614e+00f,  1.763719e-02f,  6.370440e-06f},
-        {1.968564e+00f,  1.524020e-02f, -2.517152e-06f},
-        {1.282417e+00f,  8.703393e-03f,  2.289292e-05f},
-        {2.280820e+00f,  1.918010e-02f,  4.484520e-06f},
-        {4.833473e-02f,  1.641773e-04f, -4.654200e-07f},
-        {5.589232e-02f, -3.455092e-04f, -7.388560e-07f},
-        {4.634443e-02f, -2.658234e-05f,  7.757000e-08f},
-        {8.997041e-03f,  6.329728e-06f, -1.939256e-09f},
-        {2.284178e-02f, -9.941590e-05f,  6.787400e-08f},
-        {4.350267e-02f, -6.839749e-05f, -2.714956e-07f},
-        {1.348204e-02f,  1.091504e-05f,  6.903760e-07f},
-        {3.106570e-02f, -1.665665e-04f, -1.590188e-07f}
-    };
-    //
-    // constants of the arguments of the short-period perturbations
-    // by the planets: DCARGS[k][i]
-    //   i==0            i==1
-    static const double DCARGS[15][2] = {
-        {5.0974222e+00, -7.8604195454652e+02},
-        {3.9584962e+00, -5.7533848094674e+02},
-        {1.6338070e+00, -1.1506769618935e+03},
-        {2.5487111e+00, -3.9302097727326e+02},
-        {4.9255514e+00, -5.8849265665348e+02},
-        {1.3363463e+00, -5.5076098609303e+02},
-        {1.6072053e+00, -5.2237501616674e+02},
-        {1.3629480e+00, -1.1790629318198e+03},
-        {5.5657014e+00, -1.0977134971135e+03},
-        {5.0708205e+00, -1.5774000881978e+02},
-        {3.9318944e+00,  5.2963464780000e+01},
-        {4.8989497e+00,  3.9809289073258e+01},
-        {1.3097446e+00,  7.7540959633708e+01},
-        {3.5147141e+00,  7.9618578146517e+01},
-        {3.5413158e+00, -5.4868336758022e+02}
-    };
-    //
-    // amplitudes CCAMPS[k][n] of the short-period perturbations
-    //    n==0           n==1           n==2           n==3           n==4
-    static const float CCAMPS[15][5] = {
-        {-2.279594e-5f,  1.407414e-5f,  8.273188e-6f,  1.340565e-5f, -2.490817e-7f},
-        {-3.494537e-5f,  2.860401e-7f,  1.289448e-7f,  1.627237e-5f, -1.823138e-7f},
-        { 6.593466e-7f,  1.322572e-5f,  9.258695e-6f, -4.674248e-7f, -3.646275e-7f},
-        { 1.140767e-5f, -2.049792e-5f, -4.747930e-6f, -2.638763e-6f, -1.245408e-7f},
-        { 9.516893e-6f, -2.748894e-6f, -1.319381e-6f, -4.549908e-6f, -1.864821e-7f},
-        { 7.310990e-6f, -1.924710e-6f, -8.772849e-7f, -3.334143e-6f, -1.745256e-7f},
-        {-2.603449e-6f,  7.359472e-6f,  3.168357e-6f,  1.119056e-6f, -1.655307e-7f},
-        {-3.228859e-6f,  1.308997e-7f,  1.013137e-7f,  2.403899e-6f, -3.736225e-7f},
-        { 3.442177e-7f,  2.671323e-6f,  1.832858e-6f, -2.394688e-7f, -3.478444e-7f},
-        { 8.702406e-6f, -8.421214e-6f, -1.372341e-6f, -1.455234e-6f, -4.998479e-8f},
-        {-1.488378e-6f, -1.251789e-5f,  5.226868e-7f, -2.049301e-7f,  0.0f},
-        {-8.043059e-6f, -2.991300e-6f,  1.473654e-7f, -3.154542e-7f,  0.0f},
-        { 3.699128e-6f, -3.316126e-6f,  2.901257e-7f,  3.407826e-7f,  0.0f},
-        { 2.550120e-6f, -1.241123e-6f,  9.901116e-8f,  2.210482e-7f,  0.0f},
-        {-6.351059e-7f,  2.341650e-6f,  1.061492e-6f,  2.878231e-7f,  0.0f}
-    };
-    //
-    // constants of the secular perturbations in longitude CCSEC3 and CCSEC[k][n]
-    //   n==0           n==1           n==2
-    constexpr float CCSEC3 = -7.757020e-08f;
-    static const float CCSEC[4][3] = {
-        {1.289600e-06f, 5.550147e-01f, 2.076942e+00f},
-        {3.102810e-05f, 4.035027e+00f, 3.525565e-01f},
-        {9.124190e-06f, 9.990265e-01f, 2.622706e+00f},
-        {9.793240e-07f, 5.508259e+00f, 1.559103e+01f}
-    };
-
-    // Sidereal rate DCSLD in longitude, rate CCSGD in mean anomaly
-    constexpr double DCSLD = 1.990987e-07;
-    constexpr float CCSGD = 1.990969e-07f;
-
-    // Some constants used in the calculation of the lunar contribution
-    constexpr float CCKM = 3.122140e-05f;
-    constexpr float CCMLD = 2.661699e-06f;
-    constexpr float CCFDI = 2.399485e-07f;
-
-    // constants DCARGM[k][i] of the arguments of the perturbations of the motion of the Moon
-    //   i==0            i==1
-    static const double DCARGM[3][2] = {
-        {5.1679830e+00,  8.3286911095275e+03},
-        {5.4913150e+00, -7.2140632838100e+03},
-        {5.9598530e+00,  1.5542754389685e+04}
-    };
-
-    //
-    // Amplitudes CCAMPM[k][n] of the perturbations of the Moon
-    //    n==0          n==1          n==2           n==3
-    static const float CCAMPM[3][4] = {
-        { 1.097594e-01, 2.896773e-07, 5.450474e-02,  1.438491e-07},
-        {-2.223581e-02, 5.083103e-08, 1.002548e-02, -2.291823e-08},
-        { 1.148966e-02, 5.658888e-08, 8.249439e-03,  4.063015e-08}
-    };
-
-    // CCPAMV[k]=a*M*DL/dt (planets), DC1MME=1-MASS(Earth+Moon)
-    static const float CCPAMV[4] = {
-        8.326827e-11,1.843484e-11,1.988712e-12,1.881276e-12
-    };
-    constexpr double DC1MME = 0.99999696;
-
-    // CCPAM[k]=a*M(planets), CCIM=INCLINATION(Moon)
-    static const float CCPAM[4] = {
-        4.960906e-3, 2.727436e-3, 8.392311e-4, 1.556861e-3
-    };
-    constexpr float CCIM = 8.978749e-2f;
-
     //
     // EXECUTION
     // ---------
@@ -423,4 +427,261 @@ void evp(double date, double deqx,
     }
 }
 
+/// Body of sla::evp_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void evp_batch_kernel(int n, const double* dates, double deqx,
+    Vector<double>* bvelo, Vector<double>* bpos, Vector<double>* hvelo, Vector<double>* hpos) {
+    // number of dates processed together
+    constexpr int CHUNK = 32;
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+        const double* date = dates + base;
+
+        // time arguments, and values of all elements for the instant date
+        double dt[CHUNK], dml[CHUNK], deps[CHUNK];
+        float t[CHUNK], forbel[7][CHUNK], sorbel[17][CHUNK];
+        for (int j = 0; j < count; j++) {
+            dt[j] = (date[j] - 15019.5) / 36525.0;
+            t[j] = (float) dt[j];
+            const double dtsq = dt[j] * dt[j];
+            dml[j] = lane_fmod(DCFEL[0][0] + dt[j] * DCFEL[0][1] + dtsq * DCFEL[0][2], DC2PI);
+            deps[j] = lane_fmod(DCEPS[0] + dt[j] * DCEPS[1] + dtsq * DCEPS[2], DC2PI);
+        }
+        for (int k = 1; k < 8; k++) {
+            for (int j = 0; j < count; j++) {
+                const double dtsq = dt[j] * dt[j];
+                forbel[k - 1][j] = (float) lane_fmod(DCFEL[k][0] + dt[j] * DCFEL[k][1] + dtsq * DCFEL[k][2], DC2PI);
+            }
+        }
+        for (int k = 0; k < 17; k++) {
+            for (int j = 0; j < count; j++) {
+                const float tsq = (float) (dt[j] * dt[j]);
+                sorbel[k][j] = lane_fmod(CCSEL[k][0] + t[j] * CCSEL[k][1] + tsq * CCSEL[k][2], CC2PI);
+            }
+        }
+
+        // secular perturbations in longitude
+        float pertl[CHUNK], pertld[CHUNK], pertr[CHUNK], pertrd[CHUNK];
+        for (int j = 0; j < count; j++) {
+            float sn[4], cs;
+            for (int k = 0; k < 4; k++) {
+                lane_sincos(lane_fmod(CCSEC[k][1] + t[j] * CCSEC[k][2], CC2PI), sn[k], cs);
+            }
+            pertl[j] = CCSEC[0][0] * sn[0] + CCSEC[1][0] * sn[1] + (CCSEC[2][0] + t[j] * CCSEC3) * sn[2] +
+                CCSEC[3][0] * sn[3];
+            pertld[j] = 0.0f;
+            pertr[j] = 0.0f;
+            pertrd[j] = 0.0f;
+        }
+
+        // periodic perturbations of the EMB (Earth-Moon barycentre); rate amplitudes of the last five terms are zero
+        for (int k = 0; k < 15; k++) {
+            for (int j = 0; j < count; j++) {
+                float sin_a, cos_a;
+                lane_sincos((float) lane_fmod(DCARGS[k][0] + dt[j] * DCARGS[k][1], DC2PI), sin_a, cos_a);
+                pertl[j] += CCAMPS[k][0] * cos_a + CCAMPS[k][1] * sin_a;
+                pertr[j] += CCAMPS[k][2] * cos_a + CCAMPS[k][3] * sin_a;
+                pertld[j] += (CCAMPS[k][1] * cos_a - CCAMPS[k][0] * sin_a) * CCAMPS[k][4];
+                pertrd[j] += (CCAMPS[k][3] * cos_a - CCAMPS[k][2] * sin_a) * CCAMPS[k][4];
+            }
+        }
+
+        // influence of eccentricity, evection and variation on the geocentric motion of the Moon
+        float mpertl[CHUNK], mpertld[CHUNK], pertp[CHUNK], pertpd[CHUNK];
+        for (int j = 0; j < count; j++) {
+            mpertl[j] = 0.0f;
+            mpertld[j] = 0.0f;
+            pertp[j] = 0.0f;
+            pertpd[j] = 0.0f;
+        }
+        for (int k = 0; k < 3; k++) {
+            for (int j = 0; j < count; j++) {
+                float sin_a, cos_a;
+                lane_sincos((float) lane_fmod(DCARGM[k][0] + dt[j] * DCARGM[k][1], DC2PI), sin_a, cos_a);
+                mpertl[j] += CCAMPM[k][0] * sin_a;
+                mpertld[j] += CCAMPM[k][1] * cos_a;
+                pertp[j] += CCAMPM[k][2] * cos_a;
+                pertpd[j] -= CCAMPM[k][3] * sin_a;
+            }
+        }
+
+        /*
+         * Single precision parts of the elliptic motion of the EMB, of the heliocentric motion of the Earth, and of
+         * the planetary contributions to the barycentric motion of the Earth.
+         */
+        float phi[CHUNK], sinlm[CHUNK], coslm[CHUNK], sigma[CHUNK], am[CHUNK], bm[CHUNK], flatm[CHUNK];
+        double dpsi[CHUNK], drd[CHUNK], drld[CHUNK], dzhd[CHUNK];
+        double pxbd[CHUNK], pybd[CHUNK], pzbd[CHUNK], pxb[CHUNK], pyb[CHUNK], pzb[CHUNK];
+        for (int j = 0; j < count; j++) {
+            // elliptic part of the motion of the EMB
+            const float e = sorbel[0][j];
+            const float g = forbel[0][j];
+            const float esq = e * e;
+            const double dparam = 1.0 - double(esq);
+            const auto param = (float) dparam;
+            const float two_e = e + e;
+            const float two_g = g + g;
+            float sin_g, sin_2g, sin_3g, cs;
+            lane_sincos(g, sin_g, cs);
+            lane_sincos(two_g, sin_2g, cs);
+            lane_sincos(g + two_g, sin_3g, cs);
+            phi[j] = two_e * ((1.0f - esq * 0.125f) * sin_g + e * 0.625f * sin_2g + esq * 0.54166667f * sin_3g);
+            float sin_f, cos_f;
+            lane_sincos(g + phi[j], sin_f, cos_f);
+            dpsi[j] = dparam / (1.0 + double(e * cos_f));
+            const float phid = two_e * CCSGD * ((1.0f + esq * 1.5f) * cos_f + e * (1.25f - sin_f * sin_f * 0.5f));
+            const float psid = CCSGD * e * sin_f / std::sqrt(param);
+
+            // perturbed heliocentric motion of the EMB
+            const double d1pdro = 1.0 + double(pertr[j]);
+            drd[j] = d1pdro * (double(psid) + dpsi[j] * double(pertrd[j]));
+            drld[j] = d1pdro * dpsi[j] * (DCSLD + double(phid) + double(pertld[j]));
+            dpsi[j] *= d1pdro;
+
+            // heliocentric motion of the Earth
+            lane_sincos(forbel[1][j] + mpertl[j], sinlm[j], coslm[j]);
+            sigma[j] = CCKM / (1.0f + pertp[j]);
+            am[j] = sigma[j] * (CCMLD + mpertld[j]);
+            bm[j] = sigma[j] * pertpd[j];
+            float sin_f2, cos_f2;
+            lane_sincos(forbel[2][j], sin_f2, cos_f2);
+            dzhd[j] = -double(sigma[j] * CCFDI * cos_f2);
+            flatm[j] = CCIM * sin_f2;
+
+            // planetary contributions to the barycentric motion of the Earth
+            pxbd[j] = pybd[j] = pzbd[j] = 0.0;
+            pxb[j] = pyb[j] = pzb[j] = 0.0;
+            for (int k = 0; k < 4; k++) {
+                const float plon = forbel[k + 3][j];
+                const float pomg = sorbel[k + 1][j];
+                const float pecc = sorbel[k + 9][j];
+                float sin_d, cos_d, sin_lp, cos_lp, sin_pomg, cos_pomg, sin_n, cos_n;
+                lane_sincos(plon - pomg, sin_d, cos_d);
+                lane_sincos(lane_fmod(plon + 2.0f * pecc * sin_d, CC2PI), sin_lp, cos_lp);
+                lane_sincos(pomg, sin_pomg, cos_pomg);
+                lane_sincos(plon - sorbel[k + 5][j], sin_n, cos_n);
+                pxbd[j] += double(CCPAMV[k] * (sin_lp + pecc * sin_pomg));
+                pybd[j] -= double(CCPAMV[k] * (cos_lp + pecc * cos_pomg));
+                pzbd[j] -= double(CCPAMV[k] * sorbel[k + 13][j] * cos_n);
+                float sin_flat, cos_flat;
+                const float flat = sorbel[k + 13][j] * sin_n;
+                lane_sincos(flat, sin_flat, cos_flat);
+                const float a = CCPAM[k] * (1.0f - pecc * cos_d);
+                const float b = a * cos_flat;
+                pxb[j] -= double(b * cos_lp);
+                pyb[j] -= double(b * sin_lp);
+                pzb[j] -= double(a * sin_flat);
+            }
+        }
+
+        /*
+         * Double precision parts, and transformation into final form.
+         */
+        for (int j = 0; j < count; j++) {
+            // perturbed heliocentric motion of the EMB
+            const double dtl = lane_fmod(dml[j] + double(phi[j]) + double(pertl[j]), DC2PI);
+            const double dsinls = std::sin(dtl);
+            const double dcosls = std::cos(dtl);
+            const double dxhd = drd[j] * dcosls - drld[j] * dsinls + double(am[j] * sinlm[j]) +
+                double(bm[j] * coslm[j]);
+            const double dyhd = drd[j] * dsinls + drld[j] * dcosls - double(am[j] * coslm[j]) +
+                double(bm[j] * sinlm[j]);
+
+            // barycentric motion of the Earth
+            const double dxbd = dxhd * DC1MME + pxbd[j];
+            const double dybd = dyhd * DC1MME + pybd[j];
+            const double dzbd = dzhd[j] * DC1MME + pzbd[j];
+
+            // transition to mean equator of date
+            const double dcosep = std::cos(deps[j]);
+            const double dsinep = std::sin(deps[j]);
+            const double dyahd = dcosep * dyhd - dsinep * dzhd[j];
+            const double dzahd = dsinep * dyhd + dcosep * dzhd[j];
+            const double dyabd = dcosep * dybd - dsinep * dzbd;
+            const double dzabd = dsinep * dybd + dcosep * dzbd;
+
+            // heliocentric coordinates of the Earth
+            const float a = sigma[j] * std::cos(flatm[j]);
+            const double dxh = dpsi[j] * dcosls - double(a * coslm[j]);
+            const double dyh = dpsi[j] * dsinls - double(a * sinlm[j]);
+            const double dzh = -double(sigma[j] * std::sin(flatm[j]));
+
+            // barycentric coordinates of the Earth
+            const double dxb = dxh * DC1MME + pxb[j];
+            const double dyb = dyh * DC1MME + pyb[j];
+            const double dzb = dzh * DC1MME + pzb[j];
+
+            // transition to mean equator of date
+            const double dyah = dcosep * dyh - dsinep * dzh;
+            const double dzah = dsinep * dyh + dcosep * dzh;
+            const double dyab = dcosep * dyb - dsinep * dzb;
+            const double dzab = dsinep * dyb + dcosep * dzb;
+
+            // copy result components into vectors, correcting for FK4 equinox
+            const double depj = epj(date[j]);
+            const double deqcor = DS2R * (0.035 + 0.00085 * (depj - B1950));
+            double* hv = hvelo[base + j];
+            double* bv = bvelo[base + j];
+            double* hp = hpos[base + j];
+            double* bp = bpos[base + j];
+            hv[0] = dxhd - deqcor * dyahd;
+            hv[1] = dyahd + deqcor * dxhd;
+            hv[2] = dzahd;
+            bv[0] = dxbd - deqcor * dyabd;
+            bv[1] = dyabd + deqcor * dxbd;
+            bv[2] = dzabd;
+            hp[0] = dxh - deqcor * dyah;
+            hp[1] = dyah + deqcor * dxh;
+            hp[2] = dzah;
+            bp[0] = dxb - deqcor * dyab;
+            bp[1] = dyab + deqcor * dxb;
+            bp[2] = dzab;
+
+            // was precession to another equinox requested?
+            if (deqx > 0.0) {
+                Matrix<double> mat;
+                prec(depj, deqx, mat);
+                dmxv(mat, hv, hv);
+                dmxv(mat, bv, bv);
+                dmxv(mat, hp, hp);
+                dmxv(mat, bp, bp);
+            }
+        }
+    }
+}
+
+static KernelDispatcher<evp_batch_kernel> evp_batch_dispatcher("evp_batch");
+static const bool evp_batch_enlisted = evp_batch_dispatcher.enlist();
+
+/**
+ * Calculates barycentric and heliocentric velocities and positions of the Earth for many dates (double precision).
+ *
+ * Implements the same model as the sla::evp() function, with dates processed in chunks: perturbation terms are in
+ * the outer loops and dates in the inner ones; single precision parts of the model are computed in loops that are
+ * free of branches and library calls (sine and cosine of each argument are computed together by an inlined
+ * polynomial), so compilers can vectorize them across dates. Results agree with those of sla::evp() to within a few
+ * float ulps of the single precision terms.
+ *
+ * @param n Number of dates.
+ * @param dates TDB (Barycentric Dynamical Time; loosely ET) as Modified Julian Dates (JD-2400000.5).
+ * @param deqx Julian Epoch (e.g. 2000.0D0) of mean equator and equinox of the vectors returned; if `deqx` <= 0.0,
+ *   then vectors are referred to the mean equator and equinox (FK5) of respective dates.
+ * @param bvelo Return value: array of `n` barycentric velocities (AU/s, Cartesian vectors).
+ * @param bpos Return value: array of `n` barycentric positions (AU, Cartesian vectors).
+ * @param hvelo Return value: array of `n` heliocentric velocities (AU/s, Cartesian vectors).
+ * @param hpos Return value: array of `n` heliocentric positions (AU, Cartesian vectors).
+ */
+void evp_batch(int n, const double* dates, double deqx,
+    Vector<double>* bvelo, Vector<double>* bpos, Vector<double>* hvelo, Vector<double>* hpos) {
+    evp_batch_dispatcher(n, dates, deqx, bvelo, bpos, hvelo, hpos);
+}
+
+/// Version of sla::evp_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void evp_batch(StridedSpan<const double> dates, double deqx, StridedSpan<Vector<double>> bvelo,
+    StridedSpan<Vector<double>> bpos, StridedSpan<Vector<double>> hvelo, StridedSpan<Vector<double>> hpos) {
+    span_tiles(dates.get_size(), [&](int n, auto dates, auto bvelo, auto bpos, auto hvelo, auto hpos) {
+        evp_batch(n, dates, deqx, bvelo, bpos, hvelo, hpos);
+    }, dates, bvelo, bpos, hvelo, hpos);
+}
+
 }
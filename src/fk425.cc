@@ -0,0 +1,244 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "dispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Converts B1950.0 FK4 star data to J2000.0 FK5 (double precision).
+ *
+ * This function converts stars from the old, Bessel-Newcomb, FK4 system to the new, IAU 1976, FK5, Fricke system.
+ * The precepts of Smith et al (Ref 1) are followed, using the implementation by Yallop et al (Ref 2) of a matrix
+ * method due to Standish. Kinoshita's development of Andoyer's post-Newcomb precession is used. The numerical
+ * constants from Seidelmann et al (Ref 3) are used canonically.
+ *
+ * The proper motions in RA are dRA/dt rather than cos(Dec)*dRA/dt, and are per year rather than per century.
+ *
+ * Conversion from Besselian epoch 1950.0 to Julian epoch 2000.0 only is provided for. Conversions involving other
+ * epochs will require use of the appropriate precession, proper motion, and E-terms functions before and/or after
+ * FK425 is called.
+ *
+ * In the FK4 catalogue the proper motions of stars within 10 degrees of the poles do not embody the differential
+ * E-term effect and should, strictly speaking, be handled in a different manner from stars outside these regions.
+ * However, given the general lack of homogeneity of the star data available for routine astrometry, the difficulties
+ * of handling positions that may have been determined from astrometric fields spanning the polar and non-polar
+ * regions, the likelihood that the differential E-terms effect was not taken into account when allowing for proper
+ * motion in past astrometry, and the undesirability of a discontinuity in the algorithm, the decision has been made
+ * in this function to include the effect of differential E-terms on the proper motions for all stars, whether polar
+ * or not. At epoch 2000, and measuring on the sky rather than in terms of dRA, the errors resulting from this
+ * simplification are less than 1 milliarcsecond in position and 1 milliarcsecond per century in proper motion.
+ *
+ * References:
+ *   1. Smith, C.A. et al., 1989, "The transformation of astrometric catalog systems to the equinox J2000.0", Astron.J.
+ *      97, 265.
+ *   2. Yallop, B.D. et al., 1989, "Transformation of mean star places from FK4 B1950.0 to FK5 J2000.0 using matrices
+ *      in 6-space", Astron.J. 97, 274.
+ *   3. Seidelmann, P.K. (ed), 1992, "Explanatory Supplement to the Astronomical Almanac", ISBN 0-935702-68-7.
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param dir1950 B1950.0 RA,Dec (radians).
+ * @param pm1950 B1950.0 proper motions (RA,Dec; radians per tropical year).
+ * @param px1950 Parallax (arcsec).
+ * @param rv1950 Radial velocity (km/s, +ve = moving away).
+ * @param dir2000 Return value: J2000.0 RA,Dec (radians).
+ * @param pm2000 Return value: J2000.0 proper motions (RA,Dec; radians per Julian year).
+ * @param px2000 Return value: parallax (arcsec).
+ * @param rv2000 Return value: radial velocity (km/s, +ve = moving away).
+ */
+void fk425(const Spherical<double>& dir1950, const Spherical<double>& pm1950, double px1950, double rv1950,
+    Spherical<double>& dir2000, Spherical<double>& pm2000, double& px2000, double& rv2000) {
+    const double r1950 = dir1950.get_ra();
+    const double d1950 = dir1950.get_dec();
+    const double dr1950 = pm1950.get_ra();
+    const double dd1950 = pm1950.get_dec();
+    double r2000, d2000, dr2000, dd2000;
+    fk425_batch(1, &r1950, &d1950, &dr1950, &dd1950, &px1950, &rv1950,
+        &r2000, &d2000, &dr2000, &dd2000, &px2000, &rv2000);
+    dir2000.set_ra(r2000);
+    dir2000.set_dec(d2000);
+    pm2000.set_ra(dr2000);
+    pm2000.set_dec(dd2000);
+}
+
+/// Body of sla::fk425_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void fk425_batch_kernel(int n, const double* r1950, const double* d1950, const double* dr1950,
+    const double* dd1950, const double* p1950, const double* v1950, double* r2000, double* d2000, double* dr2000,
+    double* dd2000, double* p2000, double* v2000) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    constexpr double D2PI = 6.283185307179586476925287;
+
+    // radians per year to arcsec per century
+    constexpr double PMF = 100.0 * 60.0 * 60.0 * 360.0 / D2PI;
+
+    // small number to avoid arithmetic problems
+    constexpr double TINY = 1.0e-30;
+
+    // km per sec to AU per tropical century (86400 * 36524.2198782 / 149597870)
+    constexpr double VF = 21.095;
+
+    // constant vectors (E-terms and their rate of change) and matrix
+    static const double A[3] = {-1.62557e-6, -0.31919e-6, -0.13843e-6};
+    static const double AD[3] = {+1.245e-3, -1.580e-3, -0.659e-3};
+    static const double EM[6][6] = {
+        {+0.9999256782, -0.0111820611, -0.0048579477, +0.00000242395018, -0.00000002710663, -0.00000001177656},
+        {+0.0111820610, +0.9999374784, -0.0000271765, +0.00000002710663, +0.00000242397878, -0.00000000006587},
+        {+0.0048579479, -0.0000271474, +0.9999881997, +0.00000001177656, -0.00000000006582, +0.00000242410173},
+        {-0.000551, -0.238565, +0.435739, +0.99994704, -0.01118251, -0.00485767},
+        {+0.238514, -0.002667, -0.008541, +0.01118251, +0.99995883, -0.00002718},
+        {-0.435623, +0.012254, +0.002117, +0.00485767, -0.00002714, +1.00000956}
+    };
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // position+velocity 6-vectors, before and after conversion
+        double v1[6][CHUNK], v2[6][CHUNK];
+
+        for (int k = 0; k < count; k++) {
+            // pick up B1950 data (units radians and arcsec/TC)
+            const int i = base + k;
+            const double ur = dr1950[i] * PMF;
+            const double ud = dd1950[i] * PMF;
+
+            // spherical to Cartesian
+            const double sr = std::sin(r1950[i]);
+            const double cr = std::cos(r1950[i]);
+            const double sd = std::sin(d1950[i]);
+            const double cd = std::cos(d1950[i]);
+            const Vector<double> r0 = {cr * cd, sr * cd, sd};
+            double w = VF * v1950[i] * p1950[i];
+            const Vector<double> rd0 = {
+                (-sr * cd * ur) - (cr * sd * ud) + (w * r0[0]),
+                (cr * cd * ur) - (sr * sd * ud) + (w * r0[1]),
+                (cd * ud) + (w * r0[2])
+            };
+
+            // allow for E-terms and express as position+velocity 6-vector
+            w = (r0[0] * A[0]) + (r0[1] * A[1]) + (r0[2] * A[2]);
+            const double wd = (r0[0] * AD[0]) + (r0[1] * AD[1]) + (r0[2] * AD[2]);
+            for (int j = 0; j < 3; j++) {
+                v1[j][k] = r0[j] - A[j] + w * r0[j];
+                v1[j + 3][k] = rd0[j] - AD[j] + wd * r0[j];
+            }
+        }
+
+        // convert position+velocity vectors to Fricke system
+        for (int j = 0; j < 6; j++) {
+            for (int k = 0; k < count; k++) {
+                double w = 0.0;
+                for (int m = 0; m < 6; m++) {
+                    w += EM[j][m] * v1[m][k];
+                }
+                v2[j][k] = w;
+            }
+        }
+
+        // revert to spherical coordinates
+        for (int k = 0; k < count; k++) {
+            const int i = base + k;
+            const double x = v2[0][k];
+            const double y = v2[1][k];
+            const double z = v2[2][k];
+            const double xd = v2[3][k];
+            const double yd = v2[4][k];
+            const double zd = v2[5][k];
+            const double rxysq = x * x + y * y;
+            const double rxyzsq = rxysq + z * z;
+            const double rxy = std::sqrt(rxysq);
+            const double rxyz = std::sqrt(rxyzsq);
+            const double spxy = x * xd + y * yd;
+            const double spxyz = spxy + z * zd;
+            double r = 0.0;
+            if (x != 0.0 || y != 0.0) {
+                r = std::atan2(y, x);
+                if (r < 0.0) {
+                    r += D2PI;
+                }
+            }
+            const double d = std::atan2(z, rxy);
+            double ur = dr1950[i] * PMF;
+            double ud = dd1950[i] * PMF;
+            if (rxy > TINY) {
+                ur = (x * yd - y * xd) / rxysq;
+                ud = (zd * rxysq - z * spxy) / (rxyzsq * rxy);
+            }
+            double px = p1950[i];
+            double rv = v1950[i];
+            if (px > TINY) {
+                rv = spxyz / (px * rxyz * VF);
+                px = px / rxyz;
+            }
+
+            // return results
+            r2000[i] = r;
+            d2000[i] = d;
+            dr2000[i] = ur / PMF;
+            dd2000[i] = ud / PMF;
+            p2000[i] = px;
+            v2000[i] = rv;
+        }
+    }
+}
+
+static KernelDispatcher<fk425_batch_kernel> fk425_batch_dispatcher("fk425_batch");
+static const bool fk425_batch_enlisted = fk425_batch_dispatcher.enlist();
+
+/**
+ * Converts B1950.0 FK4 star data to J2000.0 FK5 for many stars (double precision).
+ *
+ * Results are identical to those of the sla::fk425() function (which is implemented as a batch of one star). Stars
+ * are processed in chunks; the 6x6 matrix is applied in loops over stars that are free of branches and library
+ * calls, so compilers can vectorize them. Output arrays may be the same as input ones.
+ *
+ * @param n Number of stars.
+ * @param r1950 B1950.0 RAs (radians).
+ * @param d1950 B1950.0 Decs (radians).
+ * @param dr1950 B1950.0 proper motions in RA (dRA/dt, radians per tropical year).
+ * @param dd1950 B1950.0 proper motions in Dec (radians per tropical year).
+ * @param p1950 Parallaxes (arcsec).
+ * @param v1950 Radial velocities (km/s, +ve = moving away).
+ * @param r2000 Return value: J2000.0 RAs (radians).
+ * @param d2000 Return value: J2000.0 Decs (radians).
+ * @param dr2000 Return value: J2000.0 proper motions in RA (dRA/dt, radians per Julian year).
+ * @param dd2000 Return value: J2000.0 proper motions in Dec (radians per Julian year).
+ * @param p2000 Return value: parallaxes (arcsec).
+ * @param v2000 Return value: radial velocities (km/s, +ve = moving away).
+ */
+void fk425_batch(int n, const double* r1950, const double* d1950, const double* dr1950, const double* dd1950,
+    const double* p1950, const double* v1950, double* r2000, double* d2000, double* dr2000, double* dd2000,
+    double* p2000, double* v2000) {
+    fk425_batch_dispatcher(n, r1950, d1950, dr1950, dd1950, p1950, v1950, r2000, d2000, dr2000, dd2000, p2000, v2000);
+}
+
+/// Version of sla::fk425_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void fk425_batch(StridedSpan<const double> r1950, StridedSpan<const double> d1950, StridedSpan<const double> dr1950,
+    StridedSpan<const double> dd1950, StridedSpan<const double> p1950, StridedSpan<const double> v1950,
+    StridedSpan<double> r2000, StridedSpan<double> d2000, StridedSpan<double> dr2000, StridedSpan<double> dd2000,
+    StridedSpan<double> p2000, StridedSpan<double> v2000) {
+    span_tiles(r1950.get_size(), [](int n, auto... p) { fk425_batch(n, p...); },
+        r1950, d1950, dr1950, dd1950, p1950, v1950, r2000, d2000, dr2000, dd2000, p2000, v2000);
+}
+
+}
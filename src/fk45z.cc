@@ -0,0 +1,185 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "dispatch.h"
+#include <algorithm>
+
+namespace sla {
+
+/**
+ * Converts B1950.0 FK4 star position to J2000.0 FK5 assuming zero proper motion in the FK5 system (double
+ * precision).
+ *
+ * This function converts stars from the old, Bessel-Newcomb, FK4 system to the new, IAU 1976, FK5, Fricke system,
+ * in such a way that the FK5 proper motion is zero. Because such a star has, in general, a non-zero proper motion in
+ * the FK4 system, the function requires the epoch at which the position in the FK4 system was determined.
+ *
+ * The method is from Appendix 2 of Ref 1, but using the constants of Ref 4.
+ *
+ * The epoch `bepoch` is strictly speaking Besselian, but if a Julian epoch is supplied the result will be affected
+ * only to a negligible extent.
+ *
+ * Conversion from Besselian epoch 1950.0 to Julian epoch 2000.0 only is provided for. Conversions involving other
+ * epochs will require use of the appropriate precession, proper motion, and E-terms functions before and/or after
+ * FK45Z is called.
+ *
+ * In the FK4 catalogue the proper motions of stars within 10 degrees of the poles do not embody the differential
+ * E-term effect and should, strictly speaking, be handled in a different manner from stars outside these regions.
+ * However, given the general lack of homogeneity of the star data available for routine astrometry, the difficulties
+ * of handling positions that may have been determined from astrometric fields spanning the polar and non-polar
+ * regions, the likelihood that the differential E-terms effect was not taken into account when allowing for proper
+ * motion in past astrometry, and the undesirability of a discontinuity in the algorithm, the decision has been made
+ * in this function to include the effect of differential E-terms on the proper motions for all stars, whether polar
+ * or not. At epoch 2000, and measuring on the sky rather than in terms of dRA, the errors resulting from this
+ * simplification are less than 1 milliarcsecond in position and 1 milliarcsecond per century in proper motion.
+ *
+ * References:
+ *   1. Aoki, S. et al., 1983, "Conversion matrix of epoch B1950.0 FK4-based positions of stars to epoch J2000.0
+ *      positions in accordance with the new IAU resolutions", Astron.Astrophys. 128, 263.
+ *   2. Smith, C.A. et al., 1989, "The transformation of astrometric catalog systems to the equinox J2000.0", Astron.J.
+ *      97, 265.
+ *   3. Yallop, B.D. et al., 1989, "Transformation of mean star places from FK4 B1950.0 to FK5 J2000.0 using matrices
+ *      in 6-space", Astron.J. 97, 274.
+ *   4. Seidelmann, P.K. (ed), 1992, "Explanatory Supplement to the Astronomical Almanac", ISBN 0-935702-68-7.
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param dir1950 B1950.0 FK4 RA,Dec at epoch `bepoch` (radians).
+ * @param bepoch Besselian epoch (e.g. 1979.3).
+ * @param dir2000 Return value: J2000.0 FK5 RA,Dec (radians).
+ */
+void fk45z(const Spherical<double>& dir1950, double bepoch, Spherical<double>& dir2000) {
+    const double r1950 = dir1950.get_ra();
+    const double d1950 = dir1950.get_dec();
+    double r2000, d2000;
+    fk45z_batch(1, &r1950, &d1950, bepoch, &r2000, &d2000);
+    dir2000.set_ra(r2000);
+    dir2000.set_dec(d2000);
+}
+
+/// Body of sla::fk45z_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void fk45z_batch_kernel(int n, const double* r1950, const double* d1950, double bepoch,
+    double* r2000, double* d2000) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    // radians per year to arcsec per century
+    constexpr double PMF = 100.0 * 60.0 * 60.0 * 360.0 / 6.283185307179586476925287;
+
+    // position and position+velocity vectors
+    static const double A[3] = {-1.62557e-6, -0.31919e-6, -0.13843e-6};
+    static const double AD[3] = {+1.245e-3, -1.580e-3, -0.659e-3};
+
+    // 3x6 matrix (position part of the 6x6 FK4 to FK5 matrix)
+    static const double EM[6][3] = {
+        {+0.9999256782, -0.0111820611, -0.0048579477},
+        {+0.0111820610, +0.9999374784, -0.0000271765},
+        {+0.0048579479, -0.0000271474, +0.9999881997},
+        {-0.000551, -0.238565, +0.435739},
+        {+0.238514, -0.002667, -0.008541},
+        {-0.435623, +0.012254, +0.002117}
+    };
+
+    // adjust vector A to give zero proper motion in FK5
+    double w = (bepoch - 1950.0) / PMF;
+    Vector<double> a1;
+    for (int j = 0; j < 3; j++) {
+        a1[j] = A[j] + w * AD[j];
+    }
+
+    // fictitious proper motion in FK4 factor
+    const double wpm = (epj(epb2d(bepoch)) - 2000.0) / PMF;
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // position vectors with E-terms removed, and position+velocity vectors in Fricke system
+        double v1[3][CHUNK], v2[6][CHUNK];
+
+        for (int k = 0; k < count; k++) {
+            // spherical to Cartesian
+            Vector<double> r0;
+            dcs2c({r1950[base + k], d1950[base + k]}, r0);
+
+            // remove E-terms
+            w = r0[0] * a1[0] + r0[1] * a1[1] + r0[2] * a1[2];
+            for (int j = 0; j < 3; j++) {
+                v1[j][k] = r0[j] - a1[j] + w * r0[j];
+            }
+        }
+
+        // convert position vectors to Fricke system
+        for (int j = 0; j < 6; j++) {
+            for (int k = 0; k < count; k++) {
+                double wj = 0.0;
+                for (int m = 0; m < 3; m++) {
+                    wj += EM[j][m] * v1[m][k];
+                }
+                v2[j][k] = wj;
+            }
+        }
+
+        for (int k = 0; k < count; k++) {
+            // allow for fictitious proper motion in FK4
+            Vector<double> v;
+            for (int j = 0; j < 3; j++) {
+                v[j] = v2[j][k] + wpm * v2[j + 3][k];
+            }
+
+            // revert to spherical coordinates
+            Spherical<double> dir;
+            dcc2s(v, dir);
+            r2000[base + k] = dranrm(dir.get_ra());
+            d2000[base + k] = dir.get_dec();
+        }
+    }
+}
+
+static KernelDispatcher<fk45z_batch_kernel> fk45z_batch_dispatcher("fk45z_batch");
+static const bool fk45z_batch_enlisted = fk45z_batch_dispatcher.enlist();
+
+/**
+ * Converts B1950.0 FK4 star positions of the same epoch to J2000.0 FK5 assuming zero proper motion in the FK5 system
+ * (double precision).
+ *
+ * Results are identical to those of the sla::fk45z() function (which is implemented as a batch of one star), but
+ * terms depending on the epoch are computed only once. Stars are processed in chunks; the matrix is applied in loops
+ * over stars that are free of branches and library calls, so compilers can vectorize them. Output arrays may be the
+ * same as input ones.
+ *
+ * @param n Number of stars.
+ * @param r1950 B1950.0 FK4 RAs at epoch `bepoch` (radians).
+ * @param d1950 B1950.0 FK4 Decs at epoch `bepoch` (radians).
+ * @param bepoch Besselian epoch (e.g. 1979.3).
+ * @param r2000 Return value: J2000.0 FK5 RAs (radians).
+ * @param d2000 Return value: J2000.0 FK5 Decs (radians).
+ */
+void fk45z_batch(int n, const double* r1950, const double* d1950, double bepoch, double* r2000, double* d2000) {
+    fk45z_batch_dispatcher(n, r1950, d1950, bepoch, r2000, d2000);
+}
+
+/// Version of sla::fk45z_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void fk45z_batch(StridedSpan<const double> r1950, StridedSpan<const double> d1950, double bepoch,
+    StridedSpan<double> r2000, StridedSpan<double> d2000) {
+    span_tiles(r1950.get_size(), [&](int n, auto r1950, auto d1950, auto r2000, auto d2000) {
+        fk45z_batch(n, r1950, d1950, bepoch, r2000, d2000);
+    }, r1950, d1950, r2000, d2000);
+}
+
+}
@@ -0,0 +1,259 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "dispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Converts J2000.0 FK5 star data to B1950.0 FK4 (double precision).
+ *
+ * This function converts stars from the new, IAU 1976, FK5, Fricke system, to the old, Bessel-Newcomb, FK4 system.
+ * The precepts of Smith et al (Ref 1) are followed, using the implementation by Yallop et al (Ref 2) of a matrix
+ * method due to Standish. Kinoshita's development of Andoyer's post-Newcomb precession is used. The numerical
+ * constants from Seidelmann et al (Ref 3) are used canonically.
+ *
+ * The proper motions in RA are dRA/dt rather than cos(Dec)*dRA/dt, and are per year rather than per century.
+ *
+ * Note that conversion from Julian epoch 2000.0 to Besselian epoch 1950.0 only is provided for. Conversions
+ * involving other epochs will require use of the appropriate precession, proper motion, and E-terms functions before
+ * and/or after FK524 is called.
+ *
+ * In the FK4 catalogue the proper motions of stars within 10 degrees of the poles do not embody the differential
+ * E-term effect and should, strictly speaking, be handled in a different manner from stars outside these regions.
+ * However, given the general lack of homogeneity of the star data available for routine astrometry, the difficulties
+ * of handling positions that may have been determined from astrometric fields spanning the polar and non-polar
+ * regions, the likelihood that the differential E-terms effect was not taken into account when allowing for proper
+ * motion in past astrometry, and the undesirability of a discontinuity in the algorithm, the decision has been made
+ * in this function to include the effect of differential E-terms on the proper motions for all stars, whether polar
+ * or not. At epoch 2000, and measuring on the sky rather than in terms of dRA, the errors resulting from this
+ * simplification are less than 1 milliarcsecond in position and 1 milliarcsecond per century in proper motion.
+ *
+ * References:
+ *   1. Smith, C.A. et al., 1989, "The transformation of astrometric catalog systems to the equinox J2000.0", Astron.J.
+ *      97, 265.
+ *   2. Yallop, B.D. et al., 1989, "Transformation of mean star places from FK4 B1950.0 to FK5 J2000.0 using matrices
+ *      in 6-space", Astron.J. 97, 274.
+ *   3. Seidelmann, P.K. (ed), 1992, "Explanatory Supplement to the Astronomical Almanac", ISBN 0-935702-68-7.
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param dir2000 J2000.0 RA,Dec (radians).
+ * @param pm2000 J2000.0 proper motions (RA,Dec; radians per Julian year).
+ * @param px2000 Parallax (arcsec).
+ * @param rv2000 Radial velocity (km/s, +ve = moving away).
+ * @param dir1950 Return value: B1950.0 RA,Dec (radians).
+ * @param pm1950 Return value: B1950.0 proper motions (RA,Dec; radians per tropical year).
+ * @param px1950 Return value: parallax (arcsec).
+ * @param rv1950 Return value: radial velocity (km/s, +ve = moving away).
+ */
+void fk524(const Spherical<double>& dir2000, const Spherical<double>& pm2000, double px2000, double rv2000,
+    Spherical<double>& dir1950, Spherical<double>& pm1950, double& px1950, double& rv1950) {
+    const double r2000 = dir2000.get_ra();
+    const double d2000 = dir2000.get_dec();
+    const double dr2000 = pm2000.get_ra();
+    const double dd2000 = pm2000.get_dec();
+    double r1950, d1950, dr1950, dd1950;
+    fk524_batch(1, &r2000, &d2000, &dr2000, &dd2000, &px2000, &rv2000,
+        &r1950, &d1950, &dr1950, &dd1950, &px1950, &rv1950);
+    dir1950.set_ra(r1950);
+    dir1950.set_dec(d1950);
+    pm1950.set_ra(dr1950);
+    pm1950.set_dec(dd1950);
+}
+
+/// Body of sla::fk524_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void fk524_batch_kernel(int n, const double* r2000, const double* d2000, const double* dr2000,
+    const double* dd2000, const double* p2000, const double* v2000, double* r1950, double* d1950, double* dr1950,
+    double* dd1950, double* p1950, double* v1950) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    constexpr double D2PI = 6.283185307179586476925287;
+
+    // radians per year to arcsec per century
+    constexpr double PMF = 100.0 * 60.0 * 60.0 * 360.0 / D2PI;
+
+    // small number to avoid arithmetic problems
+    constexpr double TINY = 1.0e-30;
+
+    // km per sec to AU per tropical century (86400 * 36524.2198782 / 149597870)
+    constexpr double VF = 21.095;
+
+    // constant vectors (E-terms and their rate of change) and matrix
+    static const double A[3] = {-1.62557e-6, -0.31919e-6, -0.13843e-6};
+    static const double AD[3] = {+1.245e-3, -1.580e-3, -0.659e-3};
+    static const double EMI[6][6] = {
+        {+0.9999256795, +0.0111814828, +0.0048590039, -0.00000242389840, -0.00000002710544, -0.00000001177742},
+        {-0.0111814828, +0.9999374849, -0.0000271771, +0.00000002710544, -0.00000242392702, +0.00000000006585},
+        {-0.0048590040, -0.0000271557, +0.9999881946, +0.00000001177742, +0.00000000006585, -0.00000242404995},
+        {-0.000551, +0.238509, -0.435614, +0.99990432, +0.01118145, +0.00485852},
+        {-0.238560, -0.002667, +0.012254, -0.01118145, +0.99991613, -0.00002717},
+        {+0.435730, -0.008541, +0.002117, -0.00485852, -0.00002716, +0.99996684}
+    };
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // position+velocity 6-vectors, before and after conversion
+        double v1[6][CHUNK], v2[6][CHUNK];
+
+        for (int k = 0; k < count; k++) {
+            // pick up J2000 data (units radians and arcsec/JC)
+            const int i = base + k;
+            const double ur = dr2000[i] * PMF;
+            const double ud = dd2000[i] * PMF;
+
+            // spherical to Cartesian
+            const double sr = std::sin(r2000[i]);
+            const double cr = std::cos(r2000[i]);
+            const double sd = std::sin(d2000[i]);
+            const double cd = std::cos(d2000[i]);
+            const double x = cr * cd;
+            const double y = sr * cd;
+            const double z = sd;
+            const double w = VF * v2000[i] * p2000[i];
+            v1[0][k] = x;
+            v1[1][k] = y;
+            v1[2][k] = z;
+            v1[3][k] = -ur * y - cr * sd * ud + w * x;
+            v1[4][k] = ur * x - sr * sd * ud + w * y;
+            v1[5][k] = cd * ud + w * z;
+        }
+
+        // convert position+velocity vectors to BN (Bessel-Newcomb) system
+        for (int j = 0; j < 6; j++) {
+            for (int k = 0; k < count; k++) {
+                double w = 0.0;
+                for (int m = 0; m < 6; m++) {
+                    w += EMI[j][m] * v1[m][k];
+                }
+                v2[j][k] = w;
+            }
+        }
+
+        for (int k = 0; k < count; k++) {
+            // position vector components and magnitude
+            const int i = base + k;
+            double x = v2[0][k];
+            double y = v2[1][k];
+            double z = v2[2][k];
+            double rxyz = std::sqrt(x * x + y * y + z * z);
+
+            // apply E-terms to position
+            double w = x * A[0] + y * A[1] + z * A[2];
+            x = x + A[0] * rxyz - w * x;
+            y = y + A[1] * rxyz - w * y;
+            z = z + A[2] * rxyz - w * z;
+
+            // recompute magnitude
+            rxyz = std::sqrt(x * x + y * y + z * z);
+
+            // apply E-terms to both position and velocity
+            x = v2[0][k];
+            y = v2[1][k];
+            z = v2[2][k];
+            w = x * A[0] + y * A[1] + z * A[2];
+            const double wd = x * AD[0] + y * AD[1] + z * AD[2];
+            x = x + A[0] * rxyz - w * x;
+            y = y + A[1] * rxyz - w * y;
+            z = z + A[2] * rxyz - w * z;
+            const double xd = v2[3][k] + AD[0] * rxyz - wd * x;
+            const double yd = v2[4][k] + AD[1] * rxyz - wd * y;
+            const double zd = v2[5][k] + AD[2] * rxyz - wd * z;
+
+            // convert to spherical
+            const double rxysq = x * x + y * y;
+            const double rxy = std::sqrt(rxysq);
+            double r = 0.0;
+            if (x != 0.0 || y != 0.0) {
+                r = std::atan2(y, x);
+                if (r < 0.0) {
+                    r += D2PI;
+                }
+            }
+            const double d = std::atan2(z, rxy);
+            double ur = dr2000[i] * PMF;
+            double ud = dd2000[i] * PMF;
+            if (rxy > TINY) {
+                ur = (x * yd - y * xd) / rxysq;
+                ud = (zd * rxysq - z * (x * xd + y * yd)) / ((rxysq + z * z) * rxy);
+            }
+
+            // radial velocity and parallax
+            double px = p2000[i];
+            double rv = v2000[i];
+            if (px > TINY) {
+                rv = (x * xd + y * yd + z * zd) / (px * VF * rxyz);
+                px = px / rxyz;
+            }
+
+            // return results
+            r1950[i] = r;
+            d1950[i] = d;
+            dr1950[i] = ur / PMF;
+            dd1950[i] = ud / PMF;
+            p1950[i] = px;
+            v1950[i] = rv;
+        }
+    }
+}
+
+static KernelDispatcher<fk524_batch_kernel> fk524_batch_dispatcher("fk524_batch");
+static const bool fk524_batch_enlisted = fk524_batch_dispatcher.enlist();
+
+/**
+ * Converts J2000.0 FK5 star data to B1950.0 FK4 for many stars (double precision).
+ *
+ * Results are identical to those of the sla::fk524() function (which is implemented as a batch of one star). Stars
+ * are processed in chunks; the 6x6 matrix is applied in loops over stars that are free of branches and library
+ * calls, so compilers can vectorize them. Output arrays may be the same as input ones.
+ *
+ * @param n Number of stars.
+ * @param r2000 J2000.0 RAs (radians).
+ * @param d2000 J2000.0 Decs (radians).
+ * @param dr2000 J2000.0 proper motions in RA (dRA/dt, radians per Julian year).
+ * @param dd2000 J2000.0 proper motions in Dec (radians per Julian year).
+ * @param p2000 Parallaxes (arcsec).
+ * @param v2000 Radial velocities (km/s, +ve = moving away).
+ * @param r1950 Return value: B1950.0 RAs (radians).
+ * @param d1950 Return value: B1950.0 Decs (radians).
+ * @param dr1950 Return value: B1950.0 proper motions in RA (dRA/dt, radians per tropical year).
+ * @param dd1950 Return value: B1950.0 proper motions in Dec (radians per tropical year).
+ * @param p1950 Return value: parallaxes (arcsec).
+ * @param v1950 Return value: radial velocities (km/s, +ve = moving away).
+ */
+void fk524_batch(int n, const double* r2000, const double* d2000, const double* dr2000, const double* dd2000,
+    const double* p2000, const double* v2000, double* r1950, double* d1950, double* dr1950, double* dd1950,
+    double* p1950, double* v1950) {
+    fk524_batch_dispatcher(n, r2000, d2000, dr2000, dd2000, p2000, v2000, r1950, d1950, dr1950, dd1950, p1950, v1950);
+}
+
+/// Version of sla::fk524_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void fk524_batch(StridedSpan<const double> r2000, StridedSpan<const double> d2000, StridedSpan<const double> dr2000,
+    StridedSpan<const double> dd2000, StridedSpan<const double> p2000, StridedSpan<const double> v2000,
+    StridedSpan<double> r1950, StridedSpan<double> d1950, StridedSpan<double> dr1950, StridedSpan<double> dd1950,
+    StridedSpan<double> p1950, StridedSpan<double> v1950) {
+    span_tiles(r2000.get_size(), [](int n, auto... p) { fk524_batch(n, p...); },
+        r2000, d2000, dr2000, dd2000, p2000, v2000, r1950, d1950, dr1950, dd1950, p1950, v1950);
+}
+
+}
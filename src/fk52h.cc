@@ -0,0 +1,157 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "hipparcos.h"
+#include "dispatch.h"
+#include <algorithm>
+
+namespace sla {
+
+/**
+ * Transforms FK5 (J2000) star data into the Hipparcos frame (double precision).
+ *
+ * The proper motions in RA are dRA/dt rather than cos(Dec)*dRA/dt, and are per year rather than per century.
+ *
+ * The FK5 to Hipparcos transformation consists of a pure rotation and spin; zonal errors in the FK5 catalogue are not
+ * taken into account.
+ *
+ * See also sla::h2fk5(), sla::fk5hz(), sla::hfk5z().
+ *
+ * Reference: F.Mignard & M.Froeschle, Astron. Astrophys. 354, 732-739 (2000).
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param dir5 J2000.0 FK5 RA,Dec (radians).
+ * @param pm5 J2000.0 FK5 proper motions (RA,Dec; radians per Julian year).
+ * @param dirh Return value: Hipparcos RA,Dec (radians).
+ * @param pmh Return value: Hipparcos proper motions (RA,Dec; radians per Julian year).
+ */
+void fk52h(const Spherical<double>& dir5, const Spherical<double>& pm5, Spherical<double>& dirh,
+    Spherical<double>& pmh) {
+    const double r5 = dir5.get_ra();
+    const double d5 = dir5.get_dec();
+    const double dr5 = pm5.get_ra();
+    const double dd5 = pm5.get_dec();
+    double rh, dh, drh, ddh;
+    fk52h_batch(1, &r5, &d5, &dr5, &dd5, &rh, &dh, &drh, &ddh);
+    dirh.set_ra(rh);
+    dirh.set_dec(dh);
+    pmh.set_ra(drh);
+    pmh.set_dec(ddh);
+}
+
+/// Body of sla::fk52h_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void fk52h_batch_kernel(int n, const double* r5, const double* d5, const double* dr5,
+    const double* dd5, double* rh, double* dh, double* drh, double* ddh) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    // FK5 to Hipparcos orientation matrix and spin vector
+    const HipparcosFrame& frame = get_hipparcos_frame();
+    const Matrix<double>& r5h = frame.hf_r5h;
+    const Vector<double>& s5 = frame.hf_s5;
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // FK5 and Hipparcos position/velocity 6-vectors
+        double pv5[6][CHUNK], pvh[6][CHUNK];
+
+        // FK5 barycentric position/velocity 6-vectors (normalized)
+        for (int k = 0; k < count; k++) {
+            SphericalPV<double> spv;
+            spv.set_ra(r5[base + k]);
+            spv.set_dec(d5[base + k]);
+            spv.set_dist(1.0);
+            spv.set_dra(dr5[base + k]);
+            spv.set_ddec(dd5[base + k]);
+            spv.set_ddist(0.0);
+            VectorPV<double> pv;
+            ds2c6(spv, pv);
+            for (int j = 0; j < 3; j++) {
+                pv5[j][k] = pv.get_position()[j];
+                pv5[j + 3][k] = pv.get_velocity()[j];
+            }
+        }
+
+        for (int k = 0; k < count; k++) {
+            // orient the position into the Hipparcos frame
+            for (int j = 0; j < 3; j++) {
+                pvh[j][k] = r5h[j][0] * pv5[0][k] + r5h[j][1] * pv5[1][k] + r5h[j][2] * pv5[2][k];
+            }
+
+            // apply spin to the position giving an extra space motion component
+            const double vv0 = pv5[3][k] + (pv5[1][k] * s5[2] - pv5[2][k] * s5[1]);
+            const double vv1 = pv5[4][k] + (pv5[2][k] * s5[0] - pv5[0][k] * s5[2]);
+            const double vv2 = pv5[5][k] + (pv5[0][k] * s5[1] - pv5[1][k] * s5[0]);
+
+            // orient the space motion into the Hipparcos frame
+            for (int j = 0; j < 3; j++) {
+                pvh[j + 3][k] = r5h[j][0] * vv0 + r5h[j][1] * vv1 + r5h[j][2] * vv2;
+            }
+        }
+
+        // Hipparcos 6-vectors to spherical
+        for (int k = 0; k < count; k++) {
+            const Vector<double> p = {pvh[0][k], pvh[1][k], pvh[2][k]};
+            const Vector<double> v = {pvh[3][k], pvh[4][k], pvh[5][k]};
+            SphericalPV<double> spv;
+            dc62s(VectorPV<double>(p, v), spv);
+            rh[base + k] = dranrm(spv.get_ra());
+            dh[base + k] = spv.get_dec();
+            drh[base + k] = spv.get_dra();
+            ddh[base + k] = spv.get_ddec();
+        }
+    }
+}
+
+static KernelDispatcher<fk52h_batch_kernel> fk52h_batch_dispatcher("fk52h_batch");
+static const bool fk52h_batch_enlisted = fk52h_batch_dispatcher.enlist();
+
+/**
+ * Transforms FK5 (J2000) data of many stars into the Hipparcos frame (double precision).
+ *
+ * Results are identical to those of the sla::fk52h() function (which is implemented as a batch of one star). The
+ * orientation matrix and spin vector are built only once; stars are processed in chunks, and rotation and spin are
+ * applied in loops over stars that are free of branches and library calls, so compilers can vectorize them. Output
+ * arrays may be the same as input ones.
+ *
+ * @param n Number of stars.
+ * @param r5 J2000.0 FK5 RAs (radians).
+ * @param d5 J2000.0 FK5 Decs (radians).
+ * @param dr5 J2000.0 FK5 proper motions in RA (dRA/dt, radians per Julian year).
+ * @param dd5 J2000.0 FK5 proper motions in Dec (dDec/dt, radians per Julian year).
+ * @param rh Return value: Hipparcos RAs (radians).
+ * @param dh Return value: Hipparcos Decs (radians).
+ * @param drh Return value: Hipparcos proper motions in RA (dRA/dt, radians per Julian year).
+ * @param ddh Return value: Hipparcos proper motions in Dec (dDec/dt, radians per Julian year).
+ */
+void fk52h_batch(int n, const double* r5, const double* d5, const double* dr5, const double* dd5,
+    double* rh, double* dh, double* drh, double* ddh) {
+    fk52h_batch_dispatcher(n, r5, d5, dr5, dd5, rh, dh, drh, ddh);
+}
+
+/// Version of sla::fk52h_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void fk52h_batch(StridedSpan<const double> r5, StridedSpan<const double> d5, StridedSpan<const double> dr5,
+    StridedSpan<const double> dd5, StridedSpan<double> rh, StridedSpan<double> dh, StridedSpan<double> drh,
+    StridedSpan<double> ddh) {
+    span_tiles(r5.get_size(), [](int n, auto... p) { fk52h_batch(n, p...); }, r5, d5, dr5, dd5, rh, dh, drh, ddh);
+}
+
+}
@@ -0,0 +1,111 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include <algorithm>
+
+namespace sla {
+
+/**
+ * Converts a J2000.0 FK5 star position to B1950.0 FK4 assuming zero proper motion and parallax (double precision).
+ *
+ * This function converts star positions from the new, IAU 1976, FK5, Fricke system to the old, Bessel-Newcomb, FK4
+ * system.
+ *
+ * The proper motion in RA is dRA/dt rather than cos(Dec)*dRA/dt.
+ *
+ * Conversion from Julian epoch 2000.0 to Besselian epoch 1950.0 only is provided for. Conversions involving other
+ * epochs will require use of the appropriate precession functions before and after this function is called.
+ *
+ * Unlike in the sla::fk524() function, it is assumed that the star has zero proper motion and parallax in the FK5
+ * system (it is, in other words, a "star" fixed in the inertial frame); its proper motion in the FK4 system is then
+ * fictitious, and is returned so that the FK4 position can be moved to other epochs.
+ *
+ * The position returned by this function is in the B1950.0 FK4 reference system but at Besselian epoch `bepoch`. For
+ * comparison with catalogues the `bepoch` argument will frequently be 1950.0. (In this context the distinction
+ * between Besselian and Julian epoch is insignificant.)
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param dir2000 J2000.0 FK5 RA,Dec (radians).
+ * @param bepoch Besselian epoch (e.g. 1950.0).
+ * @param dir1950 Return value: B1950.0 FK4 RA,Dec at epoch `bepoch` (radians).
+ * @param pm1950 Return value: B1950.0 FK4 proper motions (RA,Dec; radians per tropical year).
+ */
+void fk54z(const Spherical<double>& dir2000, double bepoch, Spherical<double>& dir1950, Spherical<double>& pm1950) {
+    const double r2000 = dir2000.get_ra();
+    const double d2000 = dir2000.get_dec();
+    double r1950, d1950, dr1950, dd1950;
+    fk54z_batch(1, &r2000, &d2000, bepoch, &r1950, &d1950, &dr1950, &dd1950);
+    dir1950.set_ra(r1950);
+    dir1950.set_dec(d1950);
+    pm1950.set_ra(dr1950);
+    pm1950.set_dec(dd1950);
+}
+
+/**
+ * Converts J2000.0 FK5 star positions to B1950.0 FK4 at the same epoch assuming zero proper motion and parallax
+ * (double precision).
+ *
+ * Results are identical to those of the sla::fk54z() function (which is implemented as a batch of one star); stars
+ * are converted by sla::fk524_batch(), in chunks. Output arrays may be the same as input ones.
+ *
+ * @param n Number of stars.
+ * @param r2000 J2000.0 FK5 RAs (radians).
+ * @param d2000 J2000.0 FK5 Decs (radians).
+ * @param bepoch Besselian epoch (e.g. 1950.0).
+ * @param r1950 Return value: B1950.0 FK4 RAs at epoch `bepoch` (radians).
+ * @param d1950 Return value: B1950.0 FK4 Decs at epoch `bepoch` (radians).
+ * @param dr1950 Return value: B1950.0 FK4 proper motions in RA (radians per tropical year).
+ * @param dd1950 Return value: B1950.0 FK4 proper motions in Dec (radians per tropical year).
+ */
+void fk54z_batch(int n, const double* r2000, const double* d2000, double bepoch,
+    double* r1950, double* d1950, double* dr1950, double* dd1950) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    // zero proper motions, parallaxes, and radial velocities
+    static const double ZERO[CHUNK] = {};
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // FK5 equinox J2000 (any epoch) to FK4 equinox B1950 epoch B1950
+        double px[CHUNK], rv[CHUNK];
+        fk524_batch(count, r2000 + base, d2000 + base, ZERO, ZERO, ZERO, ZERO,
+            r1950 + base, d1950 + base, dr1950 + base, dd1950 + base, px, rv);
+
+        // fictitious proper motion to epoch `bepoch`
+        for (int k = base; k < base + count; k++) {
+            Spherical<double> dir;
+            pm({r1950[k], d1950[k]}, {dr1950[k], dd1950[k]}, 0.0, 0.0, 1950.0, bepoch, dir);
+            r1950[k] = dir.get_ra();
+            d1950[k] = dir.get_dec();
+        }
+    }
+}
+
+/// Version of sla::fk54z_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void fk54z_batch(StridedSpan<const double> r2000, StridedSpan<const double> d2000, double bepoch,
+    StridedSpan<double> r1950, StridedSpan<double> d1950, StridedSpan<double> dr1950, StridedSpan<double> dd1950) {
+    span_tiles(r2000.get_size(), [&](int n, auto r2000, auto d2000, auto r1950, auto d1950, auto dr1950, auto dd1950) {
+        fk54z_batch(n, r2000, d2000, bepoch, r1950, d1950, dr1950, dd1950);
+    }, r2000, d2000, r1950, d1950, dr1950, dd1950);
+}
+
+}
@@ -0,0 +1,143 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "hipparcos.h"
+#include "dispatch.h"
+#include <algorithm>
+
+namespace sla {
+
+/**
+ * Transforms an FK5 (J2000) star position into the frame of the Hipparcos catalogue, assuming zero Hipparcos proper
+ * motion (double precision).
+ *
+ * This function converts a star position from the FK5 system to the ICRS-based Hipparcos system, in such a way that
+ * the Hipparcos proper motion is zero. The FK5 position is at the specified epoch; in contrast to sla::fk52h(), the
+ * FK5 proper motion, parallax and radial velocity are presumed zero.
+ *
+ * The FK5 to Hipparcos transformation consists of a pure rotation and spin; zonal errors in the FK5 catalogue are not
+ * taken into account.
+ *
+ * The published orientation and spin components are interpreted as "axial vectors". An axial vector points at the
+ * pole of the rotation and its length is the amount of rotation in radians.
+ *
+ * See also sla::fk52h(), sla::h2fk5(), sla::hfk5z().
+ *
+ * Reference: F.Mignard & M.Froeschle, Astron. Astrophys. 354, 732-739 (2000).
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param dir5 FK5 RA,Dec (radians), equinox J2000, at epoch `epoch`.
+ * @param epoch Julian epoch (TDB).
+ * @param dirh Return value: Hipparcos RA,Dec (radians).
+ */
+void fk5hz(const Spherical<double>& dir5, double epoch, Spherical<double>& dirh) {
+    const double r5 = dir5.get_ra();
+    const double d5 = dir5.get_dec();
+    double rh, dh;
+    fk5hz_batch(1, &r5, &d5, epoch, &rh, &dh);
+    dirh.set_ra(rh);
+    dirh.set_dec(dh);
+}
+
+/// Body of sla::fk5hz_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void fk5hz_batch_kernel(int n, const double* r5, const double* d5, double epoch, double* rh,
+    double* dh) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    // accumulated Hipparcos wrt FK5 spin over the interval from epoch to J2000, as a rotation matrix
+    const HipparcosFrame& frame = get_hipparcos_frame();
+    Matrix<double> rst;
+    frame.get_spin_matrix(2000.0 - epoch, rst);
+
+    // rotation matrix: de-spin to J2000, then FK5 to Hipparcos
+    Matrix<double> rot;
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            rot[i][j] = frame.hf_r5h[i][0] * rst[j][0] + frame.hf_r5h[i][1] * rst[j][1] +
+                frame.hf_r5h[i][2] * rst[j][2];
+        }
+    }
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // FK5 and Hipparcos position vectors
+        double p5[3][CHUNK], ph[3][CHUNK];
+
+        // the FK5 barycentric position vectors
+        for (int k = 0; k < count; k++) {
+            Vector<double> p;
+            dcs2c({r5[base + k], d5[base + k]}, p);
+            for (int j = 0; j < 3; j++) {
+                p5[j][k] = p[j];
+            }
+        }
+
+        // de-spin and rotate into the Hipparcos frame
+        for (int j = 0; j < 3; j++) {
+            for (int k = 0; k < count; k++) {
+                ph[j][k] = rot[j][0] * p5[0][k] + rot[j][1] * p5[1][k] + rot[j][2] * p5[2][k];
+            }
+        }
+
+        // Hipparcos vectors to spherical
+        for (int k = 0; k < count; k++) {
+            const Vector<double> p = {ph[0][k], ph[1][k], ph[2][k]};
+            Spherical<double> dir;
+            dcc2s(p, dir);
+            rh[base + k] = dranrm(dir.get_ra());
+            dh[base + k] = dir.get_dec();
+        }
+    }
+}
+
+static KernelDispatcher<fk5hz_batch_kernel> fk5hz_batch_dispatcher("fk5hz_batch");
+static const bool fk5hz_batch_enlisted = fk5hz_batch_dispatcher.enlist();
+
+/**
+ * Transforms FK5 (J2000) positions of many stars observed at the same epoch into the frame of the Hipparcos
+ * catalogue, assuming zero Hipparcos proper motion (double precision).
+ *
+ * Results are identical to those of the sla::fk5hz() function (which is implemented as a batch of one star). The
+ * accumulated spin and the orientation are combined into a single rotation matrix only once per batch; stars are
+ * processed in chunks, and the rotation is applied in a loop over stars that compilers can vectorize. Output arrays may
+ * be the same as input ones.
+ *
+ * @param n Number of stars.
+ * @param r5 FK5 RAs (radians), equinox J2000, at epoch `epoch`.
+ * @param d5 FK5 Decs (radians), equinox J2000, at epoch `epoch`.
+ * @param epoch Julian epoch (TDB).
+ * @param rh Return value: Hipparcos RAs (radians).
+ * @param dh Return value: Hipparcos Decs (radians).
+ */
+void fk5hz_batch(int n, const double* r5, const double* d5, double epoch, double* rh, double* dh) {
+    fk5hz_batch_dispatcher(n, r5, d5, epoch, rh, dh);
+}
+
+/// Version of sla::fk5hz_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void fk5hz_batch(StridedSpan<const double> r5, StridedSpan<const double> d5, double epoch, StridedSpan<double> rh,
+    StridedSpan<double> dh) {
+    span_tiles(r5.get_size(), [&](int n, auto r5, auto d5, auto rh, auto dh) {
+        fk5hz_batch(n, r5, d5, epoch, rh, dh);
+    }, r5, d5, rh, dh);
+}
+
+}
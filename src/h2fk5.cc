@@ -0,0 +1,157 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "hipparcos.h"
+#include "dispatch.h"
+#include <algorithm>
+
+namespace sla {
+
+/**
+ * Transforms Hipparcos star data into the FK5 (J2000) frame (double precision).
+ *
+ * The proper motions in RA are dRA/dt rather than cos(Dec)*dRA/dt, and are per year rather than per century.
+ *
+ * The FK5 to Hipparcos transformation consists of a pure rotation and spin; zonal errors in the FK5 catalogue are not
+ * taken into account.
+ *
+ * See also sla::fk52h(), sla::fk5hz(), sla::hfk5z().
+ *
+ * Reference: F.Mignard & M.Froeschle, Astron. Astrophys. 354, 732-739 (2000).
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param dirh Hipparcos RA,Dec (radians).
+ * @param pmh Hipparcos proper motions (RA,Dec; radians per Julian year).
+ * @param dir5 Return value: J2000.0 FK5 RA,Dec (radians).
+ * @param pm5 Return value: J2000.0 FK5 proper motions (RA,Dec; radians per Julian year).
+ */
+void h2fk5(const Spherical<double>& dirh, const Spherical<double>& pmh, Spherical<double>& dir5,
+    Spherical<double>& pm5) {
+    const double rh = dirh.get_ra();
+    const double dh = dirh.get_dec();
+    const double drh = pmh.get_ra();
+    const double ddh = pmh.get_dec();
+    double r5, d5, dr5, dd5;
+    h2fk5_batch(1, &rh, &dh, &drh, &ddh, &r5, &d5, &dr5, &dd5);
+    dir5.set_ra(r5);
+    dir5.set_dec(d5);
+    pm5.set_ra(dr5);
+    pm5.set_dec(dd5);
+}
+
+/// Body of sla::h2fk5_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void h2fk5_batch_kernel(int n, const double* rh, const double* dh, const double* drh,
+    const double* ddh, double* r5, double* d5, double* dr5, double* dd5) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    // FK5 to Hipparcos orientation matrix, and Hipparcos wrt FK5 spin vector in the Hipparcos frame
+    const HipparcosFrame& frame = get_hipparcos_frame();
+    const Matrix<double>& r5h = frame.hf_r5h;
+    const Vector<double>& sh = frame.hf_sh;
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // Hipparcos and FK5 position/velocity 6-vectors
+        double pvh[6][CHUNK], pv5[6][CHUNK];
+
+        // Hipparcos barycentric position/velocity 6-vectors (normalized)
+        for (int k = 0; k < count; k++) {
+            SphericalPV<double> spv;
+            spv.set_ra(rh[base + k]);
+            spv.set_dec(dh[base + k]);
+            spv.set_dist(1.0);
+            spv.set_dra(drh[base + k]);
+            spv.set_ddec(ddh[base + k]);
+            spv.set_ddist(0.0);
+            VectorPV<double> pv;
+            ds2c6(spv, pv);
+            for (int j = 0; j < 3; j++) {
+                pvh[j][k] = pv.get_position()[j];
+                pvh[j + 3][k] = pv.get_velocity()[j];
+            }
+        }
+
+        for (int k = 0; k < count; k++) {
+            // de-orient the Hipparcos position into the FK5 frame
+            for (int j = 0; j < 3; j++) {
+                pv5[j][k] = r5h[0][j] * pvh[0][k] + r5h[1][j] * pvh[1][k] + r5h[2][j] * pvh[2][k];
+            }
+
+            // apply spin to the position giving an extra space motion component, and subtract it
+            const double vv0 = pvh[3][k] - (pvh[1][k] * sh[2] - pvh[2][k] * sh[1]);
+            const double vv1 = pvh[4][k] - (pvh[2][k] * sh[0] - pvh[0][k] * sh[2]);
+            const double vv2 = pvh[5][k] - (pvh[0][k] * sh[1] - pvh[1][k] * sh[0]);
+
+            // de-orient the Hipparcos space motion into the FK5 frame
+            for (int j = 0; j < 3; j++) {
+                pv5[j + 3][k] = r5h[0][j] * vv0 + r5h[1][j] * vv1 + r5h[2][j] * vv2;
+            }
+        }
+
+        // FK5 6-vectors to spherical
+        for (int k = 0; k < count; k++) {
+            const Vector<double> p = {pv5[0][k], pv5[1][k], pv5[2][k]};
+            const Vector<double> v = {pv5[3][k], pv5[4][k], pv5[5][k]};
+            SphericalPV<double> spv;
+            dc62s(VectorPV<double>(p, v), spv);
+            r5[base + k] = dranrm(spv.get_ra());
+            d5[base + k] = spv.get_dec();
+            dr5[base + k] = spv.get_dra();
+            dd5[base + k] = spv.get_ddec();
+        }
+    }
+}
+
+static KernelDispatcher<h2fk5_batch_kernel> h2fk5_batch_dispatcher("h2fk5_batch");
+static const bool h2fk5_batch_enlisted = h2fk5_batch_dispatcher.enlist();
+
+/**
+ * Transforms Hipparcos data of many stars into the FK5 (J2000) frame (double precision).
+ *
+ * Results are identical to those of the sla::h2fk5() function (which is implemented as a batch of one star). The
+ * orientation matrix and spin vector are built only once; stars are processed in chunks, and rotation and spin are
+ * applied in loops over stars that are free of branches and library calls, so compilers can vectorize them. Output
+ * arrays may be the same as input ones.
+ *
+ * @param n Number of stars.
+ * @param rh Hipparcos RAs (radians).
+ * @param dh Hipparcos Decs (radians).
+ * @param drh Hipparcos proper motions in RA (dRA/dt, radians per Julian year).
+ * @param ddh Hipparcos proper motions in Dec (dDec/dt, radians per Julian year).
+ * @param r5 Return value: J2000.0 FK5 RAs (radians).
+ * @param d5 Return value: J2000.0 FK5 Decs (radians).
+ * @param dr5 Return value: J2000.0 FK5 proper motions in RA (dRA/dt, radians per Julian year).
+ * @param dd5 Return value: J2000.0 FK5 proper motions in Dec (dDec/dt, radians per Julian year).
+ */
+void h2fk5_batch(int n, const double* rh, const double* dh, const double* drh, const double* ddh,
+    double* r5, double* d5, double* dr5, double* dd5) {
+    h2fk5_batch_dispatcher(n, rh, dh, drh, ddh, r5, d5, dr5, dd5);
+}
+
+/// Version of sla::h2fk5_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void h2fk5_batch(StridedSpan<const double> rh, StridedSpan<const double> dh, StridedSpan<const double> drh,
+    StridedSpan<const double> ddh, StridedSpan<double> r5, StridedSpan<double> d5, StridedSpan<double> dr5,
+    StridedSpan<double> dd5) {
+    span_tiles(rh.get_size(), [](int n, auto... p) { h2fk5_batch(n, p...); }, rh, dh, drh, ddh, r5, d5, dr5, dd5);
+}
+
+}
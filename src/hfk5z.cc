@@ -0,0 +1,156 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "hipparcos.h"
+#include "dispatch.h"
+#include <algorithm>
+
+namespace sla {
+
+/**
+ * Transforms a Hipparcos star position into FK5 J2000, assuming zero Hipparcos proper motion (double precision).
+ *
+ * The proper motion in RA is dRA/dt rather than cos(Dec)*dRA/dt.
+ *
+ * The FK5 to Hipparcos transformation consists of a pure rotation and spin; zonal errors in the FK5 catalogue are not
+ * taken into account.
+ *
+ * The published orientation and spin components are interpreted as "axial vectors". An axial vector points at the
+ * pole of the rotation and its length is the amount of rotation in radians.
+ *
+ * It was the intention that Hipparcos should be a close approximation to an inertial frame, so that distant objects
+ * have zero proper motion; such objects have (in general) non-zero proper motion in FK5, and this function returns
+ * those fictitious proper motions.
+ *
+ * The position returned by this function is in the FK5 J2000 reference system but at epoch `epoch`.
+ *
+ * See also sla::fk52h(), sla::h2fk5(), sla::fk5hz().
+ *
+ * Reference: F.Mignard & M.Froeschle, Astron. Astrophys. 354, 732-739 (2000).
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param dirh Hipparcos RA,Dec (radians).
+ * @param epoch Julian epoch (TDB).
+ * @param dir5 Return value: FK5 RA,Dec (radians), equinox J2000, at epoch `epoch`.
+ * @param pm5 Return value: FK5 proper motions (RA,Dec; dRA/dt and dDec/dt, radians per Julian year).
+ */
+void hfk5z(const Spherical<double>& dirh, double epoch, Spherical<double>& dir5, Spherical<double>& pm5) {
+    const double rh = dirh.get_ra();
+    const double dh = dirh.get_dec();
+    double r5, d5, dr5, dd5;
+    hfk5z_batch(1, &rh, &dh, epoch, &r5, &d5, &dr5, &dd5);
+    dir5.set_ra(r5);
+    dir5.set_dec(d5);
+    pm5.set_ra(dr5);
+    pm5.set_dec(dd5);
+}
+
+/// Body of sla::hfk5z_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void hfk5z_batch_kernel(int n, const double* rh, const double* dh, double epoch,
+    double* r5, double* d5, double* dr5, double* dd5) {
+    // number of stars processed together
+    constexpr int CHUNK = 64;
+
+    // accumulated Hipparcos wrt FK5 spin over the interval from J2000 to epoch, as a rotation matrix
+    const HipparcosFrame& frame = get_hipparcos_frame();
+    const Vector<double>& sh = frame.hf_sh;
+    Matrix<double> rst, r5ht;
+    frame.get_spin_matrix(epoch - 2000.0, rst);
+
+    // rotation matrix: accumulated spin, then FK5 to Hipparcos
+    dmxm(frame.hf_r5h, rst, r5ht);
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // Hipparcos position vectors, and FK5 position/velocity 6-vectors
+        double ph[3][CHUNK], pv5[6][CHUNK];
+
+        // the Hipparcos barycentric position vectors (normalized)
+        for (int k = 0; k < count; k++) {
+            Vector<double> p;
+            dcs2c({rh[base + k], dh[base + k]}, p);
+            for (int j = 0; j < 3; j++) {
+                ph[j][k] = p[j];
+            }
+        }
+
+        for (int k = 0; k < count; k++) {
+            // apply spin to the position giving a space motion
+            const double vv0 = sh[1] * ph[2][k] - sh[2] * ph[1][k];
+            const double vv1 = sh[2] * ph[0][k] - sh[0] * ph[2][k];
+            const double vv2 = sh[0] * ph[1][k] - sh[1] * ph[0][k];
+
+            // de-orient and de-spin the Hipparcos position and space motion into FK5 J2000
+            for (int j = 0; j < 3; j++) {
+                pv5[j][k] = r5ht[0][j] * ph[0][k] + r5ht[1][j] * ph[1][k] + r5ht[2][j] * ph[2][k];
+                pv5[j + 3][k] = r5ht[0][j] * vv0 + r5ht[1][j] * vv1 + r5ht[2][j] * vv2;
+            }
+        }
+
+        // FK5 6-vectors to spherical
+        for (int k = 0; k < count; k++) {
+            const Vector<double> p = {pv5[0][k], pv5[1][k], pv5[2][k]};
+            const Vector<double> v = {pv5[3][k], pv5[4][k], pv5[5][k]};
+            SphericalPV<double> spv;
+            dc62s(VectorPV<double>(p, v), spv);
+            r5[base + k] = dranrm(spv.get_ra());
+            d5[base + k] = spv.get_dec();
+            dr5[base + k] = spv.get_dra();
+            dd5[base + k] = spv.get_ddec();
+        }
+    }
+}
+
+static KernelDispatcher<hfk5z_batch_kernel> hfk5z_batch_dispatcher("hfk5z_batch");
+static const bool hfk5z_batch_enlisted = hfk5z_batch_dispatcher.enlist();
+
+/**
+ * Transforms Hipparcos positions of many stars into FK5 J2000 at the same epoch, assuming zero Hipparcos proper
+ * motion (double precision).
+ *
+ * Results are identical to those of the sla::hfk5z() function (which is implemented as a batch of one star). The
+ * combined orientation and accumulated spin matrix is built only once per batch; stars are processed in chunks, and
+ * rotation and spin are applied in loops over stars that compilers can vectorize. Output arrays may be the same as
+ * input ones.
+ *
+ * @param n Number of stars.
+ * @param rh Hipparcos RAs (radians).
+ * @param dh Hipparcos Decs (radians).
+ * @param epoch Julian epoch (TDB).
+ * @param r5 Return value: FK5 RAs (radians), equinox J2000, at epoch `epoch`.
+ * @param d5 Return value: FK5 Decs (radians), equinox J2000, at epoch `epoch`.
+ * @param dr5 Return value: FK5 proper motions in RA (dRA/dt, radians per Julian year).
+ * @param dd5 Return value: FK5 proper motions in Dec (dDec/dt, radians per Julian year).
+ */
+void hfk5z_batch(int n, const double* rh, const double* dh, double epoch,
+    double* r5, double* d5, double* dr5, double* dd5) {
+    hfk5z_batch_dispatcher(n, rh, dh, epoch, r5, d5, dr5, dd5);
+}
+
+/// Version of sla::hfk5z_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void hfk5z_batch(StridedSpan<const double> rh, StridedSpan<const double> dh, double epoch, StridedSpan<double> r5,
+    StridedSpan<double> d5, StridedSpan<double> dr5, StridedSpan<double> dd5) {
+    span_tiles(rh.get_size(), [&](int n, auto rh, auto dh, auto r5, auto d5, auto dr5, auto dd5) {
+        hfk5z_batch(n, rh, dh, epoch, r5, d5, dr5, dd5);
+    }, rh, dh, r5, d5, dr5, dd5);
+}
+
+}
@@ -0,0 +1,152 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "simd.h"
+#include <cmath>
+
+namespace sla {
+
+/*
+ * The batch methods run the kernels from `kernels.h` over SIMD packs (see `simd.h`); arc tangents are computed by
+ * `kernel::arctan2()`, which, unlike `std::atan2()`, vectorizes, so no step of the loops falls back to scalar calls.
+ */
+
+/**
+ * Creates horizon frame for an observing site.
+ *
+ * @param phi Observatory latitude, in radians; not range-checked; must be geodetic; in critical applications,
+ *   corrections for polar motion should be applied.
+ */
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+HorizonFrame<T, E>::HorizonFrame(T phi) {
+    hf_sin_phi = std::sin(phi);
+    hf_cos_phi = std::cos(phi);
+}
+
+/**
+ * Converts equatorial coordinates to horizon coordinates: HA,Dec to Az,El (see sla::e2h() and sla::de2h()).
+ *
+ * @param n Number of targets.
+ * @param ha Hour angles (radians); not range-checked.
+ * @param dec Declinations (radians); not range-checked.
+ * @param azimuth Output: azimuths; returned in the range 0-2Pi; north is zero, and east is +Pi/2.
+ * @param elevation Output: elevations; returned in the range +/-Pi/2.
+ */
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::e2h(int n, const T* ha, const T* dec, T* azimuth, T* elevation) const {
+    lane_loop<T>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V a, b;
+        kernel::e2h(hf_sin_phi, hf_cos_phi, lane_load<V>(ha + i), lane_load<V>(dec + i), a, b);
+        lane_store(a, azimuth + i);
+        lane_store(b, elevation + i);
+    });
+}
+
+/**
+ * Converts horizon coordinates to equatorial coordinates: Az,El to HA,Dec (see sla::h2e() and sla::dh2e()).
+ *
+ * @param n Number of targets.
+ * @param azimuth Azimuths (radians); not range-checked; north is zero, and east is +Pi/2.
+ * @param elevation Elevations (radians); not range-checked.
+ * @param ha Output: hour angles; returned in the range +/-Pi.
+ * @param dec Output: declinations; returned in the range +/-Pi/2.
+ */
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::h2e(int n, const T* azimuth, const T* elevation, T* ha, T* dec) const {
+    lane_loop<T>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V a, b;
+        kernel::h2e(hf_sin_phi, hf_cos_phi, lane_load<V>(azimuth + i), lane_load<V>(elevation + i), a, b);
+        lane_store(a, ha + i);
+        lane_store(b, dec + i);
+    });
+}
+
+/**
+ * Calculates zenith distances from HA,Dec (see sla::zd()).
+ *
+ * @param n Number of targets.
+ * @param ha Hour angles (radians); not range-checked.
+ * @param dec Declinations (radians); not range-checked.
+ * @param zd Output: zenith distances, in the range [0..pi].
+ */
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::zd(int n, const T* ha, const T* dec, T* zd) const {
+    lane_loop<T>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        lane_store(kernel::zd(hf_sin_phi, hf_cos_phi, lane_load<V>(ha + i), lane_load<V>(dec + i)), zd + i);
+    });
+}
+
+/**
+ * Calculates parallactic angles from HA,Dec (see sla::pa()).
+ *
+ * @param n Number of targets.
+ * @param ha Hour angles (radians); not range-checked.
+ * @param dec Declinations (radians); not range-checked.
+ * @param pa Output: parallactic angles (radians, range: [-pi..pi]); positive for a star west of the meridian.
+ */
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::pa(int n, const T* ha, const T* dec, T* pa) const {
+    lane_loop<T>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        lane_store(kernel::pa(hf_sin_phi, hf_cos_phi, lane_load<V>(ha + i), lane_load<V>(dec + i)), pa + i);
+    });
+}
+
+/// Version of sla::HorizonFrame::e2h() that accesses items through strided spans of the same size.
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::e2h(StridedSpan<const T> ha, StridedSpan<const T> dec, StridedSpan<T> azimuth,
+    StridedSpan<T> elevation) const {
+    span_tiles(ha.get_size(), [this](int n, auto ha, auto dec, auto azimuth, auto elevation) {
+        e2h(n, ha, dec, azimuth, elevation);
+    }, ha, dec, azimuth, elevation);
+}
+
+/// Version of sla::HorizonFrame::h2e() that accesses items through strided spans of the same size.
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::h2e(StridedSpan<const T> azimuth, StridedSpan<const T> elevation, StridedSpan<T> ha,
+    StridedSpan<T> dec) const {
+    span_tiles(azimuth.get_size(), [this](int n, auto azimuth, auto elevation, auto ha, auto dec) {
+        h2e(n, azimuth, elevation, ha, dec);
+    }, azimuth, elevation, ha, dec);
+}
+
+/// Version of sla::HorizonFrame::zd() that accesses items through strided spans of the same size.
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::zd(StridedSpan<const T> ha, StridedSpan<const T> dec, StridedSpan<T> zd) const {
+    span_tiles(ha.get_size(), [this](int n, auto ha, auto dec, auto zd) {
+        this->zd(n, ha, dec, zd);
+    }, ha, dec, zd);
+}
+
+/// Version of sla::HorizonFrame::pa() that accesses items through strided spans of the same size.
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> E>
+void HorizonFrame<T, E>::pa(StridedSpan<const T> ha, StridedSpan<const T> dec, StridedSpan<T> pa) const {
+    span_tiles(ha.get_size(), [this](int n, auto ha, auto dec, auto pa) {
+        this->pa(n, ha, dec, pa);
+    }, ha, dec, pa);
+}
+
+// supported instantiations
+template class HorizonFrame<float>;
+template class HorizonFrame<double>;
+
+}
@@ -0,0 +1,72 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_HIPPARCOS_H_INCLUDED
+#define SLALIB_HIPPARCOS_H_INCLUDED
+
+#include "slalib.h"
+
+namespace sla {
+
+/**
+ * Orientation and spin of the Hipparcos frame with respect to FK5 (J2000), as published by Mignard & Froeschle
+ * (2000), Astron. Astrophys. 354, 732-739.
+ *
+ * The orientation matrix is built (by sla::dav2m()) only once, on first use; all FK5<->Hipparcos conversion functions
+ * share the single instance returned by get_hipparcos_frame().
+ */
+struct HipparcosFrame {
+    Matrix<double> hf_r5h; ///< FK5 to Hipparcos orientation matrix
+    Vector<double> hf_s5;  ///< Hipparcos wrt FK5 spin vector, in FK5 axes (radians per Julian year)
+    Vector<double> hf_sh;  ///< Hipparcos wrt FK5 spin vector, in Hipparcos axes (radians per Julian year)
+
+    HipparcosFrame() {
+        // arcseconds to radians
+        constexpr double AS2R = 0.484813681109535994e-5;
+
+        // FK5 to Hipparcos orientation (radians)
+        const Vector<double> ortn = {-19.9e-3 * AS2R, -9.1e-3 * AS2R, +22.9e-3 * AS2R};
+        dav2m(ortn, hf_r5h);
+
+        // Hipparcos wrt FK5 spin (radians per year)
+        hf_s5[0] = -0.30e-3 * AS2R;
+        hf_s5[1] = +0.60e-3 * AS2R;
+        hf_s5[2] = +0.70e-3 * AS2R;
+        dmxv(hf_r5h, hf_s5, hf_sh);
+    }
+
+    /**
+     * Computes rotation matrix accumulated by the spin over a time interval.
+     *
+     * @param t Time interval (Julian years).
+     * @param rst Output: rotation matrix.
+     */
+    void get_spin_matrix(double t, Matrix<double> rst) const {
+        const Vector<double> vst = {hf_s5[0] * t, hf_s5[1] * t, hf_s5[2] * t};
+        dav2m(vst, rst);
+    }
+};
+
+/// Returns shared FK5 to Hipparcos orientation and spin data, initializing them (in a thread-safe manner) on first use.
+inline const HipparcosFrame& get_hipparcos_frame() {
+    static const HipparcosFrame frame;
+    return frame;
+}
+
+} // sla
+
+#endif // SLALIB_HIPPARCOS_H_INCLUDED
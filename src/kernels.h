@@ -0,0 +1,398 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_KERNELS_H_INCLUDED
+#define SLALIB_KERNELS_H_INCLUDED
+
+#include <cmath>
+#include <type_traits>
+
+/*
+ * This header is included by `slalib.h`, and relies on the types declared there; it is not meant to be included
+ * directly.
+ *
+ * Computational cores of the routines that come in single and double precision pairs. Every kernel is a template
+ * over value type `V`, which can be `float`, `double`, or any other floating point type, or a SIMD pack of those
+ * (see `simd.h`); the public functions (e.g. `sla::cs2c()` and `sla::dcs2c()`) are instantiations for `float` and
+ * `double`, and their batch forms (e.g. `sla::cs2c_batch()`) instantiate the same kernels for packs.
+ *
+ * Math functions are called unqualified, so that overloads for packs are found by argument-dependent lookup;
+ * conditionals are expressed with `lane_select()`. Constants are converted to the element type explicitly, as packs
+ * do not accept conversions that lose precision.
+ */
+namespace sla {
+
+/**
+ * Properties of a value type the kernels can be instantiated with: a floating-point scalar here, and a SIMD pack in
+ * the specializations found in `simd.h`.
+ */
+template <typename V>
+struct LaneTraits {
+    static_assert(std::is_floating_point<V>::value, "kernels can only be instantiated with floating point types");
+    using scalar = V;
+    static constexpr int width = 1;
+
+    static constexpr V select(bool mask, V a, V b) { return mask? a: b; }
+};
+
+/// Element type of the value type `V`.
+template <typename V>
+using lane_scalar_t = typename LaneTraits<V>::scalar;
+
+/// Per-lane `mask? a: b`; dispatched through `LaneTraits`, so that specializations declared later are picked up.
+template <typename M, typename V>
+constexpr V lane_select(const M& mask, const V& a, const V& b) {
+    return LaneTraits<V>::select(mask, a, b);
+}
+
+namespace kernel {
+
+using std::atan2;
+using std::copysign;
+using std::cos;
+using std::fabs;
+using std::floor;
+using std::fmod;
+using std::signbit;
+using std::sin;
+using std::sqrt;
+
+/**
+ * Arc tangent of `t` in [0..1], as a polynomial (single precision) or a rational function (double precision) from
+ * the Cephes library; accurate to about one ulp, and branch-free, so that it vectorizes where `std::atan()` does not.
+ */
+template <typename V>
+inline V arctan_unit(V t) {
+    using T = lane_scalar_t<V>;
+    constexpr T PI_OVER_4 = T(0.785398163397448309615660845819875721L);
+    if constexpr (std::is_same<T, float>::value) {
+        // reduction about tan(pi/8)
+        const auto high = t > T(0.4142135623730950);
+        const V x = lane_select(high, (t - T(1)) / (t + T(1)), t);
+        const V z = x * x;
+        const V p = (((T(8.05374449538e-2) * z - T(1.38776856032e-1)) * z + T(1.99777106478e-1)) * z -
+            T(3.33329491539e-1)) * z * x + x;
+        return lane_select(high, p + PI_OVER_4, p);
+    } else {
+        // reduction about 0.66, with the low part of pi/4 added separately
+        constexpr T MOREBITS = T(6.123233995736765886130e-17);
+        const auto high = t > T(0.66);
+        const V x = lane_select(high, (t - T(1)) / (t + T(1)), t);
+        const V z = x * x;
+        const V p = (((T(-8.750608600031904122785e-1) * z - T(1.615753718733365076637e1)) * z -
+            T(7.500855792314704667340e1)) * z - T(1.228866684490136173410e2)) * z - T(6.485021904942025371773e1);
+        const V q = ((((z + T(2.485846490142306297962e1)) * z + T(1.650270098316988542046e2)) * z +
+            T(4.328810604912902668951e2)) * z + T(4.853903996359136964868e2)) * z + T(1.945506571482613964425e2);
+        const V r = x * (z * p / q) + x;
+        return lane_select(high, r + T(0.5) * MOREBITS + PI_OVER_4, r);
+    }
+}
+
+/**
+ * Four-quadrant arc tangent of `y`/`x`, with the same conventions as `std::atan2()` for finite arguments (including
+ * signed zeros); built on `arctan_unit()`, so that it vectorizes where `std::atan2()` does not.
+ */
+template <typename V>
+inline V arctan2(V y, V x) {
+    using T = lane_scalar_t<V>;
+    constexpr T PI = T(3.141592653589793238462643L);
+    constexpr T PI_OVER_2 = T(1.570796326794896619231322L);
+    const V ax = fabs(x);
+    const V ay = fabs(y);
+    const auto steep = ay > ax;
+    const V num = lane_select(steep, ax, ay);
+    const V den = lane_select(steep, ay, ax);
+    const V a = arctan_unit(lane_select(den == T(0), V(T(0)), num / lane_select(den == T(0), V(T(1)), den)));
+    const V b = lane_select(steep, PI_OVER_2 - a, a);
+    return copysign(lane_select(signbit(x), PI - b, b), y);
+}
+
+/**
+ * Sine and cosine of `x`, with the argument reduction and polynomials of the Cephes library; accurate to about one ulp
+ * for |x| up to about 1e9 (double precision) or 8192 (single precision), and branch-free, so that each pack lane gets
+ * exactly the result of a scalar call, which `std::sin()` and `std::cos()` on packs do not guarantee.
+ */
+template <typename V>
+inline void sine_cosine(V x, V& sine, V& cosine) {
+    using T = lane_scalar_t<V>;
+    constexpr T FOUR_OVER_PI = T(1.273239544735162686151070106980114896L);
+    const V ax = fabs(x);
+
+    // octant of `ax`, rounded up to an even one, and remainder within +/- pi/4
+    V y = floor(ax * FOUR_OVER_PI);
+    y = lane_select(fmod(y, V(T(2))) != T(0), y + T(1), y);
+    const V q = fmod(y, V(T(8)));
+    V z, zs, zc;
+    if constexpr (std::is_same<T, float>::value) {
+        z = ((ax - y * T(0.78515625)) - y * T(2.4187564849853515625e-4)) - y * T(3.77489497744594108e-8);
+        const V zz = z * z;
+        zs = ((T(-1.9515295891e-4) * zz + T(8.3321608736e-3)) * zz - T(1.6666654611e-1)) * zz * z + z;
+        zc = ((T(2.443315711809948e-5) * zz - T(1.388731625493765e-3)) * zz + T(4.166664568298827e-2)) * zz * zz -
+            T(0.5) * zz + T(1);
+    } else {
+        z = ((ax - y * T(7.85398125648498535156e-1)) - y * T(3.77489470793079817668e-8)) -
+            y * T(2.69515142907905952645e-15);
+        const V zz = z * z;
+        zs = (((((T(1.58962301576546568060e-10) * zz - T(2.50507477628578072866e-8)) * zz +
+            T(2.75573136213857245213e-6)) * zz - T(1.98412698295895385996e-4)) * zz +
+            T(8.33333333332211858878e-3)) * zz - T(1.66666666666666307295e-1)) * zz * z + z;
+        zc = (((((T(-1.13585365213876817300e-11) * zz + T(2.08757008419747316778e-9)) * zz -
+            T(2.75573141792967388112e-7)) * zz + T(2.48015872888517045348e-5)) * zz -
+            T(1.38888888888730564116e-3)) * zz + T(4.16666666666665929218e-2)) * zz * zz - T(0.5) * zz + T(1);
+    }
+
+    // octants 0, 2, 4, 6: sin(ax) is zs, zc, -zs, -zc; cos(ax) is zc, -zs, -zc, zs
+    const auto odd_quadrant = q == T(2) || q == T(6);
+    const V s = lane_select(odd_quadrant, zc, zs);
+    const V c = lane_select(odd_quadrant, zs, zc);
+    sine = copysign(V(T(1)), x) * lane_select(q >= T(4), -s, s);
+    cosine = lane_select(q == T(2) || q == T(4), -c, c);
+}
+
+/// Spherical to Cartesian coordinates (see `sla::cs2c()`).
+template <typename V>
+inline void cs2c(V a, V b, V& x, V& y, V& z) {
+    V sin_a, cos_a, sin_b, cos_b;
+    sine_cosine(a, sin_a, cos_a);
+    sine_cosine(b, sin_b, cos_b);
+    x = cos_a * cos_b;
+    y = sin_a * cos_b;
+    z = sin_b;
+}
+
+/// Cartesian to spherical coordinates (see `sla::cc2s()`).
+template <typename V>
+inline void cc2s(V x, V y, V z, V& a, V& b) {
+    using T = lane_scalar_t<V>;
+    const V r = sqrt(x * x + y * y);
+    a = lane_select(r == T(0), V(T(0)), atan2(y, x));
+    b = lane_select(z == T(0), V(T(0)), atan2(z, r));
+}
+
+/// Angle normalized into range +/- pi (see `sla::range()`).
+template <typename V>
+inline V range(V angle) {
+    using T = lane_scalar_t<V>;
+    constexpr T PI = T(3.141592653589793238462643L);
+    constexpr T PI2 = T(6.283185307179586476925287L);
+    const V result = fmod(angle, V(PI2));
+    return lane_select(fabs(result) >= PI, result - lane_select(angle >= T(0), V(PI2), V(-PI2)), result);
+}
+
+/// Angle normalized into range 0-2*pi (see `sla::ranorm()`).
+template <typename V>
+inline V ranorm(V angle) {
+    using T = lane_scalar_t<V>;
+    constexpr T A2PI = T(6.283185307179586476925287L);
+    const V result = fmod(angle, V(A2PI));
+    return lane_select(result < T(0), result + A2PI, result);
+}
+
+/// Scalar product of two vectors (see `sla::vdv()`).
+template <typename V>
+constexpr V vdv(V ax, V ay, V az, V bx, V by, V bz) {
+    return ax * bx + ay * by + az * bz;
+}
+
+/// Vector product of two vectors (see `sla::vxv()`); outputs may not alias inputs.
+template <typename V>
+constexpr void vxv(V ax, V ay, V az, V bx, V by, V bz, V& cx, V& cy, V& cz) {
+    cx = ay * bz - az * by;
+    cy = az * bx - ax * bz;
+    cz = ax * by - ay * bx;
+}
+
+/// Normalized vector and its modulus (see `sla::vn()`); outputs may not alias inputs.
+template <typename V>
+inline V vn(V x, V y, V z, V& nx, V& ny, V& nz) {
+    using T = lane_scalar_t<V>;
+    const V modulus = sqrt(x * x + y * y + z * z);
+    const V divisor = lane_select(modulus <= T(0), V(T(1)), modulus);
+    nx = x / divisor;
+    ny = y / divisor;
+    nz = z / divisor;
+    return modulus;
+}
+
+/// Angle between two vectors (see `sla::dsepv()`).
+template <typename V>
+inline V sepv(V ax, V ay, V az, V bx, V by, V bz) {
+    using T = lane_scalar_t<V>;
+    V cx, cy, cz;
+    vxv(ax, ay, az, bx, by, bz, cx, cy, cz);
+    const V s = sqrt(cx * cx + cy * cy + cz * cz);
+    const V c = vdv(ax, ay, az, bx, by, bz);
+    return lane_select(s != T(0) || c != T(0), atan2(s, c), V(T(0)));
+}
+
+/// Angle between two points on a sphere (see `sla::dsep()`).
+template <typename V>
+inline V sep(V aa, V ab, V ba, V bb) {
+    V ax, ay, az, bx, by, bz;
+    cs2c(aa, ab, ax, ay, az);
+    cs2c(ba, bb, bx, by, bz);
+    return sepv(ax, ay, az, bx, by, bz);
+}
+
+/// Vector transformed by a matrix of scalars (see `sla::mxv()`); outputs may not alias inputs.
+template <typename V>
+constexpr void mxv(const lane_scalar_t<V> mat[3][3], V x, V y, V z, V& ox, V& oy, V& oz) {
+    ox = mat[0][0] * x + mat[0][1] * y + mat[0][2] * z;
+    oy = mat[1][0] * x + mat[1][1] * y + mat[1][2] * z;
+    oz = mat[2][0] * x + mat[2][1] * y + mat[2][2] * z;
+}
+
+/// Vector transformed by the transpose of a matrix of scalars (see `sla::imxv()`); outputs may not alias inputs.
+template <typename V>
+constexpr void imxv(const lane_scalar_t<V> mat[3][3], V x, V y, V z, V& ox, V& oy, V& oz) {
+    ox = mat[0][0] * x + mat[1][0] * y + mat[2][0] * z;
+    oy = mat[0][1] * x + mat[1][1] * y + mat[2][1] * z;
+    oz = mat[0][2] * x + mat[1][2] * y + mat[2][2] * z;
+}
+
+/// Product of two matrices (see `sla::mxm()`); the result may not alias either multiplicand.
+template <typename T>
+constexpr void mxm(const T ma[3][3], const T mb[3][3], T mc[3][3]) {
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            mc[i][j] = ma[i][0] * mb[0][j] + ma[i][1] * mb[1][j] + ma[i][2] * mb[2][j];
+        }
+    }
+}
+
+/**
+ * Gnomonic projection onto the tangent plane (see `sla::s2tp()`); the tangent point is given by its RA and the sine
+ * and cosine of its declination. Returns the unclamped denominator, from which `s2tp_status()` derives the status.
+ */
+template <typename V>
+inline V s2tp(V ra, V dec, lane_scalar_t<V> tra, lane_scalar_t<V> sin_tdec, lane_scalar_t<V> cos_tdec,
+    V& xi, V& eta) {
+    using T = lane_scalar_t<V>;
+    constexpr T TINY = T(1e-6);
+    const V sin_dec = sin(dec);
+    const V cos_dec = cos(dec);
+    const V ra_diff = ra - tra;
+    const V sin_ra_diff = sin(ra_diff);
+    const V cos_ra_diff = cos(ra_diff);
+    // reciprocal of star vector length to tangent plane; vectors too far from axis are clamped
+    const V denom = sin_dec * sin_tdec + cos_dec * cos_tdec * cos_ra_diff;
+    const V clamped = lane_select(denom > TINY, denom,
+        lane_select(denom >= T(0), V(TINY), lane_select(denom > -TINY, V(-TINY), denom)));
+    xi = cos_dec * sin_ra_diff / clamped;
+    eta = (sin_dec * cos_tdec - cos_dec * sin_tdec * cos_ra_diff) / clamped;
+    return denom;
+}
+
+/// Status of the projection given the denominator returned by `s2tp()`.
+template <typename T>
+inline TPPStatus s2tp_status(T denom) {
+    constexpr T TINY = T(1e-6);
+    if (denom > TINY) {
+        return TPP_OK;
+    } else if (denom >= T(0)) {
+        return TPP_TOO_FAR;
+    } else if (denom > -TINY) {
+        return TPP_ASTAR_ON_TP;
+    } else {
+        return TPP_ASTAR_TOO_FAR;
+    }
+}
+
+/**
+ * Tangent plane to spherical coordinates (see `sla::tp2s()`); the tangent point is given by its RA and the sine and
+ * cosine of its declination.
+ */
+template <typename V>
+inline void tp2s(V xi, V eta, lane_scalar_t<V> tra, lane_scalar_t<V> sin_tdec, lane_scalar_t<V> cos_tdec,
+    V& ra, V& dec) {
+    const V denom = cos_tdec - eta * sin_tdec;
+    ra = ranorm(atan2(xi, denom) + tra);
+    dec = atan2(sin_tdec + eta * cos_tdec, sqrt(xi * xi + denom * denom));
+}
+
+/**
+ * Equatorial to horizon coordinates: HA,Dec to Az,El for an observer at a latitude given by its sine and cosine (see
+ * `sla::HorizonFrame::e2h()`).
+ */
+template <typename V>
+inline void e2h(lane_scalar_t<V> sin_phi, lane_scalar_t<V> cos_phi, V ha, V dec, V& azimuth, V& elevation) {
+    using T = lane_scalar_t<V>;
+    constexpr T PI2 = T(6.283185307179586476925287L);
+    const V sin_ha = sin(ha);
+    const V cos_ha = cos(ha);
+    const V sin_dec = sin(dec);
+    const V cos_dec = cos(dec);
+
+    // Az,El as x,y,z
+    const V x = -cos_ha * cos_dec * sin_phi + sin_dec * cos_phi;
+    const V y = -sin_ha * cos_dec;
+    const V z = cos_ha * cos_dec * cos_phi + sin_dec * sin_phi;
+
+    // to spherical coordinates
+    const V r = sqrt(x * x + y * y);
+    const V a = lane_select(r == T(0), V(T(0)), arctan2(y, x));
+    azimuth = lane_select(a < T(0), a + PI2, a);
+    elevation = arctan2(z, r);
+}
+
+/// Horizon to equatorial coordinates: Az,El to HA,Dec (see `sla::HorizonFrame::h2e()`).
+template <typename V>
+inline void h2e(lane_scalar_t<V> sin_phi, lane_scalar_t<V> cos_phi, V azimuth, V elevation, V& ha, V& dec) {
+    using T = lane_scalar_t<V>;
+    const V sin_az = sin(azimuth);
+    const V cos_az = cos(azimuth);
+    const V sin_el = sin(elevation);
+    const V cos_el = cos(elevation);
+
+    // Az,El,Phi as x,y,z
+    const V x = -cos_az * cos_el * sin_phi + sin_el * cos_phi;
+    const V y = -sin_az * cos_el;
+    const V z = cos_az * cos_el * cos_phi + sin_el * sin_phi;
+
+    // to HA,Dec
+    const V r = sqrt(x * x + y * y);
+    ha = lane_select(r == T(0), V(T(0)), arctan2(y, x));
+    dec = arctan2(z, r);
+}
+
+/// Zenith distance from HA,Dec (see `sla::HorizonFrame::zd()`).
+template <typename V>
+inline V zd(lane_scalar_t<V> sin_phi, lane_scalar_t<V> cos_phi, V ha, V dec) {
+    const V sin_ha = sin(ha);
+    const V cos_ha = cos(ha);
+    const V sin_dec = sin(dec);
+    const V cos_dec = cos(dec);
+    const V x = cos_ha * cos_dec * sin_phi - sin_dec * cos_phi;
+    const V y = sin_ha * cos_dec;
+    const V z = cos_ha * cos_dec * cos_phi + sin_dec * sin_phi;
+    return arctan2(sqrt(x * x + y * y), z);
+}
+
+/// Parallactic angle from HA,Dec (see `sla::HorizonFrame::pa()`).
+template <typename V>
+inline V pa(lane_scalar_t<V> sin_phi, lane_scalar_t<V> cos_phi, V ha, V dec) {
+    using T = lane_scalar_t<V>;
+    const V sqsz = cos_phi * sin(ha);
+    const V cqsz = sin_phi * cos(dec) - cos_phi * sin(dec) * cos(ha);
+    return arctan2(sqsz, lane_select(sqsz == T(0) && cqsz == T(0), V(T(1)), cqsz));
+}
+
+} // kernel
+
+} // sla
+
+#endif // SLALIB_KERNELS_H_INCLUDED
@@ -0,0 +1,77 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_LANES_H_INCLUDED
+#define SLALIB_LANES_H_INCLUDED
+
+namespace sla {
+
+/*
+ * Branch-free replacements for the math library functions used in the inner loops of batch functions; unlike calls
+ * to `std::fmod()` or `std::sin()`, they can be inlined and vectorized by the compiler.
+ */
+
+/**
+ * Remainder of `x`/`y` with the sign of `x` (like `std::fmod()`); intermediate results are kept in double precision,
+ * so the result is exactly that of `std::fmod()` unless the quotient falls within rounding error of an integer, in
+ * which case it may differ by `y`. The magnitude of the quotient must be less than 2**31.
+ */
+inline float lane_fmod(float x, float y) {
+    const double dx = x;
+    const double dy = y;
+    return float(dx - dy * double(int(dx / dy)));
+}
+
+/**
+ * Remainder of `x`/`y` with the sign of `x` (like `std::fmod()`), accurate to a few ulps of `x`; the magnitude of the
+ * quotient must be less than 2**31.
+ */
+inline double lane_fmod(double x, double y) {
+    return x - y * double(int(x / y));
+}
+
+/**
+ * Calculates both sine and cosine of a single precision angle, to within about one ulp of `std::sin()` and
+ * `std::cos()`. Argument is reduced to [-pi/4..+pi/4] in double precision, so the magnitude of `x` must not exceed
+ * 1e6 or so; the polynomials are those of the Cephes library.
+ */
+inline void lane_sincos(float x, float& s, float& c) {
+    constexpr double TWO_OVER_PI = 0.636619772367581343075535;
+    constexpr double PI_OVER_2 = 1.57079632679489661923132;
+
+    // quadrant, and reduced argument
+    const double dx = x;
+    const int q = int(dx * TWO_OVER_PI + (dx >= 0.0? 0.5: -0.5));
+    const float r = float(dx - double(q) * PI_OVER_2);
+    const float r2 = r * r;
+
+    // sine and cosine of the reduced argument
+    const float sr = r + r * r2 * (-1.6666654611e-1f + r2 * (8.3321608736e-3f + r2 * -1.9515295891e-4f));
+    const float cr = 1.0f - 0.5f * r2 + r2 * r2 *
+        (4.166664568298827e-2f + r2 * (-1.388731625493765e-3f + r2 * 2.443315711809948e-5f));
+
+    // map back to the original quadrant
+    const bool odd = (q & 1) != 0;
+    const float ss = odd? cr: sr;
+    const float cs = odd? sr: cr;
+    s = (q & 2) != 0? -ss: ss;
+    c = ((q + 1) & 2) != 0? -cs: cs;
+}
+
+} // sla
+
+#endif // SLALIB_LANES_H_INCLUDED
@@ -16,11 +16,174 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "lanes.h"
+#include "dispatch.h"
+#include <algorithm>
 #include <cmath>
 #include <cstdint>
 
 namespace sla {
 
+// degrees to radians
+static constexpr float DEGREES_2_RADIANS = 1.745329252e-2f;
+
+// rate conversion factor: DEGREES_2_RADIANS**2/(86400*365.25)
+static constexpr float RATE_CONV_FACTOR = 9.652743551e-12f;
+
+// Earth radius in AU: 6378.137/149597870
+static constexpr float EARTH_RADIUS_AU = 4.2635212653763e-5f;
+
+/*
+ * Coefficients for fundamental arguments:
+ *
+ * fixed term (deg), term in t (deg & whole revs + fraction per year).
+ */
+
+// Moon's mean longitude
+static constexpr float ELP0 = 270.434164f,
+    ELP1 = 4812.678831f,
+    ELP1I = 4680.0f,
+    ELP1F = 132.678831f;
+
+// Sun's mean anomaly
+static constexpr float EM0 = 358.475833f,
+    EM1 = 359.990498f,
+    EM1F = 359.990498f;
+
+// Moon's mean anomaly
+static constexpr float EMP0 = 296.104608f,
+    EMP1 = 4771.988491f,
+    EMP1I = 4680.0f,
+    EMP1F = 91.988491f;
+
+// Moon's mean elongation
+static constexpr float D0 = 350.737486f,
+    D1 = 4452.671142f,
+    D1I = 4320.0f,
+    D1F = 132.671142f;
+
+// mean distance of the Moon from its ascending node
+static constexpr float F0 = 11.250889f,
+    F1 = 4832.020251f,
+    F1I = 4680.0f,
+    F1F = 152.020251;
+
+/*
+ * Coefficients for Moon position:
+ *
+ * t[n]        = coefficient of term (deg.)
+ * IT[n][0..3] = coefficients of M, M', d, f in argument
+ */
+
+// longitude
+static const float TL[39] = {
+    +6.288750f, +1.274018f, +0.658309f, +0.213616f, -0.185596f,
+    -0.114336f, +0.058793f, +0.057212f, +0.053320f, +0.045874f,
+    +0.041024f, -0.034718f, -0.030465f, +0.015326f, -0.012528f,
+    -0.010980f, +0.010674f, +0.010034f, +0.008548f, -0.007910f,
+    -0.006783f, +0.005162f, +0.005000f, +0.004049f, +0.003996f,
+    +0.003862f, +0.003665f, +0.002695f, +0.002602f, +0.002396f,
+    -0.002349f, +0.002249f, -0.002125f, -0.002079f, +0.002059f,
+    -0.001773f, -0.001595f, +0.001220f, -0.001110f
+};
+static const int8_t ITL[39][4] = {
+    //   M   M'  d   f
+    {0,  +1, 0,  0},
+    {0,  -1, +2, 0},
+    {0,  0,  +2, 0},
+    {0,  +2, 0,  0},
+    {+1, 0,  0,  0},
+    {0,  0,  0,  +2},
+    {0,  -2, +2, 0},
+    {-1, -1, +2, 0},
+    {0,  +1, +2, 0},
+    {-1, 0,  +2, 0},
+    {-1, +1, 0,  0},
+    {0,  0,  +1, 0},
+    {+1, +1, 0,  0},
+    {0,  0,  +2, -2},
+    {0,  +1, 0,  +2},
+    {0,  -1, 0,  +2},
+    {0,  -1, +4, 0},
+    {0,  +3, 0,  0},
+    {0,  -2, +4, 0},
+    {+1, -1, +2, 0},
+    {+1, 0,  +2, 0},
+    {0,  +1, -1, 0},
+    {+1, 0,  +1, 0},
+    {-1, +1, +2, 0},
+    {0,  +2, +2, 0},
+    {0,  0,  +4, 0},
+    {0,  -3, +2, 0},
+    {-1, +2, 0,  0},
+    {0,  +1, -2, -2},
+    {-1, -2, +2, 0},
+    {0,  +1, +1, 0},
+    {-2, 0,  +2, 0},
+    {+1, +2, 0,  0},
+    {+2, 0,  0,  0},
+    {-2, -1, +2, 0},
+    {0,  +1, +2, -2},
+    {0,  0,  +2, +2},
+    {-1, -1, +4, 0},
+    {0,  +2, 0,  +2}
+};
+
+// latitude
+static const float TB[29] = {
+    +5.128189f, +0.280606f, +0.277693f, +0.173238f, +0.055413f,
+    +0.046272f, +0.032573f, +0.017198f, +0.009267f, +0.008823f,
+    +0.008247f, +0.004323f, +0.004200f, +0.003372f, +0.002472f,
+    +0.002222f, +0.002072f, +0.001877f, +0.001828f, -0.001803f,
+    -0.001750f, +0.001570f, -0.001487f, -0.001481f, +0.001417f,
+    +0.001350f, +0.001330f, +0.001106f, +0.001020f
+};
+static const int8_t ITB[29][4] = {
+    //   M   M'  d   f
+    {0,  0,  0,  +1},
+    {0,  +1, 0,  +1},
+    {0,  +1, 0,  -1},
+    {0,  0,  +2, -1},
+    {0,  -1, +2, +1},
+    {0,  -1, +2, -1},
+    {0,  0,  +2, +1},
+    {0,  +2, 0,  +1},
+    {0,  +1, +2, -1},
+    {0,  +2, 0,  -1},
+    {-1, 0,  +2, -1},
+    {0,  -2, +2, -1},
+    {0,  +1, +2, +1},
+    {-1, 0,  -2, +1},
+    {-1, -1, +2, +1},
+    {-1, 0,  +2, +1},
+    {-1, -1, +2, -1},
+    {-1, +1, 0,  +1},
+    {0,  -1, +4, -1},
+    {+1, 0,  0,  +1},
+    {0,  0,  0,  +3},
+    {-1, +1, 0,  -1},
+    {0,  0,  +1, +1},
+    {+1, +1, 0,  +1},
+    {-1, -1, 0,  +1},
+    {-1, 0,  0,  +1},
+    {0,  0,  -1, +1},
+    {0,  +3, 0,  +1},
+    {0,  0,  +4, -1}
+};
+
+// parallax
+static const float TP[4] = {
+    +0.051818f, +0.009531f, +0.007843f, +0.002824f
+};
+static const int8_t ITP[4][4] = {
+    //   M   M'  d   f
+    {0, +1, 0,  0},
+    {0, -1, +2, 0},
+    {0, 0,  +2, 0},
+    {0, +2, 0,  0}
+};
+
 /**
  * Calculates approximate geocentric position and velocity of the Moon (single precision).
  *
@@ -50,165 +213,6 @@ namespace sla {
  *   equinox of date; position part is in AU; velocity part is in AU/sec.
  */
 void moon(int year, int day, float fraction, VectorPV<float>& pv) {
-    // degrees to radians
-    constexpr float DEGREES_2_RADIANS = 1.745329252e-2f;
-
-    // rate conversion factor: DEGREES_2_RADIANS**2/(86400*365.25)
-    constexpr float RATE_CONV_FACTOR = 9.652743551e-12f;
-
-    // Earth radius in AU: 6378.137/149597870
-    constexpr float EARTH_RADIUS_AU = 4.2635212653763e-5f;
-
-    /*
-     * Coefficients for fundamental arguments:
-     *
-     * fixed term (deg), term in t (deg & whole revs + fraction per year).
-     */
-
-    // Moon's mean longitude
-    constexpr float ELP0 = 270.434164f,
-        ELP1 = 4812.678831f,
-        ELP1I = 4680.0f,
-        ELP1F = 132.678831f;
-
-    // Sun's mean anomaly
-    constexpr float EM0 = 358.475833f,
-        EM1 = 359.990498f,
-        EM1F = 359.990498f;
-
-    // Moon's mean anomaly
-    constexpr float EMP0 = 296.104608f,
-        EMP1 = 4771.988491f,
-        EMP1I = 4680.0f,
-        EMP1F = 91.988491f;
-
-    // Moon's mean elongation
-    constexpr float D0 = 350.737486f,
-        D1 = 4452.671142f,
-        D1I = 4320.0f,
-        D1F = 132.671142f;
-
-    // mean distance of the Moon from its ascending node
-    constexpr float F0 = 11.250889f,
-        F1 = 4832.020251f,
-        F1I = 4680.0f,
-        F1F = 152.020251;
-
-    /*
-     * Coefficients for Moon position:
-     *
-     * t[n]        = coefficient of term (deg.)
-     * IT[n][0..3] = coefficients of M, M', d, f in argument
-     */
-
-    // longitude
-    static const float TL[39] = {
-        +6.288750f, +1.274018f, +0.658309f, +0.213616f, -0.185596f,
-        -0.114336f, +0.058793f, +0.057212f, +0.053320f, +0.045874f,
-        +0.041024f, -0.034718f, -0.030465f, +0.015326f, -0.012528f,
-        -0.010980f, +0.010674f, +0.010034f, +0.008548f, -0.007910f,
-        -0.006783f, +0.005162f, +0.005000f, +0.004049f, +0.003996f,
-        +0.003862f, +0.003665f, +0.002695f, +0.002602f, +0.002396f,
-        -0.002349f, +0.002249f, -0.002125f, -0.002079f, +0.002059f,
-        -0.001773f, -0.001595f, +0.001220f, -0.001110f
-    };
-    static const int8_t ITL[39][4] = {
-        //   M   M'  d   f
-        {0,  +1, 0,  0},
-        {0,  -1, +2, 0},
-        {0,  0,  +2, 0},
-        {0,  +2, 0,  0},
-        {+1, 0,  0,  0},
-        {0,  0,  0,  +2},
-        {0,  -2, +2, 0},
-        {-1, -1, +2, 0},
-        {0,  +1, +2, 0},
-        {-1, 0,  +2, 0},
-        {-1, +1, 0,  0},
-        {0,  0,  +1, 0},
-        {+1, +1, 0,  0},
-        {0,  0,  +2, -2},
-        {0,  +1, 0,  +2},
-        {0,  -1, 0,  +2},
-        {0,  -1, +4, 0},
-        {0,  +3, 0,  0},
-        {0,  -2, +4, 0},
-        {+1, -1, +2, 0},
-        {+1, 0,  +2, 0},
-        {0,  +1, -1, 0},
-        {+1, 0,  +1, 0},
-        {-1, +1, +2, 0},
-        {0,  +2, +2, 0},
-        {0,  0,  +4, 0},
-        {0,  -3, +2, 0},
-        {-1, +2, 0,  0},
-        {0,  +1, -2, -2},
-        {-1, -2, +2, 0},
-        {0,  +1, +1, 0},
-        {-2, 0,  +2, 0},
-        {+1, +2, 0,  0},
-        {+2, 0,  0,  0},
-        {-2, -1, +2, 0},
-        {0,  +1, +2, -2},
-        {0,  0,  +2, +2},
-        {-1, -1, +4, 0},
-        {0,  +2, 0,  +2}
-    };
-
-    // latitude
-    static const float TB[29] = {
-        +5.128189f, +0.280606f, +0.277693f, +0.173238f, +0.055413f,
-        +0.046272f, +0.032573f, +0.017198f, +0.009267f, +0.008823f,
-        +0.008247f, +0.004323f, +0.004200f, +0.003372f, +0.002472f,
-        +0.002222f, +0.002072f, +0.001877f, +0.001828f, -0.001803f,
-        -0.001750f, +0.001570f, -0.001487f, -0.001481f, +0.001417f,
-        +0.001350f, +0.001330f, +0.001106f, +0.001020f
-    };
-    static const int8_t ITB[29][4] = {
-        //   M   M'  d   f
-        {0,  0,  0,  +1},
-        {0,  +1, 0,  +1},
-        {0,  +1, 0,  -1},
-        {0,  0,  +2, -1},
-        {0,  -1, +2, +1},
-        {0,  -1, +2, -1},
-        {0,  0,  +2, +1},
-        {0,  +2, 0,  +1},
-        {0,  +1, +2, -1},
-        {0,  +2, 0,  -1},
-        {-1, 0,  +2, -1},
-        {0,  -2, +2, -1},
-        {0,  +1, +2, +1},
-        {-1, 0,  -2, +1},
-        {-1, -1, +2, +1},
-        {-1, 0,  +2, +1},
-        {-1, -1, +2, -1},
-        {-1, +1, 0,  +1},
-        {0,  -1, +4, -1},
-        {+1, 0,  0,  +1},
-        {0,  0,  0,  +3},
-        {-1, +1, 0,  -1},
-        {0,  0,  +1, +1},
-        {+1, +1, 0,  +1},
-        {-1, -1, 0,  +1},
-        {-1, 0,  0,  +1},
-        {0,  0,  -1, +1},
-        {0,  +3, 0,  +1},
-        {0,  0,  +4, -1}
-    };
-
-    // parallax
-    static const float TP[4] = {
-        +0.051818f, +0.009531f, +0.007843f, +0.002824f
-    };
-    static const int8_t ITP[4][4] = {
-        //   M   M'  d   f
-        {0, +1, 0,  0},
-        {0, -1, +2, 0},
-        {0, 0,  +2, 0},
-        {0, +2, 0,  0}
-    };
-
     // whole years & fraction of year, and years since J1900.0
     const float yi = float(year - 1900);
     const int iy4 = ((year % 4) + 4) % 4;
@@ -306,4 +310,165 @@ void moon(int year, int day, float fraction, VectorPV<float>& pv) {
     pv.set_dz(v.get_dy() * sin_eps + v.get_dz() * cos_eps);
 }
 
+/// Body of sla::moon_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void moon_batch_kernel(int n, const int* years, const int* days, const float* fractions,
+    VectorPV<float>* pv) {
+    // number of dates processed together
+    constexpr int CHUNK = 32;
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // years since J1900.0, and fundamental arguments, per date
+        float t[CHUNK], elp[CHUNK], em[CHUNK], emp[CHUNK], d[CHUNK], f[CHUNK];
+        for (int j = 0; j < count; j++) {
+            const int year = years[base + j];
+            const float yi = float(year - 1900);
+            const int iy4 = ((year % 4) + 4) % 4;
+            const float yf = (float(4 * (days[base + j] - 1 / (iy4 + 1)) - iy4 - 2) + 4.0f * fractions[base + j])
+                / 1461.0f;
+            t[j] = yi + yf;
+            elp[j] = DEGREES_2_RADIANS * lane_fmod(ELP0 + ELP1I * yf + ELP1F * t[j], 360.0f);
+            em[j] = DEGREES_2_RADIANS * lane_fmod(EM0 + EM1F * t[j], 360.0f);
+            emp[j] = DEGREES_2_RADIANS * lane_fmod(EMP0 + EMP1I * yf + EMP1F * t[j], 360.0f);
+            d[j] = DEGREES_2_RADIANS * lane_fmod(D0 + D1I * yf + D1F * t[j], 360.0f);
+            f[j] = DEGREES_2_RADIANS * lane_fmod(F0 + F1I * yf + F1F * t[j], 360.0f);
+        }
+
+        // longitude
+        float el[CHUNK], eld[CHUNK];
+        for (int j = 0; j < count; j++) {
+            el[j] = 0.0f;
+            eld[j] = 0.0f;
+        }
+        for (int i = 38; i >= 0; i--) {
+            const float coeff = TL[i];
+            const float cem = (float) ITL[i][0];
+            const float cemp = (float) ITL[i][1];
+            const float cd = (float) ITL[i][2];
+            const float cf = (float) ITL[i][3];
+            const float thetad = cem * EM1 + cemp * EMP1 + cd * D1 + cf * F1;
+            for (int j = 0; j < count; j++) {
+                float sin_theta, cos_theta;
+                lane_sincos(cem * em[j] + cemp * emp[j] + cd * d[j] + cf * f[j], sin_theta, cos_theta);
+                el[j] += coeff * sin_theta;
+                eld[j] += coeff * cos_theta * thetad;
+            }
+        }
+
+        // latitude
+        float b[CHUNK], bd[CHUNK];
+        for (int j = 0; j < count; j++) {
+            b[j] = 0.0f;
+            bd[j] = 0.0f;
+        }
+        for (int i = 28; i >= 0; i--) {
+            const float coeff = TB[i];
+            const float cem = (float) ITB[i][0];
+            const float cemp = (float) ITB[i][1];
+            const float cd = (float) ITB[i][2];
+            const float cf = (float) ITB[i][3];
+            const float thetad = cem * EM1 + cemp * EMP1 + cd * D1 + cf * F1;
+            for (int j = 0; j < count; j++) {
+                float sin_theta, cos_theta;
+                lane_sincos(cem * em[j] + cemp * emp[j] + cd * d[j] + cf * f[j], sin_theta, cos_theta);
+                b[j] += coeff * sin_theta;
+                bd[j] += coeff * cos_theta * thetad;
+            }
+        }
+
+        // parallax
+        float p[CHUNK], pd[CHUNK];
+        for (int j = 0; j < count; j++) {
+            p[j] = 0.0f;
+            pd[j] = 0.0f;
+        }
+        for (int i = 3; i >= 0; i--) {
+            const float coeff = TP[i];
+            const float cem = (float) ITP[i][0];
+            const float cemp = (float) ITP[i][1];
+            const float cd = (float) ITP[i][2];
+            const float cf = (float) ITP[i][3];
+            const float thetad = cem * EM1 + cemp * EMP1 + cd * D1 + cf * F1;
+            for (int j = 0; j < count; j++) {
+                float sin_theta, cos_theta;
+                lane_sincos(cem * em[j] + cemp * emp[j] + cd * d[j] + cf * f[j], sin_theta, cos_theta);
+                p[j] += coeff * cos_theta;
+                pd[j] -= coeff * sin_theta * thetad;
+            }
+        }
+
+        // transformation into final form
+        for (int j = 0; j < count; j++) {
+            const float lon = el[j] * DEGREES_2_RADIANS + elp[j];
+            const float dlon = RATE_CONV_FACTOR * (eld[j] + ELP1 / DEGREES_2_RADIANS);
+            const float lat = b[j] * DEGREES_2_RADIANS;
+            const float dlat = bd[j] * RATE_CONV_FACTOR;
+            const float par = (p[j] + 0.950724f) * DEGREES_2_RADIANS;
+            const float dpar = pd[j] * RATE_CONV_FACTOR;
+
+            // transform parallax to distance (AU, AU/sec)
+            float sp, cp;
+            lane_sincos(par, sp, cp);
+            const float r = EARTH_RADIUS_AU / sp;
+            const float rd = -r * dpar / sp;
+
+            // longitude, latitude to x,y,z (AU)
+            float sin_lon, cos_lon, sin_lat, cos_lat;
+            lane_sincos(lon, sin_lon, cos_lon);
+            lane_sincos(lat, sin_lat, cos_lat);
+            const float r_cos_lat = r * cos_lat;
+            const float x = r_cos_lat * cos_lon;
+            const float y = r_cos_lat * sin_lon;
+            const float z = r * sin_lat;
+            const float r_dlat = r * dlat;
+            const float w = r_dlat * sin_lat - cos_lat * rd;
+            const float dx = -y * dlon - w * cos_lon;
+            const float dy = x * dlon - w * sin_lon;
+            const float dz = r_dlat * cos_lat + sin_lat * rd;
+
+            // mean obliquity
+            float sin_eps, cos_eps;
+            lane_sincos(DEGREES_2_RADIANS * (23.45229f - 0.00013f * t[j]), sin_eps, cos_eps);
+
+            // rotate Moon position and velocity into equatorial system
+            VectorPV<float>& result = pv[base + j];
+            result.set_x(x);
+            result.set_y(y * cos_eps - z * sin_eps);
+            result.set_z(y * sin_eps + z * cos_eps);
+            result.set_dx(dx);
+            result.set_dy(dy * cos_eps - dz * sin_eps);
+            result.set_dz(dy * sin_eps + dz * cos_eps);
+        }
+    }
+}
+
+static KernelDispatcher<moon_batch_kernel> moon_batch_dispatcher("moon_batch");
+static const bool moon_batch_enlisted = moon_batch_dispatcher.enlist();
+
+/**
+ * Calculates approximate geocentric positions and velocities of the Moon for many dates (single precision).
+ *
+ * Implements the same model as the sla::moon() function, with dates processed in chunks: series terms are in the
+ * outer loops and dates in the inner ones, which are free of branches and library calls (sine and cosine of each
+ * argument are computed together by an inlined polynomial), so compilers can vectorize them across dates. Results
+ * agree with those of sla::moon() to within a few float ulps.
+ *
+ * @param n Number of dates.
+ * @param years Years (see sla::moon()).
+ * @param days Days in years (1 = Jan 1-st).
+ * @param fractions Fractions of days.
+ * @param pv Return value: array of `n` elements receiving Moon position and velocity vectors: Moon center relative
+ *   to Earth center, mean equator and equinox of date; position part is in AU; velocity part is in AU/sec.
+ */
+void moon_batch(int n, const int* years, const int* days, const float* fractions, VectorPV<float>* pv) {
+    moon_batch_dispatcher(n, years, days, fractions, pv);
+}
+
+/// Version of sla::moon_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void moon_batch(StridedSpan<const int> years, StridedSpan<const int> days, StridedSpan<const float> fractions,
+    StridedSpan<VectorPV<float>> pv) {
+    span_tiles(years.get_size(), [](int n, auto... p) { moon_batch(n, p...); }, years, days, fractions, pv);
+}
+
 }
@@ -0,0 +1,191 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include <cmath>
+#include <limits>
+
+namespace sla {
+
+/**
+ * Evaluates six Chebyshev series (position and velocity components) using Clenshaw's recurrence.
+ *
+ * @param coeffs Coefficients, `ncoeffs` per component.
+ * @param ncoeffs Number of coefficients per component (polynomial degree plus one).
+ * @param x Argument, normalized to [-1..+1] range.
+ * @param pv Return value: position and velocity.
+ */
+static void chebyshev(const double* coeffs, int ncoeffs, double x, VectorPV<double>& pv) {
+    const double x2 = 2.0 * x;
+    double result[6];
+    for (int c = 0; c < 6; c++) {
+        const double* cc = coeffs + c * ncoeffs;
+        double b1 = 0.0, b2 = 0.0;
+        for (int j = ncoeffs - 1; j >= 1; j--) {
+            const double b0 = x2 * b1 - b2 + cc[j];
+            b2 = b1;
+            b1 = b0;
+        }
+        result[c] = x * b1 - b2 + 0.5 * cc[0];
+    }
+    pv.set_x(result[0]);
+    pv.set_y(result[1]);
+    pv.set_z(result[2]);
+    pv.set_dx(result[3]);
+    pv.set_dy(result[4]);
+    pv.set_dz(result[5]);
+}
+
+/**
+ * Creates empty Moon ephemeris cache.
+ *
+ * With default settings (1-day segments, 12th degree polynomials), interpolation errors are at the level of 2e-14 AU
+ * (3 mm) in position and 5e-20 AU/s in velocity, which is the numerical noise floor of sla::dmoon() itself; fitting
+ * a segment takes 13 + 44 sla::dmoon() evaluations, so the cache pays off when a few dozen dates fall into each
+ * segment.
+ *
+ * Until the first call to sla::MoonEphemeris::get(), sla::MoonEphemeris::get_velocity_error_estimate() returns NaN.
+ *
+ * @param span Length of a segment (days).
+ * @param degree Degree of Chebyshev polynomials.
+ * @param capacity Maximum number of cached segments.
+ */
+MoonEphemeris::MoonEphemeris(double span, int degree, int capacity):
+    me_span(span), me_degree(degree), me_last(0), me_clock(0),
+    me_keys(capacity, 0), me_stamps(capacity, 0), me_pos_est(capacity, std::numeric_limits<double>::quiet_NaN()),
+    me_vel_est(capacity, std::numeric_limits<double>::quiet_NaN()),
+    me_coeffs((std::size_t) capacity * 6 * (degree + 1), 0.0) {
+    assert(span > 0.0 && degree > 0 && capacity > 0);
+}
+
+/**
+ * Fits Chebyshev polynomials to sla::dmoon() over given segment, and stores them in the least recently used cache
+ * slot.
+ *
+ * The fit is checked against sla::dmoon() at both ends of the segment and at quarter points between every two
+ * adjacent Chebyshev nodes, which is where interpolation errors peak; three times the largest deviations found
+ * become error estimates of the segment (the margin covers numerical noise of sla::dmoon(), which is at the level of
+ * 1e-14 AU and is not smooth, so it can not be interpolated). These are estimates rather than guaranteed bounds:
+ * deviations are only sampled, and between check points they may exceed the sampled maximum.
+ *
+ * @param key Segment number: segment starts at `key` * `me_span`.
+ * @return Cache slot containing the fitted segment.
+ */
+int MoonEphemeris::fit(std::int64_t key) {
+    constexpr double PI = 3.1415926535897932384626433832795;
+    const int ncoeffs = me_degree + 1;
+
+    // pick the least recently used (or empty) slot
+    int slot = 0;
+    for (int i = 1; i < (int) me_stamps.size(); i++) {
+        if (me_stamps[i] < me_stamps[slot]) {
+            slot = i;
+        }
+    }
+
+    // evaluate the ephemeris at Chebyshev nodes and at check points, in one batch
+    const int npoints = 4 * ncoeffs + 5;
+    const double half = 0.5 * me_span;
+    const double mid = (double) key * me_span + half;
+    std::vector<double> x(npoints), dates(npoints);
+    for (int k = 0; k < ncoeffs; k++) {
+        x[k] = std::cos(PI * (k + 0.5) / ncoeffs);
+    }
+    int index = ncoeffs;
+    x[index++] = 1.0;
+    x[index++] = -1.0;
+    for (int k = 0; k <= ncoeffs; k++) {
+        // quarter points of the interval between adjacent nodes (or between a node and segment end)
+        const double x0 = k > 0? x[k - 1]: 1.0;
+        const double x1 = k < ncoeffs? x[k]: -1.0;
+        for (int q = 1; q <= 3; q++) {
+            x[index++] = x0 + (x1 - x0) * q / 4.0;
+        }
+    }
+    for (int k = 0; k < npoints; k++) {
+        dates[k] = mid + half * x[k];
+    }
+    std::vector<VectorPV<double>> pv(npoints);
+    dmoon_batch(npoints, dates.data(), pv.data());
+
+    // Chebyshev coefficients of the six components
+    double* coeffs = me_coeffs.data() + (std::size_t) slot * 6 * ncoeffs;
+    for (int c = 0; c < 6; c++) {
+        for (int j = 0; j < ncoeffs; j++) {
+            double sum = 0.0;
+            for (int k = 0; k < ncoeffs; k++) {
+                const double value = c < 3? pv[k].get_position()[c]: pv[k].get_velocity()[c - 3];
+                sum += value * std::cos(PI * j * (k + 0.5) / ncoeffs);
+            }
+            coeffs[c * ncoeffs + j] = 2.0 * sum / ncoeffs;
+        }
+    }
+    me_keys[slot] = key;
+
+    // check the fit at points other than the nodes
+    double pos_err = 0.0, vel_err = 0.0;
+    for (int k = ncoeffs; k < npoints; k++) {
+        VectorPV<double> ipv;
+        chebyshev(coeffs, ncoeffs, x[k], ipv);
+        for (int c = 0; c < 3; c++) {
+            pos_err = std::max(pos_err, std::abs(ipv.get_position()[c] - pv[k].get_position()[c]));
+            vel_err = std::max(vel_err, std::abs(ipv.get_velocity()[c] - pv[k].get_velocity()[c]));
+        }
+    }
+    me_pos_est[slot] = 3.0 * pos_err;
+    me_vel_est[slot] = 3.0 * vel_err;
+    return slot;
+}
+
+/**
+ * Calculates approximate geocentric position and velocity of the Moon by interpolating cached approximation of the
+ * sla::dmoon() ephemeris, fitting new segment if necessary.
+ *
+ * @param date TDB (Barycentric Dynamical Time; loosely ET) as a Modified Julian Date (JD-2400000.5).
+ * @param pv Return value: Moon {x,y,z},{xdot,ydot,zdot}, mean equator and equinox of date (AU, AU/s).
+ * @return Estimate of the difference between returned position and that returned by sla::dmoon() (AU), sampled
+ *   when the segment was fitted (see sla::MoonEphemeris::fit()); velocity error estimate can be retrieved with
+ *   sla::MoonEphemeris::get_velocity_error_estimate().
+ */
+double MoonEphemeris::get(double date, VectorPV<double>& pv) {
+    const auto key = (std::int64_t) std::floor(date / me_span);
+
+    // find segment, trying the most recently used one first
+    int slot = me_last;
+    if (me_stamps[slot] == 0 || me_keys[slot] != key) {
+        slot = -1;
+        for (int i = 0; i < (int) me_keys.size(); i++) {
+            if (me_stamps[i] != 0 && me_keys[i] == key) {
+                slot = i;
+                break;
+            }
+        }
+        if (slot < 0) {
+            slot = fit(key);
+        }
+        me_stamps[slot] = ++me_clock;
+        me_last = slot;
+    }
+
+    // evaluate Chebyshev series
+    const int ncoeffs = me_degree + 1;
+    const double x = 2.0 * (date / me_span - (double) key) - 1.0;
+    chebyshev(me_coeffs.data() + (std::size_t) slot * 6 * ncoeffs, ncoeffs, x, pv);
+    return me_pos_est[slot];
+}
+
+}
@@ -16,35 +16,34 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
 /**
- * Procedure that performs the 3D forward unitary transformation (single precision):
- *
- *   vector `vb` = matrix `mat` * vector `va`
- *
- * Original FORTRAN code by P.T. Wallace.
+ * Transforms many vectors by the same matrix (single precision); this is a vectorized version of sla::mxv().
  *
  * @param mat Transformation matrix.
- * @param va Vector to transform.
- * @param vb Output: vector `va` multiplied by matrix `mat`; can be the same as `va`.
+ * @param n Number of vectors.
+ * @param va Vectors to transform.
+ * @param vb Output: `n` vectors, each being matrix `mat` * vector from `va`; can be the same array as `va`.
  */
-void mxv(const Matrix<float> mat, const Vector<float> va, Vector<float> vb) {
-    // matrix `mat` * vector `va` -> vector `result`
-    Vector<float> result;
-    for (int j = 0; j < 3; j++) {
-        float element = 0.0f;
-        for (int i = 0; i < 3; i++) {
-            element += mat[j][i] * va[i];
-        }
-        result[j] = element;
-    }
+void mxv_batch(const Matrix<float> mat, int n, const Vector<float>* va, Vector<float>* vb) {
+    lane_loop<float>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V x, y, z;
+        kernel::mxv(mat, lane_load<V>(&va[i][0], 3), lane_load<V>(&va[i][1], 3), lane_load<V>(&va[i][2], 3),
+            x, y, z);
+        lane_store(x, &vb[i][0], 3);
+        lane_store(y, &vb[i][1], 3);
+        lane_store(z, &vb[i][2], 3);
+    });
+}
 
-    // return result vector
-    for (int k = 0; k < 3; k++) {
-        vb[k] = result[k];
-    }
+/// Version of sla::mxv_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void mxv_batch(const Matrix<float> mat, StridedSpan<const Vector<float>> va, StridedSpan<Vector<float>> vb) {
+    span_tiles(va.get_size(), [mat](int n, auto... p) { mxv_batch(mat, n, p...); }, va, vb);
 }
 
 }
@@ -16,35 +16,13 @@
  *
  */
 #include "slalib.h"
+#include "dispatch.h"
 #include <cmath>
 
 namespace sla {
 
-/**
- * Calculates nutation: longitude & obliquity components and mean obliquity, using the Shirai & Fukushima (2001) theory.
- *
- * This function predicts forced nutation (but not free core nutation) plus corrections to the IAU 1976 precession
- * model. Earth attitude predictions made by combining the present nutation model with IAU 1976 precession are accurate
- * to 1 milliactsecond (with respect to the ICRF) for a few decades around 2000.
- *
- * The sla::nutc80() function is the equivalent of the present function but uses the IAU 1980 nutation theory. The
- * older theory is less accurate, leading to errors as large as 350 milliarcseconds over the interval 1900-2100,
- * mainly because of the error in the IAU 1976 precession.
- *
- * References:
- *   Shirai, T. & Fukushima, T., Astron.J. 121, 3270-3283 (2001).
- *   Fukushima, T., Astron.Astrophys. 244, L11 (1991).
- *   Simon, J. L., Bretagnon, P., Chapront, J., Chapront-Touze, M., Francou, G. & Laskar, J.,
- *     Astron.Astrophys. 282, 663 (1994).
- *
- * Original FORTRAN code by P.T. Wallace.
- *
- * @param tdb TDB (Barycentric Dynamical Time; loosely ET, Ephemeris Time) as Modified Julian Date (JD-2400000.5).
- * @param psi Return value: nutation in longitude.
- * @param eps Return value: nutation in obliquity.
- * @param eps0 Return value: mean obliquity.
- */
-void nutc(double tdb, double& psi, double& eps, double& eps0) {
+/// Body of sla::nutc(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void nutc_kernel(double tdb, double& psi, double& eps, double& eps0) {
     // degrees to radians
     constexpr double DEGREES_2_RADIANS = 1.745329251994329576923691e-2;
     // arc seconds to radians
@@ -727,4 +705,35 @@ void nutc(double tdb, double& psi, double& eps, double& eps0) {
         -0.000000025 * centuries) * centuries) * centuries) * centuries) * centuries) * ARCSECS_2_RADIANS;
 }
 
+static KernelDispatcher<nutc_kernel> nutc_dispatcher("nutc");
+static const bool nutc_enlisted = nutc_dispatcher.enlist();
+
+/**
+ * Calculates nutation: longitude & obliquity components and mean obliquity, using the Shirai & Fukushima (2001) theory.
+ *
+ * This function predicts forced nutation (but not free core nutation) plus corrections to the IAU 1976 precession
+ * model. Earth attitude predictions made by combining the present nutation model with IAU 1976 precession are accurate
+ * to 1 milliactsecond (with respect to the ICRF) for a few decades around 2000.
+ *
+ * The sla::nutc80() function is the equivalent of the present function but uses the IAU 1980 nutation theory. The
+ * older theory is less accurate, leading to errors as large as 350 milliarcseconds over the interval 1900-2100,
+ * mainly because of the error in the IAU 1976 precession.
+ *
+ * References:
+ *   Shirai, T. & Fukushima, T., Astron.J. 121, 3270-3283 (2001).
+ *   Fukushima, T., Astron.Astrophys. 244, L11 (1991).
+ *   Simon, J. L., Bretagnon, P., Chapront, J., Chapront-Touze, M., Francou, G. & Laskar, J.,
+ *     Astron.Astrophys. 282, 663 (1994).
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param tdb TDB (Barycentric Dynamical Time; loosely ET, Ephemeris Time) as Modified Julian Date (JD-2400000.5).
+ * @param psi Return value: nutation in longitude.
+ * @param eps Return value: nutation in obliquity.
+ * @param eps0 Return value: mean obliquity.
+ */
+void nutc(double tdb, double& psi, double& eps, double& eps0) {
+    nutc_dispatcher(tdb, psi, eps, eps0);
+}
+
 }
@@ -0,0 +1,58 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+
+namespace sla {
+
+/**
+ * Observed to apparent place.
+ *
+ * Observed RA,Dec or HA,Dec, or Az,ZD, are converted into geocentric apparent RA,Dec. The star-independent parameters
+ * are computed by sla::aoppa(), and the transformation is then done by sla::oapqk(); see these functions for details.
+ * When many places are to be computed for the same date and site, call sla::aoppa() once and then sla::oapqk() (or
+ * sla::oapqk_batch()) for the places.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param type Type of coordinates: 'R' or 'r' for RA,Dec, 'H' or 'h' for HA,Dec, 'A' or 'a' (or anything else) for
+ *   Az,ZD.
+ * @param ob1 Observed Az, HA or RA (radians; Az is N=0, E=90).
+ * @param ob2 Observed ZD or Dec (radians).
+ * @param date UTC date/time (Modified Julian Date, JD-2400000.5).
+ * @param dut Delta UT: UT1-UTC (UTC seconds).
+ * @param elongm Mean longitude of the observer (radians, east positive).
+ * @param phim Mean geodetic latitude of the observer (radians).
+ * @param hm Observer's height above sea level (meters).
+ * @param xp Polar motion x-coordinate (radians).
+ * @param yp Polar motion y-coordinate (radians).
+ * @param tdk Local ambient temperature (K; std=273.15).
+ * @param pmb Local atmospheric pressure (mb; std=1013.25).
+ * @param rh Local relative humidity (in the range 0.0-1.0).
+ * @param wl Effective wavelength (micrometers, e.g. 0.55).
+ * @param tlr Tropospheric lapse rate (K per meter, e.g. 0.0065).
+ * @param rap Return value: geocentric apparent right ascension (radians).
+ * @param dap Return value: geocentric apparent declination (radians).
+ */
+void oap(char type, double ob1, double ob2, double date, double dut, double elongm, double phim, double hm,
+    double xp, double yp, double tdk, double pmb, double rh, double wl, double tlr, double& rap, double& dap) {
+    AOParams params;
+    aoppa(date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, params);
+    oapqk(type, ob1, ob2, params, rap, dap);
+}
+
+}
@@ -0,0 +1,198 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Quick observed to apparent place.
+ *
+ * Observed RA,Dec or HA,Dec, or Az,ZD, are converted into geocentric apparent RA,Dec, using the star-independent
+ * parameters computed by sla::aoppa(); this is the inverse of sla::aopqk().
+ *
+ * Notes:
+ *
+ *   1. Only the first character of the `type` argument is significant. 'R' or 'r' indicates that `ob1` and `ob2` are
+ *      the observed right ascension and declination; 'H' or 'h' indicates that they are hour angle (west +ve) and
+ *      declination; anything else ('A' or 'a' is recommended) indicates that `ob1` and `ob2` are azimuth (north zero,
+ *      east 90 degrees) and zenith distance. (Zenith distance is used rather than elevation in order to reflect the
+ *      fact that no allowance is made for depression of the horizon.)
+ *
+ *   2. The accuracy of the result is limited by the corrections for refraction. Providing the meteorological
+ *      parameters are known accurately and there are no gross local effects, the predicted apparent RA,Dec should be
+ *      within about 0.1 arcsec for a zenith distance of less than 70 degrees. Even at a topocentric zenith distance
+ *      of 90 degrees, the accuracy in elevation should be better than 1 arcmin; useful results are available for a
+ *      further 3 degrees, beyond which the sla::refro() function returns a fixed value of the refraction. The
+ *      complementary functions sla::aop() (or sla::aopqk()) and sla::oap() (or sla::oapqk()) are self-consistent to
+ *      better than 1 microarcsecond all over the celestial sphere.
+ *
+ *   3. It is advisable to take great care with units, as even unlikely values of the input parameters are accepted
+ *      and processed in accordance with the models used.
+ *
+ *   4. "Observed" Az,El means the position that would be seen by a perfect theodolite located at the observer. This
+ *      is related to the observed HA,Dec via the standard rotation, using the geodetic latitude (corrected for polar
+ *      motion), while the observed HA and RA are related simply through the local apparent ST. "Observed" RA,Dec or
+ *      HA,Dec thus means the position that would be seen by a perfect equatorial located at the observer and with its
+ *      polar axis aligned to the Earth's axis of rotation (n.b. not to the refracted pole). By removing from the
+ *      observed place the effects of atmospheric refraction and diurnal aberration, the geocentric apparent RA,Dec is
+ *      obtained.
+ *
+ *   5. Refraction is computed with the two-constant model of sla::refz() (constants from sla::refco()) for zenith
+ *      distances up to about 76 degrees, and with sla::refro() beyond that.
+ *
+ *   6. To convert many places (for example, encoder readings logged at a high rate), use sla::oapqk_batch().
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param type Type of coordinates: 'R' or 'r' for RA,Dec, 'H' or 'h' for HA,Dec, 'A' or 'a' (or anything else) for
+ *   Az,ZD.
+ * @param ob1 Observed Az, HA or RA (radians; Az is N=0, E=90).
+ * @param ob2 Observed ZD or Dec (radians).
+ * @param params Star-independent apparent-to-observed place parameters, as computed by sla::aoppa().
+ * @param rap Return value: geocentric apparent right ascension (radians).
+ * @param dap Return value: geocentric apparent declination (radians).
+ */
+void oapqk(char type, double ob1, double ob2, const AOParams& params, double& rap, double& dap) {
+    oapqk_batch(type, 1, &ob1, &ob2, params, &rap, &dap);
+}
+
+/**
+ * Quick observed to apparent place, for many observed places.
+ *
+ * Results are identical to those of the sla::oapqk() function (which is implemented as a batch of one place). Places
+ * are processed in chunks; all steps except the rigorous refraction calculation (which is only needed for zenith
+ * distances greater than about 76 degrees) are loops over places that compilers can vectorize, and site constants
+ * are taken from the star-independent parameters.
+ *
+ * @param type Type of coordinates (see sla::oapqk()).
+ * @param n Number of places.
+ * @param ob1 Observed Az, HA or RA (radians; Az is N=0, E=90).
+ * @param ob2 Observed ZD or Dec (radians).
+ * @param params Star-independent apparent-to-observed place parameters, as computed by sla::aoppa().
+ * @param rap Return value: geocentric apparent right ascension (radians).
+ * @param dap Return value: geocentric apparent declination (radians).
+ */
+void oapqk_batch(char type, int n, const double* ob1, const double* ob2, const AOParams& params,
+    double* rap, double* dap) {
+    // breakpoint for fast/slow refraction algorithm: ZD greater than arctan(4) (see sla::refco()), or vector Z less
+    // than cosine(arctan(Z)) = 1/sqrt(17)
+    constexpr double ZBREAK = 0.242535625;
+
+    // number of places processed together
+    constexpr int CHUNK = 64;
+
+    // standardize coordinate type
+    const char c = (type == 'R' || type == 'r')? 'R': ((type == 'H' || type == 'h')? 'H': 'A');
+
+    // sin, cos of latitude, and local apparent sidereal time
+    const double sphi = params.ao_sin_phi;
+    const double cphi = params.ao_cos_phi;
+    const double st = params.ao_lst;
+
+    // refraction constants, and diurnal aberration
+    const double refa = params.ao_refa;
+    const double refb = params.ao_refb;
+    const double diurab = -params.ao_diurab;
+
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+        const double* c1 = ob1 + base;
+        const double* c2 = ob2 + base;
+        double xaeo[CHUNK], yaeo[CHUNK], zaeo[CHUNK], az[CHUNK], zdo[CHUNK], dref[CHUNK];
+
+        if (c == 'A') {
+            // Az,ZD to Cartesian (S=0,E=90)
+            for (int k = 0; k < count; k++) {
+                const double ce = std::sin(c2[k]);
+                xaeo[k] = -std::cos(c1[k]) * ce;
+                yaeo[k] = std::sin(c1[k]) * ce;
+                zaeo[k] = std::cos(c2[k]);
+            }
+        } else {
+            // RA,Dec to HA,Dec (if necessary), to Cartesian -HA,Dec, to Cartesian Az,El (S=0,E=90)
+            const double sign = (c == 'R')? 1.0: -1.0;
+            const double offset = (c == 'R')? -st: 0.0;
+            for (int k = 0; k < count; k++) {
+                const double mha = sign * c1[k] + offset;
+                const double cosd = std::cos(c2[k]);
+                const double xmhdo = std::cos(mha) * cosd;
+                const double yhdo = std::sin(mha) * cosd;
+                const double zhdo = std::sin(c2[k]);
+                xaeo[k] = sphi * xmhdo - cphi * zhdo;
+                yaeo[k] = yhdo;
+                zaeo[k] = cphi * xmhdo + sphi * zhdo;
+            }
+        }
+
+        // azimuth (S=0,E=90), observed ZD, and refraction using the fast two constant model
+        for (int k = 0; k < count; k++) {
+            az[k] = (xaeo[k] != 0.0 || yaeo[k] != 0.0)? std::atan2(yaeo[k], xaeo[k]): 0.0;
+            const double sz = std::sqrt(xaeo[k] * xaeo[k] + yaeo[k] * yaeo[k]);
+            zdo[k] = std::atan2(sz, zaeo[k]);
+            const double tz = sz / std::max(zaeo[k], ZBREAK);
+            dref[k] = (refa + refb * tz * tz) * tz;
+        }
+
+        // rigorous algorithm for large ZD
+        for (int k = 0; k < count; k++) {
+            if (zaeo[k] < ZBREAK) {
+                dref[k] = refro(zdo[k], params.ao_height, params.ao_tdk, params.ao_pmb, params.ao_rh, params.ao_wl,
+                    params.ao_phi, params.ao_tlr, 1.0e-8);
+            }
+        }
+
+        for (int k = 0; k < count; k++) {
+            // to Cartesian Az,ZD
+            const double zdt = zdo[k] + dref[k];
+            const double ce = std::sin(zdt);
+            const double xaet = std::cos(az[k]) * ce;
+            const double yaet = std::sin(az[k]) * ce;
+            const double zaet = std::cos(zdt);
+
+            // Cartesian Az,ZD to Cartesian -HA,Dec
+            const double xmhda = sphi * xaet + cphi * zaet;
+            const double yhda = yaet;
+            const double zhda = -cphi * xaet + sphi * zaet;
+
+            // diurnal aberration
+            const double f = 1.0 - diurab * yhda;
+            const double x = f * xmhda;
+            const double y = f * (yhda + diurab);
+            const double z = f * zhda;
+
+            // to spherical -HA,Dec, and to RA
+            const double r = std::sqrt(x * x + y * y);
+            const double hma = (r == 0.0)? 0.0: std::atan2(y, x);
+            dap[base + k] = (z == 0.0)? 0.0: std::atan2(z, r);
+            rap[base + k] = dranrm(st + hma);
+        }
+    }
+}
+
+/// Version of sla::oapqk_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void oapqk_batch(char type, StridedSpan<const double> ob1, StridedSpan<const double> ob2, const AOParams& params,
+    StridedSpan<double> rap, StridedSpan<double> dap) {
+    span_tiles(ob1.get_size(), [&](int n, auto ob1, auto ob2, auto rap, auto dap) {
+        oapqk_batch(type, n, ob1, ob2, params, rap, dap);
+    }, ob1, ob2, rap, dap);
+}
+
+}
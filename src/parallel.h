@@ -0,0 +1,65 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_PARALLEL_H_INCLUDED
+#define SLALIB_PARALLEL_H_INCLUDED
+
+#include <algorithm>
+#include <thread>
+#include <vector>
+
+namespace sla {
+
+/**
+ * Splits range [0..n) into contiguous chunks and processes them concurrently, calling `func(begin, end)` for each
+ * chunk; the calling thread processes the first chunk itself, and returns after all chunks have been processed.
+ *
+ * Only functions that do not use static state (see `SLALIB_THREAD_SAFE`) may be called from `func`.
+ *
+ * @param n Number of items to process.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ * @param func Chunk processor, callable as `func(int begin, int end)`.
+ * @param min_chunk Minimum number of items per thread; should be large for cheap items, so as not to spawn threads
+ *   for tiny ranges, and can be 1 for items that take long to process.
+ */
+template <typename F>
+void parallel_for(int n, int nthreads, F func, int min_chunk = 64) {
+    if (nthreads <= 0) {
+        nthreads = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+    nthreads = std::max(1, std::min(nthreads, n / std::max(min_chunk, 1)));
+    if (nthreads == 1) {
+        if (n > 0) {
+            func(0, n);
+        }
+        return;
+    }
+    const int chunk = (n + nthreads - 1) / nthreads;
+    std::vector<std::thread> threads;
+    threads.reserve(nthreads - 1);
+    for (int begin = chunk; begin < n; begin += chunk) {
+        threads.emplace_back(func, begin, std::min(begin + chunk, n));
+    }
+    func(0, std::min(chunk, n));
+    for (auto& thread: threads) {
+        thread.join();
+    }
+}
+
+} // sla
+
+#endif // SLALIB_PARALLEL_H_INCLUDED
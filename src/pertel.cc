@@ -0,0 +1,86 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+
+namespace sla {
+
+/**
+ * Updates the osculating orbital elements of an asteroid or comet by applying planetary perturbations.
+ *
+ * The elements are with respect to the J2000 ecliptic and equinox, and must be in either OEF_MINOR_PLANET or OEF_COMET
+ * form (see sla::el2ue() for the meaning of the elements); the updated elements are returned in the same form.
+ *
+ * The elements `el0` are first propagated from their epoch to `date0`, the date from which the perturbations are
+ * integrated, using two-body (unperturbed) motion; if `date0` is the same as the epoch of the elements (which is the
+ * usual case for OEF_MINOR_PLANET form), this step does nothing. The perturbations are then integrated from `date0` to
+ * `date1` by sla::pertue() (see that function for details of the method and its accuracy), and the resulting
+ * universal elements are converted back to conventional form by sla::ue2el().
+ *
+ * For OEF_MINOR_PLANET form, the epoch of the updated elements is `date1`; for OEF_COMET form, it is the date of
+ * perihelion passage of the osculating orbit at `date1`.
+ *
+ * To update the elements of many bodies, convert them to universal form with sla::el2ue() and use
+ * sla::pertue_batch(), which integrates all of them concurrently and shares the planetary ephemerides between them.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date0 Date (TT MJD) of the start of the perturbation calculations.
+ * @param date1 Date (TT MJD) of the end of the perturbation calculations, to which the elements are updated.
+ * @param el0 Osculating orbital elements of the body.
+ * @param el1 Return value: updated osculating orbital elements; unchanged in case of an error.
+ * @return Status: OES_OK, OES_CLOSE_APPROACH (warning: the body passed very close to a perturbing body),
+ *   OES_BAD_FORM (form is not OEF_MINOR_PLANET or OEF_COMET), OES_BAD_ECCENTRICITY, OES_BAD_DISTANCE, or an error
+ *   returned by sla::el2ue(), sla::pertue(), or sla::ue2el() (numerical error).
+ */
+OEStatus pertel(double date0, double date1, const OrbitalElements& el0, OrbitalElements& el1) {
+    // check that the elements are either minor-planet or comet format
+    if (el0.oe_form != OEF_MINOR_PLANET && el0.oe_form != OEF_COMET) {
+        return OES_BAD_FORM;
+    }
+
+    // check the eccentricity and distance
+    if (el0.oe_e < 0.0 || el0.oe_e > 10.0 || (el0.oe_e >= 1.0 && el0.oe_form != OEF_COMET)) {
+        return OES_BAD_ECCENTRICITY;
+    }
+    if (el0.oe_aorq <= 0.0) {
+        return OES_BAD_DISTANCE;
+    }
+
+    // transform the elements from conventional to universal form
+    UniversalElements u;
+    OEStatus status = el2ue(date0, el0, u);
+    if (status != OES_OK) {
+        return status;
+    }
+
+    // update the universal elements to date `date1`
+    const OEStatus result = pertue(date1, u);
+    if (result != OES_OK && result != OES_CLOSE_APPROACH) {
+        return result;
+    }
+
+    // transform from universal to conventional elements
+    OrbitalElements elements;
+    if ((status = ue2el(u, el0.oe_form, elements)) != OES_OK) {
+        return status;
+    }
+    el1 = elements;
+    return result;
+}
+
+}
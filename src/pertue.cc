@@ -0,0 +1,462 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sla {
+
+// Gaussian gravitational constant (exact), squared
+static constexpr double GCON2 = 0.01720209895 * 0.01720209895;
+
+// seconds per day
+static constexpr double SPD = 86400.0;
+
+// perturbing bodies: Mercury to Neptune (with the Earth-Moon barycentre as the third one), then the Earth and the Moon
+static constexpr int N_PLANETS = 8;
+static constexpr int EMB = 2;
+static constexpr int EARTH = 8;
+static constexpr int MOON = 9;
+static constexpr int N_PERTURBERS = 10;
+
+// inverse masses of the perturbing bodies
+static const double AMAS[N_PERTURBERS] = {
+    6023600.0, 408523.5, 328900.5, 3098710.0, 1047.355, 3498.5, 22869.0, 19314.0, 332946.038, 27068709.3
+};
+
+// ratio of the mass of the Moon to that of the Earth-Moon system
+static constexpr double EMMR = 0.012150581;
+
+// distance from the Earth-Moon barycentre (AU) within which the Earth and the Moon are treated separately
+static constexpr double RNE = 1.0;
+
+// distance from a perturbing body (AU) that is deemed to be a close approach
+static constexpr double COINC = 1.0e-4;
+
+// coefficient relating the timestep to the time scales of the perturbations, and limits of the timestep (days)
+static constexpr double TSC = 0.05;
+static constexpr double TSMIN = 0.01;
+static constexpr double TSMAX = 10.0;
+
+// spacing of the ephemeris nodes (days) for the planets, and for the Earth and the Moon
+static constexpr double PLANET_SPACING = 2.0;
+static constexpr double EARTH_MOON_SPACING = 1.0;
+
+/*
+ * Positions and velocities of the perturbing bodies, tabulated at equally spaced nodes and interpolated between them;
+ * node dates are multiples of the spacing, so any two tables hold identical values for the same node. Nodes are
+ * computed on demand, unless the whole table is filled up front (as it must be before sharing it between threads).
+ */
+class PerturberTable {
+    double pt_spacing;           // spacing of the nodes (days)
+    int pt_first;                // index of the first node (date divided by spacing)
+    int pt_nbodies;              // number of bodies per node
+    bool pt_earth_moon;          // `true` if the table holds the Earth and the Moon, `false` if it holds the planets
+    std::vector<double> pt_pv;   // node states: position (AU) and velocity (AU/day) for every body
+    std::vector<char> pt_ready;  // non-zero for the nodes that have been computed
+
+    void compute(int first, int last);
+    const double* node(int index);
+
+public:
+    PerturberTable(bool earth_moon, double date1, double date2);
+    void fill(int nthreads);
+    void interpolate(double date, double pos[][3], double vel[][3]);
+};
+
+PerturberTable::PerturberTable(bool earth_moon, double date1, double date2):
+    pt_spacing(earth_moon? EARTH_MOON_SPACING: PLANET_SPACING), pt_nbodies(earth_moon? 2: N_PLANETS),
+    pt_earth_moon(earth_moon) {
+    pt_first = (int) std::floor(std::min(date1, date2) / pt_spacing);
+    const int n = (int) std::floor(std::max(date1, date2) / pt_spacing) - pt_first + 2;
+    pt_pv.resize((std::size_t) n * pt_nbodies * 6);
+    pt_ready.resize(n, 0);
+}
+
+// computes nodes [first..last) of the table
+void PerturberTable::compute(int first, int last) {
+    constexpr int CHUNK = 64;
+    double dates[CHUNK];
+    VectorPV<double> pv[9 * CHUNK];
+    PLStatus status[9 * CHUNK];
+    for (int base = first; base < last; base += CHUNK) {
+        const int count = std::min(CHUNK, last - base);
+        for (int k = 0; k < count; k++) {
+            dates[k] = (pt_first + base + k) * pt_spacing;
+        }
+        // only Mercury to Neptune perturb the bodies (and only the Earth-Moon barycentre is needed for the Earth and
+        // the Moon), so Pluto is not computed
+        planet_batch(count, dates, pv, status, pt_earth_moon? EMB + 1: N_PLANETS);
+        if (pt_earth_moon) {
+            // geocentric Moon (mean of date), which is then referred to J2000 and made heliocentric
+            VectorPV<double> moon[CHUNK];
+            dmoon_batch(count, dates, moon);
+            for (int k = 0; k < count; k++) {
+                Matrix<double> rmat;
+                Vector<double> mp, mv;
+                prec(epj(dates[k]), 2000.0, rmat);
+                dmxv(rmat, moon[k].get_position(), mp);
+                dmxv(rmat, moon[k].get_velocity(), mv);
+                const VectorPV<double>& emb = pv[9 * k + EMB];
+                double* out = &pt_pv[(std::size_t) (base + k) * 2 * 6];
+                for (int i = 0; i < 3; i++) {
+                    out[i] = emb.get_position()[i] - EMMR * mp[i];
+                    out[3 + i] = (emb.get_velocity()[i] - EMMR * mv[i]) * SPD;
+                    out[6 + i] = emb.get_position()[i] + (1.0 - EMMR) * mp[i];
+                    out[9 + i] = (emb.get_velocity()[i] + (1.0 - EMMR) * mv[i]) * SPD;
+                }
+                pt_ready[base + k] = 1;
+            }
+        } else {
+            for (int k = 0; k < count; k++) {
+                double* out = &pt_pv[(std::size_t) (base + k) * N_PLANETS * 6];
+                for (int np = 0; np < N_PLANETS; np++) {
+                    const VectorPV<double>& ppv = pv[9 * k + np];
+                    for (int i = 0; i < 3; i++) {
+                        out[6 * np + i] = ppv.get_position()[i];
+                        out[6 * np + 3 + i] = ppv.get_velocity()[i] * SPD;
+                    }
+                }
+                pt_ready[base + k] = 1;
+            }
+        }
+    }
+}
+
+// returns states of the bodies at node `index`, computing them if necessary
+const double* PerturberTable::node(int index) {
+    if (!pt_ready[index]) {
+        compute(index, index + 1);
+    }
+    return &pt_pv[(std::size_t) index * pt_nbodies * 6];
+}
+
+// computes all nodes of the table, so that it can then be used by several threads concurrently
+void PerturberTable::fill(int nthreads) {
+    parallel_for((int) pt_ready.size(), nthreads, [this](int first, int last) {
+        compute(first, last);
+    }, 64);
+}
+
+// positions (AU) and velocities (AU/day) of all bodies in the table at given date, by cubic Hermite interpolation
+void PerturberTable::interpolate(double date, double pos[][3], double vel[][3]) {
+    const double x = date / pt_spacing;
+    const int index = std::min(std::max((int) std::floor(x) - pt_first, 0), (int) pt_ready.size() - 2);
+    const double s = x - (pt_first + index);
+    const double* a = node(index);
+    const double* b = node(index + 1);
+
+    // Hermite basis functions and their derivatives
+    const double s2 = s * s;
+    const double s3 = s2 * s;
+    const double h00 = 2.0 * s3 - 3.0 * s2 + 1.0;
+    const double h10 = (s3 - 2.0 * s2 + s) * pt_spacing;
+    const double h01 = 3.0 * s2 - 2.0 * s3;
+    const double h11 = (s3 - s2) * pt_spacing;
+    const double d00 = (6.0 * s2 - 6.0 * s) / pt_spacing;
+    const double d10 = 3.0 * s2 - 4.0 * s + 1.0;
+    const double d11 = 3.0 * s2 - 2.0 * s;
+    for (int np = 0; np < pt_nbodies; np++) {
+        const double* pa = a + 6 * np;
+        const double* pb = b + 6 * np;
+        for (int i = 0; i < 3; i++) {
+            pos[np][i] = h00 * pa[i] + h10 * pa[3 + i] + h01 * pb[i] + h11 * pb[3 + i];
+            vel[np][i] = d00 * (pa[i] - pb[i]) + d10 * pa[3 + i] + d11 * pb[3 + i];
+        }
+    }
+}
+
+/*
+ * States of the perturbing bodies at some date: all planets, plus the Earth and the Moon (if `earth_moon` is `true`,
+ * in which case the Earth-Moon barycentre is not used).
+ */
+struct Perturbers {
+    double p_pos[N_PERTURBERS][3]; // heliocentric positions (AU)
+    double p_vel[N_PERTURBERS][3]; // heliocentric velocities (AU/day)
+    bool p_earth_moon;             // `true` if the Earth and the Moon are treated separately
+};
+
+static void get_perturbers(PerturberTable& planets, PerturberTable& earth_moon, double date, bool separate,
+    Perturbers& p) {
+    planets.interpolate(date, p.p_pos, p.p_vel);
+    if (separate) {
+        earth_moon.interpolate(date, p.p_pos + EARTH, p.p_vel + EARTH);
+    }
+    p.p_earth_moon = separate;
+}
+
+/*
+ * Acceleration (AU/day^2) of the deviation `dr` of the body from its reference (unperturbed) orbit, where it is at
+ * `r0` at this moment: the difference between attractions of the Sun at actual and reference positions (`gm` is
+ * the gravitational parameter of the Sun and the body), plus direct and indirect perturbations by the planets.
+ * Returns the distance to the closest perturbing body.
+ */
+static double deviation_accel(double gm, const double r0[3], const double dr[3], const Perturbers& p, double acc[3]) {
+    double r[3];
+    for (int i = 0; i < 3; i++) {
+        r[i] = r0[i] + dr[i];
+    }
+    const double rr = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    const double rr0 = std::sqrt(r0[0] * r0[0] + r0[1] * r0[1] + r0[2] * r0[2]);
+    const double f = gm / (rr * rr * rr);
+    const double f0 = gm / (rr0 * rr0 * rr0);
+    for (int i = 0; i < 3; i++) {
+        acc[i] = f0 * r0[i] - f * r[i];
+    }
+
+    double dmin = 1.0e30;
+    for (int np = 0; np < N_PERTURBERS; np++) {
+        if (p.p_earth_moon? np == EMB: np >= EARTH) {
+            continue;
+        }
+        const double* rp = p.p_pos[np];
+        double d[3];
+        for (int i = 0; i < 3; i++) {
+            d[i] = rp[i] - r[i];
+        }
+        const double dd = std::sqrt(d[0] * d[0] + d[1] * d[1] + d[2] * d[2]);
+        const double rp2 = std::sqrt(rp[0] * rp[0] + rp[1] * rp[1] + rp[2] * rp[2]);
+        const double gmp = GCON2 / AMAS[np];
+        const double fd = gmp / (dd * dd * dd);
+        const double fi = gmp / (rp2 * rp2 * rp2);
+        for (int i = 0; i < 3; i++) {
+            acc[i] += fd * d[i] - fi * rp[i];
+        }
+        dmin = std::min(dmin, dd);
+    }
+    return dmin;
+}
+
+/*
+ * Timestep (days) suitable for integrating the perturbations of a body at `r` moving at `v`: a fraction of the
+ * shortest time scale among those of its heliocentric motion, and of its encounters with the perturbing bodies.
+ */
+static double timestep(const double r[3], const double v[3], const Perturbers& p) {
+    const double rr = std::sqrt(r[0] * r[0] + r[1] * r[1] + r[2] * r[2]);
+    const double vv = std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    double scale = rr / std::max(vv, 1.0e-12);
+    for (int np = 0; np < N_PERTURBERS; np++) {
+        if (p.p_earth_moon? np == EMB: np >= EARTH) {
+            continue;
+        }
+        double d2 = 0.0, w2 = 0.0;
+        for (int i = 0; i < 3; i++) {
+            const double d = p.p_pos[np][i] - r[i];
+            const double w = p.p_vel[np][i] - v[i];
+            d2 += d * d;
+            w2 += w * w;
+        }
+        const double d = std::sqrt(d2);
+        const double crossing = d / std::max(std::sqrt(w2), 1.0e-12);
+        const double dynamical = std::sqrt(d2 * d * AMAS[np] / GCON2);
+        scale = std::min(scale, std::min(crossing, dynamical));
+    }
+    return std::max(TSMIN, std::min(TSMAX, TSC * scale));
+}
+
+// integrates perturbations of one body from its epoch to `date` using given tables of perturbing bodies
+static OEStatus pertue_tables(PerturberTable& planets, PerturberTable& earth_moon, double date, UniversalElements& u,
+    double step_factor) {
+    UniversalElements ul = u;
+    const double gm = GCON2 * ul.ue_mass;
+    const double pmass = ul.ue_mass - 1.0;
+    OEStatus result = OES_OK;
+
+    // state at the start of the current step
+    double t = ul.ue_t0;
+    VectorPV<double> pv;
+    OEStatus status = ue2pv(t, ul, pv);
+    if (status != OES_OK) {
+        return status;
+    }
+
+    while (t != date) {
+        // state at the start of the step (AU, AU/day)
+        double r[3], v[3];
+        for (int i = 0; i < 3; i++) {
+            r[i] = pv.get_position()[i];
+            v[i] = pv.get_velocity()[i] * SPD;
+        }
+
+        // treat the Earth and the Moon separately if the body is near them
+        Perturbers p1;
+        get_perturbers(planets, earth_moon, t, false, p1);
+        double e2 = 0.0;
+        for (int i = 0; i < 3; i++) {
+            e2 += (r[i] - p1.p_pos[EMB][i]) * (r[i] - p1.p_pos[EMB][i]);
+        }
+        const bool separate = e2 < RNE * RNE;
+        if (separate) {
+            get_perturbers(planets, earth_moon, t, true, p1);
+        }
+
+        // timestep, with its sign and the last step clipped to the final date
+        double h = step_factor * timestep(r, v, p1);
+        const double left = date - t;
+        const double t_next = (std::fabs(left) <= h)? date: t + std::copysign(h, left);
+        h = t_next - t;
+
+        // reference orbit at midpoint and end of the step
+        VectorPV<double> pv_mid, pv_end;
+        if ((status = ue2pv(t + 0.5 * h, ul, pv_mid)) != OES_OK || (status = ue2pv(t_next, ul, pv_end)) != OES_OK) {
+            return status;
+        }
+        const double* r_mid = pv_mid.get_position();
+        const double* r_end = pv_end.get_position();
+        Perturbers p2, p3;
+        get_perturbers(planets, earth_moon, t + 0.5 * h, separate, p2);
+        get_perturbers(planets, earth_moon, t_next, separate, p3);
+
+        // Runge-Kutta-Nystrom (fourth order) step for the deviation from the reference orbit; both the deviation and
+        // its rate are zero at the start of the step, and the two midpoint stages coincide, as the acceleration does
+        // not depend on velocity
+        const double zero[3] = {0.0, 0.0, 0.0};
+        double a1[3], a2[3], a4[3], dr[3];
+        double dmin = deviation_accel(gm, r, zero, p1, a1);
+        for (int i = 0; i < 3; i++) {
+            dr[i] = 0.125 * h * h * a1[i];
+        }
+        dmin = std::min(dmin, deviation_accel(gm, r_mid, dr, p2, a2));
+        for (int i = 0; i < 3; i++) {
+            dr[i] = 0.5 * h * h * a2[i];
+        }
+        dmin = std::min(dmin, deviation_accel(gm, r_end, dr, p3, a4));
+        if (dmin < COINC) {
+            result = OES_CLOSE_APPROACH;
+        }
+
+        // perturbed state at the end of the step, from which the reference orbit is rectified
+        Vector<double> pos, vel;
+        for (int i = 0; i < 3; i++) {
+            pos[i] = r_end[i] + h * h * (a1[i] + 2.0 * a2[i]) / 6.0;
+            vel[i] = pv_end.get_velocity()[i] + h * (a1[i] + 4.0 * a2[i] + a4[i]) / 6.0 / SPD;
+        }
+        pv = VectorPV<double>(pos, vel);
+        if ((status = pv2ue(pv, t_next, pmass, ul)) != OES_OK) {
+            return status;
+        }
+        t = t_next;
+    }
+    u = ul;
+    return result;
+}
+
+/**
+ * Updates the universal elements of an asteroid or comet by applying planetary perturbations.
+ *
+ * The universal elements are updated from their reference epoch (the `ue_t0` member) to `date`, which becomes the
+ * new reference epoch; the elements can then be used by sla::ue2pv() or converted by sla::ue2el().
+ *
+ * The "universal" elements are those which define the orbit for the purposes of the method of universal variables
+ * (see reference 2). They consist of the combined mass of the Sun and body, the total energy of the orbit, the
+ * reference epoch with the position and velocity at that epoch, plus various auxiliary data (see sla::pv2ue()).
+ *
+ * The perturbations are integrated using the method of Encke: the deviation of the body from its unperturbed
+ * (two-body) orbit is integrated numerically with a fourth-order Runge-Kutta-Nystrom scheme, and the orbit is
+ * rectified (the universal elements recomputed from the perturbed position and velocity) after every step. The
+ * timestep is a fraction of the shortest among the time scales of the body's heliocentric motion and of its
+ * encounters with the planets (their distance divided by relative speed, and the dynamical time of the encounter),
+ * and is kept within 0.01-10 days (before being multiplied by `step_factor`).
+ *
+ * The perturbing bodies are the eight major planets Mercury to Neptune; within 1 AU of the Earth-Moon barycentre, the
+ * Earth and the Moon are treated separately. The planetary positions are obtained from sla::planet() and sla::dmoon()
+ * at equally spaced dates (2 days apart for the planets, 1 day for the Earth and the Moon) and are interpolated
+ * between them. Pluto is not included.
+ *
+ * The accuracy is limited by that of the planetary ephemerides: a few parts in 10^5 of the perturbations themselves
+ * for typical cases, with the exception of very close encounters. A body passing within 1e-4 AU of a perturbing body
+ * gets the elements updated, but the OES_CLOSE_APPROACH warning is returned.
+ *
+ * The function sla::pertue_batch() integrates many bodies concurrently, sharing the planetary ephemerides between
+ * them.
+ *
+ * References:
+ *   1. Sterne, Theodore E., "An Introduction to Celestial Mechanics", Interscience Publishers Inc., 1960.
+ *   2. Everhart, E. & Pitkin, E.T., Am.J.Phys. 51, 712, 1983.
+ *
+ * @param date Final epoch (TT MJD) for the updated elements.
+ * @param u Universal orbital elements, updated in place; on error, `u` is not changed.
+ * @param step_factor Factor applied to the timestep: smaller values make the integration more accurate (errors of the
+ *   integration itself scale as the fourth power of the timestep) at proportionally higher cost.
+ * @return Status: OES_OK, OES_CLOSE_APPROACH (warning: the body passed very close to a perturbing body, the result
+ *   is unreliable), or an error returned by sla::ue2pv() or sla::pv2ue() (numerical error).
+ */
+OEStatus pertue(double date, UniversalElements& u, double step_factor) {
+    assert(step_factor > 0.0);
+    PerturberTable planets(false, u.ue_t0, date);
+    PerturberTable earth_moon(true, u.ue_t0, date);
+    return pertue_tables(planets, earth_moon, date, u, step_factor);
+}
+
+/// Implementation of sla::pertue_batch() for statuses accessed through a pointer or sla::StridedSpan.
+template <typename S>
+static void pertue_many(double date, UniversalElementsArray& elements, S status, int nthreads, double step_factor) {
+    assert(step_factor > 0.0);
+    const int n = elements.size();
+    if (n == 0) {
+        return;
+    }
+    double first = date, last = date;
+    UniversalElements u;
+    for (int i = 0; i < n; i++) {
+        elements.get(i, u);
+        first = std::min(first, u.ue_t0);
+        last = std::max(last, u.ue_t0);
+    }
+    PerturberTable planets(false, first, last);
+    PerturberTable earth_moon(true, first, last);
+    planets.fill(nthreads);
+    earth_moon.fill(nthreads);
+
+    parallel_for(n, nthreads, [&](int begin, int end) {
+        UniversalElements ui;
+        for (int i = begin; i < end; i++) {
+            elements.get(i, ui);
+            status[i] = pertue_tables(planets, earth_moon, date, ui, step_factor);
+            elements.set(i, ui);
+        }
+    }, 1);
+}
+
+/**
+ * Updates the universal elements of many asteroids or comets by applying planetary perturbations.
+ *
+ * Results are identical to those of the sla::pertue() function. The planetary ephemerides are computed once, for the
+ * time span covered by all bodies, and are then shared by all of them; the bodies are integrated concurrently.
+ *
+ * @param date Final epoch (TT MJD) for the updated elements.
+ * @param elements Universal orbital elements, updated in place; elements of the bodies that fail are not changed.
+ * @param status Return value: `elements.size()` statuses (see sla::pertue()).
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ * @param step_factor Factor applied to the timestep (see sla::pertue()).
+ */
+void pertue_batch(double date, UniversalElementsArray& elements, OEStatus* status, int nthreads,
+    double step_factor) {
+    pertue_many(date, elements, status, nthreads, step_factor);
+}
+
+/// Version of sla::pertue_batch() that stores statuses through a strided span of `elements.size()` items.
+void pertue_batch(double date, UniversalElementsArray& elements, StridedSpan<OEStatus> status, int nthreads,
+    double step_factor) {
+    assert(status.get_size() == elements.size());
+    pertue_many(date, elements, status, nthreads, step_factor);
+}
+
+}
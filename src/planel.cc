@@ -0,0 +1,86 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "parallel.h"
+
+namespace sla {
+
+/**
+ * Heliocentric position and velocity of a planet, asteroid or comet, starting from orbital elements.
+ *
+ * The elements are with respect to the J2000 ecliptic and equinox; see sla::el2ue() for their meaning in each of the
+ * three forms (OEF_MAJOR_PLANET, OEF_MINOR_PLANET, and OEF_COMET).
+ *
+ * The elements are converted to universal form for `date` by sla::el2ue(), which also gives the position and velocity
+ * at that date; this is a two-body (unperturbed) prediction, so the accuracy is limited by that of the elements and
+ * decreases with the time elapsed since their epoch. If many predictions are to be made for the same body, it is
+ * more efficient to convert the elements once with sla::el2ue() and then use sla::ue2pv().
+ *
+ * Reference: H.M.Smart, "Textbook on Spherical Astronomy", sixth edition, Cambridge University Press, 1977.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date Date (TT MJD).
+ * @param elements Osculating orbital elements of the body.
+ * @param pv Return value: heliocentric {x,y,z},{xdot,ydot,zdot}, J2000 equatorial triad (AU, AU/s).
+ * @return Status: OES_OK, or an error returned by sla::el2ue() (illegal elements or numerical error).
+ */
+OEStatus planel(double date, const OrbitalElements& elements, VectorPV<double>& pv) {
+    // validate the elements and convert them to "universal variables" parameters
+    UniversalElements u;
+    OEStatus status = el2ue(date, elements, u);
+    if (status == OES_OK) {
+        // determine the position and velocity
+        status = ue2pv(date, u, pv);
+    }
+    return status;
+}
+
+/**
+ * Heliocentric positions and velocities of many planets, asteroids or comets, starting from orbital elements.
+ *
+ * Results are identical to those of the sla::planel() function; bodies are processed concurrently.
+ *
+ * @param date Date (TT MJD).
+ * @param n Number of bodies.
+ * @param elements Osculating orbital elements of the bodies.
+ * @param pv Return value: `n` heliocentric {x,y,z},{xdot,ydot,zdot}, J2000 equatorial triads (AU, AU/s).
+ * @param status Return value: `n` statuses (see sla::planel()).
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void planel_batch(double date, int n, const OrbitalElements* elements, VectorPV<double>* pv, OEStatus* status,
+    int nthreads) {
+    parallel_for(n, nthreads, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            status[i] = planel(date, elements[i], pv[i]);
+        }
+    }, 64);
+}
+
+/// Version of sla::planel_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void planel_batch(double date, StridedSpan<const OrbitalElements> elements, StridedSpan<VectorPV<double>> pv,
+    StridedSpan<OEStatus> status, int nthreads) {
+    parallel_span_tiles(elements.get_size(), nthreads, [date](int n, auto elements, auto pv, auto status) {
+        for (int i = 0; i < n; i++) {
+            status[i] = planel(date, elements[i], pv[i]);
+        }
+    }, elements, pv, status);
+}
+
+}
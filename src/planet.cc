@@ -0,0 +1,624 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "dispatch.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sla {
+
+// number of dates processed together
+static constexpr int CHUNK = 32;
+
+// 2Pi, arcseconds to radians, and degrees to radians
+static constexpr double D2PI = 6.283185307179586476925287;
+static constexpr double AS2R = 4.848136811095359935899141e-6;
+static constexpr double D2R = 0.017453292519943295769236907;
+
+// Gaussian gravitational constant (exact)
+static constexpr double GCON = 0.01720209895;
+
+// sin and cos of J2000 mean obliquity (IAU 1976)
+static constexpr double SE = 0.3977771559319137;
+static constexpr double CE = 0.9174820620691818;
+
+// seconds per day and per Julian century
+static constexpr double SPD = 86400.0;
+static constexpr double SPC = 36525.0 * 86400.0;
+
+/*
+ * Mercury to Neptune: mean elements and trigonometric terms by Simon et al. (1994); each row is for one planet.
+ */
+
+// planetary inverse masses
+static const double AMAS[8] = {6023600.0, 408523.5, 328900.5, 3098710.0, 1047.355, 3498.5, 22869.0, 19314.0};
+
+// semi-major axis (AU)
+static const double A[8][3] = {
+    {0.3870983098, 0.0, 0.0},
+    {0.7233298200, 0.0, 0.0},
+    {1.0000010178, 0.0, 0.0},
+    {1.5236793419, 3e-10, 0.0},
+    {5.2026032092, 19132e-10, -39e-10},
+    {9.5549091915, -0.0000213896, 444e-10},
+    {19.2184460618, -3716e-10, 979e-10},
+    {30.1103868694, -16635e-10, 686e-10}
+};
+
+// mean longitude (degree and arcsecond)
+static const double DLM[8][3] = {
+    {252.25090552, 5381016286.88982, -1.92789},
+    {181.97980085, 2106641364.33548, 0.59381},
+    {100.46645683, 1295977422.83429, -2.04411},
+    {355.43299958, 689050774.93988, 0.94264},
+    {34.35151874, 109256603.77991, -30.60378},
+    {50.07744430, 43996098.55732, 75.61614},
+    {314.05500511, 15424811.93933, -1.75083},
+    {304.34866548, 7865503.20744, 0.21103}
+};
+
+// eccentricity
+static const double E[8][3] = {
+    {0.2056317526, 0.0002040653, -28349e-10},
+    {0.0067719164, -0.0004776521, 98127e-10},
+    {0.0167086342, -0.0004203654, -0.0000126734},
+    {0.0934006477, 0.0009048438, -80641e-10},
+    {0.0484979255, 0.0016322542, -0.0000471366},
+    {0.0555481426, -0.0034664062, -0.0000643639},
+    {0.0463812221, -0.0002729293, 0.0000078913},
+    {0.0094557470, 0.0000603263, 0.0}
+};
+
+// longitude of perihelion (degree and arcsecond)
+static const double PI[8][3] = {
+    {77.45611904, 5719.11590, -4.83016},
+    {131.56370300, 175.48640, -498.48184},
+    {102.93734808, 11612.35290, 53.27577},
+    {336.06023395, 15980.45908, -62.32800},
+    {14.33120687, 7758.75163, 259.95938},
+    {93.05723748, 20395.49439, 190.25952},
+    {173.00529106, 3215.56238, -34.09288},
+    {48.12027554, 1050.71912, 27.39717}
+};
+
+// inclination (degree and arcsecond)
+static const double DINC[8][3] = {
+    {7.00498625, -214.25629, 0.28977},
+    {3.39466189, -30.84437, -11.67836},
+    {0.0, 469.97289, -3.35053},
+    {1.84972648, -293.31722, -8.11830},
+    {1.30326698, -71.55890, 11.95297},
+    {2.48887878, 91.85195, -17.66225},
+    {0.77319689, -60.72723, 1.25759},
+    {1.76995259, 8.12333, 0.08135}
+};
+
+// longitude of the ascending node (degree and arcsecond)
+static const double OMEGA[8][3] = {
+    {48.33089304, -4515.21727, -31.79892},
+    {76.67992019, -10008.48154, -51.32614},
+    {174.87317577, -8679.27034, 15.34191},
+    {49.55809321, -10620.90088, -230.57416},
+    {100.46440702, 6362.03561, 326.52178},
+    {113.66550252, -9240.19942, -66.23743},
+    {74.00595701, 2669.15033, 145.93964},
+    {131.78405702, -221.94322, -0.78728}
+};
+
+// trigonometric terms to be added to the mean elements of the semi-major axes
+static const double KP[8][9] = {
+    {69613, 75645, 88306, 59899, 15746, 71087, 142173, 3086, 0},
+    {21863, 32794, 26934, 10931, 26250, 43725, 53867, 28939, 0},
+    {16002, 21863, 32004, 10931, 14529, 16368, 15318, 32794, 0},
+    {6345, 7818, 15636, 7077, 8184, 14163, 1107, 4872, 0},
+    {1760, 1454, 1167, 880, 287, 2640, 19, 2047, 1454},
+    {574, 0, 880, 287, 19, 1760, 1167, 306, 574},
+    {204, 0, 177, 1265, 4, 385, 200, 208, 204},
+    {0, 102, 106, 4, 98, 1367, 487, 204, 0}
+};
+static const double CA[8][9] = {
+    {4, -13, 11, -9, -9, -3, -1, 4, 0},
+    {-156, 59, -42, 6, 19, -20, -10, -12, 0},
+    {64, -152, 62, -8, 32, -41, 19, -11, 0},
+    {124, 621, -145, 208, 54, -57, 30, 15, 0},
+    {-23437, -2634, 6601, 6259, -1507, -1821, 2620, -2115, -1489},
+    {62911, -119919, 79336, 17814, -24241, 12068, 8306, -4893, 8902},
+    {389061, -262125, -44088, 8387, -22976, -2093, -615, -9720, 6633},
+    {-412235, -157046, -31430, 37817, -9740, -13, -7449, 9644, 0}
+};
+static const double SA[8][9] = {
+    {-29, -1, 9, 6, -6, 5, 4, 0, 0},
+    {-48, -125, -26, -37, 18, -13, -20, -2, 0},
+    {-150, -46, 68, 54, 14, 24, -28, 22, 0},
+    {-621, 532, -694, -20, 192, -94, 71, -73, 0},
+    {-14614, -19828, -5869, 1881, -4372, -2255, 782, 930, 913},
+    {139737, 0, 24667, 51123, -5102, 7429, -4095, -1976, -9566},
+    {-138081, 0, 37205, -49039, -41901, -33872, -27037, -12474, 18797},
+    {0, 28492, 133236, 69654, 52322, -49577, -26430, -3593, 0}
+};
+
+// trigonometric terms to be added to the mean elements of the mean longitudes
+static const double KQ[8][10] = {
+    {3086, 15746, 69613, 59899, 75645, 88306, 12661, 2658, 0, 0},
+    {21863, 32794, 10931, 73, 4387, 26934, 1473, 2157, 0, 0},
+    {10, 16002, 21863, 10931, 1473, 32004, 4387, 73, 0, 0},
+    {10, 6345, 7818, 1107, 15636, 7077, 8184, 532, 10, 0},
+    {19, 1760, 1454, 287, 1167, 880, 574, 2640, 19, 1454},
+    {19, 574, 287, 306, 1760, 12, 31, 38, 19, 574},
+    {4, 204, 177, 8, 31, 200, 1265, 102, 4, 204},
+    {4, 102, 106, 8, 98, 1367, 487, 204, 4, 102}
+};
+static const double CL[8][10] = {
+    {21, -95, -157, 41, -5, 42, 23, 30, 0, 0},
+    {-160, -313, -235, 60, -74, -76, -27, 34, 0, 0},
+    {-325, -322, -79, 232, -52, 97, 55, -41, 0, 0},
+    {2268, -979, 802, 602, -668, -33, 345, 201, -55, 0},
+    {7610, -4997, -7689, -5841, -2617, 1115, -748, -607, 6074, 354},
+    {-18549, 30125, 20012, -730, 824, 23, 1289, -352, -14767, -2062},
+    {-135245, -14594, 4197, -4030, -5630, -2898, 2540, -306, 2939, 1986},
+    {89948, 2103, 8963, 2695, 3682, 1648, 866, -154, -1963, -283}
+};
+static const double SL[8][10] = {
+    {-342, 136, -23, 62, 66, -52, -33, 17, 0, 0},
+    {524, -149, -35, 117, 151, 122, -71, -62, 0, 0},
+    {-105, -137, 258, 35, -116, -88, -112, -80, 0, 0},
+    {854, -205, -936, -240, 140, -341, -97, -232, 536, 0},
+    {-56980, 8016, 1012, 1448, -3024, -3710, 318, 503, 3767, 577},
+    {138606, -13478, -4964, 1441, -1319, -1482, 427, 1236, -9167, -1918},
+    {71234, -41116, 5334, -4935, -1848, 66, 434, -1748, 3780, -701},
+    {-47645, 11647, 2166, 3194, 679, 0, -244, -419, -2531, 48}
+};
+
+/*
+ * Pluto: periodic terms from Meeus, "Astronomical Algorithms", Table 37.A; each row holds multipliers of the
+ * fundamental arguments (Jupiter, Saturn, Pluto), then the A and B coefficients for longitude and latitude (in units of
+ * 1e-6 degree), and for radius vector (in units of 1e-7 AU).
+ */
+static constexpr int N_PLUTO_TERMS = 43;
+static const int PLUTO_TERMS[N_PLUTO_TERMS][9] = {
+    {0, 0, 1, -19799805, 19850055, -5452852, -14974862, 66865439, 68951812},
+    {0, 0, 2, 897144, -4954829, 3527812, 1672790, -11827535, -332538},
+    {0, 0, 3, 611149, 1211027, -1050748, 327647, 1593179, -1438890},
+    {0, 0, 4, -341243, -189585, 178690, -292153, -18444, 483220},
+    {0, 0, 5, 129287, -34992, 18650, 100340, -65977, -85431},
+    {0, 0, 6, -38164, 30893, -30697, -25823, 31174, -6032},
+    {0, 1, -1, 20442, -9987, 4878, 11248, -5794, 22161},
+    {0, 1, 0, -4063, -5071, 226, -64, 4601, 4032},
+    {0, 1, 1, -6016, -3336, 2030, -836, -1729, 234},
+    {0, 1, 2, -3956, 3039, 69, -604, -415, 702},
+    {0, 1, 3, -667, 3572, -247, -567, 239, 723},
+    {0, 2, -2, 1276, 501, -57, 1, 67, -67},
+    {0, 2, -1, 1152, -917, -122, 175, 1034, -451},
+    {0, 2, 0, 630, -1277, -49, -164, -129, 504},
+    {1, -1, 0, 2571, -459, -197, 199, 480, -231},
+    {1, -1, 1, 899, -1449, -25, 217, 2, -441},
+    {1, 0, -3, -1016, 1043, 589, -248, -3359, 265},
+    {1, 0, -2, -2343, -1012, -269, 711, 7856, -7832},
+    {1, 0, -1, 7042, 788, 185, 193, 36, 45763},
+    {1, 0, 0, 1199, -338, 315, 807, 8663, 8547},
+    {1, 0, 1, 418, -67, -130, -43, -809, -769},
+    {1, 0, 2, 120, -274, 5, 3, 263, -144},
+    {1, 0, 3, -60, -159, 2, 17, -126, 32},
+    {1, 0, 4, -82, -29, 2, 5, -35, -16},
+    {1, 1, -3, -36, -29, 2, 3, -19, -4},
+    {1, 1, -2, -40, 7, 3, 1, -15, 8},
+    {1, 1, -1, -14, 22, 2, -1, -4, 12},
+    {1, 1, 0, 4, 13, 1, -1, 5, 6},
+    {1, 1, 1, 5, 2, 0, -1, 3, 1},
+    {1, 1, 3, -1, 0, 0, 0, 6, -2},
+    {2, 0, -6, 2, 0, 0, -2, 2, 2},
+    {2, 0, -5, -4, 5, 2, 2, -2, -2},
+    {2, 0, -4, 4, -7, -7, 0, 14, 13},
+    {2, 0, -3, 14, 24, 10, -8, -63, 13},
+    {2, 0, -2, -49, -34, -3, 20, 136, -236},
+    {2, 0, -1, 163, -48, 6, 5, 273, 1065},
+    {2, 0, 0, 9, -24, 14, 17, 251, 149},
+    {2, 0, 1, -4, 1, -2, 0, -25, -9},
+    {2, 0, 2, -3, 1, 0, 0, 9, -2},
+    {2, 0, 3, 1, 3, 0, 0, -8, 7},
+    {3, 0, -2, -3, -1, 0, 1, 9, 5},
+    {3, 0, -1, 5, -3, 0, 0, -20, -34},
+    {3, 0, 0, 0, 0, 0, 0, 1, 0}
+};
+
+// Pluto: mean longitudes (degrees) and their rates of change (degrees per Julian century) of Jupiter, Saturn, Pluto
+static constexpr double DJ0 = 34.35, DJD = 3034.9057;
+static constexpr double DS0 = 50.08, DSD = 1222.1138;
+static constexpr double DP0 = 238.96, DPD = 144.9600;
+
+// Pluto: constant terms of longitude (degrees) and its rate (degrees per Julian century), latitude (degrees), and
+// radius vector (AU)
+static constexpr double DL0 = 238.958116, DLD0 = 144.96;
+static constexpr double DB0 = -3.908239;
+static constexpr double DR0 = 40.7241346;
+
+// date-dependent terms shared by all planets: Julian millennia (`tm`) and centuries (`tc`) since J2000, and the
+// argument of the trigonometric terms of Simon et al (`dmu`)
+static SLALIB_KERNEL void date_terms(int count, const double* dates, double* tm, double* tc, double* dmu) {
+    for (int k = 0; k < count; k++) {
+        tm[k] = (dates[k] - 51544.5) / 365250.0;
+        tc[k] = (dates[k] - 51544.5) / 36525.0;
+        dmu[k] = 0.35953620 * tm[k];
+    }
+}
+
+/*
+ * Heliocentric positions and velocities of one of the planets Mercury to Neptune (`ip` = 0 to 7) for up to CHUNK dates
+ * given as Julian millennia since J2000 (`t`), along with the corresponding arguments of the trigonometric terms
+ * (`dmu`, see date_terms()); results for date `k` go to `pv[k * stride]` and `status[k * stride]`.
+ *
+ * All steps are loops over dates; the iterative solution of Kepler's equation masks out dates that have already
+ * converged, so results do not depend on the number of dates processed together.
+ */
+static SLALIB_KERNEL void simon_lanes(int ip, int count, const double* t, const double* dmu, VectorPV<double>* pv,
+    PLStatus* status, int stride) {
+    // maximum number of iterations allowed when solving Kepler's equation
+    constexpr int KMAX = 10;
+
+    double da[CHUNK], dl[CHUNK], de[CHUNK], dp[CHUNK], di[CHUNK], dom[CHUNK];
+    double am[CHUNK], ae[CHUNK];
+    bool active[CHUNK];
+    int kount[CHUNK];
+
+    // compute the mean elements
+    for (int k = 0; k < count; k++) {
+        const double tk = t[k];
+        da[k] = A[ip][0] + (A[ip][1] + A[ip][2] * tk) * tk;
+        dl[k] = (3600.0 * DLM[ip][0] + (DLM[ip][1] + DLM[ip][2] * tk) * tk) * AS2R;
+        de[k] = E[ip][0] + (E[ip][1] + E[ip][2] * tk) * tk;
+        dp[k] = (3600.0 * PI[ip][0] + (PI[ip][1] + PI[ip][2] * tk) * tk) * AS2R;
+        di[k] = (3600.0 * DINC[ip][0] + (DINC[ip][1] + DINC[ip][2] * tk) * tk) * AS2R;
+        dom[k] = (3600.0 * OMEGA[ip][0] + (OMEGA[ip][1] + OMEGA[ip][2] * tk) * tk) * AS2R;
+    }
+    for (int k = 0; k < count; k++) {
+        dp[k] = dranrm(dp[k]);
+        dom[k] = dranrm(dom[k]);
+    }
+
+    // apply the trigonometric terms
+    for (int j = 0; j < 8; j++) {
+        for (int k = 0; k < count; k++) {
+            const double arga = KP[ip][j] * dmu[k];
+            const double argl = KQ[ip][j] * dmu[k];
+            da[k] += (CA[ip][j] * std::cos(arga) + SA[ip][j] * std::sin(arga)) * 1.0e-7;
+            dl[k] += (CL[ip][j] * std::cos(argl) + SL[ip][j] * std::sin(argl)) * 1.0e-7;
+        }
+    }
+    for (int k = 0; k < count; k++) {
+        const double arga = KP[ip][8] * dmu[k];
+        da[k] += t[k] * (CA[ip][8] * std::cos(arga) + SA[ip][8] * std::sin(arga)) * 1.0e-7;
+    }
+    for (int j = 8; j < 10; j++) {
+        for (int k = 0; k < count; k++) {
+            const double argl = KQ[ip][j] * dmu[k];
+            dl[k] += t[k] * (CL[ip][j] * std::cos(argl) + SL[ip][j] * std::sin(argl)) * 1.0e-7;
+        }
+    }
+
+    // iterative solution of Kepler's equation to get eccentric anomaly
+    for (int k = 0; k < count; k++) {
+        dl[k] = std::fmod(dl[k], D2PI);
+        am[k] = dl[k] - dp[k];
+        ae[k] = am[k] + de[k] * std::sin(am[k]);
+        active[k] = true;
+        kount[k] = 0;
+    }
+    for (int iter = 0; iter < KMAX; iter++) {
+        bool any_active = false;
+        for (int k = 0; k < count; k++) {
+            const double dae = (am[k] - ae[k] + de[k] * std::sin(ae[k])) / (1.0 - de[k] * std::cos(ae[k]));
+            ae[k] = active[k]? ae[k] + dae: ae[k];
+            kount[k] += active[k]? 1: 0;
+            active[k] = active[k] && std::fabs(dae) > 1.0e-12;
+            any_active = any_active || active[k];
+        }
+        if (!any_active) {
+            break;
+        }
+    }
+
+    for (int k = 0; k < count; k++) {
+        // true anomaly
+        const double ae2 = ae[k] / 2.0;
+        const double at = 2.0 * std::atan2(std::sqrt((1.0 + de[k]) / (1.0 - de[k])) * std::sin(ae2), std::cos(ae2));
+
+        // distance (AU) and speed (radians per day)
+        const double r = da[k] * (1.0 - de[k] * std::cos(ae[k]));
+        const double v = GCON * std::sqrt((1.0 + 1.0 / AMAS[ip]) / (da[k] * da[k] * da[k]));
+
+        const double si2 = std::sin(di[k] / 2.0);
+        const double xq = si2 * std::cos(dom[k]);
+        const double xp = si2 * std::sin(dom[k]);
+        const double tl = at + dp[k];
+        const double xsw = std::sin(tl);
+        const double xcw = std::cos(tl);
+        const double xm2 = 2.0 * (xp * xcw - xq * xsw);
+        const double xf = da[k] / std::sqrt(1.0 - de[k] * de[k]);
+        const double ci2 = std::cos(di[k] / 2.0);
+        const double xms = (de[k] * std::sin(dp[k]) + xsw) * xf;
+        const double xmc = (de[k] * std::cos(dp[k]) + xcw) * xf;
+        const double xpxq2 = 2.0 * xp * xq;
+
+        // position (J2000 ecliptic x,y,z in AU), rotated to equatorial
+        double x = r * (xcw - xm2 * xp);
+        double y = r * (xsw + xm2 * xq);
+        double z = r * (-xm2 * ci2);
+        VectorPV<double>& out = pv[k * stride];
+        out.set_x(x);
+        out.set_y(y * CE - z * SE);
+        out.set_z(y * SE + z * CE);
+
+        // velocity (J2000 ecliptic xdot,ydot,zdot in AU/day), rotated to equatorial and scaled to AU/s
+        x = v * ((-1.0 + 2.0 * xp * xp) * xms + xpxq2 * xmc);
+        y = v * ((1.0 - 2.0 * xq * xq) * xmc - xpxq2 * xms);
+        z = v * (2.0 * ci2 * (xp * xms + xq * xmc));
+        out.set_dx(x / SPD);
+        out.set_dy((y * CE - z * SE) / SPD);
+        out.set_dz((y * SE + z * CE) / SPD);
+
+        // status: Kepler's equation used all KMAX iterations (flagged even if the last one converged, as in the
+        // Fortran original), or date outside 1000-3000 AD
+        PLStatus& st = status[k * stride];
+        if (kount[k] >= KMAX) {
+            st = PLS_NO_CONVERGENCE;
+        } else {
+            st = (std::fabs(t[k]) > 1.0)? PLS_DATE_WARNING: PLS_OK;
+        }
+    }
+}
+
+/*
+ * Heliocentric positions and velocities of Pluto for up to CHUNK dates given as Julian centuries since J2000; results
+ * for date `k` go to `pv[k * stride]` and `status[k * stride]`. Series terms are in the outer loop, and dates in the
+ * inner one.
+ */
+static SLALIB_KERNEL void pluto_lanes(int count, const double* t, VectorPV<double>* pv, PLStatus* status,
+    int stride) {
+    double dj[CHUNK], ds[CHUNK], dp[CHUNK];
+    double wlbr[3][CHUNK], wlbrd[3][CHUNK];
+
+    // fundamental arguments (radians)
+    for (int k = 0; k < count; k++) {
+        dj[k] = (DJ0 + DJD * t[k]) * D2R;
+        ds[k] = (DS0 + DSD * t[k]) * D2R;
+        dp[k] = (DP0 + DPD * t[k]) * D2R;
+        for (int i = 0; i < 3; i++) {
+            wlbr[i][k] = 0.0;
+            wlbrd[i][k] = 0.0;
+        }
+    }
+
+    // term by term through Meeus Table 37.A
+    for (const auto& term: PLUTO_TERMS) {
+        // argument multipliers, and rate of change of argument (radians per Julian century)
+        const double wj = term[0];
+        const double ws = term[1];
+        const double wp = term[2];
+        const double ald = (wj * DJD + ws * DSD + wp * DPD) * D2R;
+
+        // A and B coefficients (degrees, AU)
+        const double ac[3] = {term[3] * 1.0e-6, term[5] * 1.0e-6, term[7] * 1.0e-7};
+        const double bc[3] = {term[4] * 1.0e-6, term[6] * 1.0e-6, term[8] * 1.0e-7};
+
+        for (int k = 0; k < count; k++) {
+            // argument and its functions
+            const double al = wj * dj[k] + ws * ds[k] + wp * dp[k];
+            const double sal = std::sin(al);
+            const double cal = std::cos(al);
+
+            // periodic terms in longitude, latitude, radius vector (degrees, AU, per Julian century)
+            for (int i = 0; i < 3; i++) {
+                wlbr[i][k] += ac[i] * sal + bc[i] * cal;
+                wlbrd[i][k] += (ac[i] * cal - bc[i] * sal) * ald;
+            }
+        }
+    }
+
+    for (int k = 0; k < count; k++) {
+        // heliocentric longitude and derivative (radians, radians/sec)
+        const double dl = (DL0 + DLD0 * t[k] + wlbr[0][k]) * D2R;
+        const double dld = (DLD0 + wlbrd[0][k]) * D2R / SPC;
+
+        // heliocentric latitude and derivative (radians, radians/sec)
+        const double db = (DB0 + wlbr[1][k]) * D2R;
+        const double dbd = wlbrd[1][k] * D2R / SPC;
+
+        // heliocentric radius vector and derivative (AU, AU/sec)
+        const double dr = DR0 + wlbr[2][k];
+        const double drd = wlbrd[2][k] / SPC;
+
+        // functions of latitude, longitude, radius vector
+        const double sl = std::sin(dl);
+        const double cl = std::cos(dl);
+        const double sb = std::sin(db);
+        const double cb = std::cos(db);
+        const double slcb = sl * cb;
+        const double clcb = cl * cb;
+
+        // heliocentric vector and derivative, J2000 ecliptic and equinox
+        const double x = dr * clcb;
+        const double y = dr * slcb;
+        const double z = dr * sb;
+        const double xd = drd * clcb - dr * (cl * sb * dbd + slcb * dld);
+        const double yd = drd * slcb + dr * (-sl * sb * dbd + clcb * dld);
+        const double zd = drd * sb + dr * cb * dbd;
+
+        // transform to J2000 equator and equinox
+        VectorPV<double>& out = pv[k * stride];
+        out.set_x(x);
+        out.set_y(y * CE - z * SE);
+        out.set_z(y * SE + z * CE);
+        out.set_dx(xd);
+        out.set_dy(yd * CE - zd * SE);
+        out.set_dz(yd * SE + zd * CE);
+
+        // status: date outside 1885-2099 AD
+        status[k * stride] = (t[k] < -1.15 || t[k] > 1.0)? PLS_DATE_WARNING: PLS_OK;
+    }
+}
+
+/**
+ * Approximate heliocentric position and velocity of a specified major planet.
+ *
+ * The epoch, `date`, is in the TDB timescale and is a Modified Julian Date (JD-2400000.5).
+ *
+ * The reference frame is equatorial and is with respect to the mean equinox and ecliptic of epoch J2000.
+ *
+ * If a planet number `np` outside the range 1-9 is supplied, an error status (PLS_BAD_PLANET) is returned and the
+ * `pv` vector is set to zeroes.
+ *
+ * The algorithm for obtaining the mean elements of the planets from Mercury to Neptune is due to J.L. Simon, P.
+ * Bretagnon, J. Chapront, M. Chapront-Touze, G. Francou and J. Laskar (Bureau des Longitudes, Paris). The (completely
+ * different) algorithm for calculating the ecliptic coordinates of Pluto is by Meeus.
+ *
+ * Comparisons of the present function with the JPL DE200 ephemeris give the following RMS errors over the interval
+ * 1960-2025:
+ *
+ *                        position (km)     speed (metre/sec)
+ *
+ *        Mercury            334               0.437
+ *        Venus             1060               0.855
+ *        EMB               2010               0.815
+ *        Mars              7690               1.98
+ *        Jupiter          71700               7.70
+ *        Saturn          199000              19.4
+ *        Uranus          564000              16.4
+ *        Neptune         158000              14.4
+ *        Pluto              36400               0.137
+ *
+ * From comparisons with DE102, Simon et al quote the following longitude accuracies over the interval 1800-2200:
+ *
+ *        Mercury                 4"
+ *        Venus                   5"
+ *        EMB                     6"
+ *        Mars                   17"
+ *        Jupiter                71"
+ *        Saturn                 81"
+ *        Uranus                 86"
+ *        Neptune                11"
+ *
+ * In the case of Pluto, Meeus quotes an accuracy of 0.6 arcsec in longitude and 0.2 arcsec in latitude for the period
+ * 1885-2099.
+ *
+ * For all except Pluto, over the period 1000-3000 the accuracy is better than 1.5 times that over 1800-2200. Outside
+ * the period 1000-3000 the accuracy declines. For Pluto the accuracy declines rapidly outside the period 1885-2099.
+ * Outside these ranges, a warning status (PLS_DATE_WARNING) is returned.
+ *
+ * The algorithms for (i) Mercury through Neptune and (ii) Pluto are completely independent. In the Mercury through
+ * Neptune case, the present implementation differs from the original Simon et al Fortran code in the following
+ * respects: velocity as well as position is returned; the Kepler iteration is terminated on convergence rather than
+ * after a fixed number of steps (PLS_NO_CONVERGENCE is returned if the iteration limit is reached, even when the
+ * last step converged); and the result is rotated from the ecliptic to the J2000 equator.
+ *
+ * References:
+ *   1. Simon, J.L, Bretagnon, P., Chapront, J., Chapront-Touze, M., Francou, G., and Laskar, J., Astron. Astrophys.
+ *      282, 663 (1994).
+ *   2. Meeus, J., "Astronomical Algorithms", Willmann-Bell (1991).
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date TDB Modified Julian Date (JD-2400000.5).
+ * @param np Planet: 1 = Mercury, 2 = Venus, 3 = Earth-Moon barycentre, 4 = Mars, 5 = Jupiter, 6 = Saturn, 7 = Uranus,
+ *   8 = Neptune, 9 = Pluto.
+ * @param pv Return value: heliocentric {x,y,z},{xdot,ydot,zdot}, J2000 equatorial triad (AU, AU/s).
+ * @return Status: PLS_OK, PLS_DATE_WARNING, PLS_BAD_PLANET, or PLS_NO_CONVERGENCE.
+ */
+PLStatus planet(double date, int np, VectorPV<double>& pv) {
+    PLStatus status;
+    if (np < 1 || np > 9) {
+        const Vector<double> zero = {0.0, 0.0, 0.0};
+        pv = VectorPV<double>(zero, zero);
+        return PLS_BAD_PLANET;
+    }
+    double tm, tc, dmu;
+    date_terms(1, &date, &tm, &tc, &dmu);
+    if (np < 9) {
+        simon_lanes(np - 1, 1, &tm, &dmu, &pv, &status, 1);
+    } else {
+        pluto_lanes(1, &tc, &pv, &status, 1);
+    }
+    return status;
+}
+
+/// Body of sla::planet_batch(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL void planet_batch_kernel(int n, const double* dates, VectorPV<double>* pv, PLStatus* status,
+    int nplanets) {
+    for (int base = 0; base < n; base += CHUNK) {
+        const int count = std::min(CHUNK, n - base);
+
+        // terms that only depend on the date
+        double tm[CHUNK], tc[CHUNK], dmu[CHUNK];
+        date_terms(count, dates + base, tm, tc, dmu);
+
+        VectorPV<double>* chunk_pv = pv + 9 * base;
+        PLStatus* chunk_status = status + 9 * base;
+        for (int ip = 0; ip < std::min(nplanets, 8); ip++) {
+            simon_lanes(ip, count, tm, dmu, chunk_pv + ip, chunk_status + ip, 9);
+        }
+        if (nplanets == 9) {
+            pluto_lanes(count, tc, chunk_pv + 8, chunk_status + 8, 9);
+        }
+    }
+}
+
+static KernelDispatcher<planet_batch_kernel> planet_batch_dispatcher("planet_batch");
+static const bool planet_batch_enlisted = planet_batch_dispatcher.enlist();
+
+/**
+ * Approximate heliocentric positions and velocities of all major planets (Mercury to Pluto) for many dates.
+ *
+ * Results are identical to those of the sla::planet() function. Dates are processed in chunks; terms that only depend
+ * on the date are computed once per date and shared by all planets, and every step of the series evaluation and of the
+ * solution of Kepler's equation is a loop over dates that compilers can vectorize.
+ *
+ * @param n Number of dates.
+ * @param dates TDB Modified Julian Dates (JD-2400000.5).
+ * @param pv Return value: `9 * n` heliocentric {x,y,z},{xdot,ydot,zdot}, J2000 equatorial triads (AU, AU/s); state of
+ *   planet `np` (see sla::planet()) for date `i` is stored at index `9 * i + np - 1`.
+ * @param status Return value: `9 * n` statuses (see sla::planet()), indexed the same way as `pv`.
+ * @param nplanets Number of planets to compute, 1 to 9: only planets 1 to `nplanets` (e.g. 8 for Mercury to Neptune)
+ *   are computed, and entries of `pv` and `status` for the others are left unchanged.
+ */
+void planet_batch(int n, const double* dates, VectorPV<double>* pv, PLStatus* status, int nplanets) {
+    assert(nplanets >= 1 && nplanets <= 9);
+    planet_batch_dispatcher(n, dates, pv, status, nplanets);
+}
+
+/**
+ * Version of sla::planet_batch() that accesses items through strided spans (see sla::StridedSpan); `pv` and `status`
+ * must hold nine times as many items as `dates`.
+ */
+void planet_batch(StridedSpan<const double> dates, StridedSpan<VectorPV<double>> pv, StridedSpan<PLStatus> status) {
+    // tiles of dates are smaller than usual, so that tiles of results (nine per date) stay small, too
+    constexpr int DATES = SPAN_TILE / 8;
+    const int n = dates.get_size();
+    assert(pv.get_size() == 9 * n && status.get_size() == 9 * n);
+    SpanTile<const double, DATES> date_tile(dates);
+    SpanTile<VectorPV<double>, 9 * DATES> pv_tile(pv);
+    SpanTile<PLStatus, 9 * DATES> status_tile(status);
+    for (int first = 0; first < n; first += DATES) {
+        const int count = std::min(DATES, n - first);
+        planet_batch_dispatcher(count, date_tile.load(first, count), pv_tile.load(9 * first, 9 * count),
+            status_tile.load(9 * first, 9 * count), 9);
+        pv_tile.store(9 * first, 9 * count);
+        status_tile.store(9 * first, 9 * count);
+    }
+}
+
+}
@@ -0,0 +1,115 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include <vector>
+
+namespace sla {
+
+/**
+ * Topocentric apparent RA,Dec of a solar-system body whose heliocentric orbital elements are given, for the instant
+ * and observer of this context.
+ *
+ * See sla::plante() for details.
+ *
+ * @param elements Osculating orbital elements of the body.
+ * @param ra Return value: topocentric apparent RA (radians).
+ * @param dec Return value: topocentric apparent Dec (radians).
+ * @param r Return value: distance from observer (AU).
+ * @return Status, as returned by sla::planel(); in case of an error, `ra`, `dec`, and `r` are not changed.
+ */
+OEStatus TopocentricContext::plante(const OrbitalElements& elements, double& ra, double& dec, double& r) const {
+    VectorPV<double> pv;
+    const OEStatus status = planel(tc_date, elements, pv);
+    if (status == OES_OK) {
+        apparent(pv, ra, dec, r);
+    }
+    return status;
+}
+
+/**
+ * Topocentric apparent RA,Dec of many solar-system bodies whose heliocentric orbital elements are given, for the
+ * instant and observer of this context.
+ *
+ * Results are identical to those of the single-body version. Heliocentric states of the bodies are computed by
+ * sla::planel_batch(), and the observer state is shared by all bodies.
+ *
+ * @param n Number of bodies.
+ * @param elements Osculating orbital elements of the bodies.
+ * @param ra Return value: `n` topocentric apparent RAs (radians).
+ * @param dec Return value: `n` topocentric apparent Decs (radians).
+ * @param r Return value: `n` distances from observer (AU).
+ * @param status Return value: `n` statuses (see sla::planel()); bodies whose status is not OES_OK get zero RA, Dec,
+ *   and distance.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void TopocentricContext::plante(int n, const OrbitalElements* elements, double* ra, double* dec, double* r,
+    OEStatus* status, int nthreads) const {
+    std::vector<VectorPV<double>> pv(n);
+    planel_batch(tc_date, n, elements, pv.data(), status, nthreads);
+    apparent(n, pv.data(), status, ra, dec, r, nthreads);
+}
+
+/**
+ * Version of sla::TopocentricContext::plante() that accesses items through strided spans of the same size (see
+ * sla::StridedSpan); tiles of the spans are processed concurrently, body by body.
+ */
+void TopocentricContext::plante(StridedSpan<const OrbitalElements> elements, StridedSpan<double> ra,
+    StridedSpan<double> dec, StridedSpan<double> r, StridedSpan<OEStatus> status, int nthreads) const {
+    parallel_span_tiles(elements.get_size(), nthreads, [this](int n, auto elements, auto ra, auto dec, auto r,
+        auto status) {
+        for (int i = 0; i < n; i++) {
+            status[i] = plante(elements[i], ra[i], dec[i], r[i]);
+            if (status[i] != OES_OK) {
+                ra[i] = dec[i] = r[i] = 0.0;
+            }
+        }
+    }, elements, ra, dec, r, status);
+}
+
+/**
+ * Topocentric apparent RA,Dec of a solar-system body whose heliocentric orbital elements are given.
+ *
+ * The elements are with respect to the J2000 ecliptic and equinox; see sla::el2ue() for their meaning in each of the
+ * three forms. The elements are converted to universal form by sla::el2ue() for `date`, and the apparent place is
+ * then computed as by sla::plantu(), which see for details of the method and conventions.
+ *
+ * The accuracy is limited by that of the elements: planetary perturbations are not applied, so for dates far from
+ * the epoch of the elements, use sla::pertel() to update them first.
+ *
+ * To compute apparent places of many bodies for the same instant and observer, construct an sla::TopocentricContext
+ * and use its methods: the observer state is then computed only once.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date TT MJD of observation (JD-2400000.5).
+ * @param elong Observer's east longitude (radians).
+ * @param phi Observer's geodetic latitude (radians).
+ * @param elements Osculating orbital elements of the body.
+ * @param ra Return value: topocentric apparent RA (radians).
+ * @param dec Return value: topocentric apparent Dec (radians).
+ * @param r Return value: distance from observer (AU).
+ * @return Status: OES_OK, or an error returned by sla::el2ue() (illegal elements or numerical error); in case of an
+ *   error, `ra`, `dec`, and `r` are not changed.
+ */
+OEStatus plante(double date, double elong, double phi, const OrbitalElements& elements,
+    double& ra, double& dec, double& r) {
+    return TopocentricContext(date, elong, phi).plante(elements, ra, dec, r);
+}
+
+}
@@ -0,0 +1,230 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include "spans.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace sla {
+
+/**
+ * Computes the state of an observer at given instant, for subsequent computations of topocentric apparent places of
+ * solar-system bodies.
+ *
+ * The heliocentric position of the Earth is obtained from sla::epv(), and is rotated to the true equator and equinox
+ * of date using sla::prenut(); the position and velocity of the observer with respect to the Earth's centre is
+ * obtained from sla::pvobs(), with the local sidereal time computed from sla::gmst() (with UT1 approximated as TT
+ * minus sla::dt()). The observer is assumed to be at sea level. All this is done once, and is then shared by all
+ * bodies.
+ *
+ * @param date TT MJD of observation (JD-2400000.5).
+ * @param elong Observer's east longitude (radians).
+ * @param phi Observer's geodetic latitude (radians).
+ */
+TopocentricContext::TopocentricContext(double date, double elong, double phi): tc_date(date) {
+    // Sun to geocentre (J2000)
+    Vector<double> hpos, hvelo, bpos, bvelo;
+    epv(date, hpos, hvelo, bpos, bvelo);
+
+    // precession/nutation matrix, J2000 to date
+    prenut(2000.0, date, tc_rmat);
+
+    // Sun to geocentre (true of date, velocity in AU/s)
+    Vector<double> sg_pos, sg_vel;
+    dmxv(tc_rmat, hpos, sg_pos);
+    dmxv(tc_rmat, hvelo, sg_vel);
+
+    // local sidereal time, and geocentric vector of the observer (true of date)
+    const double stl = gmst(date - dt(epj(date)) / 86400.0) + elong;
+    VectorPV<double> go;
+    pvobs(phi, 0.0, stl, go);
+
+    // Sun to observer (true of date)
+    for (int i = 0; i < 3; i++) {
+        tc_pos[i] = sg_pos[i] + go.get_position()[i];
+        tc_vel[i] = sg_vel[i] / 86400.0 + go.get_velocity()[i];
+    }
+}
+
+/**
+ * Converts heliocentric J2000 position and velocity of a body into topocentric apparent RA,Dec and distance.
+ *
+ * @param pv Heliocentric position (AU) and velocity (AU/s) of the body, J2000 equatorial.
+ * @param ra Return value: topocentric apparent RA (radians).
+ * @param dec Return value: topocentric apparent Dec (radians).
+ * @param r Return value: topocentric distance (AU).
+ */
+void TopocentricContext::apparent(const VectorPV<double>& pv, double& ra, double& dec, double& r) const {
+    // light time for unit distance (sec)
+    constexpr double TAU = 499.004782;
+
+    // topocentric position and velocity of the body (true of date)
+    Vector<double> pos, vel;
+    dmxv(tc_rmat, pv.get_position(), pos);
+    dmxv(tc_rmat, pv.get_velocity(), vel);
+    for (int i = 0; i < 3; i++) {
+        pos[i] -= tc_pos[i];
+        vel[i] -= tc_vel[i];
+    }
+
+    // topocentric distance of the body (AU)
+    const double d = std::sqrt(pos[0] * pos[0] + pos[1] * pos[1] + pos[2] * pos[2]);
+
+    // light-time correction (sec)
+    const double tl = TAU * d;
+
+    // correct position for planetary aberration
+    for (int i = 0; i < 3; i++) {
+        pos[i] -= tl * vel[i];
+    }
+
+    // to RA,Dec
+    Spherical<double> dir;
+    dcc2s(pos, dir);
+    ra = dranrm(dir.get_ra());
+    dec = dir.get_dec();
+    r = d;
+}
+
+/**
+ * Converts heliocentric J2000 positions and velocities of many bodies into topocentric apparent RA,Dec and distances;
+ * the bodies whose status is not OES_OK get zero RA, Dec, and distance.
+ *
+ * @param n Number of bodies.
+ * @param pv Heliocentric positions (AU) and velocities (AU/s) of the bodies, J2000 equatorial.
+ * @param status Statuses of the computations of `pv`.
+ * @param ra Return value: topocentric apparent RAs (radians).
+ * @param dec Return value: topocentric apparent Decs (radians).
+ * @param r Return value: topocentric distances (AU).
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void TopocentricContext::apparent(int n, const VectorPV<double>* pv, const OEStatus* status,
+    double* ra, double* dec, double* r, int nthreads) const {
+    parallel_for(n, nthreads, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            if (status[i] == OES_OK) {
+                apparent(pv[i], ra[i], dec[i], r[i]);
+            } else {
+                ra[i] = dec[i] = r[i] = 0.0;
+            }
+        }
+    }, 256);
+}
+
+/**
+ * Topocentric apparent RA,Dec of a solar-system body whose heliocentric universal elements are given, for the
+ * instant and observer of this context.
+ *
+ * See sla::plantu() for details; as a side effect, the date and universal eccentric anomaly of the most recent
+ * prediction are updated in `u` (see sla::ue2pv()), which speeds up subsequent predictions for nearby dates.
+ *
+ * @param u Universal orbital elements, updated on return.
+ * @param ra Return value: topocentric apparent RA (radians).
+ * @param dec Return value: topocentric apparent Dec (radians).
+ * @param r Return value: distance from observer (AU).
+ * @return Status, as returned by sla::ue2pv(); in case of an error, `ra`, `dec`, and `r` are not changed.
+ */
+OEStatus TopocentricContext::plantu(UniversalElements& u, double& ra, double& dec, double& r) const {
+    VectorPV<double> pv;
+    const OEStatus status = ue2pv(tc_date, u, pv);
+    if (status == OES_OK) {
+        apparent(pv, ra, dec, r);
+    }
+    return status;
+}
+
+/**
+ * Topocentric apparent RA,Dec of many solar-system bodies whose heliocentric universal elements are given, for the
+ * instant and observer of this context.
+ *
+ * Results are identical to those of the single-body version. Heliocentric states of the bodies are computed by
+ * sla::ue2pv_batch(), and the observer state is shared by all bodies.
+ *
+ * @param elements Universal orbital elements, updated on return (see sla::ue2pv_batch()).
+ * @param ra Return value: `elements.size()` topocentric apparent RAs (radians).
+ * @param dec Return value: `elements.size()` topocentric apparent Decs (radians).
+ * @param r Return value: `elements.size()` distances from observer (AU).
+ * @param status Return value: `elements.size()` statuses (see sla::ue2pv()); bodies whose status is not OES_OK get
+ *   zero RA, Dec, and distance.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void TopocentricContext::plantu(UniversalElementsArray& elements, double* ra, double* dec, double* r,
+    OEStatus* status, int nthreads) const {
+    const int n = elements.size();
+    std::vector<VectorPV<double>> pv(n);
+    ue2pv_batch(tc_date, elements, pv.data(), status, nthreads);
+    apparent(n, pv.data(), status, ra, dec, r, nthreads);
+}
+
+/**
+ * Version of sla::TopocentricContext::plantu() that stores results through strided spans of `elements.size()` items
+ * (see sla::StridedSpan); the elements themselves are already held in "structure of arrays" layout.
+ */
+void TopocentricContext::plantu(UniversalElementsArray& elements, StridedSpan<double> ra, StridedSpan<double> dec,
+    StridedSpan<double> r, StridedSpan<OEStatus> status, int nthreads) const {
+    const int n = elements.size();
+    std::vector<VectorPV<double>> pv(n);
+    std::vector<OEStatus> pv_status(n);
+    ue2pv_batch(tc_date, elements, pv.data(), pv_status.data(), nthreads);
+    parallel_span_tiles(n, nthreads, [this](int n, auto pv, auto pv_status, auto ra, auto dec, auto r, auto status) {
+        apparent(n, pv, pv_status, ra, dec, r, 1);
+        std::copy(pv_status, pv_status + n, status);
+    }, StridedSpan<const VectorPV<double>>(pv.data(), n), StridedSpan<const OEStatus>(pv_status.data(), n), ra, dec,
+        r, status);
+}
+
+/**
+ * Topocentric apparent RA,Dec of a solar-system body whose heliocentric universal elements are given.
+ *
+ * The universal elements are those which define the orbit for the purposes of the method of universal variables (see
+ * reference); they can be obtained from conventional elements by sla::el2ue(), or from a position and velocity by
+ * sla::pv2ue(). The universal elements are updated in place (see sla::ue2pv()).
+ *
+ * The date is in a dynamical timescale (TT, which is the same as TDB to within 2 ms), and is also used to estimate
+ * UT1 for computing the sidereal time.
+ *
+ * The longitude and latitude allow correction for geocentric parallax. This is usually a small effect, but can become
+ * important for near-Earth asteroids. Geocentric positions can be generated by appropriate use of sla::ue2pv() or
+ * sla::planel() with sla::epv() or sla::evp().
+ *
+ * The light-time is allowed for by a first-order correction: the position is extrapolated back along the topocentric
+ * velocity by the light time for the geometric distance.
+ *
+ * To compute apparent places of many bodies for the same instant and observer, construct an sla::TopocentricContext
+ * and use its methods: the observer state is then computed only once.
+ *
+ * Reference: Everhart, E. & Pitkin, E.T., Am.J.Phys. 51, 712, 1983.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date TT MJD of observation (JD-2400000.5).
+ * @param elong Observer's east longitude (radians).
+ * @param phi Observer's geodetic latitude (radians).
+ * @param u Universal orbital elements, updated on return.
+ * @param ra Return value: topocentric apparent RA (radians).
+ * @param dec Return value: topocentric apparent Dec (radians).
+ * @param r Return value: distance from observer (AU).
+ * @return Status, as returned by sla::ue2pv(); in case of an error, `ra`, `dec`, and `r` are not changed.
+ */
+OEStatus plantu(double date, double elong, double phi, UniversalElements& u, double& ra, double& dec, double& r) {
+    return TopocentricContext(date, elong, phi).plantu(u, ra, dec, r);
+}
+
+}
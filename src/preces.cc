@@ -16,6 +16,7 @@
  *
  */
 #include "slalib.h"
+#include "simd.h"
 
 namespace sla {
 
@@ -68,4 +69,56 @@ void preces(Catalogue system, double ep0, double ep1, Spherical<double>& pos) {
     }
 }
 
+/**
+ * Applies precession - either FK4 (Bessel-Newcomb, pre IAU 1976) or FK5 (Fricke, post IAU 1976) as required - to many
+ * positions.
+ *
+ * Results are identical to those of the sla::preces() function, but the precession matrix is only computed once, and
+ * positions are processed in SIMD packs (see `simd.h`). Input and output arrays may be the same.
+ *
+ * @param system Precession to be applied, a `CAT_xxx` constant (only `CAT_FK4` or `CAT_FK5` are accepted).
+ * @param ep0 Starting epoch.
+ * @param ep1 Ending epoch.
+ * @param n Number of positions.
+ * @param ra RAs, mean equator & equinox of epoch `ep0` (radians).
+ * @param dec Decs, mean equator & equinox of epoch `ep0` (radians).
+ * @param pra Return value: RAs, mean equator & equinox of epoch `ep1` (radians); -99.0 if an invalid `system` is
+ *   specified.
+ * @param pdec Return value: Decs, mean equator & equinox of epoch `ep1` (radians); -99.0 if an invalid `system` is
+ *   specified.
+ */
+void preces_batch(Catalogue system, double ep0, double ep1, int n, const double* ra, const double* dec, double* pra,
+    double* pdec) {
+    // generate appropriate precession matrix
+    Matrix<double> m_precession;
+    switch (system) {
+        case CAT_FK4:
+            prebn(ep0, ep1, m_precession);
+            break;
+        case CAT_FK5:
+            prec(ep0, ep1, m_precession);
+            break;
+        default:
+            for (int i = 0; i < n; i++) {
+                pra[i] = -99.0;
+                pdec[i] = -99.0;
+            }
+            return;
+    }
+
+    lane_loop<double>(n, [=, &m_precession](auto tag, int i) {
+        using V = decltype(tag);
+        // convert RA,Dec to x,y,z, and precess
+        V x1, y1, z1, x2, y2, z2;
+        kernel::cs2c(lane_load<V>(ra + i), lane_load<V>(dec + i), x1, y1, z1);
+        kernel::mxv(m_precession, x1, y1, z1, x2, y2, z2);
+
+        // convert back to RA,Dec
+        V a, b;
+        kernel::cc2s(x2, y2, z2, a, b);
+        lane_store(kernel::ranorm(a), pra + i);
+        lane_store(b, pdec + i);
+    });
+}
+
 }
@@ -0,0 +1,237 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Heliocentric osculating elements obtained from instantaneous position and velocity.
+ *
+ * The `pv` argument is with respect to the mean equator and equinox of epoch J2000. The orbital elements produced are
+ * with respect to the J2000 ecliptic and mean equinox.
+ *
+ * The `pmass` argument is the mass of the body in solar masses; for example, for Jupiter this is 1/1047.355. For
+ * minor bodies, it can be set to zero.
+ *
+ * The requested form of the elements `jformr` is honoured only for elliptical orbits; if the orbit is parabolic or
+ * hyperbolic (or nearly parabolic, with the eccentricity within 1e-8 of unity), OEF_COMET elements are returned. The
+ * actual form is returned in the `oe_form` member of `elements`. Members that are not used by the actual form are not
+ * changed.
+ *
+ * Reference: Sterne, Theodore E., "An Introduction to Celestial Mechanics", Interscience Publishers Inc., 1960.
+ * Section 6.7, p199.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param pv Heliocentric position (AU) and velocity (AU/s), equatorial, J2000.
+ * @param date Date (TT MJD).
+ * @param pmass Mass of the planet (Sun = 1).
+ * @param jformr Requested form of the elements.
+ * @param elements Return value: conventional orbital elements (see sla::el2ue()).
+ * @return Status: OES_OK, OES_BAD_MASS (negative `pmass`), OES_BAD_FORM (illegal `jformr`), OES_TOO_CLOSE
+ *   (heliocentric distance less than 0.001 AU), OES_TOO_SLOW (speed less than 1e-8 AU/day), or OES_ZERO_MOMENTUM.
+ */
+OEStatus pv2el(const VectorPV<double>& pv, double date, double pmass, OEForm jformr, OrbitalElements& elements) {
+    // Gaussian gravitational constant (exact)
+    constexpr double GCON = 0.01720209895;
+
+    // sin and cos of J2000 mean obliquity (IAU 1976)
+    constexpr double SE = 0.3977771559319137;
+    constexpr double CE = 0.9174820620691818;
+
+    // minimum allowed distance (AU) and speed (AU/day)
+    constexpr double RMIN = 1.0e-3;
+    constexpr double VMIN = 1.0e-8;
+
+    // how close to unity the eccentricity has to be to call it a parabola
+    constexpr double PARAB = 1.0e-8;
+
+    // validate arguments
+    if (pmass < 0.0) {
+        return OES_BAD_MASS;
+    }
+    if (jformr < OEF_MAJOR_PLANET || jformr > OEF_COMET) {
+        return OES_BAD_FORM;
+    }
+
+    // provisionally assume the elements will be in the chosen form
+    OEForm jf = jformr;
+
+    // rotate the position from equatorial to ecliptic coordinates
+    const double x = pv.get_x();
+    const double y = pv.get_y() * CE + pv.get_z() * SE;
+    const double z = -pv.get_y() * SE + pv.get_z() * CE;
+
+    // rotate the velocity similarly, scaling to AU/day
+    const double xd = pv.get_dx() * 86400.0;
+    const double yd = (pv.get_dy() * CE + pv.get_dz() * SE) * 86400.0;
+    const double zd = (-pv.get_dy() * SE + pv.get_dz() * CE) * 86400.0;
+
+    // distance and speed
+    const double r = std::sqrt(x * x + y * y + z * z);
+    const double v2 = xd * xd + yd * yd + zd * zd;
+    const double v = std::sqrt(v2);
+
+    // reject unreasonably small values
+    if (r < RMIN) {
+        return OES_TOO_CLOSE;
+    }
+    if (v < VMIN) {
+        return OES_TOO_SLOW;
+    }
+
+    // R dot V
+    const double rdv = x * xd + y * yd + z * zd;
+
+    // mu
+    const double gmu = (1.0 + pmass) * GCON * GCON;
+
+    // vector angular momentum per unit reduced mass
+    const double hx = y * zd - z * yd;
+    const double hy = z * xd - x * zd;
+    const double hz = x * yd - y * xd;
+
+    // areal constant
+    const double hx2py2 = hx * hx + hy * hy;
+    const double h2 = hx2py2 + hz * hz;
+    const double h = std::sqrt(h2);
+
+    // reject zero angular momentum
+    if (h == 0.0) {
+        return OES_ZERO_MOMENTUM;
+    }
+
+    // inclination
+    const double oi = std::atan2(std::sqrt(hx2py2), hz);
+
+    // longitude of ascending node
+    const double bigom = (hx != 0.0 || hy != 0.0)? std::atan2(hx, -hy): 0.0;
+
+    // reciprocal of mean distance etc.
+    const double ar = 2.0 / r - v2 / gmu;
+
+    // eccentricity
+    double ecc = std::sqrt(std::max(1.0 - ar * h2 / gmu, 0.0));
+
+    // true anomaly
+    double s = h * rdv;
+    double c = h2 - r * gmu;
+    const double at = (s != 0.0 || c != 0.0)? std::atan2(s, c): 0.0;
+
+    // argument of the latitude
+    s = std::sin(bigom);
+    c = std::cos(bigom);
+    const double u = std::atan2((-x * s + y * c) * std::cos(oi) + z * std::sin(oi), x * c + y * s);
+
+    // argument of perihelion
+    const double om = u - at;
+
+    // capture near-parabolic cases
+    if (std::fabs(ecc - 1.0) < PARAB) {
+        ecc = 1.0;
+    }
+
+    // comply with jformr = OEF_MAJOR_PLANET or OEF_MINOR_PLANET only if orbit is elliptical
+    if (ecc >= 1.0) {
+        jf = OEF_COMET;
+    }
+
+    // functions
+    const double gar3 = gmu * ar * ar * ar;
+    const double em1 = ecc - 1.0;
+    const double ep1 = ecc + 1.0;
+    const double hat = at / 2.0;
+    const double shat = std::sin(hat);
+    const double chat = std::cos(hat);
+
+    // variable initializations to avoid compiler warnings
+    double am = 0.0, dn = 0.0, pl = 0.0, el = 0.0, q = 0.0, tp = 0.0;
+
+    // ellipse?
+    if (ecc < 1.0) {
+        // eccentric anomaly
+        const double ae = 2.0 * std::atan2(std::sqrt(-em1) * shat, std::sqrt(ep1) * chat);
+
+        // mean anomaly
+        am = ae - ecc * std::sin(ae);
+
+        // daily motion
+        dn = std::sqrt(gar3);
+    }
+
+    // "major planet" element set?
+    if (jf == OEF_MAJOR_PLANET) {
+        // longitude of perihelion
+        pl = bigom + om;
+
+        // longitude at epoch
+        el = pl + am;
+    }
+
+    // "comet" element set?
+    if (jf == OEF_COMET) {
+        // perihelion distance
+        q = h2 / (gmu * ep1);
+
+        // ellipse, parabola, hyperbola?
+        if (ecc < 1.0) {
+            // ellipse: epoch of perihelion
+            tp = date - am / dn;
+        } else {
+            // parabola or hyperbola: evaluate tan ( ( true anomaly ) / 2 )
+            const double that = shat / chat;
+            if (ecc == 1.0) {
+                // parabola: epoch of perihelion
+                tp = date - that * (1.0 + that * that / 3.0) * h * h2 / (2.0 * gmu * gmu);
+            } else {
+                // hyperbola: epoch of perihelion
+                const double thhf = std::sqrt(em1 / ep1) * that;
+                const double f = std::log(1.0 + thhf) - std::log(1.0 - thhf);
+                tp = date - (ecc * std::sinh(f) - f) / std::sqrt(-gar3);
+            }
+        }
+    }
+
+    // return the appropriate set of elements
+    elements.oe_form = jf;
+    elements.oe_orbinc = oi;
+    elements.oe_anode = dranrm(bigom);
+    elements.oe_e = ecc;
+    if (jf == OEF_MAJOR_PLANET) {
+        elements.oe_perih = dranrm(pl);
+        elements.oe_aorl = dranrm(el);
+        elements.oe_dm = dn;
+    } else {
+        elements.oe_perih = dranrm(om);
+        if (jf == OEF_MINOR_PLANET) {
+            elements.oe_aorl = dranrm(am);
+        }
+    }
+    if (jf != OEF_COMET) {
+        elements.oe_epoch = date;
+        elements.oe_aorq = 1.0 / ar;
+    } else {
+        elements.oe_epoch = tp;
+        elements.oe_aorq = q;
+    }
+    return OES_OK;
+}
+
+}
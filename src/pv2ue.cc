@@ -0,0 +1,107 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Constructs a universal element set based on an instantaneous position and velocity.
+ *
+ * The `pv` argument is relative to the Sun. The `pmass` argument is the mass of the body in solar masses. It is the
+ * ratio of the body's mass to the Sun's mass; for example, for Jupiter this is 1/1047.355; for minor bodies, it can be
+ * set to zero.
+ *
+ * The universal elements are primarily intended as a way of predicting the position and velocity of a body quickly
+ * and accurately (see sla::ue2pv()), but they can also be converted into conventional elements by means of the
+ * sla::ue2el() function.
+ *
+ * The universal elements include the reference epoch, which is the date (`date`) of the supplied position and
+ * velocity, and also the date of the most recent prediction and its universal eccentric anomaly; at construction, the
+ * latter two are set to `date` and zero respectively.
+ *
+ * References:
+ *   1. Sterne, Theodore E., "An Introduction to Celestial Mechanics", Interscience Publishers Inc., 1960. Section
+ *      6.7, p199.
+ *   2. Everhart, E. & Pitkin, E.T., Am.J.Phys. 51, 712, 1983.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param pv Heliocentric position (AU) and velocity (AU/s), equatorial, J2000.
+ * @param date Date (TT MJD).
+ * @param pmass Mass of the planet (Sun = 1).
+ * @param u Return value: universal orbital elements.
+ * @return Status: OES_OK, OES_BAD_MASS (negative `pmass`), OES_TOO_CLOSE (heliocentric distance less than 0.001 AU),
+ *   or OES_TOO_SLOW (speed less than 0.001 AU per canonical day); in the latter three cases, `u` is not changed.
+ */
+OEStatus pv2ue(const VectorPV<double>& pv, double date, double pmass, UniversalElements& u) {
+    // Gaussian gravitational constant (exact)
+    constexpr double GCON = 0.01720209895;
+
+    // canonical days to seconds
+    constexpr double CD2S = GCON / 86400.0;
+
+    // minimum allowed distance (AU) and speed (AU per canonical day)
+    constexpr double RMIN = 1.0e-3;
+    constexpr double VMIN = 1.0e-3;
+
+    // combined mass (mu = M + m)
+    if (pmass < 0.0) {
+        return OES_BAD_MASS;
+    }
+    const double cm = 1.0 + pmass;
+
+    // unpack the state vector, expressing velocity in AU per canonical day
+    const double x = pv.get_x();
+    const double y = pv.get_y();
+    const double z = pv.get_z();
+    const double xd = pv.get_dx() / CD2S;
+    const double yd = pv.get_dy() / CD2S;
+    const double zd = pv.get_dz() / CD2S;
+
+    // heliocentric distance, and speed
+    const double r = std::sqrt(x * x + y * y + z * z);
+    const double v2 = xd * xd + yd * yd + zd * zd;
+    const double v = std::sqrt(v2);
+
+    // reject unreasonably small values
+    if (r < RMIN) {
+        return OES_TOO_CLOSE;
+    }
+    if (v < VMIN) {
+        return OES_TOO_SLOW;
+    }
+
+    // package the universal elements
+    u.ue_mass = cm;
+    u.ue_alpha = v2 - 2.0 * cm / r; // total energy of the orbit
+    u.ue_t0 = date;
+    u.ue_p0[0] = x;
+    u.ue_p0[1] = y;
+    u.ue_p0[2] = z;
+    u.ue_v0[0] = xd;
+    u.ue_v0[1] = yd;
+    u.ue_v0[2] = zd;
+    u.ue_r0 = r;
+    u.ue_sigma0 = x * xd + y * yd + z * zd;
+    u.ue_t = date;
+    u.ue_psi = 0.0;
+    return OES_OK;
+}
+
+}
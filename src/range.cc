@@ -16,26 +16,28 @@
  *
  */
 #include "slalib.h"
-#include "f77_utils.h"
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
 /**
- * Normalizes angle into range +/- pi  (single precision).
+ * Normalizes many angles into range +/- pi (single precision); this is a vectorized version of sla::range().
  *
- * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
- *
- * @param angle The angle in radians.
- * @return The `angle` expressed in the +/- pi.
+ * @param n Number of angles.
+ * @param angles The angles in radians.
+ * @param result Output: `n` angles expressed in the +/- pi range; can be the same array as `angles`.
  */
-float range(float angle) {
-    constexpr float PI = 3.141592653589793238462643f;
-    constexpr float PI2 = 6.283185307179586476925287f;
-    float result = std::fmod(angle, PI2);
-    if (std::fabs(result) >= PI) {
-        result -= f_sign(PI2, angle);
-    }
-    return result;
+void range_batch(int n, const float* angles, float* result) {
+    lane_loop<float>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        lane_store(kernel::range(lane_load<V>(angles + i)), result + i);
+    });
+}
+
+/// Version of sla::range_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void range_batch(StridedSpan<const float> angles, StridedSpan<float> result) {
+    span_tiles(angles.get_size(), [](int n, auto... p) { range_batch(n, p...); }, angles, result);
 }
 
 }
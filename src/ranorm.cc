@@ -16,25 +16,28 @@
  *
  */
 #include "slalib.h"
-#include <cmath>
+#include "spans.h"
+#include "simd.h"
 
 namespace sla {
 
 /**
- * Normalize angle into range 0-2*pi (single precision).
+ * Normalizes many angles into range 0-2*pi (single precision); this is a vectorized version of sla::ranorm().
  *
- * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
- *
- * @param angle The angle in radians.
- * @return The `angle` expressed in the range 0-2*pi .
+ * @param n Number of angles.
+ * @param angles The angles in radians.
+ * @param result Output: `n` angles expressed in the range 0-2*pi; can be the same array as `angles`.
  */
-float ranorm(float angle) {
-    constexpr float A2PI = 6.283185307179586476925287f;
-    float result = std::fmod(angle, A2PI);
-    if (result < 0.0f) {
-        result += A2PI;
-    }
-    return result;
+void ranorm_batch(int n, const float* angles, float* result) {
+    lane_loop<float>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        lane_store(kernel::ranorm(lane_load<V>(angles + i)), result + i);
+    });
+}
+
+/// Version of sla::ranorm_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void ranorm_batch(StridedSpan<const float> angles, StridedSpan<float> result) {
+    span_tiles(angles.get_size(), [](int n, auto... p) { ranorm_batch(n, p...); }, angles, result);
 }
 
 }
@@ -0,0 +1,179 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include <cmath>
+
+namespace sla {
+
+/**
+ * Approximate topocentric apparent RA,Dec of a planet, and its angular diameter.
+ *
+ * The date is in a dynamical timescale (TDB, formerly ET) and is in the form of a Modified Julian Date (JD-2400000.5).
+ * For all practical purposes, TT can be used instead of TDB, and for many applications UT will do (except for the
+ * Moon).
+ *
+ * The longitude and latitude allow correction for geocentric parallax. This is a major effect for the Moon, but in
+ * the context of the limited accuracy of the present function its effect on planetary positions is small (negligible
+ * for the outer planets). Geocentric positions can be generated by appropriate use of functions sla::dmoon() and
+ * sla::planet().
+ *
+ * The direction accuracy (arcsec, 1000-3000 AD) is of order:
+ *
+ *        Sun              5
+ *        Mercury          2
+ *        Venus           10
+ *        Moon            30
+ *        Mars            50
+ *        Jupiter         90
+ *        Saturn          90
+ *        Uranus          90
+ *        Neptune         10
+ *        Pluto            1   (1885-2099 AD only)
+ *
+ * The angular diameter accuracy is about 0.4% for the Moon, and 0.01% or better for the Sun and planets.
+ *
+ * See the sla::planet() function for references.
+ *
+ * The Sun's angular diameter is computed for the photosphere, and the planetary diameters are for the equator.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date MJD of observation (JD-2400000.5).
+ * @param np Planet: 1 = Mercury, 2 = Venus, 3 = Moon, 4 = Mars, 5 = Jupiter, 6 = Saturn, 7 = Uranus, 8 = Neptune,
+ *   9 = Pluto; any other value means the Sun.
+ * @param elong Observer's east longitude (radians).
+ * @param phi Observer's geodetic latitude (radians).
+ * @param ra Return value: topocentric apparent RA (radians).
+ * @param dec Return value: topocentric apparent Dec (radians).
+ * @param diam Return value: angular diameter (equatorial, radians).
+ */
+void rdplan(double date, int np, double elong, double phi, double& ra, double& dec, double& diam) {
+    // AU in km
+    constexpr double AUKM = 1.49597870e8;
+
+    // light time for unit distance (sec)
+    constexpr double TAU = 499.004782;
+
+    // equatorial radii (km)
+    static const double EQRAU[10] = {
+        696000.0,  // Sun
+        2439.7,    // Mercury
+        6051.9,    // Venus
+        1738.0,    // Moon
+        3397.0,    // Mars
+        71492.0,   // Jupiter
+        60268.0,   // Saturn
+        25559.0,   // Uranus
+        24764.0,   // Neptune
+        1151.0     // Pluto
+    };
+
+    // classify NP
+    if (np < 0 || np > 9) {
+        np = 0;
+    }
+
+    // approximate local sidereal time
+    const double stl = gmst(date - dt(epj(date)) / 86400.0) + elong;
+
+    // geocentre to Moon (mean of date)
+    VectorPV<double> pv;
+    dmoon(date, pv);
+
+    // nutation to true of date
+    Matrix<double> rmat;
+    nut(date, rmat);
+    Vector<double> gm_pos, gm_vel;
+    dmxv(rmat, pv.get_position(), gm_pos);
+    dmxv(rmat, pv.get_velocity(), gm_vel);
+
+    Vector<double> pos, vel;
+    if (np == 3) {
+        // geocentre to Moon (true of date)
+        for (int i = 0; i < 3; i++) {
+            pos[i] = gm_pos[i];
+            vel[i] = gm_vel[i];
+        }
+    } else {
+        // current epoch, precession/nutation matrix
+        prenut(2000.0, date, rmat);
+
+        // Sun to Earth-Moon barycentre (true of date)
+        planet(date, 3, pv);
+        Vector<double> se_pos, se_vel;
+        dmxv(rmat, pv.get_position(), se_pos);
+        dmxv(rmat, pv.get_velocity(), se_vel);
+
+        // Sun to geocentre (true of date)
+        Vector<double> sg_pos, sg_vel;
+        for (int i = 0; i < 3; i++) {
+            sg_pos[i] = se_pos[i] - 0.012150581 * gm_pos[i];
+            sg_vel[i] = se_vel[i] - 0.012150581 * gm_vel[i];
+        }
+
+        if (np == 0) {
+            // geocentre to Sun
+            for (int i = 0; i < 3; i++) {
+                pos[i] = -sg_pos[i];
+                vel[i] = -sg_vel[i];
+            }
+        } else {
+            // Sun to planet (true of date)
+            planet(date, np, pv);
+            Vector<double> sp_pos, sp_vel;
+            dmxv(rmat, pv.get_position(), sp_pos);
+            dmxv(rmat, pv.get_velocity(), sp_vel);
+
+            // geocentre to planet (true of date)
+            for (int i = 0; i < 3; i++) {
+                pos[i] = sp_pos[i] - sg_pos[i];
+                vel[i] = sp_vel[i] - sg_vel[i];
+            }
+        }
+    }
+
+    // refer to origin at the observer
+    VectorPV<double> go;
+    pvobs(phi, 0.0, stl, go);
+    for (int i = 0; i < 3; i++) {
+        pos[i] -= go.get_position()[i];
+        vel[i] -= go.get_velocity()[i];
+    }
+
+    // geometric distance (AU)
+    const double r = std::sqrt(pos[0] * pos[0] + pos[1] * pos[1] + pos[2] * pos[2]);
+
+    // light time (sec)
+    const double tl = TAU * r;
+
+    // correct position for planetary aberration
+    for (int i = 0; i < 3; i++) {
+        pos[i] -= tl * vel[i];
+    }
+
+    // to RA,Dec
+    Spherical<double> dir;
+    dcc2s(pos, dir);
+    ra = dranrm(dir.get_ra());
+    dec = dir.get_dec();
+
+    // angular diameter (radians)
+    diam = 2.0 * std::asin(EQRAU[np] / (r * AUKM));
+}
+
+}
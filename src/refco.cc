@@ -19,6 +19,10 @@
 
 namespace sla {
 
+// sample zenith distances: atan(1.0) and atan(4.0)
+constexpr double ATAN_1 = 0.7853981633974483;
+constexpr double ATAN_4 = 1.325817663668033;
+
 /**
  * Determines the constants A and B in the atmospheric refraction model dZ = A tan Z + B tan**3 Z.
  *
@@ -45,11 +49,6 @@ namespace sla {
  */
 void refco(double oh, double atk, double apm, double arh, double wl, double phi, double tlr, double eps,
     double& refa, double& refb) {
-
-    // sample zenith distances: atan(1.0) and atan(4.0)
-    constexpr double ATAN_1 = 0.7853981633974483;
-    constexpr double ATAN_4 = 1.325817663668033;
-
     // determine refraction for the two sample zenith distances
     const double r1 = refro(ATAN_1, oh, atk, apm, arh, wl, phi, tlr, eps);
     const double r2 = refro(ATAN_4, oh, atk, apm, arh, wl, phi, tlr, eps);
@@ -59,4 +58,31 @@ void refco(double oh, double atk, double apm, double arh, double wl, double phi,
     refb = (r2 - 4.0 * r1) / 60.0;
 }
 
+/**
+ * Real-time variant of the sla::refco() function: determines the constants A and B in the atmospheric refraction
+ * model dZ = A tan Z + B tan**3 Z using sla::refro_rt(), and thus with fixed, data-independent amount of work (two
+ * sla::refro_rt() calls).
+ *
+ * @param oh Height of the observer above sea level (meters).
+ * @param atk Ambient temperature at the observer (degrees K).
+ * @param apm Pressure at the observer (millibars).
+ * @param arh Relative humidity at the observer (range: [0..1])
+ * @param wl Effective wavelength of the source (micrometers).
+ * @param phi Latitude of the observer (radians, astronomical).
+ * @param tlr Temperature lapse rate in the troposphere (degrees K/meter).
+ * @param refa Return value: tan Z coefficient (radians).
+ * @param refb Return value: tan**3 Z coefficient (radians).
+ * @param strips Number of Simpson strips per integral (see sla::refro_rt()).
+ */
+void refco_rt(double oh, double atk, double apm, double arh, double wl, double phi, double tlr,
+    double& refa, double& refb, int strips) {
+    // determine refraction for the two sample zenith distances
+    const double r1 = refro_rt(ATAN_1, oh, atk, apm, arh, wl, phi, tlr, strips);
+    const double r2 = refro_rt(ATAN_4, oh, atk, apm, arh, wl, phi, tlr, strips);
+
+    // solve for refraction constants
+    refa = (64.0 * r1 - r2) / 60.0;
+    refb = (r2 - 4.0 * r1) / 60.0;
+}
+
 }
@@ -16,6 +16,7 @@
  *
  */
 #include "slalib.h"
+#include <algorithm>
 #include <cmath>
 
 namespace sla {
@@ -75,80 +76,23 @@ static void atmt(double r0, double t0, double alpha, double gamm2, double delm2,
 }
 
 /**
- * Calculates atmospheric refraction for radio and optical/IR wavelengths.
- *
- * This function computes the refraction for zenith distances up to and a little beyond 90 degrees using the method
- * of Hohenkerk and Sinclair (NAO Technical Notes 59 and 63, subsequently adopted in the Explanatory Supplement, 1992
- * edition - see section 3.281).
- *
- * As in the original Hohenkerk and Sinclair algorithm, fixed values of the water vapour polytrope exponent, the height
- * of the tropopause, and the height at which refraction is negligible are used.
- *
- * The radio refraction has been tested against work done by Iain Coulson, JACH, (private communication 1995) for the
- * James Clerk Maxwell Telescope, Mauna Kea. For typical conditions, agreement at the 0.1 arcsec level is achieved for
- * moderate ZD, worsening to perhaps 0.5-1.0 arcsec at ZD 80 deg. At hot and humid sea-level sites the accuracy will
- * not be as good.
- *
- * The algorithm is designed for observers in the troposphere. The supplied temperature, pressure and lapse rate are
- * assumed to be for a point in the troposphere and are used to define a model atmosphere with the tropopause at 11km
- * altitude and a constant temperature above that. However, in practice, the refraction values returned for
- * stratospheric observers, at altitudes up to 25km, are quite usable.
- *
- * Original FORTRAN code by P.T. Wallace.
- *
- * The FORTRAN code was a development of the optical/IR refraction subroutine AREF of C.Hohenkerk (HMNAO, September
- * 1984), with extensions to support the radio case. Apart from merely cosmetic changes, the following modifications
- * to the original HMNAO optical/IR refraction code had been made:
- *
- * - The angle arguments have been changed to radians.
- *
- * - Any value of ZOBS is allowed.
- *
- * - Other argument values have been limited to safe values.
- *
- * - Murray's values for the gas constants have been used (Vectorial Astrometry, Adam Hilger, 1983).
- *
- * - The numerical integration phase has been rearranged for extra clarity.
- *
- * - A better model for Ps(T) has been adopted (taken from Gill, Atmosphere-Ocean Dynamics, Academic Press, 1982).
- *
- * - More accurate expressions for Pwo have been adopted (again from Gill 1982).
- *
- * - The formula for the water vapour pressure, given the saturation pressure and the relative humidity, is from
- *   Crane (1976), expression 2.5.5.
- *
- * - Provision for radio wavelengths has been added using expressions devised by A.T.Sinclair, RGO (private
- *   communication 1989). The refractivity model currently used is from J.M.Rueger, "Refractive Index Formulae for
- *   Electronic Distance Measurement with Radio and Millimetre Waves", in Unisurv Report S-68 (2002), School of
- *   Surveying and Spatial Information Systems, University of New South Wales, Sydney, Australia.
- *
- * - The optical refractivity for dry air is from Resolution 3 of the International Association of Geodesy adopted at
- *   the XXIIth General Assembly in Birmingham, UK, 1999.
+ * Implementation of the sla::refro() and sla::refro_rt() functions.
  *
- * - Various small changes have been made to gain speed.
- *
- * @param ozd Observed zenith distance of the source (radians); before use, the value of `ozd` is expressed in the
- *   range +/- pi; if this ranged `ozd` is -ve, the return value is computed from its absolute value before being
- *   made -ve to match; in addition, if it has an absolute value greater than 93 degrees, a fixed refraction value
- *   equal to the result for `ozd` = 93 degrees is returned, appropriately signed.
+ * @param ozd Observed zenith distance of the source (radians).
  * @param oh Height of the observer above sea level (meters).
  * @param atk Ambient temperature at the observer (degrees K).
  * @param apm Pressure at the observer (millibars).
- * @param arh Relative humidity at the observer (range: [0-1]); relative humidity `arh` is formally defined in terms of
- *   "mixing ratio" rather than pressures or densities as is often stated. It is the mass of water per unit mass of
- *   dry air divided by that for saturated air at the same temperature and pressure (see Gill 1982).
- * @param wl Effective wavelength of the source (micrometers); the radio refraction is chosen by specifying WL > 100
- *   micrometers; because the algorithm takes no account of the ionosphere, the accuracy deteriorates at low
- *   frequencies, below about 30 MHz.
+ * @param arh Relative humidity at the observer (range: [0-1]).
+ * @param wl Effective wavelength of the source (micrometers).
  * @param phi Latitude of the observer (radians, astronomical).
- * @param tlr Temperature lapse rate in the troposphere (degrees K/meter); A suggested value for the TLR argument
- *   is 0.0065; the refraction is significantly affected by `tlr`, and if studies of the local atmosphere have been
- *   carried out a better `tlr` value may be available; the sign of the supplied TLR value is ignored.
- * @param eps Precision required to terminate iteration (radians); a suggested value for the EPS argument is 1.0e-8;
- *   the result is usually at least two orders of magnitude more computationally precise than the supplied `eps` value.
+ * @param tlr Temperature lapse rate in the troposphere (degrees K/meter).
+ * @param eps Precision required to terminate iteration (radians); ignored if `fixed_strips` is non-zero.
+ * @param fixed_strips If zero, the number of strips is doubled until `eps` is reached; otherwise, fixed number of
+ *   strips to use, with no convergence tests whatsoever.
  * @return Refraction: in vacuo ZD minus observed ZD (radians).
  */
-double refro(double ozd, double oh, double atk, double apm, double arh, double wl, double phi, double tlr, double eps) {
+static double refro_integrate(double ozd, double oh, double atk, double apm, double arh, double wl, double phi,
+    double tlr, double eps, int fixed_strips) {
     // 93 degrees in radians
     constexpr double DEG93_IN_RADIANS = 1.623156204;
     // universal (molar) gas constant
@@ -249,8 +193,8 @@ double refro(double ozd, double oh, double atk, double apm, double arh, double w
     for (int k = 0; k < 2; k++) {
         // initialize previous refraction to ensure at least two iterations
         double ref_old = 1.0;
-        // start off with 8 strips
-        int num_strips = 8;
+        // start off with 8 strips (unless running with fixed cost)
+        int num_strips = fixed_strips? fixed_strips: 8;
         // start Z, Z range, and start and end values
         double z0, z_range, fb, ff;
         if (k == 0) {
@@ -286,7 +230,7 @@ double refro(double ozd, double oh, double atk, double apm, double arh, double w
                     const double ww = sk0 / sine_zd;
                     double rg = r;
                     double dr = 1.0e6;
-                    for (int j = 0; j < 4 && std::abs(dr) > 1.0; j++) {
+                    for (int j = 0; j < 4 && (fixed_strips || std::abs(dr) > 1.0); j++) {
                         if (k == 0) {
                             double tg;
                             atmt(r0, tdk_ok, alpha, gamm2, delm2, c1, c2, c3, c4, c5, c6, rg, tg, dn, rdndr);
@@ -320,7 +264,7 @@ double refro(double ozd, double oh, double atk, double apm, double arh, double w
             refp = h * (fb + 4.0 * f_odd + 2.0 * f_even + ff) / 3.0;
 
             // has the required precision been achieved (or can't be)?
-            if (std::abs(refp - ref_old) > tolerance && num_strips < MAX_STRIPS) {
+            if (!fixed_strips && std::abs(refp - ref_old) > tolerance && num_strips < MAX_STRIPS) {
                 // NO: prepare for next iteration
                 // save current value for convergence test
                 ref_old = refp;
@@ -349,4 +293,117 @@ double refro(double ozd, double oh, double atk, double apm, double arh, double w
     return result;
 }
 
+/**
+ * Calculates atmospheric refraction for radio and optical/IR wavelengths.
+ *
+ * This function computes the refraction for zenith distances up to and a little beyond 90 degrees using the method
+ * of Hohenkerk and Sinclair (NAO Technical Notes 59 and 63, subsequently adopted in the Explanatory Supplement, 1992
+ * edition - see section 3.281).
+ *
+ * As in the original Hohenkerk and Sinclair algorithm, fixed values of the water vapour polytrope exponent, the height
+ * of the tropopause, and the height at which refraction is negligible are used.
+ *
+ * The radio refraction has been tested against work done by Iain Coulson, JACH, (private communication 1995) for the
+ * James Clerk Maxwell Telescope, Mauna Kea. For typical conditions, agreement at the 0.1 arcsec level is achieved for
+ * moderate ZD, worsening to perhaps 0.5-1.0 arcsec at ZD 80 deg. At hot and humid sea-level sites the accuracy will
+ * not be as good.
+ *
+ * The algorithm is designed for observers in the troposphere. The supplied temperature, pressure and lapse rate are
+ * assumed to be for a point in the troposphere and are used to define a model atmosphere with the tropopause at 11km
+ * altitude and a constant temperature above that. However, in practice, the refraction values returned for
+ * stratospheric observers, at altitudes up to 25km, are quite usable.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * The FORTRAN code was a development of the optical/IR refraction subroutine AREF of C.Hohenkerk (HMNAO, September
+ * 1984), with extensions to support the radio case. Apart from merely cosmetic changes, the following modifications
+ * to the original HMNAO optical/IR refraction code had been made:
+ *
+ * - The angle arguments have been changed to radians.
+ *
+ * - Any value of ZOBS is allowed.
+ *
+ * - Other argument values have been limited to safe values.
+ *
+ * - Murray's values for the gas constants have been used (Vectorial Astrometry, Adam Hilger, 1983).
+ *
+ * - The numerical integration phase has been rearranged for extra clarity.
+ *
+ * - A better model for Ps(T) has been adopted (taken from Gill, Atmosphere-Ocean Dynamics, Academic Press, 1982).
+ *
+ * - More accurate expressions for Pwo have been adopted (again from Gill 1982).
+ *
+ * - The formula for the water vapour pressure, given the saturation pressure and the relative humidity, is from
+ *   Crane (1976), expression 2.5.5.
+ *
+ * - Provision for radio wavelengths has been added using expressions devised by A.T.Sinclair, RGO (private
+ *   communication 1989). The refractivity model currently used is from J.M.Rueger, "Refractive Index Formulae for
+ *   Electronic Distance Measurement with Radio and Millimetre Waves", in Unisurv Report S-68 (2002), School of
+ *   Surveying and Spatial Information Systems, University of New South Wales, Sydney, Australia.
+ *
+ * - The optical refractivity for dry air is from Resolution 3 of the International Association of Geodesy adopted at
+ *   the XXIIth General Assembly in Birmingham, UK, 1999.
+ *
+ * - Various small changes have been made to gain speed.
+ *
+ * @param ozd Observed zenith distance of the source (radians); before use, the value of `ozd` is expressed in the
+ *   range +/- pi; if this ranged `ozd` is -ve, the return value is computed from its absolute value before being
+ *   made -ve to match; in addition, if it has an absolute value greater than 93 degrees, a fixed refraction value
+ *   equal to the result for `ozd` = 93 degrees is returned, appropriately signed.
+ * @param oh Height of the observer above sea level (meters).
+ * @param atk Ambient temperature at the observer (degrees K).
+ * @param apm Pressure at the observer (millibars).
+ * @param arh Relative humidity at the observer (range: [0-1]); relative humidity `arh` is formally defined in terms of
+ *   "mixing ratio" rather than pressures or densities as is often stated. It is the mass of water per unit mass of
+ *   dry air divided by that for saturated air at the same temperature and pressure (see Gill 1982).
+ * @param wl Effective wavelength of the source (micrometers); the radio refraction is chosen by specifying WL > 100
+ *   micrometers; because the algorithm takes no account of the ionosphere, the accuracy deteriorates at low
+ *   frequencies, below about 30 MHz.
+ * @param phi Latitude of the observer (radians, astronomical).
+ * @param tlr Temperature lapse rate in the troposphere (degrees K/meter); A suggested value for the TLR argument
+ *   is 0.0065; the refraction is significantly affected by `tlr`, and if studies of the local atmosphere have been
+ *   carried out a better `tlr` value may be available; the sign of the supplied TLR value is ignored.
+ * @param eps Precision required to terminate iteration (radians); a suggested value for the EPS argument is 1.0e-8;
+ *   the result is usually at least two orders of magnitude more computationally precise than the supplied `eps` value.
+ * @return Refraction: in vacuo ZD minus observed ZD (radians).
+ */
+double refro(double ozd, double oh, double atk, double apm, double arh, double wl, double phi, double tlr, double eps) {
+    return refro_integrate(ozd, oh, atk, apm, arh, wl, phi, tlr, eps, 0);
+}
+
+/**
+ * Real-time variant of the sla::refro() function: computes atmospheric refraction for radio and optical/IR
+ * wavelengths with fixed, data-independent amount of work.
+ *
+ * Instead of doubling the number of strips until the requested precision is reached, both troposphere and
+ * stratosphere integrals are evaluated with exactly `strips` Simpson strips, and the inner search for the distance
+ * from the centre of the Earth always performs four Newton-Raphson iterations. Every call therefore evaluates the
+ * atmosphere model exactly 2 * 5 * (`strips` - 1) + 4 times (634 times for the default of 64 strips), whatever the
+ * arguments, which bounds its worst-case latency; by contrast, sla::refro() may need up to 2 * 5 * 16383 + 4
+ * evaluations.
+ *
+ * With 64 strips, the result agrees with that of sla::refro() with `eps`=1e-11 to better than 3e-9 radians for
+ * zenith distances up to 92 degrees, both for optical and radio wavelengths. Between 92 and 93 degrees, the
+ * integrals become ill-conditioned and the difference grows to about 1e-6 (optical) and 1e-2 (radio) radians.
+ *
+ * @param ozd Observed zenith distance of the source (radians); see sla::refro().
+ * @param oh Height of the observer above sea level (meters).
+ * @param atk Ambient temperature at the observer (degrees K).
+ * @param apm Pressure at the observer (millibars).
+ * @param arh Relative humidity at the observer (range: [0-1]).
+ * @param wl Effective wavelength of the source (micrometers); see sla::refro().
+ * @param phi Latitude of the observer (radians, astronomical).
+ * @param tlr Temperature lapse rate in the troposphere (degrees K/meter); see sla::refro().
+ * @param strips Number of Simpson strips per integral; odd numbers are rounded up to the next even number, and the
+ *   result is clamped to the range [2..16384] (the upper limit being that of sla::refro()), so that every value
+ *   yields a bounded amount of work.
+ * @return Refraction: in vacuo ZD minus observed ZD (radians).
+ */
+double refro_rt(double ozd, double oh, double atk, double apm, double arh, double wl, double phi, double tlr,
+    int strips) {
+    strips = std::min(std::max(strips, 2), 16384);
+    strips += strips & 1;
+    return refro_integrate(ozd, oh, atk, apm, arh, wl, phi, tlr, 0.0, strips);
+}
+
 }
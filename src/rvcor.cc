@@ -0,0 +1,138 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "spans.h"
+#include "lanes.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace sla {
+
+/**
+ * Calculates radial velocity corrections for many spectra taken at one observing site (single precision).
+ *
+ * Produces the results of sla::ecor(), sla::rverot(), sla::rvlsrk(), sla::rvlsrd(), sla::rvgalc(), and sla::rvlg()
+ * for every spectrum. The Earth ephemeris (see sla::earth()) is only calculated once per unique time, using
+ * sla::earth_batch(), so spectra taken simultaneously (e.g. with a multi-object spectrograph) share it. All the
+ * velocity components of a spectrum are then calculated in one pass over the spectra which is free of branches and
+ * library calls, so compilers can vectorize it. Results agree with those of the individual functions to within a few
+ * float ulps.
+ *
+ * @param phi Latitude of observing station (geodetic; radians).
+ * @param n Number of spectra.
+ * @param dirs Mean (for sla::ecor()) or apparent (for sla::rverot()) RA,Dec of date (radians); the difference
+ *   between the two is negligible at the accuracy of these functions.
+ * @param dirs2000 J2000.0 mean RA,Dec (radians); can be the same array as `dirs` if the difference does not matter.
+ * @param years Years, TDB (see sla::ecor()).
+ * @param days Days in years (1 = January 1-st).
+ * @param fractions Fractions of days.
+ * @param stimes Local apparent sidereal times (radians).
+ * @param corr Return value: array of `n` elements receiving radial velocity corrections; signs follow conventions
+ *   of the individual functions.
+ */
+void rvcor_batch(float phi, int n, const Spherical<float>* dirs, const Spherical<float>* dirs2000,
+    const int* years, const int* days, const float* fractions, const float* stimes, RVCorrections* corr) {
+    // AU to km and light sec (1985 Almanac), as in sla::ecor()
+    constexpr float AU_2_KM = 1.4959787066e8f;
+    constexpr float AU_2_LSEC = 499.0047837f;
+
+    // nominal mean sidereal speed of Earth equator in km/s, as in sla::rverot()
+    constexpr float EARTH_SPEED = 0.4655f;
+
+    // solar motion vectors (J2000.0 equatorial, km/s) of sla::rvlsrk(), sla::rvlsrd(), sla::rvgalc(), sla::rvlg()
+    static const float VA[4][3] = {
+        {-0.29000f, +17.31726f, -10.00141f},
+        {+0.63823f, +14.58542f, -7.80116f},
+        {-108.70408f, +97.86251f, -164.33610f},
+        {-148.23284f, +133.44888f, -224.09467f}
+    };
+
+    // unique times, and index of the unique time of each spectrum
+    std::vector<int> order(n), slots(n);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [=](int a, int b) {
+        if (years[a] != years[b]) {
+            return years[a] < years[b];
+        }
+        if (days[a] != days[b]) {
+            return days[a] < days[b];
+        }
+        return fractions[a] < fractions[b];
+    });
+    std::vector<int> uyears, udays;
+    std::vector<float> ufractions;
+    for (int k = 0; k < n; k++) {
+        const int i = order[k];
+        if (k == 0 || years[i] != uyears.back() || days[i] != udays.back() || fractions[i] != ufractions.back()) {
+            uyears.push_back(years[i]);
+            udays.push_back(days[i]);
+            ufractions.push_back(fractions[i]);
+        }
+        slots[i] = (int) uyears.size() - 1;
+    }
+
+    // Sun:Earth position & velocity vectors
+    const int nunique = (int) uyears.size();
+    std::vector<VectorPV<float>> pv(nunique);
+    earth_batch(nunique, uyears.data(), udays.data(), ufractions.data(), pv.data());
+
+    // all velocity components
+    const float erot_speed = EARTH_SPEED * std::cos(phi);
+    for (int i = 0; i < n; i++) {
+        // star position vector of date, and Earth rotation
+        float sin_a, cos_a, sin_d, cos_d, sin_h, cos_h;
+        lane_sincos(dirs[i].get_ra(), sin_a, cos_a);
+        lane_sincos(dirs[i].get_dec(), sin_d, cos_d);
+        lane_sincos(stimes[i] - dirs[i].get_ra(), sin_h, cos_h);
+        const float x = cos_a * cos_d;
+        const float y = sin_a * cos_d;
+        const float z = sin_d;
+        const float erot = erot_speed * sin_h * cos_d;
+
+        // star position vector, J2000
+        lane_sincos(dirs2000[i].get_ra(), sin_a, cos_a);
+        lane_sincos(dirs2000[i].get_dec(), sin_d, cos_d);
+        const float x2000 = cos_a * cos_d;
+        const float y2000 = sin_a * cos_d;
+        const float z2000 = sin_d;
+
+        // Earth orbital velocity and light time
+        const float* pos = pv[slots[i]].get_position();
+        const float* vel = pv[slots[i]].get_velocity();
+
+        RVCorrections& result = corr[i];
+        result.rv_erot = erot;
+        result.rv_eorb = -AU_2_KM * (vel[0] * x + vel[1] * y + vel[2] * z);
+        result.rv_lt = AU_2_LSEC * (pos[0] * x + pos[1] * y + pos[2] * z);
+        result.rv_lsrk = VA[0][0] * x2000 + VA[0][1] * y2000 + VA[0][2] * z2000;
+        result.rv_lsrd = VA[1][0] * x2000 + VA[1][1] * y2000 + VA[1][2] * z2000;
+        result.rv_galc = VA[2][0] * x2000 + VA[2][1] * y2000 + VA[2][2] * z2000;
+        result.rv_lg = VA[3][0] * x2000 + VA[3][1] * y2000 + VA[3][2] * z2000;
+    }
+}
+
+/// Version of sla::rvcor_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void rvcor_batch(float phi, StridedSpan<const Spherical<float>> dirs, StridedSpan<const Spherical<float>> dirs2000,
+    StridedSpan<const int> years, StridedSpan<const int> days, StridedSpan<const float> fractions,
+    StridedSpan<const float> stimes, StridedSpan<RVCorrections> corr) {
+    span_tiles(dirs.get_size(), [phi](int n, auto... p) { rvcor_batch(phi, n, p...); },
+        dirs, dirs2000, years, days, fractions, stimes, corr);
+}
+
+}
@@ -16,6 +16,8 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
 #include <cmath>
 
 namespace sla {
@@ -33,38 +35,48 @@ namespace sla {
  * @return A `TPPStatus` constant.
  */
 TPPStatus s2tp(const Spherical<float>& point, const Spherical<float>& tangent, float& xi, float& eta) {
-    constexpr float TINY = 1e-6f;
+    const float denom = kernel::s2tp(point.get_ra(), point.get_dec(),
+        tangent.get_ra(), std::sin(tangent.get_dec()), std::cos(tangent.get_dec()), xi, eta);
+    return kernel::s2tp_status(denom);
+}
 
-    // trig functions
+/**
+ * Projects many points onto the same tangent plane (single precision); this is a vectorized version of
+ * sla::s2tp().
+ *
+ * @param n Number of points.
+ * @param ra Right ascensions of the points to be projected.
+ * @param dec Declinations of the points to be projected.
+ * @param tangent Spherical coordinates of tangent point.
+ * @param xi Output: `n` rectangular coordinates on tangent plane.
+ * @param eta Output: `n` rectangular coordinates on tangent plane.
+ * @param status Output: `n` `TPPStatus` constants.
+ */
+void s2tp_batch(int n, const float* ra, const float* dec, const Spherical<float>& tangent, float* xi, float* eta,
+    TPPStatus* status) {
+    const float tra = tangent.get_ra();
     const float sin_tdec = std::sin(tangent.get_dec());
-    const float sin_dec = std::sin(point.get_dec());
     const float cos_tdec = std::cos(tangent.get_dec());
-    const float cos_dec = std::cos(point.get_dec());
-    const float ra_diff = point.get_ra() - tangent.get_ra();
-    const float sin_ra_diff = std::sin(ra_diff);
-    const float cos_ra_diff = std::cos(ra_diff);
-
-    // reciprocal of star vector length to tangent plane
-    float denom = sin_dec * sin_tdec + cos_dec * cos_tdec * cos_ra_diff;
-
-    // handle vectors too far from axis
-    TPPStatus status;
-    if (denom > TINY) {
-        status = TPP_OK;
-    } else if (denom >= 0.0f) {
-        status = TPP_TOO_FAR;
-        denom = TINY;
-    } else if (denom > -TINY) {
-        status = TPP_ASTAR_ON_TP;
-        denom = -TINY;
-    } else {
-        status = TPP_ASTAR_TOO_FAR;
-    }
+    lane_loop<float>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V xi_i, eta_i;
+        const V denom = kernel::s2tp(lane_load<V>(ra + i), lane_load<V>(dec + i), tra, sin_tdec, cos_tdec, xi_i, eta_i);
+        lane_store(xi_i, xi + i);
+        lane_store(eta_i, eta + i);
+        float denoms[LaneTraits<V>::width];
+        lane_store(denom, denoms);
+        for (int j = 0; j < LaneTraits<V>::width; j++) {
+            status[i + j] = kernel::s2tp_status(denoms[j]);
+        }
+    });
+}
 
-    // compute tangent plane coordinates (even in dubious cases)
-    xi = cos_dec * sin_ra_diff / denom;
-    eta = (sin_dec * cos_tdec - cos_dec * sin_tdec * cos_ra_diff) / denom;
-    return status;
+/// Version of sla::s2tp_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void s2tp_batch(StridedSpan<const float> ra, StridedSpan<const float> dec, const Spherical<float>& tangent,
+    StridedSpan<float> xi, StridedSpan<float> eta, StridedSpan<TPPStatus> status) {
+    span_tiles(ra.get_size(), [&](int n, auto ra, auto dec, auto xi, auto eta, auto status) {
+        s2tp_batch(n, ra, dec, tangent, xi, eta, status);
+    }, ra, dec, xi, eta, status);
 }
 
 }
@@ -0,0 +1,155 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include "simd.h"
+#include <cmath>
+#include <vector>
+
+namespace sla {
+
+/**
+ * Creates constraint evaluator for an observing site.
+ *
+ * Elevation limits are compared with in vacuo (unrefracted) elevations; refraction, which is at most a fraction of
+ * a degree at usable elevations, is ignored.
+ *
+ * @param elong Site longitude (radians, east positive).
+ * @param phi Site latitude (radians, geodetic).
+ * @param height Site height above sea level (meters).
+ * @param min_elevation Minimum target elevation (radians).
+ * @param max_airmass Maximum target air mass (as calculated by sla::airmas()).
+ * @param min_moon_dist Minimum angular distance between target and topocentric Moon (radians).
+ * @param max_sun_elevation Maximum Sun elevation (radians); e.g. -0.314 (-18 degrees) for astronomical twilight.
+ */
+ScheduleEvaluator::ScheduleEvaluator(double elong, double phi, double height, double min_elevation,
+    double max_airmass, double min_moon_dist, double max_sun_elevation) {
+    constexpr double PI_2 = 1.5707963267948966192313216916398;
+    se_elong = elong;
+    se_phi = phi;
+    se_height = height;
+    const double z_am = airmas_zd(max_airmass);
+    se_sin_el = std::max(std::sin(min_elevation), z_am < PI_2? std::cos(z_am): -1.0);
+    se_cos_sep = std::cos(min_moon_dist);
+    se_sin_sun = std::sin(max_sun_elevation);
+}
+
+/**
+ * Evaluates constraints for all targets at all steps of all nights; nights are processed in parallel.
+ *
+ * Sun and Moon positions are computed once per night, for all its steps at once, by sla::evp_batch() and
+ * sla::dmoon_batch(); sidereal time and observer's position are computed once per time step, and target positions are
+ * precessed to the mean equator and equinox of date once per night. Per step, targets are then evaluated in SIMD packs
+ * (see `simd.h`): evaluation takes only a few multiplications and comparisons, involves no trigonometry, and results
+ * are packed into words directly from pack masks.
+ *
+ * @param nnights Number of nights.
+ * @param starts Start of each night (UTC MJD), array of `nnights` elements.
+ * @param nsteps Number of time steps per night.
+ * @param interval Interval between time steps (days).
+ * @param ntargets Number of targets.
+ * @param dirs Targets' J2000 (FK5) right ascensions and declinations (radians), array of `ntargets` elements.
+ * @param bits Return value: array of `nnights` * `nsteps` * `get_row_size(ntargets)` words receiving the results.
+ * @param nthreads Maximum number of threads to use; zero means "one per hardware thread".
+ */
+void ScheduleEvaluator::evaluate(int nnights, const double* starts, int nsteps, double interval,
+    int ntargets, const Spherical<double>* dirs, std::uint64_t* bits, int nthreads) const {
+    constexpr double SECONDS_PER_DAY = 86400.0;
+    const int row_size = get_row_size(ntargets);
+    const double sin_phi = std::sin(se_phi);
+    const double cos_phi = std::cos(se_phi);
+
+    parallel_for(nnights, nthreads, [&] (int begin, int end) {
+        // target directions, mean of date
+        std::vector<double> tx(ntargets), ty(ntargets), tz(ntargets);
+        // TDB dates of the steps of a night, and Earth and Moon at those dates
+        std::vector<double> tdb(nsteps);
+        std::vector<Vector<double>> bvelo(nsteps), bpos(nsteps), hvelo(nsteps), hpos(nsteps);
+        std::vector<VectorPV<double>> moon(nsteps);
+
+        for (int night = begin; night < end; night++) {
+            const double start = starts[night];
+            const double tt_offset = dtt(start) / SECONDS_PER_DAY;
+
+            // precess targets to the middle of the night
+            Matrix<double> pmat;
+            prec(2000.0, epj(start + tt_offset + 0.5 * interval * (nsteps - 1)), pmat);
+            for (int i = 0; i < ntargets; i++) {
+                Vector<double> v2000, vdate;
+                dcs2c(dirs[i], v2000);
+                dmxv(pmat, v2000, vdate);
+                tx[i] = vdate[0];
+                ty[i] = vdate[1];
+                tz[i] = vdate[2];
+            }
+
+            // Sun and Moon for all steps of the night
+            for (int step = 0; step < nsteps; step++) {
+                tdb[step] = start + step * interval + tt_offset;
+            }
+            evp_batch(nsteps, tdb.data(), 0.0, bvelo.data(), bpos.data(), hvelo.data(), hpos.data());
+            dmoon_batch(nsteps, tdb.data(), moon.data());
+
+            for (int step = 0; step < nsteps; step++) {
+                const double date = start + step * interval;
+                const double lst = gmst(date) + se_elong;
+
+                // zenith direction, mean of date (ignoring nutation and polar motion)
+                const double zx = cos_phi * std::cos(lst);
+                const double zy = cos_phi * std::sin(lst);
+                const double zz = sin_phi;
+
+                // Sun is opposite to the heliocentric Earth
+                Vector<double> sun;
+                dvn(hpos[step], sun);
+                const bool dark = -(sun[0] * zx + sun[1] * zy + sun[2] * zz) <= se_sin_sun;
+
+                // topocentric Moon
+                VectorPV<double> observer;
+                pvobs(se_phi, se_height, lst, observer);
+                Vector<double> mv = {
+                    moon[step].get_x() - observer.get_x(),
+                    moon[step].get_y() - observer.get_y(),
+                    moon[step].get_z() - observer.get_z()
+                };
+                dvn(mv, mv);
+
+                // evaluate targets in packs, and pack per-target results into words
+                std::uint64_t* row = bits + ((std::size_t) night * nsteps + step) * row_size;
+                for (int w = 0; w < row_size; w++) {
+                    std::uint64_t word = 0;
+                    if (dark) {
+                        const double* x = tx.data() + w * 64;
+                        const double* y = ty.data() + w * 64;
+                        const double* z = tz.data() + w * 64;
+                        lane_loop<double>(std::min(64, ntargets - w * 64), [&](auto tag, int j) {
+                            using V = decltype(tag);
+                            const V x_j = lane_load<V>(x + j), y_j = lane_load<V>(y + j), z_j = lane_load<V>(z + j);
+                            const auto up = x_j * zx + y_j * zy + z_j * zz >= se_sin_el;
+                            const auto far = x_j * mv[0] + y_j * mv[1] + z_j * mv[2] <= se_cos_sep;
+                            word |= lane_bits(up && far) << j;
+                        });
+                    }
+                    row[w] = word;
+                }
+            }
+        }
+    }, 1);
+}
+
+}
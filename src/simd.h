@@ -0,0 +1,156 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_SIMD_H_INCLUDED
+#define SLALIB_SIMD_H_INCLUDED
+
+#include "slalib.h"
+#include <cstdint>
+#include <type_traits>
+
+/*
+ * SIMD vector types are taken from the Parallelism TS (`std::experimental::simd`) if the standard library provides
+ * it; otherwise, or if `SLALIB_NO_SIMD` is defined, a "pack" is just a single scalar, and batch functions built on
+ * top of this header degrade to plain loops over the kernels in `kernels.h`.
+ */
+#if !defined(SLALIB_NO_SIMD) && defined(__has_include)
+#if __has_include(<experimental/simd>)
+#include <experimental/simd>
+#define SLALIB_SIMD 1
+#endif
+#endif
+#ifndef SLALIB_SIMD
+#define SLALIB_SIMD 0
+#endif
+
+namespace sla {
+
+#if SLALIB_SIMD
+
+/// Widest SIMD pack of `T` elements supported by the target.
+template <typename T>
+using Pack = std::experimental::native_simd<T>;
+
+template <typename T, typename A>
+struct LaneTraits<std::experimental::simd<T, A>> {
+    using scalar = T;
+    static constexpr int width = (int) std::experimental::simd_size_v<T, A>;
+
+    static std::experimental::simd<T, A> select(const std::experimental::simd_mask<T, A>& mask,
+        const std::experimental::simd<T, A>& a, std::experimental::simd<T, A> b) {
+        where(mask, b) = a;
+        return b;
+    }
+};
+
+#else
+
+template <typename T>
+using Pack = T;
+
+#endif // SLALIB_SIMD
+
+/// Loads `V` from consecutive elements starting at `p`.
+template <typename V, std::enable_if_t<std::is_floating_point<V>::value, bool> = true>
+inline V lane_load(const V* p) {
+    return *p;
+}
+
+/// Loads `V` from elements `stride` apart, starting at `p`.
+template <typename V, std::enable_if_t<std::is_floating_point<V>::value, bool> = true>
+inline V lane_load(const V* p, int) {
+    return *p;
+}
+
+/// Stores `v` to consecutive elements starting at `p`.
+template <typename V, std::enable_if_t<std::is_floating_point<V>::value, bool> = true>
+inline void lane_store(V v, V* p) {
+    *p = v;
+}
+
+/// Stores `v` to elements `stride` apart, starting at `p`.
+template <typename V, std::enable_if_t<std::is_floating_point<V>::value, bool> = true>
+inline void lane_store(V v, V* p, int) {
+    *p = v;
+}
+
+#if SLALIB_SIMD
+
+template <typename V, std::enable_if_t<std::experimental::is_simd_v<V>, bool> = true>
+inline V lane_load(const lane_scalar_t<V>* p) {
+    return V(p, std::experimental::element_aligned);
+}
+
+template <typename V, std::enable_if_t<std::experimental::is_simd_v<V>, bool> = true>
+inline V lane_load(const lane_scalar_t<V>* p, int stride) {
+    return V([p, stride](auto i) { return p[i * stride]; });
+}
+
+template <typename V, std::enable_if_t<std::experimental::is_simd_v<V>, bool> = true>
+inline void lane_store(const V& v, lane_scalar_t<V>* p) {
+    v.copy_to(p, std::experimental::element_aligned);
+}
+
+template <typename V, std::enable_if_t<std::experimental::is_simd_v<V>, bool> = true>
+inline void lane_store(const V& v, lane_scalar_t<V>* p, int stride) {
+    for (int i = 0; i < LaneTraits<V>::width; i++) {
+        p[i * stride] = v[i];
+    }
+}
+
+#endif // SLALIB_SIMD
+
+/// Bit mask of a per-lane condition, with lane 0 in the lowest bit.
+inline std::uint64_t lane_bits(bool mask) {
+    return mask;
+}
+
+#if SLALIB_SIMD
+
+template <typename T, typename A>
+inline std::uint64_t lane_bits(const std::experimental::simd_mask<T, A>& mask) {
+    std::uint64_t bits = 0;
+    for (int i = 0; i < (int) mask.size(); i++) {
+        bits |= (std::uint64_t) mask[i] << i;
+    }
+    return bits;
+}
+
+#endif // SLALIB_SIMD
+
+/**
+ * Runs `func(tag, i)` over range [0..n): full packs of `T` are processed first, with `tag` of type `Pack<T>`, and the
+ * tail element by element, with `tag` of type `T`; `func` is meant to be a generic lambda that takes the value type
+ * as `decltype(tag)`, loads operands at index `i`, and calls a kernel template from `kernels.h`.
+ */
+template <typename T, typename F>
+inline void lane_loop(int n, F func) {
+    constexpr int width = LaneTraits<Pack<T>>::width;
+    int i = 0;
+    if constexpr (width > 1) {
+        for (; i + width <= n; i += width) {
+            func(Pack<T>(), i);
+        }
+    }
+    for (; i < n; i++) {
+        func(T(), i);
+    }
+}
+
+} // sla
+
+#endif // SLALIB_SIMD_H_INCLUDED
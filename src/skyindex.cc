@@ -0,0 +1,509 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+
+namespace sla {
+
+// vertices of the octahedron the mesh starts from
+static const double OCTAHEDRON[6][3] = {
+    {0.0, 0.0, 1.0}, {1.0, 0.0, 0.0}, {0.0, 1.0, 0.0}, {-1.0, 0.0, 0.0}, {0.0, -1.0, 0.0}, {0.0, 0.0, -1.0}
+};
+
+// vertices of the eight base cells (counterclockwise as seen from outside): S0..S3, then N0..N3
+static const int BASE_CELLS[8][3] = {
+    {1, 5, 2}, {2, 5, 3}, {3, 5, 4}, {4, 5, 1}, {1, 0, 4}, {4, 0, 3}, {3, 0, 2}, {2, 0, 1}
+};
+
+static constexpr double PI = 3.1415926535897932384626433832795;
+
+// margin (radians) that makes classification of cells conservative in the presence of rounding errors
+static constexpr double MARGIN = 1.0e-12;
+
+// signature of on-disk form of the index, and its version
+static const char FILE_MAGIC[8] = {'S', 'L', 'A', 'S', 'K', 'Y', 'I', 'X'};
+static constexpr std::int32_t FILE_VERSION = 1;
+
+/// Stores normalized sum of `va` and `vb` into `vc`.
+static void midpoint(const double* va, const double* vb, double* vc) {
+    Vector<double> sum = {va[0] + vb[0], va[1] + vb[1], va[2] + vb[2]};
+    dvn(sum, vc);
+}
+
+/// Returns `true` if `vec` is on the left of (or on) the great circle going from `va` to `vb`.
+static bool left_of(const double* va, const double* vb, const double* vec) {
+    Vector<double> normal;
+    dvxv(va, vb, normal);
+    return dvdv(normal, vec) >= 0.0;
+}
+
+/**
+ * Calls `visit(a, b, c, id, level)` for a cell and, if `visit()` returns `true`, for its four children, recursively;
+ * children are visited in the order of their ids.
+ */
+template <typename F>
+static void descend(const double* a, const double* b, const double* c, std::uint64_t id, int level, F& visit) {
+    if (visit(a, b, c, id, level)) {
+        Vector<double> w0, w1, w2;
+        midpoint(b, c, w0);
+        midpoint(a, c, w1);
+        midpoint(a, b, w2);
+        descend(a, w2, w1, id * 4, level + 1, visit);
+        descend(b, w0, w2, id * 4 + 1, level + 1, visit);
+        descend(c, w1, w0, id * 4 + 2, level + 1, visit);
+        descend(w0, w1, w2, id * 4 + 3, level + 1, visit);
+    }
+}
+
+/// Returns squared distance between two points (i.e. squared chord, or 4*sin**2(d/2) for unit vectors d apart).
+static double chord2(const double* va, const double* vb) {
+    const double dx = va[0] - vb[0];
+    const double dy = va[1] - vb[1];
+    const double dz = va[2] - vb[2];
+    return dx * dx + dy * dy + dz * dz;
+}
+
+/**
+ * Collects cells covering a region, descending from the base cells down to `level` (cells at lower levels are returned
+ * as ranges of their descendants at `depth`); `classify(center, s, c)` must
+ * return -1 if the cap of given center, whose radius `r` has sin(r/2) = `s` and cos(r/2) = `c`, is disjoint from the
+ * region, +1 if the cap lies within the region, and 0 otherwise. Adjacent ranges of the same kind are merged.
+ *
+ * Caps are handled through the sines and cosines of their half-radii, which unlike cosines of the radii keep full
+ * relative precision for small cells, and save inverse trigonometric functions on every visited cell.
+ */
+template <typename F>
+static void cover(int depth, int level_limit, F classify, std::vector<SkyCellRange>& ranges) {
+    ranges.clear();
+    auto visit = [&](const double* a, const double* b, const double* c, std::uint64_t id, int level) {
+        // bounding cap of the cell
+        Vector<double> center = {a[0] + b[0] + c[0], a[1] + b[1] + c[1], a[2] + b[2] + c[2]};
+        dvn(center, center);
+        const double s = 0.5 * std::sqrt(std::max(chord2(center, a), std::max(chord2(center, b), chord2(center, c))));
+
+        const int kind = classify(center, s, std::sqrt(1.0 - s * s));
+        if (kind < 0) {
+            return false;
+        }
+        if (kind == 0 && level < level_limit) {
+            return true;
+        }
+        const int shift = 2 * (depth - level);
+        const std::uint64_t first = id << shift;
+        const std::uint64_t last = ((id + 1) << shift) - 1;
+        const bool full = kind > 0;
+        if (!ranges.empty() && ranges.back().scr_last + 1 == first && ranges.back().scr_full == full) {
+            ranges.back().scr_last = last;
+        } else {
+            ranges.push_back({first, last, full});
+        }
+        return false;
+    };
+    for (int i = 0; i < 8; i++) {
+        descend(OCTAHEDRON[BASE_CELLS[i][0]], OCTAHEDRON[BASE_CELLS[i][1]], OCTAHEDRON[BASE_CELLS[i][2]], i, 0,
+            visit);
+    }
+}
+
+/**
+ * Computes unit normals of the edges of a spherical polygon, pointing inwards; fails unless the polygon is convex and
+ * its vertices are given counterclockwise (as seen from outside the sphere).
+ *
+ * @param nv Number of vertices.
+ * @param vertices Vertices of the polygon.
+ * @param normals Return value: `nv` normals; normal `i` is that of the edge going from vertex `i` to `i+1`.
+ * @return `true` if normals were computed, `false` if the polygon is not convex or not counterclockwise.
+ */
+static bool edge_normals(int nv, const Vector<double>* vertices, std::vector<double>& normals) {
+    if (nv < 3) {
+        return false;
+    }
+    normals.resize(3 * (std::size_t) nv);
+    for (int i = 0; i < nv; i++) {
+        double* normal = &normals[3 * i];
+        dvxv(vertices[i], vertices[(i + 1) % nv], normal);
+        if (dvn(normal, normal) == 0.0) {
+            return false;
+        }
+        for (int j = 0; j < nv; j++) {
+            if (j != i && j != (i + 1) % nv && dvdv(normal, vertices[j]) <= 0.0) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * Creates an empty index.
+ *
+ * @param depth Subdivision depth of the mesh, 0 to `MAX_DEPTH`: at depth 0, there are eight cells (the faces of an
+ *   octahedron); every level splits each cell into four, so that cells at depth `d` are about 90/2**d degrees across.
+ *   Depth should be chosen so that a typical cell holds a few dozen points.
+ */
+SkyIndex::SkyIndex(int depth): si_depth(depth) {
+    assert(depth >= 0 && depth <= MAX_DEPTH);
+}
+
+/**
+ * Finds the cell of the mesh that contains given point. Cells at depth `d` are numbered from 0 to 8*4**d-1 so that
+ * the four children of cell `i` are cells 4*i to 4*i+3 of the next level; thus, cells descending from the same cell
+ * form a contiguous range of ids, and nearby points tend to have close ids. Points on the boundary of two cells are
+ * assigned to one of them.
+ *
+ * @param vec Direction of the point; need not be of unit length, but must not be zero.
+ * @param depth Subdivision depth of the mesh, 0 to `MAX_DEPTH`.
+ * @return Id of the cell.
+ */
+std::uint64_t SkyIndex::get_cell(const Vector<double> vec, int depth) {
+    int base = 0;
+    while (base < 7 && !(left_of(OCTAHEDRON[BASE_CELLS[base][0]], OCTAHEDRON[BASE_CELLS[base][1]], vec) &&
+        left_of(OCTAHEDRON[BASE_CELLS[base][1]], OCTAHEDRON[BASE_CELLS[base][2]], vec) &&
+        left_of(OCTAHEDRON[BASE_CELLS[base][2]], OCTAHEDRON[BASE_CELLS[base][0]], vec))) {
+        base++;
+    }
+    Vector<double> a, b, c;
+    std::memcpy(a, OCTAHEDRON[BASE_CELLS[base][0]], sizeof a);
+    std::memcpy(b, OCTAHEDRON[BASE_CELLS[base][1]], sizeof b);
+    std::memcpy(c, OCTAHEDRON[BASE_CELLS[base][2]], sizeof c);
+    std::uint64_t id = base;
+    for (int level = 0; level < depth; level++) {
+        Vector<double> w0, w1, w2;
+        midpoint(b, c, w0);
+        midpoint(a, c, w1);
+        midpoint(a, b, w2);
+        if (left_of(w2, w1, vec)) {
+            // child 0: (a, w2, w1)
+            std::memcpy(b, w2, sizeof b);
+            std::memcpy(c, w1, sizeof c);
+            id = id * 4;
+        } else if (left_of(w0, w2, vec)) {
+            // child 1: (b, w0, w2)
+            std::memcpy(a, b, sizeof a);
+            std::memcpy(b, w0, sizeof b);
+            std::memcpy(c, w2, sizeof c);
+            id = id * 4 + 1;
+        } else if (left_of(w1, w0, vec)) {
+            // child 2: (c, w1, w0)
+            std::memcpy(a, c, sizeof a);
+            std::memcpy(b, w1, sizeof b);
+            std::memcpy(c, w0, sizeof c);
+            id = id * 4 + 2;
+        } else {
+            // child 3: (w0, w1, w2)
+            std::memcpy(a, w0, sizeof a);
+            std::memcpy(b, w1, sizeof b);
+            std::memcpy(c, w2, sizeof c);
+            id = id * 4 + 3;
+        }
+    }
+    return id;
+}
+
+/**
+ * Finds cells of all points, and sorts points by cell ids; the points must be stored (as unit vectors) in
+ * `si_vectors`, in their original order.
+ *
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void SkyIndex::index_points(int nthreads) {
+    const int n = (int) (si_vectors.size() / 3);
+    const int depth = si_depth;
+    std::vector<std::uint64_t> cells(n);
+    parallel_for(n, nthreads, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            cells[i] = get_cell(&si_vectors[3 * (std::size_t) i], depth);
+        }
+    }, 1024);
+
+    // stable, so points in the same cell stay in their original order
+    si_order.resize(n);
+    radix_sort_keys(n, cells.data(), si_order.data(), nthreads);
+
+    // put cell ids and vectors in that order
+    si_cells.resize(n);
+    std::vector<double> vectors(si_vectors.size());
+    parallel_for(n, nthreads, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            const std::size_t k = si_order[i];
+            si_cells[i] = cells[k];
+            std::memcpy(&vectors[3 * (std::size_t) i], &si_vectors[3 * k], 3 * sizeof(double));
+        }
+    }, 1024);
+    si_vectors.swap(vectors);
+}
+
+/**
+ * Builds the index over given points, replacing its current contents; the vectors are normalized.
+ *
+ * @param n Number of points.
+ * @param vecs Directions of the points; must not be zero.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void SkyIndex::build(int n, const Vector<double>* vecs, int nthreads) {
+    si_vectors.resize(3 * (std::size_t) n);
+    parallel_for(n, nthreads, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            dvn(vecs[i], &si_vectors[3 * (std::size_t) i]);
+        }
+    }, 1024);
+    index_points(nthreads);
+}
+
+/**
+ * Builds the index over given points, replacing its current contents.
+ *
+ * @param n Number of points.
+ * @param ra Right ascensions (or longitudes) of the points (radians).
+ * @param dec Declinations (or latitudes) of the points (radians).
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void SkyIndex::build(int n, const double* ra, const double* dec, int nthreads) {
+    si_vectors.resize(3 * (std::size_t) n);
+    parallel_for(n, nthreads, [&](int first, int last) {
+        for (int i = first; i < last; i++) {
+            dcs2c({ra[i], dec[i]}, &si_vectors[3 * (std::size_t) i]);
+        }
+    }, 1024);
+    index_points(nthreads);
+}
+
+/**
+ * Finds cells (at the depth of the index) that cover a cone, i.e. a circle on the sphere. Classification of cells is
+ * conservative: "full" cells are within the cone, while "partial" ones may contain points both inside and outside
+ * of it, or even lie outside of it entirely.
+ *
+ * @param center Direction of the axis of the cone; must not be zero.
+ * @param radius Radius of the cone (radians).
+ * @param ranges Return value: ranges of cells, in ascending order.
+ * @param level Level at which to stop subdividing partial cells, up to the depth of the index (negative means "the
+ *   depth of the index"); coarser levels yield fewer but wider partial ranges, and are faster to compute.
+ */
+void SkyIndex::query_cone(const Vector<double> center, double radius, std::vector<SkyCellRange>& ranges,
+    int level) const {
+    Vector<double> axis;
+    dvn(center, axis);
+    // sines and cosines of halves of the radius, widened and narrowed by the margin
+    const double outer = 0.5 * std::min(radius + MARGIN, PI);
+    const double inner = 0.5 * std::max(radius - MARGIN, 0.0);
+    const double s_outer = std::sin(outer), c_outer = std::cos(outer);
+    const double s_inner = std::sin(inner), c_inner = std::cos(inner);
+    cover(si_depth, level < 0? si_depth: std::min(level, si_depth), [&](const Vector<double> cap_center, double s,
+        double c) {
+        // sine of half of the distance from the axis to the center of the cap
+        const double s_distance = 0.5 * std::sqrt(chord2(cap_center, axis));
+        // disjoint if distance exceeds outer radius plus cap radius (which must then be less than PI)
+        if (c_outer * c - s_outer * s > 0.0 && s_distance > s_outer * c + c_outer * s) {
+            return -1;
+        }
+        // within if distance does not exceed inner radius minus cap radius
+        return s <= s_inner && s_distance <= s_inner * c - c_inner * s? 1: 0;
+    }, ranges);
+}
+
+/**
+ * Finds cells (at the depth of the index) that cover a convex spherical polygon, whose sides are great circle arcs.
+ * Classification of cells is conservative (see sla::SkyIndex::query_cone()).
+ *
+ * @param nv Number of vertices, at least 3.
+ * @param vertices Directions of the vertices, counterclockwise as seen from outside the sphere (i.e. with the inside
+ *   of the polygon on the left when going from one vertex to the next, as on a sky chart with east to the left).
+ * @param ranges Return value: ranges of cells, in ascending order.
+ * @return `true` if ranges were found, `false` if the polygon is not convex, or its vertices are not counterclockwise.
+ */
+bool SkyIndex::query_polygon(int nv, const Vector<double>* vertices, std::vector<SkyCellRange>& ranges) const {
+    std::vector<double> normals;
+    if (!edge_normals(nv, vertices, normals)) {
+        ranges.clear();
+        return false;
+    }
+    cover(si_depth, si_depth, [&](const Vector<double> cap_center, double s, double c) {
+        // sine of the cap radius plus the margin (cap radii never exceed 55 degrees, so the sum is below 90)
+        const double reach = 2.0 * s * c + MARGIN * (c * c - s * s);
+        int kind = 1;
+        for (int i = 0; i < nv; i++) {
+            // sine of the distance from the center of the cap to the plane of the edge, positive inside
+            const double distance = dvdv(&normals[3 * i], cap_center);
+            if (distance < -reach) {
+                return -1;
+            }
+            if (distance < reach) {
+                kind = 0;
+            }
+        }
+        return kind;
+    }, ranges);
+    return true;
+}
+
+/**
+ * Collects indices of points that lie in given ranges of cells: all points in full ranges, and those in partial ones
+ * for which `accept(vec)` returns `true`.
+ */
+template <typename F>
+void SkyIndex::collect(const std::vector<SkyCellRange>& ranges, std::vector<int>& found, F accept) const {
+    found.clear();
+    for (const SkyCellRange& range: ranges) {
+        const auto begin = std::lower_bound(si_cells.begin(), si_cells.end(), range.scr_first);
+        const auto end = std::upper_bound(begin, si_cells.end(), range.scr_last);
+        for (auto k = (std::size_t) (begin - si_cells.begin()); k < (std::size_t) (end - si_cells.begin()); k++) {
+            if (range.scr_full || accept(&si_vectors[3 * k])) {
+                found.push_back(si_order[k]);
+            }
+        }
+    }
+}
+
+/**
+ * Finds points within a cone (i.e. within given angular distance from a direction). Points in cells that lie within
+ * the cone are accepted without testing; chord distances from the axis to other candidate points are compared to
+ * those of the radius plus and minus 1e-12 radians, and only borderline cases are resolved with sla::dsepv().
+ *
+ * @param center Direction of the axis of the cone; must not be zero.
+ * @param radius Radius of the cone (radians).
+ * @param found Return value: original indices of the points within the cone, in the order of their cell ids.
+ */
+void SkyIndex::search_cone(const Vector<double> center, double radius, std::vector<int>& found) const {
+    std::vector<SkyCellRange> ranges;
+    query_cone(center, radius, ranges);
+    Vector<double> axis;
+    dvn(center, axis);
+    const double inner = 2.0 * std::sin(0.5 * std::max(radius - MARGIN, 0.0));
+    const double outer = 2.0 * std::sin(0.5 * std::min(radius + MARGIN, PI));
+    const double inner2 = inner * inner, outer2 = outer * outer;
+    collect(ranges, found, [&](const double* vec) {
+        const double distance2 = chord2(vec, axis);
+        if (distance2 < inner2) {
+            return true;
+        }
+        return distance2 <= outer2 && dsepv(vec, axis) <= radius;
+    });
+}
+
+/**
+ * Finds points within a convex spherical polygon (see sla::SkyIndex::query_polygon()).
+ *
+ * @param nv Number of vertices, at least 3.
+ * @param vertices Directions of the vertices, counterclockwise as seen from outside the sphere.
+ * @param found Return value: original indices of the points within the polygon, in the order of their cell ids.
+ * @return `true` if search was done, `false` if the polygon is not convex, or its vertices are not counterclockwise.
+ */
+bool SkyIndex::search_polygon(int nv, const Vector<double>* vertices, std::vector<int>& found) const {
+    std::vector<SkyCellRange> ranges;
+    if (!query_polygon(nv, vertices, ranges)) {
+        found.clear();
+        return false;
+    }
+    std::vector<double> normals;
+    edge_normals(nv, vertices, normals);
+    collect(ranges, found, [&](const double* vec) {
+        for (int i = 0; i < nv; i++) {
+            if (dvdv(&normals[3 * i], vec) < 0.0) {
+                return false;
+            }
+        }
+        return true;
+    });
+    return true;
+}
+
+/**
+ * Saves the index to a file, in the byte order of the host: signature, version, depth, and number of points, followed
+ * by sorted cell ids, original indices, and unit vectors of the points. The file is not portable: it can only be
+ * loaded on hosts with the same byte order and the same size of `int`.
+ *
+ * @param path Path to the file, which is overwritten.
+ * @return `true` if the index was saved, `false` if the file could not be written.
+ */
+bool SkyIndex::save(const char* path) const {
+    std::FILE* file = std::fopen(path, "wb");
+    if (file == nullptr) {
+        return false;
+    }
+    const std::int32_t depth = si_depth;
+    const std::int64_t n = (std::int64_t) si_order.size();
+    bool ok = std::fwrite(FILE_MAGIC, sizeof FILE_MAGIC, 1, file) == 1 &&
+        std::fwrite(&FILE_VERSION, sizeof FILE_VERSION, 1, file) == 1 &&
+        std::fwrite(&depth, sizeof depth, 1, file) == 1 &&
+        std::fwrite(&n, sizeof n, 1, file) == 1;
+    if (ok && n > 0) {
+        ok = std::fwrite(si_cells.data(), sizeof(std::uint64_t), n, file) == (std::size_t) n &&
+            std::fwrite(si_order.data(), sizeof(int), n, file) == (std::size_t) n &&
+            std::fwrite(si_vectors.data(), sizeof(double), 3 * n, file) == 3 * (std::size_t) n;
+    }
+    return std::fclose(file) == 0 && ok;
+}
+
+/**
+ * Loads index saved by sla::SkyIndex::save(), replacing its current contents (including depth). The file must have
+ * been written on a host with the same byte order (which is not checked, other than by the signature and version).
+ *
+ * @param path Path to the file.
+ * @return `true` if the index was loaded, `false` if the file could not be read or is not a valid index file, e.g.
+ *   if it is shorter than its point count implies (the index is then left empty).
+ */
+bool SkyIndex::load(const char* path) {
+    si_cells.clear();
+    si_order.clear();
+    si_vectors.clear();
+    std::FILE* file = std::fopen(path, "rb");
+    if (file == nullptr) {
+        return false;
+    }
+    char magic[sizeof FILE_MAGIC];
+    std::int32_t version = 0, depth = -1;
+    std::int64_t n = -1;
+    bool ok = std::fread(magic, sizeof magic, 1, file) == 1 && std::memcmp(magic, FILE_MAGIC, sizeof magic) == 0 &&
+        std::fread(&version, sizeof version, 1, file) == 1 && version == FILE_VERSION &&
+        std::fread(&depth, sizeof depth, 1, file) == 1 && depth >= 0 && depth <= MAX_DEPTH &&
+        std::fread(&n, sizeof n, 1, file) == 1 && n >= 0 && n <= INT32_MAX;
+    if (ok) {
+        // check the size of the remaining data before allocating memory for it
+        const long header = std::ftell(file);
+        ok = header >= 0 && std::fseek(file, 0, SEEK_END) == 0;
+        const long end = ok? std::ftell(file): -1;
+        const std::int64_t record = sizeof(std::uint64_t) + sizeof(int) + 3 * sizeof(double);
+        ok = ok && end >= header && (std::int64_t) (end - header) >= n * record &&
+            std::fseek(file, header, SEEK_SET) == 0;
+    }
+    if (ok) {
+        si_cells.resize(n);
+        si_order.resize(n);
+        si_vectors.resize(3 * (std::size_t) n);
+        ok = std::fread(si_cells.data(), sizeof(std::uint64_t), n, file) == (std::size_t) n &&
+            std::fread(si_order.data(), sizeof(int), n, file) == (std::size_t) n &&
+            std::fread(si_vectors.data(), sizeof(double), 3 * n, file) == 3 * (std::size_t) n;
+    }
+    std::fclose(file);
+    if (!ok) {
+        si_cells.clear();
+        si_order.clear();
+        si_vectors.clear();
+        return false;
+    }
+    si_depth = depth;
+    return true;
+}
+
+} // sla
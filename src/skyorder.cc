@@ -0,0 +1,325 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include "spans.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <utility>
+
+namespace sla {
+
+// number of bits per coordinate of the Hilbert curve on each face of the cube
+static constexpr int HILBERT_ORDER = 28;
+
+// number of bits sorted by one pass of the radix sort
+static constexpr int RADIX_BITS = 8;
+static constexpr int RADIX_SIZE = 1 << RADIX_BITS;
+
+/**
+ * Computes key of a direction on a Hilbert curve covering the sphere: the direction is projected onto the face of the
+ * circumscribed cube it points to, and the position on that face is converted to the index of a point on a Hilbert
+ * curve of 2**28 by 2**28 cells (about 3 milliarcseconds across). Sorting points by their keys puts points close to
+ * each other on the sky close to each other in memory (except across edges of the cube), which improves locality of
+ * subsequent spatial processing.
+ *
+ * @param vec Direction; need not be of unit length, but must not be zero.
+ * @return Key, less than 6*2**56; its three most significant bits identify the face of the cube.
+ */
+std::uint64_t hilbert_key(const Vector<double> vec) {
+    // face of the cube, and position on it in [-1..1]
+    const double ax = std::fabs(vec[0]), ay = std::fabs(vec[1]), az = std::fabs(vec[2]);
+    int face;
+    double u, v;
+    if (ax >= ay && ax >= az) {
+        face = vec[0] >= 0.0? 0: 3;
+        u = vec[1] / ax;
+        v = vec[2] / ax;
+    } else if (ay >= az) {
+        face = vec[1] >= 0.0? 1: 4;
+        u = vec[2] / ay;
+        v = vec[0] / ay;
+    } else {
+        face = vec[2] >= 0.0? 2: 5;
+        u = vec[0] / az;
+        v = vec[1] / az;
+    }
+    constexpr std::uint32_t SIDE = 1u << HILBERT_ORDER;
+    std::uint32_t x = (std::uint32_t) std::min((u + 1.0) * (0.5 * SIDE), (double) (SIDE - 1));
+    std::uint32_t y = (std::uint32_t) std::min((v + 1.0) * (0.5 * SIDE), (double) (SIDE - 1));
+
+    // index on the Hilbert curve: quadrant by quadrant, rotating the lower ones
+    std::uint64_t index = 0;
+    for (std::uint32_t s = SIDE / 2; s > 0; s /= 2) {
+        const std::uint32_t rx = (x & s) != 0;
+        const std::uint32_t ry = (y & s) != 0;
+        index += (std::uint64_t) s * s * ((3 * rx) ^ ry);
+        if (ry == 0) {
+            if (rx == 1) {
+                x = s - 1 - (x & (s - 1));
+                y = s - 1 - (y & (s - 1));
+            }
+            std::swap(x, y);
+        }
+    }
+    return ((std::uint64_t) face << (2 * HILBERT_ORDER)) | index;
+}
+
+/**
+ * Computes Hilbert curve keys of an array of directions (see sla::hilbert_key()).
+ *
+ * @param n Number of directions.
+ * @param ra Right ascensions (or longitudes) of the directions (radians).
+ * @param dec Declinations (or latitudes) of the directions (radians).
+ * @param keys Return value: keys of the directions.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void hilbert_key_batch(int n, const double* ra, const double* dec, std::uint64_t* keys, int nthreads) {
+    parallel_for(n, nthreads, [=](int first, int last) {
+        for (int i = first; i < last; i++) {
+            Vector<double> vec;
+            dcs2c({ra[i], dec[i]}, vec);
+            keys[i] = hilbert_key(vec);
+        }
+    }, 4096);
+}
+
+/// Version of sla::hilbert_key_batch() that accesses items through strided spans of the same size.
+void hilbert_key_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, StridedSpan<std::uint64_t> keys,
+    int nthreads) {
+    parallel_span_tiles(ra.get_size(), nthreads, [](int n, auto ra, auto dec, auto keys) {
+        hilbert_key_batch(n, ra, dec, keys, 1);
+    }, ra, dec, keys);
+}
+
+/**
+ * Computes the permutation that sorts an array of keys, using a parallel least-significant-digit radix sort: every
+ * pass (over 8 bits) counts digits in one chunk of the array per thread, and then moves indices to their places,
+ * again one chunk per thread. Passes over digits that are the same in all keys are skipped, so that small keys take
+ * fewer passes. The sort is stable: indices of equal keys remain in ascending order.
+ *
+ * @param n Number of keys.
+ * @param keys Keys to sort.
+ * @param order Return value: permutation of indices of the keys, such that `keys[order[i]]` never decreases.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void radix_sort_keys(int n, const std::uint64_t* keys, int* order, int nthreads) {
+    if (nthreads <= 0) {
+        nthreads = std::max(1, (int) std::thread::hardware_concurrency());
+    }
+    const int nparts = std::max(1, std::min(nthreads, n / 65536));
+    const int part = (n + nparts - 1) / std::max(nparts, 1);
+
+    // bits that differ between keys
+    std::vector<std::uint64_t> part_or(nparts, 0), part_and(nparts, ~(std::uint64_t) 0);
+    parallel_for(nparts, nparts, [&](int first, int last) {
+        for (int p = first; p < last; p++) {
+            for (int i = p * part; i < std::min(n, (p + 1) * part); i++) {
+                part_or[p] |= keys[i];
+                part_and[p] &= keys[i];
+            }
+        }
+    }, 1);
+    std::uint64_t any = 0, all = ~(std::uint64_t) 0;
+    for (int p = 0; p < nparts; p++) {
+        any |= part_or[p];
+        all &= part_and[p];
+    }
+    const std::uint64_t differ = any ^ all;
+
+    // keys and indices are moved together, between two pairs of buffers
+    std::vector<std::uint64_t> keys_in(keys, keys + n), keys_out(n);
+    std::vector<int> order_out(n);
+    for (int i = 0; i < n; i++) {
+        order[i] = i;
+    }
+    int* order_in = order;
+    int* order_buffer = order_out.data();
+    std::vector<int> counts((std::size_t) nparts * RADIX_SIZE);
+    for (int shift = 0; shift < 64; shift += RADIX_BITS) {
+        if (((differ >> shift) & (RADIX_SIZE - 1)) == 0) {
+            continue;
+        }
+        parallel_for(nparts, nparts, [&](int first, int last) {
+            for (int p = first; p < last; p++) {
+                int* count = &counts[(std::size_t) p * RADIX_SIZE];
+                std::fill(count, count + RADIX_SIZE, 0);
+                for (int i = p * part; i < std::min(n, (p + 1) * part); i++) {
+                    count[(keys_in[i] >> shift) & (RADIX_SIZE - 1)]++;
+                }
+            }
+        }, 1);
+        // turn counts into starting positions: digit by digit, and part by part within each digit
+        int position = 0;
+        for (int digit = 0; digit < RADIX_SIZE; digit++) {
+            for (int p = 0; p < nparts; p++) {
+                const int count = counts[(std::size_t) p * RADIX_SIZE + digit];
+                counts[(std::size_t) p * RADIX_SIZE + digit] = position;
+                position += count;
+            }
+        }
+        parallel_for(nparts, nparts, [&](int first, int last) {
+            for (int p = first; p < last; p++) {
+                int* next = &counts[(std::size_t) p * RADIX_SIZE];
+                for (int i = p * part; i < std::min(n, (p + 1) * part); i++) {
+                    const int k = next[(keys_in[i] >> shift) & (RADIX_SIZE - 1)]++;
+                    keys_out[k] = keys_in[i];
+                    order_buffer[k] = order_in[i];
+                }
+            }
+        }, 1);
+        keys_in.swap(keys_out);
+        std::swap(order_in, order_buffer);
+    }
+    if (order_in != order) {
+        std::copy(order_in, order_in + n, order);
+    }
+}
+
+/**
+ * Computes the permutation that puts an array of directions in the order of their Hilbert curve keys (see
+ * sla::hilbert_key()); columns of a catalogue can then be put in that order with sla::gather_batch(), and results
+ * computed from the reordered columns can be put back in the original order with sla::scatter_batch().
+ *
+ * @param n Number of directions.
+ * @param ra Right ascensions (or longitudes) of the directions (radians).
+ * @param dec Declinations (or latitudes) of the directions (radians).
+ * @param order Return value: permutation of indices; direction `order[i]` should go to position `i`.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void hilbert_order(int n, const double* ra, const double* dec, int* order, int nthreads) {
+    std::vector<std::uint64_t> keys(n);
+    hilbert_key_batch(n, ra, dec, keys.data(), nthreads);
+    radix_sort_keys(n, keys.data(), order, nthreads);
+}
+
+/// Version of sla::hilbert_order() that reads directions through strided spans of the same size.
+void hilbert_order(StridedSpan<const double> ra, StridedSpan<const double> dec, int* order, int nthreads) {
+    const int n = ra.get_size();
+    std::vector<std::uint64_t> keys(n);
+    hilbert_key_batch(ra, dec, StridedSpan<std::uint64_t>(keys.data(), n), nthreads);
+    radix_sort_keys(n, keys.data(), order, nthreads);
+}
+
+/// Implementation of sla::gather_batch() for any type of values, accessed through pointers or sla::StridedSpan.
+template <typename V, typename R>
+static void gather(int n, const int* order, V values, R result, int nthreads) {
+    assert(n == 0 || &values[0] != &result[0]);
+    parallel_for(n, nthreads, [=](int first, int last) {
+        for (int i = first; i < last; i++) {
+            result[i] = values[order[i]];
+        }
+    }, 16384);
+}
+
+/// Implementation of sla::scatter_batch() for any type of values, accessed through pointers or sla::StridedSpan.
+template <typename V, typename R>
+static void scatter(int n, const int* order, V values, R result, int nthreads) {
+    assert(n == 0 || &values[0] != &result[0]);
+    parallel_for(n, nthreads, [=](int first, int last) {
+        for (int i = first; i < last; i++) {
+            result[order[i]] = values[i];
+        }
+    }, 16384);
+}
+
+/**
+ * Puts values (e.g. a column of a catalogue) in the order given by a permutation: `result[i] = values[order[i]]`.
+ *
+ * @param n Number of values.
+ * @param order Permutation of indices (e.g. computed by sla::hilbert_order()).
+ * @param values Values to reorder.
+ * @param result Return value: reordered values; must not overlap with `values`.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void gather_batch(int n, const int* order, const double* values, double* result, int nthreads) {
+    gather(n, order, values, result, nthreads);
+}
+
+/// Single precision version of sla::gather_batch().
+void gather_batch(int n, const int* order, const float* values, float* result, int nthreads) {
+    gather(n, order, values, result, nthreads);
+}
+
+/// Integer version of sla::gather_batch() (e.g. for identifiers of catalogue entries).
+void gather_batch(int n, const int* order, const int* values, int* result, int nthreads) {
+    gather(n, order, values, result, nthreads);
+}
+
+/// Version of sla::gather_batch() that accesses values through strided spans of the same size (see sla::StridedSpan).
+void gather_batch(const int* order, StridedSpan<const double> values, StridedSpan<double> result, int nthreads) {
+    assert(values.get_size() == result.get_size());
+    gather(result.get_size(), order, values, result, nthreads);
+}
+
+/// Single precision version of sla::gather_batch() for strided spans.
+void gather_batch(const int* order, StridedSpan<const float> values, StridedSpan<float> result, int nthreads) {
+    assert(values.get_size() == result.get_size());
+    gather(result.get_size(), order, values, result, nthreads);
+}
+
+/// Integer version of sla::gather_batch() for strided spans.
+void gather_batch(const int* order, StridedSpan<const int> values, StridedSpan<int> result, int nthreads) {
+    assert(values.get_size() == result.get_size());
+    gather(result.get_size(), order, values, result, nthreads);
+}
+
+/**
+ * Puts values computed in the order given by a permutation back in the original order: `result[order[i]] =
+ * values[i]`; this reverses sla::gather_batch().
+ *
+ * @param n Number of values.
+ * @param order Permutation of indices (e.g. computed by sla::hilbert_order()).
+ * @param values Values to put back in the original order.
+ * @param result Return value: values in the original order; must not overlap with `values`.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void scatter_batch(int n, const int* order, const double* values, double* result, int nthreads) {
+    scatter(n, order, values, result, nthreads);
+}
+
+/// Single precision version of sla::scatter_batch().
+void scatter_batch(int n, const int* order, const float* values, float* result, int nthreads) {
+    scatter(n, order, values, result, nthreads);
+}
+
+/// Integer version of sla::scatter_batch().
+void scatter_batch(int n, const int* order, const int* values, int* result, int nthreads) {
+    scatter(n, order, values, result, nthreads);
+}
+
+/// Version of sla::scatter_batch() that accesses values through strided spans of the same size (see sla::StridedSpan).
+void scatter_batch(const int* order, StridedSpan<const double> values, StridedSpan<double> result, int nthreads) {
+    assert(values.get_size() == result.get_size());
+    scatter(values.get_size(), order, values, result, nthreads);
+}
+
+/// Single precision version of sla::scatter_batch() for strided spans.
+void scatter_batch(const int* order, StridedSpan<const float> values, StridedSpan<float> result, int nthreads) {
+    assert(values.get_size() == result.get_size());
+    scatter(values.get_size(), order, values, result, nthreads);
+}
+
+/// Integer version of sla::scatter_batch() for strided spans.
+void scatter_batch(const int* order, StridedSpan<const int> values, StridedSpan<int> result, int nthreads) {
+    assert(values.get_size() == result.get_size());
+    scatter(values.get_size(), order, values, result, nthreads);
+}
+
+} // sla
@@ -19,7 +19,10 @@
 #define SLALIB_H_INCLUDED
 
 #include <cassert>
+#include <cstddef>
+#include <cstdint>
 #include <type_traits>
+#include <vector>
 
 namespace sla {
 
@@ -97,6 +100,58 @@ enum TPPStatus {
     TPP_ASTAR_TOO_FAR ///< error, antistar too far from axis
 };
 
+/// Status codes describing target visibility in sla::Visibility structure.
+enum VISStatus {
+    VIS_RISES_SETS = 0, ///< target crosses the altitude limit: rising and setting times are valid
+    VIS_ALWAYS_UP,      ///< target is always above the altitude limit (circumpolar)
+    VIS_NEVER_UP        ///< target never reaches the altitude limit
+};
+
+/// Forms of conventional orbital elements (see sla::OrbitalElements).
+enum OEForm {
+    OEF_MAJOR_PLANET = 1, ///< "major planet": epoch, inclination, node, longitude of perihelion, a, e, mean longitude
+    OEF_MINOR_PLANET,     ///< "minor planet": epoch, inclination, node, argument of perihelion, a, e, mean anomaly
+    OEF_COMET             ///< "comet": epoch of perihelion, inclination, node, argument of perihelion, q, e
+};
+
+/// Status codes for the orbital elements functions el2ue(), pertel(), pertue(), pv2el(), pv2ue(), ue2el(), and ue2pv().
+enum OEStatus {
+    OES_OK = 0,           ///< success
+    OES_BAD_FORM,         ///< illegal form of elements
+    OES_BAD_ECCENTRICITY, ///< illegal eccentricity
+    OES_BAD_DISTANCE,     ///< illegal mean or perihelion distance
+    OES_BAD_MOTION,       ///< illegal daily motion
+    OES_BAD_MASS,         ///< negative planet mass
+    OES_TOO_CLOSE,        ///< heliocentric distance too small
+    OES_TOO_SLOW,         ///< speed too small
+    OES_ZERO_MOMENTUM,    ///< zero angular momentum
+    OES_ZERO_RADIUS,      ///< radius vector zero while solving for universal eccentric anomaly
+    OES_NO_CONVERGENCE,   ///< universal eccentric anomaly failed to converge
+    OES_CLOSE_APPROACH    ///< warning: body passed very close to a major planet (pertel() and pertue() only)
+};
+
+/// Status codes of the sla::planet() and sla::planet_batch() functions.
+enum PLStatus {
+    PLS_OK = 0,        ///< success
+    PLS_DATE_WARNING,  ///< date outside the range of the algorithm (accuracy is degraded)
+    PLS_BAD_PLANET,    ///< illegal planet number
+    PLS_NO_CONVERGENCE ///< Kepler's equation failed to converge
+};
+
+/// Backends of the sla::EarthEphemeris class, in order of increasing accuracy and cost.
+enum EEBackend {
+    EE_EVP = 0, ///< sla::evp() function
+    EE_TABLE,   ///< interpolation in a table of sla::epv() results
+    EE_EPV      ///< sla::epv() function
+};
+
+/// Instruction set levels of function variants selected at run time (see sla::get_dispatched_kernels()).
+enum ISALevel {
+    ISA_SSE2 = 0, ///< baseline x86-64 (SSE2); also reported on other targets, and if run-time dispatch is disabled
+    ISA_AVX2,     ///< AVX2 (Haswell, Zen, and later)
+    ISA_AVX512    ///< AVX-512 F/DQ/VL/BW (Skylake-SP, Zen 4, and later)
+};
+
 /// Generic 3-component vector of floating-point elements.
 template<typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> = true>
 using Vector = T[3];
@@ -129,6 +184,46 @@ public:
     }
 };
 
+/**
+ * Non-owning view of `size` elements of type `T` that are `stride` bytes apart; it is accepted by batch functions, so
+ * that they could read their inputs from, and write their outputs to the fields of caller's own records (an "array of
+ * structures") without copying them into separate arrays first. Use `StridedSpan<const T>` for inputs.
+ *
+ * Every batch function and batch method that takes arrays of items has an overload taking spans instead (with the
+ * number of items given by the sizes of the spans); sla::UniversalElementsArray, already a "structure of arrays"
+ * container, is passed as is, and only the other arguments are spans.
+ *
+ * Example: `StridedSpan<const double>(stars, nstars, &Star::ra)` is a view of the `ra` fields of `nstars` records of
+ * type `Star` starting at `stars`.
+ */
+template <typename T>
+class StridedSpan {
+    using byte_type = std::conditional_t<std::is_const<T>::value, const char, char>;
+
+    T* ss_data;               ///< first element
+    int ss_size;              ///< number of elements
+    std::ptrdiff_t ss_stride; ///< distance between consecutive elements, in bytes
+
+public:
+    StridedSpan(T* data, int size, std::ptrdiff_t stride = sizeof(T)):
+        ss_data(data), ss_size(size), ss_stride(stride) {}
+    template <typename R>
+    StridedSpan(R* records, int size, std::remove_const_t<T> std::remove_cv_t<R>::* field):
+        ss_data(&(records->*field)), ss_size(size), ss_stride(sizeof(R)) {}
+    template <typename U, std::enable_if_t<std::is_same<const U, T>::value, bool> = true>
+    StridedSpan(const StridedSpan<U>& span):
+        ss_data(span.get_data()), ss_size(span.get_size()), ss_stride(span.get_stride()) {}
+
+    [[nodiscard]] T* get_data() const { return ss_data; }
+    [[nodiscard]] int get_size() const { return ss_size; }
+    [[nodiscard]] std::ptrdiff_t get_stride() const { return ss_stride; }
+    [[nodiscard]] bool is_contiguous() const { return ss_stride == (std::ptrdiff_t) sizeof(T); }
+    [[nodiscard]] T& operator[](int i) const {
+        assert(i >= 0 && i < ss_size);
+        return *reinterpret_cast<T*>(reinterpret_cast<byte_type*>(ss_data) + i * ss_stride);
+    }
+};
+
 /**
  * Representation of partial spherical coordinates (direction-only): longitude/latitude, or right ascension/
  * declination, or hour angle/declination.
@@ -289,6 +384,312 @@ public:
     [[nodiscard]] double get_pa_acceleration() const { return am_pa_accel; }
 };
 
+/**
+ * Generator of AltAz mount parameters for a star tracked at constant declination, sampled at equally spaced hour
+ * angles; produces the same results as the sla::altaz() function, but computes sines and cosines of declination and
+ * latitude once, and advances hour angle using rotation recurrences. Implemented in `altaztr.cc`.
+ */
+class AltazTracker {
+    double at_ha;       ///< hour angle of the next sample (radians)
+    double at_step;     ///< hour angle increment between samples (radians)
+    double at_sin_step; ///< sine of the hour angle increment
+    double at_cos_step; ///< cosine of the hour angle increment
+    double at_sin_dec;  ///< sine of the declination
+    double at_cos_dec;  ///< cosine of the declination
+    double at_sin_phi;  ///< sine of the observatory latitude
+    double at_cos_phi;  ///< cosine of the observatory latitude
+
+public:
+    AltazTracker(const Spherical<double>& dir, double phi, double step);
+
+    void set_ha(double radians) { at_ha = radians; }
+    [[nodiscard]] double get_ha() const { return at_ha; }
+    [[nodiscard]] double get_step() const { return at_step; }
+
+    void track(int n, AltazMount* am);
+    void track(StridedSpan<AltazMount> am);
+};
+
+/**
+ * Observing site bound conversions between equatorial (HA,Dec) and horizon (Az,El) coordinates, and zenith distance
+ * and parallactic angle calculations over arrays of targets; sine and cosine of the site latitude are computed once,
+ * when the frame is created. Arrays are in "structure of arrays" layout (separate arrays for HA and Dec, or Az and
+ * El), and results match those of sla::e2h()/sla::de2h(), sla::h2e()/sla::dh2e(), sla::zd(), and sla::pa(). The
+ * class is instantiated for `float` and `double` types; implemented in `hframe.cc`.
+ */
+template <typename T, std::enable_if_t<std::is_floating_point<T>::value, bool> = true>
+class HorizonFrame {
+    T hf_sin_phi; ///< sine of the observatory latitude
+    T hf_cos_phi; ///< cosine of the observatory latitude
+
+public:
+    explicit HorizonFrame(T phi);
+
+    [[nodiscard]] T get_sin_phi() const { return hf_sin_phi; }
+    [[nodiscard]] T get_cos_phi() const { return hf_cos_phi; }
+
+    void e2h(int n, const T* ha, const T* dec, T* azimuth, T* elevation) const;
+    void h2e(int n, const T* azimuth, const T* elevation, T* ha, T* dec) const;
+    void zd(int n, const T* ha, const T* dec, T* zd) const;
+    void pa(int n, const T* ha, const T* dec, T* pa) const;
+    void e2h(StridedSpan<const T> ha, StridedSpan<const T> dec, StridedSpan<T> azimuth, StridedSpan<T> elevation) const;
+    void h2e(StridedSpan<const T> azimuth, StridedSpan<const T> elevation, StridedSpan<T> ha, StridedSpan<T> dec) const;
+    void zd(StridedSpan<const T> ha, StridedSpan<const T> dec, StridedSpan<T> zd) const;
+    void pa(StridedSpan<const T> ha, StridedSpan<const T> dec, StridedSpan<T> pa) const;
+};
+
+/// Radial velocity corrections for one spectrum, calculated by the sla::rvcor_batch() function.
+struct RVCorrections {
+    float rv_erot; ///< component of Earth rotation, as returned by sla::rverot() (km/s)
+    float rv_eorb; ///< component of Earth orbital velocity, as returned by sla::ecor() (km/s)
+    float rv_lt;   ///< component of heliocentric light time, as returned by sla::ecor() (sec)
+    float rv_lsrk; ///< component of "standard" solar motion, as returned by sla::rvlsrk() (km/s)
+    float rv_lsrd; ///< component of "peculiar" solar motion, as returned by sla::rvlsrd() (km/s)
+    float rv_galc; ///< component of dynamical LSR motion, as returned by sla::rvgalc() (km/s)
+    float rv_lg;   ///< component of solar motion relative to the local group, as returned by sla::rvlg() (km/s)
+};
+
+/**
+ * Star-independent parameters of apparent-to-observed and observed-to-apparent place transformations, as computed by
+ * sla::aoppa() and used by sla::aopqk() and sla::oapqk(); the sidereal time can be updated with sla::aoppat().
+ */
+struct AOParams {
+    double ao_phi;     ///< geodetic latitude (radians)
+    double ao_sin_phi; ///< sine of geodetic latitude
+    double ao_cos_phi; ///< cosine of geodetic latitude
+    double ao_diurab;  ///< magnitude of diurnal aberration vector
+    double ao_height;  ///< height above sea level (meters)
+    double ao_tdk;     ///< ambient temperature (K)
+    double ao_pmb;     ///< pressure (mB)
+    double ao_rh;      ///< relative humidity (0-1)
+    double ao_wl;      ///< wavelength (micrometers)
+    double ao_tlr;     ///< lapse rate (K per meter)
+    double ao_refa;    ///< tan Z refraction coefficient (radians)
+    double ao_refb;    ///< tan**3 Z refraction coefficient (radians)
+    double ao_elong;   ///< longitude + equation of the equinoxes + sidereal equivalent of UT1-UTC (radians)
+    double ao_lst;     ///< local apparent sidereal time (radians)
+};
+
+/**
+ * Conventional heliocentric J2000 ecliptic orbital elements of a body; which members are meaningful depends on the
+ * form of the elements (see sla::OEForm). Dates are TT MJDs.
+ */
+struct OrbitalElements {
+    OEForm oe_form;   ///< form of the elements
+    double oe_epoch;  ///< epoch of elements, or epoch of perihelion for OEF_COMET
+    double oe_orbinc; ///< inclination (radians)
+    double oe_anode;  ///< longitude of the ascending node (radians)
+    double oe_perih;  ///< longitude (OEF_MAJOR_PLANET) or argument (otherwise) of perihelion (radians)
+    double oe_aorq;   ///< mean distance, or perihelion distance for OEF_COMET (AU)
+    double oe_e;      ///< eccentricity
+    double oe_aorl;   ///< mean longitude (OEF_MAJOR_PLANET) or mean anomaly (OEF_MINOR_PLANET) (radians)
+    double oe_dm;     ///< daily motion (OEF_MAJOR_PLANET only, radians)
+};
+
+/**
+ * Universal orbital elements: heliocentric J2000 equatorial position and velocity of a body at a reference epoch, plus
+ * quantities that allow fast prediction of the body's state at nearby dates. Dates are TT MJDs.
+ */
+struct UniversalElements {
+    double         ue_mass;   ///< combined mass (M+m)
+    double         ue_alpha;  ///< total energy of the orbit (alpha)
+    double         ue_t0;     ///< reference (osculating) epoch
+    Vector<double> ue_p0;     ///< position at reference epoch (AU)
+    Vector<double> ue_v0;     ///< velocity at reference epoch (AU per canonical day)
+    double         ue_r0;     ///< heliocentric distance at reference epoch (AU)
+    double         ue_sigma0; ///< `ue_p0` dot `ue_v0`
+    double         ue_t;      ///< date of the most recent prediction
+    double         ue_psi;    ///< universal eccentric anomaly at `ue_t`
+};
+
+/**
+ * Universal orbital elements of many bodies, stored as a structure of arrays so that sla::ue2pv_batch() can process
+ * several bodies in lockstep; implemented in `ue2pv.cc`.
+ */
+class UniversalElementsArray {
+    std::vector<double> uea_mass;   ///< combined masses (M+m)
+    std::vector<double> uea_alpha;  ///< total energies of the orbits (alpha)
+    std::vector<double> uea_t0;     ///< reference (osculating) epochs
+    std::vector<double> uea_p0[3];  ///< positions at reference epochs (AU), by coordinate
+    std::vector<double> uea_v0[3];  ///< velocities at reference epochs (AU per canonical day), by coordinate
+    std::vector<double> uea_r0;     ///< heliocentric distances at reference epochs (AU)
+    std::vector<double> uea_sigma0; ///< position dot velocity at reference epochs
+    std::vector<double> uea_t;      ///< dates of the most recent predictions
+    std::vector<double> uea_psi;    ///< universal eccentric anomalies at dates of the most recent predictions
+
+    friend void ue2pv_batch(double date, UniversalElementsArray& elements, VectorPV<double>* pv, OEStatus* status,
+        int nthreads);
+    friend void ue2pv_batch(double date, UniversalElementsArray& elements, StridedSpan<VectorPV<double>> pv,
+        StridedSpan<OEStatus> status, int nthreads);
+
+public:
+    UniversalElementsArray() = default;
+    explicit UniversalElementsArray(int n) { resize(n); }
+
+    [[nodiscard]] int size() const { return (int) uea_mass.size(); }
+    void resize(int n);
+    void set(int i, const UniversalElements& u);
+    void get(int i, UniversalElements& u) const;
+};
+
+/// Rise, set, and transit times of a target, as calculated by sla::VisibilitySolver (all times are UT1 MJDs).
+struct Visibility {
+    double    v_transit;   ///< upper transit nearest to the middle of the time interval
+    double    v_rise;      ///< rising above the elevation limit, preceding `v_transit`
+    double    v_set;       ///< setting below the elevation limit, following `v_transit`
+    VISStatus v_status;    ///< elevation limit crossing status; if not VIS_RISES_SETS, `v_rise`=`v_set`=`v_transit`
+    double    v_am_rise;   ///< air mass dropping below the limit, preceding `v_transit`
+    double    v_am_set;    ///< air mass exceeding the limit, following `v_transit`
+    VISStatus v_am_status; ///< air mass limit crossing status; same rules as for `v_status`
+    bool      v_visible;   ///< `true` if target satisfies both limits at some point within the time interval
+    double    v_start;     ///< start of the longest window within the interval where both limits are satisfied
+    double    v_end;       ///< end of that window
+};
+
+/**
+ * Solver calculating rise, set, and transit times and observable windows of fixed targets for an observing site,
+ * using analytical hour angle solutions polished against sla::gmst(); implemented in `visib.cc`.
+ */
+class VisibilitySolver {
+    double vs_elong;     ///< east longitude of the site (radians)
+    double vs_sin_phi;   ///< sine of the site latitude
+    double vs_cos_phi;   ///< cosine of the site latitude
+    double vs_min_el;    ///< minimum observed elevation (radians)
+    double vs_max_am;    ///< maximum air mass
+    double vs_refa;      ///< tan Z refraction coefficient (radians)
+    double vs_refb;      ///< tan**3 Z refraction coefficient (radians)
+    double vs_sin_el;    ///< sine of the in vacuo altitude corresponding to `vs_min_el`
+    double vs_sin_am;    ///< sine of the in vacuo altitude corresponding to `vs_max_am`
+
+    void setup();
+    [[nodiscard]] double polish(double date, double ra, double ha) const;
+    [[nodiscard]] VISStatus half_arc(double sin_dec, double cos_dec, double sin_alt, double& ha) const;
+
+public:
+    VisibilitySolver(double elong, double phi, double min_elevation, double max_airmass);
+
+    void set_refraction(double refa, double refb);
+
+    void solve(double start, double end, const Spherical<double>& dir, Visibility& vis) const;
+    void solve(double start, double end, int n, const Spherical<double>* dirs, Visibility* vis, int nthreads = 0) const;
+};
+
+/**
+ * Evaluator of observing constraints (target elevation, air mass, and distance from the Moon, plus Sun elevation) for
+ * many targets on a time grid spanning many nights; implemented in `sched.cc`.
+ *
+ * Results are stored as bits, one per target, in rows of `get_row_size()` 64-bit words; there is one row per time
+ * step, and rows of each night follow those of the preceding night. Bit `i % 64` of word `i / 64` of a row is set if
+ * target `i` satisfies all constraints at that step.
+ */
+class ScheduleEvaluator {
+    double se_elong;      ///< east longitude of the site (radians)
+    double se_phi;        ///< latitude of the site (radians, geodetic)
+    double se_height;     ///< height of the site above sea level (meters)
+    double se_sin_el;     ///< sine of the minimum target altitude (taking air mass limit into account)
+    double se_cos_sep;    ///< cosine of the minimum distance from the Moon
+    double se_sin_sun;    ///< sine of the maximum Sun altitude
+
+public:
+    ScheduleEvaluator(double elong, double phi, double height, double min_elevation, double max_airmass,
+        double min_moon_dist, double max_sun_elevation);
+
+    [[nodiscard]] static int get_row_size(int ntargets) { return (ntargets + 63) / 64; }
+    [[nodiscard]] static bool is_set(const std::uint64_t* row, int target) {
+        return (row[target / 64] >> (target % 64)) & 1;
+    }
+
+    void evaluate(int nnights, const double* starts, int nsteps, double interval,
+        int ntargets, const Spherical<double>* dirs, std::uint64_t* bits, int nthreads = 0) const;
+};
+
+/**
+ * Fast source of the sla::dmoon() ephemeris for many nearby dates: fits Chebyshev polynomials to sla::dmoon() over
+ * fixed-length time segments on demand, keeps the most recently used segments in a cache, and interpolates position
+ * and velocity; implemented in `moonephm.cc`. Objects of this class are not thread-safe.
+ */
+class MoonEphemeris {
+    double                     me_span;     ///< length of a segment (days)
+    int                        me_degree;   ///< degree of Chebyshev polynomials
+    int                        me_last;     ///< cache slot of the most recently used segment
+    std::uint64_t              me_clock;    ///< use counter for LRU replacement
+    std::vector<std::int64_t>  me_keys;     ///< segment number (date divided by span) in each cache slot
+    std::vector<std::uint64_t> me_stamps;   ///< last use of each cache slot; zero if slot is empty
+    std::vector<double>        me_pos_est;  ///< position error estimate of each cache slot (AU); NaN if empty
+    std::vector<double>        me_vel_est;  ///< velocity error estimate of each cache slot (AU/s); NaN if empty
+    std::vector<double>        me_coeffs;   ///< 6 * (`me_degree` + 1) Chebyshev coefficients per cache slot
+
+    int fit(std::int64_t key);
+
+public:
+    explicit MoonEphemeris(double span = 1.0, int degree = 12, int capacity = 16);
+
+    double get(double date, VectorPV<double>& pv);
+    [[nodiscard]] double get_velocity_error_estimate() const { return me_vel_est[me_last]; }
+};
+
+/**
+ * Earth ephemeris of selectable accuracy: for each date, picks the cheapest of sla::evp(), interpolation in a table of
+ * sla::epv() results, and sla::epv() that meets the required accuracy; implemented in `earthephm.cc`. Once the table
+ * is built, objects of this class can be used by several threads concurrently.
+ */
+class EarthEphemeris {
+    double              ee_pos_accuracy; ///< required position accuracy (km)
+    double              ee_vel_accuracy; ///< required velocity accuracy (mm/s)
+    double              ee_start;        ///< date of the first table node (TDB MJD)
+    double              ee_step;         ///< interval between table nodes (days)
+    int                 ee_nodes;        ///< number of table nodes; zero if there is no table
+    double              ee_pos_err;      ///< verified interpolation error bound of the table, position (km)
+    double              ee_vel_err;      ///< verified interpolation error bound of the table, velocity (mm/s)
+    std::vector<double> ee_table;        ///< 12 values per node: sla::epv() hpos, hvelo, bpos, bvelo (AU, AU/day)
+
+    void interpolate(double date, VectorPV<double>& hpv, VectorPV<double>& bpv) const;
+
+public:
+    EarthEphemeris(double pos_accuracy, double vel_accuracy);
+
+    bool tabulate(double start, double end, double step = 0.5, int nthreads = 0);
+    [[nodiscard]] EEBackend get_backend(double date) const;
+    [[nodiscard]] double get_position_error(EEBackend backend) const;
+    [[nodiscard]] double get_velocity_error(EEBackend backend) const;
+    EEBackend get(double date, VectorPV<double>& hpv, VectorPV<double>& bpv) const;
+    void get(int n, const double* dates, VectorPV<double>* hpv, VectorPV<double>* bpv, EEBackend* backends) const;
+    void get(StridedSpan<const double> dates, StridedSpan<VectorPV<double>> hpv, StridedSpan<VectorPV<double>> bpv,
+        StridedSpan<EEBackend> backends) const;
+};
+
+/**
+ * Observer state at one instant (heliocentric position and velocity of the observer, and precession-nutation matrix),
+ * shared by computations of topocentric apparent places of many solar-system bodies; implemented in `plantu.cc` and
+ * `plante.cc`.
+ */
+class TopocentricContext {
+    double         tc_date; ///< date of observation (TT MJD)
+    Matrix<double> tc_rmat; ///< precession-nutation matrix, J2000 to true equator and equinox of date
+    Vector<double> tc_pos;  ///< heliocentric position of the observer (AU, true equator and equinox of date)
+    Vector<double> tc_vel;  ///< heliocentric velocity of the observer (AU/s, true equator and equinox of date)
+
+    void apparent(const VectorPV<double>& pv, double& ra, double& dec, double& r) const;
+    void apparent(int n, const VectorPV<double>* pv, const OEStatus* status, double* ra, double* dec, double* r,
+        int nthreads) const;
+
+public:
+    TopocentricContext(double date, double elong, double phi);
+
+    [[nodiscard]] double get_date() const { return tc_date; }
+
+    OEStatus plante(const OrbitalElements& elements, double& ra, double& dec, double& r) const;
+    void plante(int n, const OrbitalElements* elements, double* ra, double* dec, double* r, OEStatus* status,
+        int nthreads = 0) const;
+    void plante(StridedSpan<const OrbitalElements> elements, StridedSpan<double> ra, StridedSpan<double> dec,
+        StridedSpan<double> r, StridedSpan<OEStatus> status, int nthreads = 0) const;
+    OEStatus plantu(UniversalElements& u, double& ra, double& dec, double& r) const;
+    void plantu(UniversalElementsArray& elements, double* ra, double* dec, double* r, OEStatus* status,
+        int nthreads = 0) const;
+    void plantu(UniversalElementsArray& elements, StridedSpan<double> ra, StridedSpan<double> dec,
+        StridedSpan<double> r, StridedSpan<OEStatus> status, int nthreads = 0) const;
+};
+
 /**
  * Representation os various conversion results: days to hours, minutes, seconds; or radians to degrees, arcminutes,
  * arcseconds; etc. The same data structure has to be passed between routines interpreting it quite differently,
@@ -353,35 +754,109 @@ public:
 // auxiliary functions (used internally by API functions)
 int process_year_defaults(int year);
 G2JStatus validate_gregorian_day(int year, int month, int day);
+void altaz_trig(double ha, double sin_ha, double cos_ha, double sin_dec, double cos_dec,
+    double sin_phi, double cos_phi, AltazMount& am);
+
+/// Range of cell ids [first..last] of a sky index (see sla::SkyIndex).
+struct SkyCellRange {
+    std::uint64_t scr_first; ///< first cell of the range
+    std::uint64_t scr_last;  ///< last cell of the range
+    bool          scr_full;  ///< `true` if the cells lie entirely within the queried region
+};
+
+/// Pair of matching points found by sla::cross_match().
+struct CrossMatch {
+    int    cm_source;     ///< original index of the point in the source (e.g. detection) catalogue
+    int    cm_reference;  ///< original index of the point in the reference catalogue
+    double cm_separation; ///< angular separation of the points (radians)
+};
+
+/// Receiver of consecutive batches of matches found by sla::cross_match(); `context` is passed through unchanged.
+using CrossMatchSink = void (*)(int n, const CrossMatch* matches, void* context);
+
+/**
+ * Hierarchical Triangular Mesh (HTM) index of points on the celestial sphere, for cone and polygon searches; points
+ * are kept as unit vectors (see sla::dcs2c()), sorted by the ids of the cells they fall into; implemented in
+ * `skyindex.cc`. Once built or loaded, the index can be queried by several threads concurrently.
+ */
+class SkyIndex {
+    int                        si_depth;   ///< subdivision depth of the mesh; there are 8 * 4**depth cells
+    std::vector<std::uint64_t> si_cells;   ///< cell ids of the points, sorted
+    std::vector<int>           si_order;   ///< original indices of the points, in the order of `si_cells`
+    std::vector<double>        si_vectors; ///< unit vectors of the points (3 values each), in the same order
+
+    void index_points(int nthreads);
+    template <typename F>
+    void collect(const std::vector<SkyCellRange>& ranges, std::vector<int>& found, F accept) const;
+
+public:
+    /// Maximum subdivision depth; cell ids then take 53 bits.
+    static constexpr int MAX_DEPTH = 25;
+
+    explicit SkyIndex(int depth = 12);
+
+    static std::uint64_t get_cell(const Vector<double> vec, int depth);
+    [[nodiscard]] std::uint64_t get_cell(const Vector<double> vec) const { return get_cell(vec, si_depth); }
+    [[nodiscard]] int get_depth() const { return si_depth; }
+    [[nodiscard]] int get_size() const { return (int) si_order.size(); }
+
+    void build(int n, const Vector<double>* vecs, int nthreads = 0);
+    void build(int n, const double* ra, const double* dec, int nthreads = 0);
+    void query_cone(const Vector<double> center, double radius, std::vector<SkyCellRange>& ranges,
+        int level = -1) const;
+    bool query_polygon(int nv, const Vector<double>* vertices, std::vector<SkyCellRange>& ranges) const;
+    void search_cone(const Vector<double> center, double radius, std::vector<int>& found) const;
+    bool search_polygon(int nv, const Vector<double>* vertices, std::vector<int>& found) const;
+    bool save(const char* path) const;
+    bool load(const char* path);
+
+    friend std::int64_t cross_match(const SkyIndex& sources, const SkyIndex& reference, double radius,
+        int max_matches, CrossMatchSink sink, void* context, int nthreads);
+};
+
+/// Function with run-time dispatch, and instruction set of the variant it uses (see sla::get_dispatched_kernels()).
+struct KernelISA {
+    const char* ki_kernel; ///< name of the library function, e.g. "evp_batch"
+    ISALevel    ki_isa;    ///< instruction set of the variant that the function uses
+};
 
 // library API (documentation can be found in the implementation files)
 double airmas(double zenith_dist);
-float range(float angle);
-double drange(double angle);
-float ranorm(float angle);
-double dranrm(double angle);
+double airmas_zd(double airmass);
+void range_batch(int n, const float* angles, float* result);
+void range_batch(StridedSpan<const float> angles, StridedSpan<float> result);
+void drange_batch(int n, const double* angles, double* result);
+void drange_batch(StridedSpan<const double> angles, StridedSpan<double> result);
+void ranorm_batch(int n, const float* angles, float* result);
+void ranorm_batch(StridedSpan<const float> angles, StridedSpan<float> result);
+void dranrm_batch(int n, const double* angles, double* result);
+void dranrm_batch(StridedSpan<const double> angles, StridedSpan<double> result);
 void av2m(const Vector<float> vec, Matrix<float> mat);
 void dav2m(const Vector<double> vec, Matrix<double> mat);
 void cc2s(const Vector<float> cartesian, Spherical<float>& spherical);
 void dcc2s(const Vector<double> cartesian, Spherical<double>& spherical);
 void cs2c(const Spherical<float>& spherical, Vector<float> cartesian);
 void dcs2c(const Spherical<double>& spherical, Vector<double> cartesian);
+void cc2s_batch(int n, const Vector<float>* cartesian, float* a, float* b);
+void cc2s_batch(StridedSpan<const Vector<float>> cartesian, StridedSpan<float> a, StridedSpan<float> b);
+void dcc2s_batch(int n, const Vector<double>* cartesian, double* a, double* b);
+void dcc2s_batch(StridedSpan<const Vector<double>> cartesian, StridedSpan<double> a, StridedSpan<double> b);
+void cs2c_batch(int n, const float* a, const float* b, Vector<float>* cartesian);
+void cs2c_batch(StridedSpan<const float> a, StridedSpan<const float> b, StridedSpan<Vector<float>> cartesian);
+void dcs2c_batch(int n, const double* a, const double* b, Vector<double>* cartesian);
+void dcs2c_batch(StridedSpan<const double> a, StridedSpan<const double> b, StridedSpan<Vector<double>> cartesian);
 void euler(const char* order, float phi, float theta, float psi, Matrix<float> mat);
 void deuler(const char* order, double phi, double theta, double psi, Matrix<double> mat);
-void imxv(const Matrix<float> mat, const Vector<float> va, Vector<float> vb);
-void dimxv(const Matrix<double> mat, const Vector<double> va, Vector<double> vb);
+void imxv_batch(const Matrix<float> mat, int n, const Vector<float>* va, Vector<float>* vb);
+void imxv_batch(const Matrix<float> mat, StridedSpan<const Vector<float>> va, StridedSpan<Vector<float>> vb);
+void dimxv_batch(const Matrix<double> mat, int n, const Vector<double>* va, Vector<double>* vb);
+void dimxv_batch(const Matrix<double> mat, StridedSpan<const Vector<double>> va, StridedSpan<Vector<double>> vb);
 void m2av(const Matrix<float> mat, Vector<float> axis);
 void dm2av(const Matrix<double> mat, Vector<double> axis);
-void mxm(const Matrix<float> ma, const Matrix<float> mb, Matrix<float> mc);
-void dmxm(const Matrix<double> ma, const Matrix<double> mb, Matrix<double> mc);
-void mxv(const Matrix<float> mat, const Vector<float> va, Vector<float> vb);
-void dmxv(const Matrix<double> mat, const Vector<double> va, Vector<double> vb);
-float vdv(const Vector<float> va, const Vector<float> vb);
-double dvdv(const Vector<double> va, const Vector<double> vb);
-float vn(const Vector<float> vec, Vector<float> nvec);
-double dvn(const Vector<double> vec, Vector<double> nvec);
-void vxv(const Vector<float> va, const Vector<float> vb, Vector<float> vc);
-void dvxv(const Vector<double> va, const Vector<double> vb, Vector<double> vc);
+void mxv_batch(const Matrix<float> mat, int n, const Vector<float>* va, Vector<float>* vb);
+void mxv_batch(const Matrix<float> mat, StridedSpan<const Vector<float>> va, StridedSpan<Vector<float>> vb);
+void dmxv_batch(const Matrix<double> mat, int n, const Vector<double>* va, Vector<double>* vb);
+void dmxv_batch(const Matrix<double> mat, StridedSpan<const Vector<double>> va, StridedSpan<Vector<double>> vb);
 double zd(const Spherical<double>& dir, double phi);
 double pa(const Spherical<double>& dir, double phi);
 float bear(const Spherical<float>& da, const Spherical<float>& db);
@@ -419,8 +894,12 @@ double gmsta(double date, double fdate);
 void atmdsp(double atk, double apm, double arh, double wl1, double a1, double b1, double wl2, double& a2, double& b2);
 void refcoq(double atk, double apm, double arh, double wl, double& refa, double& refb);
 double refro(double ozd, double oh, double atk, double apm, double arh, double wl, double phi, double tlr, double eps);
+double refro_rt(double ozd, double oh, double atk, double apm, double arh, double wl, double phi, double tlr,
+    int strips = 64);
 void refco(double oh, double atk, double apm, double arh, double wl, double phi, double tlr, double eps,
     double& refa, double& refb);
+void refco_rt(double oh, double atk, double apm, double arh, double wl, double phi, double tlr,
+    double& refa, double& refb, int strips = 64);
 void refv(const Vector<double> vec, double refa, double refb, Vector<double> rvec);
 double refz(double zu, double refa, double refb);
 void ecmat(double date, Matrix<double> mat);
@@ -448,22 +927,132 @@ void prenut(double je, double mjd, Matrix<double> mat);
 double dsepv(const Vector<double> va, const Vector<double> vb);
 float sepv(const Vector<float> va, const Vector<float> vb);
 double dsep(const Spherical<double>& sa, const Spherical<double>& sb);
+void dsep_batch(int n, const double* ra, const double* dec, const Spherical<double>& sb, double* sep);
+void dsep_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, const Spherical<double>& sb,
+    StridedSpan<double> sep);
 float sep(const Spherical<float>& sa, const Spherical<float>& sb);
 void prebn(double be0, double be1, Matrix<double> mat);
 void preces(Catalogue system, double ep0, double ep1, Spherical<double>& pos);
+void preces_batch(Catalogue system, double ep0, double ep1, int n, const double* ra, const double* dec, double* pra,
+    double* pdec);
 void supgal(const Spherical<double>& sgal, Spherical<double>& gal);
 float rverot(float phi, const Spherical<float>& pos, float stime);
 float rvgalc(const Spherical<float>& pos);
 float rvlg(const Spherical<float>& pos);
 float rvlsrd(const Spherical<float>& pos);
 float rvlsrk(const Spherical<float>& pos);
+void rvcor_batch(float phi, int n, const Spherical<float>* dirs, const Spherical<float>* dirs2000,
+    const int* years, const int* days, const float* fractions, const float* stimes, RVCorrections* corr);
+void rvcor_batch(float phi, StridedSpan<const Spherical<float>> dirs, StridedSpan<const Spherical<float>> dirs2000,
+    StridedSpan<const int> years, StridedSpan<const int> days, StridedSpan<const float> fractions,
+    StridedSpan<const float> stimes, StridedSpan<RVCorrections> corr);
 void cc62s(const VectorPV<float>& cartesian, SphericalPV<float>& spherical);
 void dc62s(const VectorPV<double>& cartesian, SphericalPV<double>& spherical);
 void cs2c6(const SphericalPV<float>& spv, VectorPV<float>& pv);
 void ds2c6(const SphericalPV<double>& spv, VectorPV<double>& pv);
 void etrms(double be, Vector<double> et);
 void addet(const Spherical<double>& dir, double be, Spherical<double>& edir);
+void addet_batch(int n, const double* ra, const double* dec, double be, double* era, double* edec);
+void addet_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, double be, StridedSpan<double> era,
+    StridedSpan<double> edec);
 void subet(const Spherical<double>& edir, double be, Spherical<double>& dir);
+void subet_batch(int n, const double* era, const double* edec, double be, double* ra, double* dec);
+void subet_batch(StridedSpan<const double> era, StridedSpan<const double> edec, double be, StridedSpan<double> ra,
+    StridedSpan<double> dec);
+void subetv_batch(int n, const Vector<double>* evecs, double be, Vector<double>* vecs);
+void subetv_batch(StridedSpan<const Vector<double>> evecs, double be, StridedSpan<Vector<double>> vecs);
+void fk425(const Spherical<double>& dir1950, const Spherical<double>& pm1950, double px1950, double rv1950,
+    Spherical<double>& dir2000, Spherical<double>& pm2000, double& px2000, double& rv2000);
+void fk425_batch(int n, const double* r1950, const double* d1950, const double* dr1950, const double* dd1950,
+    const double* p1950, const double* v1950, double* r2000, double* d2000, double* dr2000, double* dd2000,
+    double* p2000, double* v2000);
+void fk425_batch(StridedSpan<const double> r1950, StridedSpan<const double> d1950, StridedSpan<const double> dr1950,
+    StridedSpan<const double> dd1950, StridedSpan<const double> p1950, StridedSpan<const double> v1950,
+    StridedSpan<double> r2000, StridedSpan<double> d2000, StridedSpan<double> dr2000, StridedSpan<double> dd2000,
+    StridedSpan<double> p2000, StridedSpan<double> v2000);
+void fk45z(const Spherical<double>& dir1950, double bepoch, Spherical<double>& dir2000);
+void fk45z_batch(int n, const double* r1950, const double* d1950, double bepoch, double* r2000, double* d2000);
+void fk45z_batch(StridedSpan<const double> r1950, StridedSpan<const double> d1950, double bepoch,
+    StridedSpan<double> r2000, StridedSpan<double> d2000);
+void fk524(const Spherical<double>& dir2000, const Spherical<double>& pm2000, double px2000, double rv2000,
+    Spherical<double>& dir1950, Spherical<double>& pm1950, double& px1950, double& rv1950);
+void fk524_batch(int n, const double* r2000, const double* d2000, const double* dr2000, const double* dd2000,
+    const double* p2000, const double* v2000, double* r1950, double* d1950, double* dr1950, double* dd1950,
+    double* p1950, double* v1950);
+void fk524_batch(StridedSpan<const double> r2000, StridedSpan<const double> d2000, StridedSpan<const double> dr2000,
+    StridedSpan<const double> dd2000, StridedSpan<const double> p2000, StridedSpan<const double> v2000,
+    StridedSpan<double> r1950, StridedSpan<double> d1950, StridedSpan<double> dr1950, StridedSpan<double> dd1950,
+    StridedSpan<double> p1950, StridedSpan<double> v1950);
+void fk54z(const Spherical<double>& dir2000, double bepoch, Spherical<double>& dir1950, Spherical<double>& pm1950);
+void fk54z_batch(int n, const double* r2000, const double* d2000, double bepoch,
+    double* r1950, double* d1950, double* dr1950, double* dd1950);
+void fk54z_batch(StridedSpan<const double> r2000, StridedSpan<const double> d2000, double bepoch,
+    StridedSpan<double> r1950, StridedSpan<double> d1950, StridedSpan<double> dr1950, StridedSpan<double> dd1950);
+void fk52h(const Spherical<double>& dir5, const Spherical<double>& pm5, Spherical<double>& dirh,
+    Spherical<double>& pmh);
+void fk52h_batch(int n, const double* r5, const double* d5, const double* dr5, const double* dd5,
+    double* rh, double* dh, double* drh, double* ddh);
+void fk52h_batch(StridedSpan<const double> r5, StridedSpan<const double> d5, StridedSpan<const double> dr5,
+    StridedSpan<const double> dd5, StridedSpan<double> rh, StridedSpan<double> dh, StridedSpan<double> drh,
+    StridedSpan<double> ddh);
+void h2fk5(const Spherical<double>& dirh, const Spherical<double>& pmh, Spherical<double>& dir5,
+    Spherical<double>& pm5);
+void h2fk5_batch(int n, const double* rh, const double* dh, const double* drh, const double* ddh,
+    double* r5, double* d5, double* dr5, double* dd5);
+void h2fk5_batch(StridedSpan<const double> rh, StridedSpan<const double> dh, StridedSpan<const double> drh,
+    StridedSpan<const double> ddh, StridedSpan<double> r5, StridedSpan<double> d5, StridedSpan<double> dr5,
+    StridedSpan<double> dd5);
+void fk5hz(const Spherical<double>& dir5, double epoch, Spherical<double>& dirh);
+void fk5hz_batch(int n, const double* r5, const double* d5, double epoch, double* rh, double* dh);
+void fk5hz_batch(StridedSpan<const double> r5, StridedSpan<const double> d5, double epoch, StridedSpan<double> rh,
+    StridedSpan<double> dh);
+void hfk5z(const Spherical<double>& dirh, double epoch, Spherical<double>& dir5, Spherical<double>& pm5);
+void hfk5z_batch(int n, const double* rh, const double* dh, double epoch,
+    double* r5, double* d5, double* dr5, double* dd5);
+void hfk5z_batch(StridedSpan<const double> rh, StridedSpan<const double> dh, double epoch, StridedSpan<double> r5,
+    StridedSpan<double> d5, StridedSpan<double> dr5, StridedSpan<double> dd5);
+OEStatus el2ue(double date, const OrbitalElements& elements, UniversalElements& u);
+OEStatus pv2el(const VectorPV<double>& pv, double date, double pmass, OEForm jformr, OrbitalElements& elements);
+OEStatus pv2ue(const VectorPV<double>& pv, double date, double pmass, UniversalElements& u);
+OEStatus ue2el(const UniversalElements& u, OEForm jformr, OrbitalElements& elements);
+OEStatus ue2pv(double date, UniversalElements& u, VectorPV<double>& pv);
+void ue2pv_batch(double date, UniversalElementsArray& elements, VectorPV<double>* pv, OEStatus* status,
+    int nthreads = 0);
+void ue2pv_batch(double date, UniversalElementsArray& elements, StridedSpan<VectorPV<double>> pv,
+    StridedSpan<OEStatus> status, int nthreads = 0);
+OEStatus pertel(double date0, double date1, const OrbitalElements& el0, OrbitalElements& el1);
+OEStatus pertue(double date, UniversalElements& u, double step_factor = 1.0);
+void pertue_batch(double date, UniversalElementsArray& elements, OEStatus* status, int nthreads = 0,
+    double step_factor = 1.0);
+void pertue_batch(double date, UniversalElementsArray& elements, StridedSpan<OEStatus> status, int nthreads = 0,
+    double step_factor = 1.0);
+OEStatus planel(double date, const OrbitalElements& elements, VectorPV<double>& pv);
+void planel_batch(double date, int n, const OrbitalElements* elements, VectorPV<double>* pv, OEStatus* status,
+    int nthreads = 0);
+void planel_batch(double date, StridedSpan<const OrbitalElements> elements, StridedSpan<VectorPV<double>> pv,
+    StridedSpan<OEStatus> status, int nthreads = 0);
+OEStatus plante(double date, double elong, double phi, const OrbitalElements& elements,
+    double& ra, double& dec, double& r);
+OEStatus plantu(double date, double elong, double phi, UniversalElements& u, double& ra, double& dec, double& r);
+PLStatus planet(double date, int np, VectorPV<double>& pv);
+void planet_batch(int n, const double* dates, VectorPV<double>* pv, PLStatus* status, int nplanets = 9);
+void planet_batch(StridedSpan<const double> dates, StridedSpan<VectorPV<double>> pv, StridedSpan<PLStatus> status);
+void rdplan(double date, int np, double elong, double phi, double& ra, double& dec, double& diam);
+void aoppa(double date, double dut, double elongm, double phim, double hm, double xp, double yp,
+    double tdk, double pmb, double rh, double wl, double tlr, AOParams& params);
+void aoppat(double date, AOParams& params);
+void aopqk(double rap, double dap, const AOParams& params,
+    double& aob, double& zob, double& hob, double& dob, double& rob);
+void aop(double rap, double dap, double date, double dut, double elongm, double phim, double hm, double xp, double yp,
+    double tdk, double pmb, double rh, double wl, double tlr,
+    double& aob, double& zob, double& hob, double& dob, double& rob);
+void oapqk(char type, double ob1, double ob2, const AOParams& params, double& rap, double& dap);
+void oapqk_batch(char type, int n, const double* ob1, const double* ob2, const AOParams& params,
+    double* rap, double* dap);
+void oapqk_batch(char type, StridedSpan<const double> ob1, StridedSpan<const double> ob2, const AOParams& params,
+    StridedSpan<double> rap, StridedSpan<double> dap);
+void oap(char type, double ob1, double ob2, double date, double dut, double elongm, double phim, double hm,
+    double xp, double yp, double tdk, double pmb, double rh, double wl, double tlr, double& rap, double& dap);
 void geoc(double latitude, double height, double& axis_dist, double& equator_dist);
 void pvobs(double latitude, double height, double lst, VectorPV<double>& pv);
 void pcd(double disco, double& x, double& y);
@@ -481,6 +1070,9 @@ void dcmpf(const FitCoeffs& model, double& xz, double& yz, double& xs, double& y
 void pm(const Spherical<double>& dir_ep0, const Spherical<double>& motion, double parallax, double r_velocity,
     double ep0, double ep1, Spherical<double>& dir_ep1);
 void earth(int year, int day, float fraction, VectorPV<float>& pv);
+void earth_batch(int n, const int* years, const int* days, const float* fractions, VectorPV<float>* pv);
+void earth_batch(StridedSpan<const int> years, StridedSpan<const int> days, StridedSpan<const float> fractions,
+    StridedSpan<VectorPV<float>> pv);
 void ecor(Spherical<float> dir, int year, int day, float fraction, float& velocity, float& lt);
 void ecleq(const Spherical<double>& ecliptic, double date, Spherical<double>& equatorial);
 void polmo(double m_long, double m_phi, double x_pm, double y_pm, double& t_long, double& t_phi, double& d_az);
@@ -489,6 +1081,20 @@ TPPStatus s2tp(const Spherical<float>& point, const Spherical<float>& tangent, f
 TPPStatus ds2tp(const Spherical<double>& point, const Spherical<double>& tangent, double& xi, double& eta);
 void tp2s(float xi, float eta, const Spherical<float>& tangent, Spherical<float>& point);
 void dtp2s(double xi, double eta, const Spherical<double>& tangent, Spherical<double>& point);
+void s2tp_batch(int n, const float* ra, const float* dec, const Spherical<float>& tangent, float* xi, float* eta,
+    TPPStatus* status);
+void s2tp_batch(StridedSpan<const float> ra, StridedSpan<const float> dec, const Spherical<float>& tangent,
+    StridedSpan<float> xi, StridedSpan<float> eta, StridedSpan<TPPStatus> status);
+void ds2tp_batch(int n, const double* ra, const double* dec, const Spherical<double>& tangent, double* xi, double* eta,
+    TPPStatus* status);
+void ds2tp_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, const Spherical<double>& tangent,
+    StridedSpan<double> xi, StridedSpan<double> eta, StridedSpan<TPPStatus> status);
+void tp2s_batch(int n, const float* xi, const float* eta, const Spherical<float>& tangent, float* ra, float* dec);
+void tp2s_batch(StridedSpan<const float> xi, StridedSpan<const float> eta, const Spherical<float>& tangent,
+    StridedSpan<float> ra, StridedSpan<float> dec);
+void dtp2s_batch(int n, const double* xi, const double* eta, const Spherical<double>& tangent, double* ra, double* dec);
+void dtp2s_batch(StridedSpan<const double> xi, StridedSpan<const double> eta, const Spherical<double>& tangent,
+    StridedSpan<double> ra, StridedSpan<double> dec);
 int tps2c(float xi, float eta, const Spherical<float>& point,
     Spherical<float>& solution1, Spherical<float>& solution2);
 int dtps2c(double xi, double eta, const Spherical<double>& point,
@@ -502,6 +1108,10 @@ int dtpv2c(double xi, double eta, const Vector<double> point, Vector<double> sol
 CPStatus combn(int nsel, int ncand, int* list);
 CPStatus permut(int n, int* state, int* order);
 void evp(double date, double deqx, Vector<double> bvelo, Vector<double> bpos, Vector<double> hvelo, Vector<double> hpos);
+void evp_batch(int n, const double* dates, double deqx,
+    Vector<double>* bvelo, Vector<double>* bpos, Vector<double>* hvelo, Vector<double>* hpos);
+void evp_batch(StridedSpan<const double> dates, double deqx, StridedSpan<Vector<double>> bvelo,
+    StridedSpan<Vector<double>> bpos, StridedSpan<Vector<double>> hvelo, StridedSpan<Vector<double>> hpos);
 void epv(double date, Vector<double> hpos, Vector<double> hvelo, Vector<double> bpos, Vector<double> bvelo);
 void eg50(const Spherical<double>& fk4, Spherical<double>& gal);
 void ge50(const Spherical<double>& gal, Spherical<double>& fk4);
@@ -512,9 +1122,352 @@ const char* vers();
 float random(float seed);
 float gresid(float stdev);
 void moon(int year, int day, float fraction, VectorPV<float>& pv);
+void moon_batch(int n, const int* years, const int* days, const float* fractions, VectorPV<float>* pv);
+void moon_batch(StridedSpan<const int> years, StridedSpan<const int> days, StridedSpan<const float> fractions,
+    StridedSpan<VectorPV<float>> pv);
 void dmoon(double date, VectorPV<double>& pv);
+void dmoon_batch(int n, const double* dates, VectorPV<double>* pv);
+void dmoon_batch(StridedSpan<const double> dates, StridedSpan<VectorPV<double>> pv);
 bool obs(int n, const char* id, Observatory& obs);
 void wait(float seconds);
+ISALevel cpu_isa_level();
+void set_isa_limit(ISALevel limit);
+int get_dispatched_kernels(KernelISA* kernels, int max);
+const char* isa_name(ISALevel level);
+std::int64_t cross_match(const SkyIndex& sources, const SkyIndex& reference, double radius, int max_matches,
+    CrossMatchSink sink, void* context, int nthreads = 0);
+std::uint64_t hilbert_key(const Vector<double> vec);
+void hilbert_key_batch(int n, const double* ra, const double* dec, std::uint64_t* keys, int nthreads = 0);
+void hilbert_key_batch(StridedSpan<const double> ra, StridedSpan<const double> dec, StridedSpan<std::uint64_t> keys,
+    int nthreads = 0);
+void radix_sort_keys(int n, const std::uint64_t* keys, int* order, int nthreads = 0);
+void hilbert_order(int n, const double* ra, const double* dec, int* order, int nthreads = 0);
+void hilbert_order(StridedSpan<const double> ra, StridedSpan<const double> dec, int* order, int nthreads = 0);
+void gather_batch(int n, const int* order, const double* values, double* result, int nthreads = 0);
+void gather_batch(int n, const int* order, const float* values, float* result, int nthreads = 0);
+void gather_batch(int n, const int* order, const int* values, int* result, int nthreads = 0);
+void gather_batch(const int* order, StridedSpan<const double> values, StridedSpan<double> result, int nthreads = 0);
+void gather_batch(const int* order, StridedSpan<const float> values, StridedSpan<float> result, int nthreads = 0);
+void gather_batch(const int* order, StridedSpan<const int> values, StridedSpan<int> result, int nthreads = 0);
+void scatter_batch(int n, const int* order, const double* values, double* result, int nthreads = 0);
+void scatter_batch(int n, const int* order, const float* values, float* result, int nthreads = 0);
+void scatter_batch(int n, const int* order, const int* values, int* result, int nthreads = 0);
+void scatter_batch(const int* order, StridedSpan<const double> values, StridedSpan<double> result, int nthreads = 0);
+void scatter_batch(const int* order, StridedSpan<const float> values, StridedSpan<float> result, int nthreads = 0);
+void scatter_batch(const int* order, StridedSpan<const int> values, StridedSpan<int> result, int nthreads = 0);
+
+} // sla namespace
+
+#include "kernels.h"
+
+namespace sla {
+
+/*
+ * Small vector and matrix functions are defined here rather than in their own modules, so that calls to them, both
+ * from other library functions and from applications, could be inlined and vectorized.
+ *
+ * `SLALIB_SMALL_FUNCTION_ATTRIBUTES` is prepended to their definitions; it is empty unless defined otherwise before
+ * this header is included: `sla-kernel-bench` compiles a copy of some library routines (in a namespace of its own)
+ * with it set to `__attribute__((noipa))`, to compare them with routines whose calls to these functions are inlined.
+ */
+#ifndef SLALIB_SMALL_FUNCTION_ATTRIBUTES
+#define SLALIB_SMALL_FUNCTION_ATTRIBUTES
+#endif
+
+/**
+ * Normalizes angle into range +/- pi  (single precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param angle The angle in radians.
+ * @return The `angle` expressed in the +/- pi.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline float range(float angle) {
+    return kernel::range(angle);
+}
+
+/**
+ * Normalizes angle into range +/- pi  (double precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param angle The angle in radians.
+ * @return The `angle` expressed in the +/- pi.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline double drange(double angle) {
+    return kernel::range(angle);
+}
+
+/**
+ * Normalize angle into range 0-2*pi (single precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param angle The angle in radians.
+ * @return The `angle` expressed in the range 0-2*pi .
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline float ranorm(float angle) {
+    return kernel::ranorm(angle);
+}
+
+/**
+ * Normalize angle into range 0-2*pi (double precision).
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param angle The angle in radians.
+ * @return The `angle` expressed in the range 0-2*pi .
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline double dranrm(double angle) {
+    return kernel::ranorm(angle);
+}
+
+/**
+ * Computes scalar product of two 3-element vectors (single precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param va First vector.
+ * @param vb Second vector.
+ *
+ * @return Scalar product va.vb
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+constexpr float vdv(const Vector<float> va, const Vector<float> vb) {
+    return kernel::vdv(va[0], va[1], va[2], vb[0], vb[1], vb[2]);
+}
+
+/**
+ * Computes scalar product of two 3-element vectors (double precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param va First vector.
+ * @param vb Second vector.
+ *
+ * @return Scalar product va.vb
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+constexpr double dvdv(const Vector<double> va, const Vector<double> vb) {
+    return kernel::vdv(va[0], va[1], va[2], vb[0], vb[1], vb[2]);
+}
+
+/**
+ * Calculates vector product of two 3-component vectors (single precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param va First vector.
+ * @param vb Second vector.
+ * @param vc Output: vector product of the two first argument vectors; it is safe to specify either first of second
+ *  vector as a result holder.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void vxv(const Vector<float> va, const Vector<float> vb, Vector<float> vc) {
+    // form the vector product in scratch variables
+    float x, y, z;
+    kernel::vxv(va[0], va[1], va[2], vb[0], vb[1], vb[2], x, y, z);
+    // return the result
+    vc[0] = x;
+    vc[1] = y;
+    vc[2] = z;
+}
+
+/**
+ * Calculates vector product of two 3-component vectors (double precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param va First vector.
+ * @param vb Second vector.
+ * @param vc Output: vector product of the two first argument vectors; it is safe to specify either first of second
+ *  vector as a result holder.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void dvxv(const Vector<double> va, const Vector<double> vb, Vector<double> vc) {
+    // form the vector product in scratch variables
+    double x, y, z;
+    kernel::vxv(va[0], va[1], va[2], vb[0], vb[1], vb[2], x, y, z);
+    // return the result
+    vc[0] = x;
+    vc[1] = y;
+    vc[2] = z;
+}
+
+/**
+ * Normalizes a 3-component vector, calculates vector's modulus (single precision).
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory. FORTRAN implementation was a procedure
+ * that returned input vector modulus in one of its arguments; C++ implementation is a function returning the modulus
+ * directly.
+ *
+ * @param vec A 3-component vector.
+ * @param nvec Output: unit vector having the same direction as `vec`.
+ *
+ * @return Modulus of `vec`; if the modulus is zero, `nvec` is set to zero as well.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline float vn(const Vector<float> vec, Vector<float> nvec) {
+    float x, y, z;
+    const float modulus = kernel::vn(vec[0], vec[1], vec[2], x, y, z);
+    nvec[0] = x;
+    nvec[1] = y;
+    nvec[2] = z;
+    return modulus;
+}
+
+/**
+ * Normalizes a 3-component vector, calculates vector's modulus (double precision).
+ *
+ * Original FORTRAN code by P.T. Wallace. FORTRAN implementation was a procedure that returned input vector modulus
+ * in one of its arguments; C++ implementation is a function returning the modulus directly.
+ *
+ * @param vec A 3-component vector.
+ * @param nvec Output: unit vector having the same direction as `vec`.
+ *
+ * @return Modulus of `vec`; if the modulus is zero, `nvec` is set to zero as well.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline double dvn(const Vector<double> vec, Vector<double> nvec) {
+    double x, y, z;
+    const double modulus = kernel::vn(vec[0], vec[1], vec[2], x, y, z);
+    nvec[0] = x;
+    nvec[1] = y;
+    nvec[2] = z;
+    return modulus;
+}
+
+/**
+ * Procedure that performs the 3D forward unitary transformation (single precision):
+ *
+ *   vector `vb` = matrix `mat` * vector `va`
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param mat Transformation matrix.
+ * @param va Vector to transform.
+ * @param vb Output: vector `va` multiplied by matrix `mat`; can be the same as `va`.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void mxv(const Matrix<float> mat, const Vector<float> va, Vector<float> vb) {
+    float x, y, z;
+    kernel::mxv(mat, va[0], va[1], va[2], x, y, z);
+    vb[0] = x;
+    vb[1] = y;
+    vb[2] = z;
+}
+
+/**
+ * Procedure that performs the 3D forward unitary transformation (double precision):
+ *
+ *   vector `vb` = matrix `mat` * vector `va`
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param mat Transformation matrix.
+ * @param va Vector to transform.
+ * @param vb Output: vector `va` multiplied by matrix `mat`; can be the same as `va`.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void dmxv(const Matrix<double> mat, const Vector<double> va, Vector<double> vb) {
+    double x, y, z;
+    kernel::mxv(mat, va[0], va[1], va[2], x, y, z);
+    vb[0] = x;
+    vb[1] = y;
+    vb[2] = z;
+}
+
+/**
+ * Procedure that performs 3D backward unitary transformation (single precision):
+ *
+ *   vector vb = (inverse of matrix mat) * vector va
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param mat Input matrix; must be unitary, as this routine assumes that the inverse and transpose are identical.
+ * @param va Input vector; may be the same as output.
+ * @param vb Output: vector; may be the same as input.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void imxv(const Matrix<float> mat, const Vector<float> va, Vector<float> vb) {
+    float x, y, z;
+    kernel::imxv(mat, va[0], va[1], va[2], x, y, z);
+    vb[0] = x;
+    vb[1] = y;
+    vb[2] = z;
+}
+
+/**
+ * Procedure that performs 3D backward unitary transformation (double precision):
+ *
+ *   vector vb = (inverse of matrix mat) * vector va
+ *
+ * Original FORTRAN code by P.T. Wallace / Rutherford Appleton Laboratory.
+ *
+ * @param mat Input matrix; must be unitary, as this routine assumes that the inverse and transpose are identical.
+ * @param va Input vector; may be the same as output.
+ * @param vb Output: vector; may be the same as input.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void dimxv(const Matrix<double> mat, const Vector<double> va, Vector<double> vb) {
+    double x, y, z;
+    kernel::imxv(mat, va[0], va[1], va[2], x, y, z);
+    vb[0] = x;
+    vb[1] = y;
+    vb[2] = z;
+}
+
+/**
+ * Calculates product of two 3x3 matrices (single precision):
+ *
+ *   matrix `mc`  =  matrix `ma`  x  matrix `mb`
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param ma First matrix (first multiplicand).
+ * @param mb Second matrix (second multiplicand).
+ * @param mc Output: product of the two matrices; may be the same matrix as either `ma` or `mb`.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void mxm(const Matrix<float> ma, const Matrix<float> mb, Matrix<float> mc) {
+    // multiply into scratch matrix
+    Matrix<float> result;
+    kernel::mxm(ma, mb, result);
+    // return the result
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            mc[i][j] = result[i][j];
+        }
+    }
+}
+
+/**
+ * Calculates product of two 3x3 matrices (double precision):
+ *
+ *   matrix `mc`  =  matrix `ma`  x  matrix `mb`
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param ma First matrix (first multiplicand).
+ * @param mb Second matrix (second multiplicand).
+ * @param mc Output: product of the two matrices; may be the same matrix as either `ma` or `mb`.
+ */
+SLALIB_SMALL_FUNCTION_ATTRIBUTES
+inline void dmxm(const Matrix<double> ma, const Matrix<double> mb, Matrix<double> mc) {
+    // multiply into scratch matrix
+    Matrix<double> result;
+    kernel::mxm(ma, mb, result);
+    // return the result
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            mc[i][j] = result[i][j];
+        }
+    }
+}
 
 } // sla namespace
 
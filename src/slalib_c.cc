@@ -0,0 +1,308 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib_c.h"
+#include "slalib.h"
+#include "spans.h"
+#include <algorithm>
+
+/*
+ * Implementation of the flat C interface: functions that have batch counterparts in the C++ API forward to them,
+ * others loop over the points; statuses are computed into tiles of enumerations, and converted to `int` element by
+ * element.
+ */
+
+namespace sla {
+
+static_assert(sizeof(Vector<double>) == 3 * sizeof(double), "vectors must be passable as arrays of doubles");
+static_assert((int) SLA_CAT_FK4 == (int) CAT_FK4 && (int) SLA_CAT_FK5 == (int) CAT_FK5,
+    "C catalogue constants must match sla::Catalogue");
+static_assert((int) SLA_TPP_OK == (int) TPP_OK && (int) SLA_TPP_TOO_FAR == (int) TPP_TOO_FAR &&
+    (int) SLA_TPP_ASTAR_ON_TP == (int) TPP_ASTAR_ON_TP && (int) SLA_TPP_ASTAR_TOO_FAR == (int) TPP_ASTAR_TOO_FAR,
+    "C tangent plane status constants must match sla::TPPStatus");
+
+/// Views array of `3 * n` doubles as array of `n` vectors.
+static Vector<double>* as_vectors(double* v) {
+    return reinterpret_cast<Vector<double>*>(v);
+}
+
+/// Views array of `3 * n` doubles as array of `n` constant vectors.
+static const Vector<double>* as_vectors(const double* v) {
+    return reinterpret_cast<const Vector<double>*>(v);
+}
+
+/// Views array of 9 doubles as a 3x3 matrix stored in row-major order.
+static Matrix<double>& as_matrix(double* mat) {
+    return *reinterpret_cast<Matrix<double>*>(mat);
+}
+
+/// Views array of 9 doubles as a constant 3x3 matrix stored in row-major order.
+static const Matrix<double>& as_matrix(const double* mat) {
+    return *reinterpret_cast<const Matrix<double>*>(mat);
+}
+
+/// Calls `func(a, b)`, which should return a double, for all points: `out[i] = func(a[i], b[i])`.
+template <typename F>
+static void map_points(int n, const double* a, const double* b, double* out, F func) {
+    for (int i = 0; i < n; i++) {
+        out[i] = func(a[i], b[i]);
+    }
+}
+
+/// Calls `func(in, out)` with spherical coordinates of all points: `in` is {a[i], b[i]}, and `out` is stored to
+/// `ra[i]`, `rb[i]`.
+template <typename F>
+static void map_spherical(int n, const double* a, const double* b, double* ra, double* rb, F func) {
+    for (int i = 0; i < n; i++) {
+        Spherical<double> out;
+        func(Spherical<double>{a[i], b[i]}, out);
+        ra[i] = out.get_ra();
+        rb[i] = out.get_dec();
+    }
+}
+
+} // sla
+
+using namespace sla;
+
+extern "C" {
+
+// time scales
+
+void sla_dat_batch(int n, const double* utc, double* tai_utc) {
+    for (int i = 0; i < n; i++) {
+        tai_utc[i] = dat(utc[i]);
+    }
+}
+
+void sla_dtt_batch(int n, const double* utc, double* tt_utc) {
+    for (int i = 0; i < n; i++) {
+        tt_utc[i] = dtt(utc[i]);
+    }
+}
+
+void sla_gmst_batch(int n, const double* ut1, double* gmst) {
+    for (int i = 0; i < n; i++) {
+        gmst[i] = sla::gmst(ut1[i]);
+    }
+}
+
+void sla_gmsta_batch(int n, const double* date, const double* fdate, double* gmst) {
+    map_points(n, date, fdate, gmst, [](double d, double f) { return gmsta(d, f); });
+}
+
+void sla_eqeqx_batch(int n, const double* tdb, double* eqeqx) {
+    for (int i = 0; i < n; i++) {
+        eqeqx[i] = sla::eqeqx(tdb[i]);
+    }
+}
+
+void sla_rcc_batch(int n, const double* tdb, const double* ut1, double cl, double cda, double cdp, double* tdb_tt) {
+    map_points(n, tdb, ut1, tdb_tt, [=](double t, double u) { return rcc(t, u, cl, cda, cdp); });
+}
+
+void sla_epj_batch(int n, const double* mjd, double* epoch) {
+    for (int i = 0; i < n; i++) {
+        epoch[i] = epj(mjd[i]);
+    }
+}
+
+void sla_epj2d_batch(int n, const double* epoch, double* mjd) {
+    for (int i = 0; i < n; i++) {
+        mjd[i] = epj2d(epoch[i]);
+    }
+}
+
+void sla_epb_batch(int n, const double* mjd, double* epoch) {
+    for (int i = 0; i < n; i++) {
+        epoch[i] = epb(mjd[i]);
+    }
+}
+
+void sla_epb2d_batch(int n, const double* epoch, double* mjd) {
+    for (int i = 0; i < n; i++) {
+        mjd[i] = epb2d(epoch[i]);
+    }
+}
+
+// precession and nutation matrices, and their application to many vectors
+
+void sla_prec(double ep0, double ep1, double* mat) {
+    prec(ep0, ep1, as_matrix(mat));
+}
+
+void sla_prebn(double be0, double be1, double* mat) {
+    prebn(be0, be1, as_matrix(mat));
+}
+
+void sla_prenut(double epoch, double date, double* mat) {
+    prenut(epoch, date, as_matrix(mat));
+}
+
+void sla_nut(double tdb, double* mat) {
+    nut(tdb, as_matrix(mat));
+}
+
+void sla_dmxv_batch(const double* mat, int n, const double* va, double* vb) {
+    dmxv_batch(as_matrix(mat), n, as_vectors(va), as_vectors(vb));
+}
+
+void sla_dimxv_batch(const double* mat, int n, const double* va, double* vb) {
+    dimxv_batch(as_matrix(mat), n, as_vectors(va), as_vectors(vb));
+}
+
+void sla_dcs2c_batch(int n, const double* a, const double* b, double* v) {
+    dcs2c_batch(n, a, b, as_vectors(v));
+}
+
+void sla_dcc2s_batch(int n, const double* v, double* a, double* b) {
+    dcc2s_batch(n, as_vectors(v), a, b);
+}
+
+void sla_preces_batch(int system, double ep0, double ep1, int n, double* ra, double* dec) {
+    const Catalogue catalogue = system == SLA_CAT_FK4? CAT_FK4: (system == SLA_CAT_FK5? CAT_FK5: CAT_NONE);
+    preces_batch(catalogue, ep0, ep1, n, ra, dec, ra, dec);
+}
+
+// frame changes
+
+void sla_fk425_batch(int n, const double* r1950, const double* d1950, const double* dr1950, const double* dd1950,
+    const double* p1950, const double* v1950, double* r2000, double* d2000, double* dr2000, double* dd2000,
+    double* p2000, double* v2000) {
+    fk425_batch(n, r1950, d1950, dr1950, dd1950, p1950, v1950, r2000, d2000, dr2000, dd2000, p2000, v2000);
+}
+
+void sla_fk524_batch(int n, const double* r2000, const double* d2000, const double* dr2000, const double* dd2000,
+    const double* p2000, const double* v2000, double* r1950, double* d1950, double* dr1950, double* dd1950,
+    double* p1950, double* v1950) {
+    fk524_batch(n, r2000, d2000, dr2000, dd2000, p2000, v2000, r1950, d1950, dr1950, dd1950, p1950, v1950);
+}
+
+void sla_fk45z_batch(int n, const double* r1950, const double* d1950, double bepoch, double* r2000, double* d2000) {
+    fk45z_batch(n, r1950, d1950, bepoch, r2000, d2000);
+}
+
+void sla_fk54z_batch(int n, const double* r2000, const double* d2000, double bepoch,
+    double* r1950, double* d1950, double* dr1950, double* dd1950) {
+    fk54z_batch(n, r2000, d2000, bepoch, r1950, d1950, dr1950, dd1950);
+}
+
+void sla_fk52h_batch(int n, const double* r5, const double* d5, const double* dr5, const double* dd5,
+    double* rh, double* dh, double* drh, double* ddh) {
+    fk52h_batch(n, r5, d5, dr5, dd5, rh, dh, drh, ddh);
+}
+
+void sla_h2fk5_batch(int n, const double* rh, const double* dh, const double* drh, const double* ddh,
+    double* r5, double* d5, double* dr5, double* dd5) {
+    h2fk5_batch(n, rh, dh, drh, ddh, r5, d5, dr5, dd5);
+}
+
+void sla_fk5hz_batch(int n, const double* r5, const double* d5, double epoch, double* rh, double* dh) {
+    fk5hz_batch(n, r5, d5, epoch, rh, dh);
+}
+
+void sla_hfk5z_batch(int n, const double* rh, const double* dh, double epoch,
+    double* r5, double* d5, double* dr5, double* dd5) {
+    hfk5z_batch(n, rh, dh, epoch, r5, d5, dr5, dd5);
+}
+
+void sla_addet_batch(int n, const double* ra, const double* dec, double be, double* era, double* edec) {
+    addet_batch(n, ra, dec, be, era, edec);
+}
+
+void sla_subet_batch(int n, const double* era, const double* edec, double be, double* ra, double* dec) {
+    subet_batch(n, era, edec, be, ra, dec);
+}
+
+void sla_eqecl_batch(int n, const double* ra, const double* dec, double date, double* el, double* eb) {
+    map_spherical(n, ra, dec, el, eb, [date](const Spherical<double>& in, Spherical<double>& out) {
+        eqecl(in, date, out);
+    });
+}
+
+void sla_ecleq_batch(int n, const double* el, const double* eb, double date, double* ra, double* dec) {
+    map_spherical(n, el, eb, ra, dec, [date](const Spherical<double>& in, Spherical<double>& out) {
+        ecleq(in, date, out);
+    });
+}
+
+void sla_eqgal_batch(int n, const double* ra, const double* dec, double* gl, double* gb) {
+    map_spherical(n, ra, dec, gl, gb, eqgal);
+}
+
+void sla_galeq_batch(int n, const double* gl, const double* gb, double* ra, double* dec) {
+    map_spherical(n, gl, gb, ra, dec, galeq);
+}
+
+void sla_galsup_batch(int n, const double* gl, const double* gb, double* sl, double* sb) {
+    map_spherical(n, gl, gb, sl, sb, galsup);
+}
+
+void sla_supgal_batch(int n, const double* sl, const double* sb, double* gl, double* gb) {
+    map_spherical(n, sl, sb, gl, gb, supgal);
+}
+
+// tangent plane projections
+
+void sla_ds2tp_batch(int n, const double* ra, const double* dec, double raz, double decz,
+    double* xi, double* eta, int* status) {
+    // statuses are computed into a tile of enumerators, and converted to `int` one by one
+    TPPStatus tile[SPAN_TILE];
+    for (int first = 0; first < n; first += SPAN_TILE) {
+        const int count = std::min(SPAN_TILE, n - first);
+        ds2tp_batch(count, ra + first, dec + first, {raz, decz}, xi + first, eta + first, tile);
+        for (int i = 0; i < count; i++) {
+            status[first + i] = static_cast<int>(tile[i]);
+        }
+    }
+}
+
+void sla_dtp2s_batch(int n, const double* xi, const double* eta, double raz, double decz, double* ra, double* dec) {
+    dtp2s_batch(n, xi, eta, {raz, decz}, ra, dec);
+}
+
+// proper motion
+
+void sla_pm_batch(int n, const double* ra0, const double* dec0, const double* pmra, const double* pmdec,
+    const double* px, const double* rv, double ep0, double ep1, double* ra1, double* dec1) {
+    for (int i = 0; i < n; i++) {
+        Spherical<double> dir_ep1;
+        pm({ra0[i], dec0[i]}, {pmra[i], pmdec[i]}, px[i], rv[i], ep0, ep1, dir_ep1);
+        ra1[i] = dir_ep1.get_ra();
+        dec1[i] = dir_ep1.get_dec();
+    }
+}
+
+// horizon coordinates
+
+void sla_de2h_batch(int n, const double* ha, const double* dec, double phi, double* az, double* el) {
+    HorizonFrame<double>(phi).e2h(n, ha, dec, az, el);
+}
+
+void sla_dh2e_batch(int n, const double* az, const double* el, double phi, double* ha, double* dec) {
+    HorizonFrame<double>(phi).h2e(n, az, el, ha, dec);
+}
+
+void sla_zd_batch(int n, const double* ha, const double* dec, double phi, double* zd) {
+    HorizonFrame<double>(phi).zd(n, ha, dec, zd);
+}
+
+void sla_pa_batch(int n, const double* ha, const double* dec, double phi, double* pa) {
+    HorizonFrame<double>(phi).pa(n, ha, dec, pa);
+}
+
+} // extern "C"
@@ -0,0 +1,123 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_C_H_INCLUDED
+#define SLALIB_C_H_INCLUDED
+
+/*
+ * Flat C interface to the high-volume functions of the library, meant for foreign function interfaces (Python's
+ * `ctypes` or `cffi`, Julia's `ccall`, etc.).
+ *
+ * All functions process `n` points at once, and take plain arrays of `n` doubles (C-contiguous `float64` arrays in
+ * NumPy terms), so that a whole array can be passed in one call, without copying; 3-vectors are stored as `3 * n`
+ * doubles (x0, y0, z0, x1, ...), and 3x3 matrices as 9 doubles in row-major order. Unless specified otherwise, output
+ * arrays may be the same as input ones. Epochs and dates that are shared by all points are passed as scalars. Results
+ * are identical to those of the corresponding C++ functions called for each point (see their descriptions in the
+ * implementation files); the names are those of the C++ functions, prefixed with `sla_`.
+ *
+ * Statuses are returned as `int` arrays holding values of the corresponding C++ enumerations, which are mirrored by
+ * the constants below (so that C callers need not hardcode numbers).
+ */
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* catalogues (reference systems) accepted by sla_preces_batch(); values of C++ enumeration sla::Catalogue */
+enum sla_catalogue {
+    SLA_CAT_FK4 = 4,
+    SLA_CAT_FK5 = 5
+};
+
+/* statuses returned by sla_ds2tp_batch(); values of C++ enumeration sla::TPPStatus */
+enum sla_tpp_status {
+    SLA_TPP_OK = 0,           /* star on tangent plane */
+    SLA_TPP_TOO_FAR = 1,      /* error, star too far from axis */
+    SLA_TPP_ASTAR_ON_TP = 2,  /* error, antistar on tangent plane */
+    SLA_TPP_ASTAR_TOO_FAR = 3 /* error, antistar too far from axis */
+};
+
+/* time scales */
+void sla_dat_batch(int n, const double* utc, double* tai_utc);
+void sla_dtt_batch(int n, const double* utc, double* tt_utc);
+void sla_gmst_batch(int n, const double* ut1, double* gmst);
+void sla_gmsta_batch(int n, const double* date, const double* fdate, double* gmst);
+void sla_eqeqx_batch(int n, const double* tdb, double* eqeqx);
+void sla_rcc_batch(int n, const double* tdb, const double* ut1, double cl, double cda, double cdp, double* tdb_tt);
+void sla_epj_batch(int n, const double* mjd, double* epoch);
+void sla_epj2d_batch(int n, const double* epoch, double* mjd);
+void sla_epb_batch(int n, const double* mjd, double* epoch);
+void sla_epb2d_batch(int n, const double* epoch, double* mjd);
+
+/* precession and nutation matrices, and their application to many vectors */
+void sla_prec(double ep0, double ep1, double* mat);
+void sla_prebn(double be0, double be1, double* mat);
+void sla_prenut(double epoch, double date, double* mat);
+void sla_nut(double tdb, double* mat);
+void sla_dmxv_batch(const double* mat, int n, const double* va, double* vb);
+void sla_dimxv_batch(const double* mat, int n, const double* va, double* vb);
+void sla_dcs2c_batch(int n, const double* a, const double* b, double* v);
+void sla_dcc2s_batch(int n, const double* v, double* a, double* b);
+void sla_preces_batch(int system, double ep0, double ep1, int n, double* ra, double* dec);
+
+/* frame changes */
+void sla_fk425_batch(int n, const double* r1950, const double* d1950, const double* dr1950, const double* dd1950,
+    const double* p1950, const double* v1950, double* r2000, double* d2000, double* dr2000, double* dd2000,
+    double* p2000, double* v2000);
+void sla_fk524_batch(int n, const double* r2000, const double* d2000, const double* dr2000, const double* dd2000,
+    const double* p2000, const double* v2000, double* r1950, double* d1950, double* dr1950, double* dd1950,
+    double* p1950, double* v1950);
+void sla_fk45z_batch(int n, const double* r1950, const double* d1950, double bepoch, double* r2000, double* d2000);
+void sla_fk54z_batch(int n, const double* r2000, const double* d2000, double bepoch,
+    double* r1950, double* d1950, double* dr1950, double* dd1950);
+void sla_fk52h_batch(int n, const double* r5, const double* d5, const double* dr5, const double* dd5,
+    double* rh, double* dh, double* drh, double* ddh);
+void sla_h2fk5_batch(int n, const double* rh, const double* dh, const double* drh, const double* ddh,
+    double* r5, double* d5, double* dr5, double* dd5);
+void sla_fk5hz_batch(int n, const double* r5, const double* d5, double epoch, double* rh, double* dh);
+void sla_hfk5z_batch(int n, const double* rh, const double* dh, double epoch,
+    double* r5, double* d5, double* dr5, double* dd5);
+void sla_addet_batch(int n, const double* ra, const double* dec, double be, double* era, double* edec);
+void sla_subet_batch(int n, const double* era, const double* edec, double be, double* ra, double* dec);
+void sla_eqecl_batch(int n, const double* ra, const double* dec, double date, double* el, double* eb);
+void sla_ecleq_batch(int n, const double* el, const double* eb, double date, double* ra, double* dec);
+void sla_eqgal_batch(int n, const double* ra, const double* dec, double* gl, double* gb);
+void sla_galeq_batch(int n, const double* gl, const double* gb, double* ra, double* dec);
+void sla_galsup_batch(int n, const double* gl, const double* gb, double* sl, double* sb);
+void sla_supgal_batch(int n, const double* sl, const double* sb, double* gl, double* gb);
+
+/* tangent plane projections */
+void sla_ds2tp_batch(int n, const double* ra, const double* dec, double raz, double decz,
+    double* xi, double* eta, int* status);
+void sla_dtp2s_batch(int n, const double* xi, const double* eta, double raz, double decz, double* ra, double* dec);
+
+/* proper motion */
+void sla_pm_batch(int n, const double* ra0, const double* dec0, const double* pmra, const double* pmdec,
+    const double* px, const double* rv, double ep0, double ep1, double* ra1, double* dec1);
+
+/* horizon coordinates (computed by sla::HorizonFrame<double>, so results agree with those of sla::de2h(), etc. to
+   within rounding errors rather than bit for bit) */
+void sla_de2h_batch(int n, const double* ha, const double* dec, double phi, double* az, double* el);
+void sla_dh2e_batch(int n, const double* az, const double* el, double phi, double* ha, double* dec);
+void sla_zd_batch(int n, const double* ha, const double* dec, double phi, double* zd);
+void sla_pa_batch(int n, const double* ha, const double* dec, double phi, double* pa);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SLALIB_C_H_INCLUDED */
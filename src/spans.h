@@ -0,0 +1,115 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#ifndef SLALIB_SPANS_H_INCLUDED
+#define SLALIB_SPANS_H_INCLUDED
+
+#include "slalib.h"
+#include "parallel.h"
+#include <algorithm>
+#include <cstring>
+#include <tuple>
+
+namespace sla {
+
+/// Number of elements per tile: a dozen tiles of doubles (the most a batch function uses) fit in L1 data cache.
+constexpr int SPAN_TILE = 256;
+
+/**
+ * Tile of up to `SIZE` elements of a `StridedSpan<T>`: contiguous spans are accessed in place, while the elements of
+ * the others are gathered into (if `T` is const, i.e. span is an input), or scattered from (if `T` is not const) a
+ * local buffer.
+ */
+template <typename T, int SIZE = SPAN_TILE>
+class SpanTile {
+    using value_type = std::remove_const_t<T>;
+
+    StridedSpan<T> st_span;               ///< the span
+    value_type st_buffer[SIZE];           ///< local copy of the elements of a non-contiguous span
+
+public:
+    explicit SpanTile(const StridedSpan<T>& span): st_span(span) {}
+
+    /// Returns pointer to contiguous elements [first..first+count) of the span, gathering inputs if necessary.
+    T* load(int first, int count) {
+        assert(count <= SIZE && first + count <= st_span.get_size());
+        if (st_span.is_contiguous()) {
+            return st_span.get_data() + first;
+        }
+        if constexpr (std::is_const<T>::value) {
+            for (int i = 0; i < count; i++) {
+                std::memcpy(&st_buffer[i], &st_span[first + i], sizeof(value_type));
+            }
+        }
+        return st_buffer;
+    }
+
+    /// Makes results written to the pointer returned by `load()` visible in the span, scattering outputs if necessary.
+    void store(int first, int count) {
+        if constexpr (!std::is_const<T>::value) {
+            if (!st_span.is_contiguous()) {
+                for (int i = 0; i < count; i++) {
+                    std::memcpy(&st_span[first + i], &st_buffer[i], sizeof(value_type));
+                }
+            }
+        }
+    }
+};
+
+/**
+ * Calls `func(count, pointers...)` for consecutive tiles of up to `SPAN_TILE` elements of `n`-element `spans`, where
+ * `pointers` point to contiguous copies of the tiles of the corresponding spans (or into the spans themselves, if
+ * they are contiguous); `func` is meant to call the pointer-based version of a batch function.
+ *
+ * Output spans may coincide with input spans, provided that the pointer-based function supports that.
+ */
+template <typename F, typename... T>
+void span_tiles(int n, F func, const StridedSpan<T>&... spans) {
+    assert(((spans.get_size() == n) && ...));
+    std::tuple<SpanTile<T>...> tiles(spans...);
+    for (int first = 0; first < n; first += SPAN_TILE) {
+        const int count = std::min(SPAN_TILE, n - first);
+        std::apply([first, count, &func](auto&... tile) {
+            func(count, tile.load(first, count)...);
+            (tile.store(first, count), ...);
+        }, tiles);
+    }
+}
+
+/**
+ * Version of `span_tiles()` that processes tiles concurrently, each thread with tile buffers of its own; `func` is
+ * then meant to call a serial kernel, so that threads are only started once per call rather than once per tile.
+ */
+template <typename F, typename... T>
+void parallel_span_tiles(int n, int nthreads, F func, const StridedSpan<T>&... spans) {
+    assert(((spans.get_size() == n) && ...));
+    parallel_for((n + SPAN_TILE - 1) / SPAN_TILE, nthreads, [&](int first_tile, int last_tile) {
+        std::tuple<SpanTile<T>...> tiles(spans...);
+        for (int tile_index = first_tile; tile_index < last_tile; tile_index++) {
+            const int first = tile_index * SPAN_TILE;
+            const int count = std::min(SPAN_TILE, n - first);
+            std::apply([first, count, &func](auto&... tile) {
+                func(count, tile.load(first, count)...);
+                (tile.store(first, count), ...);
+            }, tiles);
+        }
+    }, 1);
+}
+
+} // sla
+
+#endif // SLALIB_SPANS_H_INCLUDED
@@ -16,6 +16,9 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
+#include <cmath>
 
 namespace sla {
 
@@ -57,4 +60,92 @@ void subet(const Spherical<double>& edir, double be, Spherical<double>& dir) {
     dir.set_ra(dranrm(dir.get_ra()));
 }
 
+/**
+ * Removes the E-terms (elliptic component of annual aberration) from many pre IAU 1976 catalogue RA,Dec of the same
+ * epoch to give mean places (double precision).
+ *
+ * Results are identical to those of the sla::subet() function, but the E-terms vector is only computed once, and
+ * places are processed in SIMD packs (see `simd.h`). Input and output arrays may be the same.
+ *
+ * @param n Number of places.
+ * @param era RAs with E-terms included (radians).
+ * @param edec Decs with E-terms included (radians).
+ * @param be Besselian epoch of mean equator and equinox.
+ * @param ra Return value: RAs without E-terms (radians).
+ * @param dec Return value: Decs without E-terms (radians).
+ */
+void subet_batch(int n, const double* era, const double* edec, double be, double* ra, double* dec) {
+    // get E-terms
+    Vector<double> et;
+    etrms(be, et);
+
+    lane_loop<double>(n, [=, &et](auto tag, int i) {
+        using V = decltype(tag);
+        // spherical to Cartesian
+        V x, y, z;
+        kernel::cs2c(lane_load<V>(era + i), lane_load<V>(edec + i), x, y, z);
+
+        // remove the E-terms
+        const V f = 1.0 + kernel::vdv(x, y, z, V(et[0]), V(et[1]), V(et[2]));
+        x = x * f - et[0];
+        y = y * f - et[1];
+        z = z * f - et[2];
+
+        // Cartesian to spherical, bringing RA into conventional range
+        V a, b;
+        kernel::cc2s(x, y, z, a, b);
+        lane_store(kernel::ranorm(a), ra + i);
+        lane_store(b, dec + i);
+    });
+}
+
+/**
+ * Removes the E-terms (elliptic component of annual aberration) from many pre IAU 1976 catalogue directions of the
+ * same epoch given as unit vectors, giving unit vectors of mean places (double precision).
+ *
+ * This is the Cartesian core of the sla::subet() function, without the spherical to Cartesian conversion and back;
+ * the loop over directions is free of branches and library calls other than square root, so compilers can vectorize
+ * it. Input and output arrays may be the same.
+ *
+ * @param n Number of directions.
+ * @param evecs Unit vectors with E-terms included.
+ * @param be Besselian epoch of mean equator and equinox.
+ * @param vecs Return value: unit vectors without E-terms.
+ */
+void subetv_batch(int n, const Vector<double>* evecs, double be, Vector<double>* vecs) {
+    // get E-terms
+    Vector<double> et;
+    etrms(be, et);
+
+    for (int i = 0; i < n; i++) {
+        // remove the E-terms
+        const double* ev = evecs[i];
+        const double f = 1.0 + ev[0] * et[0] + ev[1] * et[1] + ev[2] * et[2];
+        const double x = ev[0] * f - et[0];
+        const double y = ev[1] * f - et[1];
+        const double z = ev[2] * f - et[2];
+
+        // normalize
+        const double w = 1.0 / std::sqrt(x * x + y * y + z * z);
+        vecs[i][0] = x * w;
+        vecs[i][1] = y * w;
+        vecs[i][2] = z * w;
+    }
+}
+
+/// Version of sla::subet_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void subet_batch(StridedSpan<const double> era, StridedSpan<const double> edec, double be, StridedSpan<double> ra,
+    StridedSpan<double> dec) {
+    span_tiles(era.get_size(), [&](int n, auto era, auto edec, auto ra, auto dec) {
+        subet_batch(n, era, edec, be, ra, dec);
+    }, era, edec, ra, dec);
+}
+
+/// Version of sla::subetv_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void subetv_batch(StridedSpan<const Vector<double>> evecs, double be, StridedSpan<Vector<double>> vecs) {
+    span_tiles(evecs.get_size(), [&](int n, auto evecs, auto vecs) {
+        subetv_batch(n, evecs, be, vecs);
+    }, evecs, vecs);
+}
+
 }
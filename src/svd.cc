@@ -17,54 +17,13 @@
  */
 #include "slalib.h"
 #include "f77_utils.h"
+#include "dispatch.h"
 #include <cmath>
 
 namespace sla {
 
-/**
- * Singular value decomposition (double precision).
- *
- * This function expresses a given matrix A as the product of three matrices U, W, VT:
- *   A = U x W x VT
- *
- * Where
- *   A   is any M (rows) x N (columns) matrix, where M >= N,
- *   U   is an M x N column-orthogonal matrix,
- *   W   is an N x N diagonal matrix with W[I][I] >= 0,
- *   VT  is the transpose of an N x N orthogonal matrix.
- *
- * Note that M and N, above, are the *logical* dimensions of the matrices and vectors concerned, which can be located
- * in arrays of larger *physical* dimensions, given by MP and NP.
- *
- * References:
- *   The algorithm is an adaptation of the routine SVD in the EISPACK library (Garbow et al 1977, EISPACK Guide
- *   Extension, Springer Verlag), which is a FORTRAN 66 implementation of the Algol routine SVD of Wilkinson &
- *   Reinsch 1971 (Handbook for Automatic Computation, vol 2, ed Bauer et al, Springer Verlag). These references give
- *   full details of the algorithm used here. A good account of the use of SVD in least squares problems is given in
- *   Numerical Recipes (Press et al 1986, Cambridge University Press), which includes another variant of the EISPACK
- *   code.
- *
- * Original FORTRAN code by P.T. Wallace.
- *
- * @param m Number of rows in matrix A.
- * @param n Number of columns in matrix A.
- * @param mp Physical dimension (number of rows) of array containing matrix A.
- * @param np Physical dimension (number of columns) of array containing matrix A.
- * @param a Input: `mp`x`np` array containing `m`x`n` matrix A; output: `mp`x`np` array containing `m`x`n`
- *   column-orthogonal matrix U.
- * @param w Output value: `n`x`n` diagonal matrix W (`n` elements in one-dimensional array of length `np`: diagonal
- *   elements only).
- * @param v Output value: `np`x`np` array containing `n`x`n` orthogonal matrix V; note: it contains matrix V, not the
- *   transpose of matrix V (VT).
- * @param ws Workspace (`np`-long array containing `n` elements).
- * @return 0 = OK, -1 = A of wrong shape, >0 = index of W for which convergence failed; if returned status is greater
- *   than zero, this need not necessarily be treated as a failure; it means that, due to chance properties of the
- *   matrix A, the QR transformation phase of the routine did not fully converge in a predefined number of
- *   iterations, something that very seldom occurs; when this condition does arise, it is possible that the elements
- *   of the diagonal matrix W have not been correctly found; however, in practice the results are likely to be
- *   trustworthy; applications should report the condition as a warning, but then proceed normally.
- */
-int svd(int m, int n, int mp, int np, double* a, double* w, double* v, double* ws) {
+/// Body of sla::svd(), compiled for each supported instruction set (see dispatch.h).
+static SLALIB_KERNEL int svd_kernel(int m, int n, int mp, int np, double* a, double* w, double* v, double* ws) {
     assert(m <= mp && n <= np && a && w && v && ws);
 
     auto a_elem = [a, m, n, np](int row, int col) -> double& {
@@ -377,4 +336,54 @@ int svd(int m, int n, int mp, int np, double* a, double* w, double* v, double* w
     return status;
 }
 
+static KernelDispatcher<svd_kernel> svd_dispatcher("svd");
+static const bool svd_enlisted = svd_dispatcher.enlist();
+
+/**
+ * Singular value decomposition (double precision).
+ *
+ * This function expresses a given matrix A as the product of three matrices U, W, VT:
+ *   A = U x W x VT
+ *
+ * Where
+ *   A   is any M (rows) x N (columns) matrix, where M >= N,
+ *   U   is an M x N column-orthogonal matrix,
+ *   W   is an N x N diagonal matrix with W[I][I] >= 0,
+ *   VT  is the transpose of an N x N orthogonal matrix.
+ *
+ * Note that M and N, above, are the *logical* dimensions of the matrices and vectors concerned, which can be located
+ * in arrays of larger *physical* dimensions, given by MP and NP.
+ *
+ * References:
+ *   The algorithm is an adaptation of the routine SVD in the EISPACK library (Garbow et al 1977, EISPACK Guide
+ *   Extension, Springer Verlag), which is a FORTRAN 66 implementation of the Algol routine SVD of Wilkinson &
+ *   Reinsch 1971 (Handbook for Automatic Computation, vol 2, ed Bauer et al, Springer Verlag). These references give
+ *   full details of the algorithm used here. A good account of the use of SVD in least squares problems is given in
+ *   Numerical Recipes (Press et al 1986, Cambridge University Press), which includes another variant of the EISPACK
+ *   code.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param m Number of rows in matrix A.
+ * @param n Number of columns in matrix A.
+ * @param mp Physical dimension (number of rows) of array containing matrix A.
+ * @param np Physical dimension (number of columns) of array containing matrix A.
+ * @param a Input: `mp`x`np` array containing `m`x`n` matrix A; output: `mp`x`np` array containing `m`x`n`
+ *   column-orthogonal matrix U.
+ * @param w Output value: `n`x`n` diagonal matrix W (`n` elements in one-dimensional array of length `np`: diagonal
+ *   elements only).
+ * @param v Output value: `np`x`np` array containing `n`x`n` orthogonal matrix V; note: it contains matrix V, not the
+ *   transpose of matrix V (VT).
+ * @param ws Workspace (`np`-long array containing `n` elements).
+ * @return 0 = OK, -1 = A of wrong shape, >0 = index of W for which convergence failed; if returned status is greater
+ *   than zero, this need not necessarily be treated as a failure; it means that, due to chance properties of the
+ *   matrix A, the QR transformation phase of the routine did not fully converge in a predefined number of
+ *   iterations, something that very seldom occurs; when this condition does arise, it is possible that the elements
+ *   of the diagonal matrix W have not been correctly found; however, in practice the results are likely to be
+ *   trustworthy; applications should report the condition as a warning, but then proceed normally.
+ */
+int svd(int m, int n, int mp, int np, double* a, double* w, double* v, double* ws) {
+    return svd_dispatcher(m, n, mp, np, a, w, v, ws);
+}
+
 }
@@ -16,6 +16,8 @@
  *
  */
 #include "slalib.h"
+#include "spans.h"
+#include "simd.h"
 #include <cmath>
 
 namespace sla {
@@ -31,12 +33,42 @@ namespace sla {
  * @param point Return value: spherical coordinates (0-2pi,+/-pi/2).
  */
 void tp2s(float xi, float eta, const Spherical<float>& tangent, Spherical<float>& point) {
+    float ra, dec;
+    kernel::tp2s(xi, eta, tangent.get_ra(), std::sin(tangent.get_dec()), std::cos(tangent.get_dec()), ra, dec);
+    point.set_ra(ra);
+    point.set_dec(dec);
+}
+
+/**
+ * Transforms many tangent plane coordinates into spherical (single precision); this is a vectorized version of
+ * sla::tp2s().
+ *
+ * @param n Number of points.
+ * @param xi Tangent plane rectangular coordinates.
+ * @param eta Tangent plane rectangular coordinates.
+ * @param tangent Spherical coordinates of tangent point.
+ * @param ra Output: `n` right ascensions (0-2pi).
+ * @param dec Output: `n` declinations (+/-pi/2).
+ */
+void tp2s_batch(int n, const float* xi, const float* eta, const Spherical<float>& tangent, float* ra, float* dec) {
+    const float tra = tangent.get_ra();
     const float sin_tdec = std::sin(tangent.get_dec());
     const float cos_tdec = std::cos(tangent.get_dec());
-    const float denom = cos_tdec - eta * sin_tdec;
+    lane_loop<float>(n, [=](auto tag, int i) {
+        using V = decltype(tag);
+        V ra_i, dec_i;
+        kernel::tp2s(lane_load<V>(xi + i), lane_load<V>(eta + i), tra, sin_tdec, cos_tdec, ra_i, dec_i);
+        lane_store(ra_i, ra + i);
+        lane_store(dec_i, dec + i);
+    });
+}
 
-    point.set_ra(ranorm(std::atan2(xi, denom) + tangent.get_ra()));
-    point.set_dec(std::atan2(sin_tdec + eta * cos_tdec, std::sqrt(xi * xi + denom * denom)));
+/// Version of sla::tp2s_batch() that accesses items through strided spans of the same size (see sla::StridedSpan).
+void tp2s_batch(StridedSpan<const float> xi, StridedSpan<const float> eta, const Spherical<float>& tangent,
+    StridedSpan<float> ra, StridedSpan<float> dec) {
+    span_tiles(xi.get_size(), [&](int n, auto xi, auto eta, auto ra, auto dec) {
+        tp2s_batch(n, xi, eta, tangent, ra, dec);
+    }, xi, eta, ra, dec);
 }
 
 }
@@ -0,0 +1,59 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+
+namespace sla {
+
+/**
+ * Heliocentric osculating elements obtained from universal elements.
+ *
+ * The universal elements are those which define the orbit for the purposes of the method of universal variables (see
+ * sla::ue2pv()); they are converted into conventional elements (see sla::el2ue()) by means of sla::pv2el(), at the
+ * reference epoch of the universal elements.
+ *
+ * The requested form of the elements `jformr` is honoured only for elliptical orbits; if the orbit is parabolic or
+ * hyperbolic, OEF_COMET elements are returned. The actual form is returned in the `oe_form` member of `elements`.
+ *
+ * Reference: Sterne, Theodore E., "An Introduction to Celestial Mechanics", Interscience Publishers Inc., 1960.
+ * Section 6.7, p199.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param u Universal orbital elements.
+ * @param jformr Requested form of the elements.
+ * @param elements Return value: conventional orbital elements.
+ * @return Status, as returned by sla::pv2el().
+ */
+OEStatus ue2el(const UniversalElements& u, OEForm jformr, OrbitalElements& elements) {
+    // Gaussian gravitational constant (exact)
+    constexpr double GCON = 0.01720209895;
+
+    // canonical days to seconds
+    constexpr double CD2S = GCON / 86400.0;
+
+    // unpack the universal elements
+    const double pmass = u.ue_mass - 1.0;
+    const double date = u.ue_t0;
+    const Vector<double> vel = {u.ue_v0[0] * CD2S, u.ue_v0[1] * CD2S, u.ue_v0[2] * CD2S};
+    const VectorPV<double> pv(u.ue_p0, vel);
+
+    // convert the position and velocity etc into conventional elements
+    return pv2el(pv, date, pmass, jformr, elements);
+}
+
+}
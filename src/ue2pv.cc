@@ -0,0 +1,350 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include "spans.h"
+#include <algorithm>
+#include <cmath>
+
+namespace sla {
+
+// Gaussian gravitational constant (exact)
+static constexpr double GCON = 0.01720209895;
+
+// canonical days to seconds
+static constexpr double CD2S = GCON / 86400.0;
+
+// maximum number of bodies processed in lockstep by ue2pv_lanes()
+static constexpr int LANES = 8;
+
+/*
+ * Heliocentric positions and velocities of up to LANES bodies from their universal elements, passed as arrays of
+ * element components; dates of prediction and universal eccentric anomalies are updated for the bodies that succeed.
+ *
+ * Iterations are run for all bodies in lockstep until every body has converged (or failed): each step is a loop
+ * over lanes with no per-lane branches, in which every lane computes the update and the bodies that have already
+ * converged (or failed) are masked out by selects; no lane depends on another one, so results are identical for any
+ * number of lanes.
+ */
+static void ue2pv_lanes(int count, double date, const double* cm, const double* alpha, const double* t0,
+    const double* const p0[3], const double* const v0[3], const double* r0, const double* sigma0,
+    double* t, double* psi_io, VectorPV<double>* pv, OEStatus* status) {
+    // test value for solution and maximum number of iterations
+    constexpr double TEST = 1.0e-13;
+    constexpr int NITMAX = 25;
+
+    double psi[LANES], dt[LANES], w[LANES], tol[LANES], f[LANES], plast[LANES];
+    double s0[LANES], s1[LANES], s2[LANES], s3[LANES], r[LANES];
+    double psj[LANES], psj2[LANES], beta[LANES];
+    int nhalf[LANES];
+    bool active[LANES];
+
+    for (int l = 0; l < count; l++) {
+        // approximately update the universal eccentric anomaly
+        psi[l] = psi_io[l] + (date - t[l]) * GCON / r0[l];
+
+        // time from reference epoch to date (in canonical days: a canonical day is 58.1324409... days, defined as
+        // 1/GCON)
+        dt[l] = (date - t0[l]) * GCON;
+
+        w[l] = 1.0;
+        tol[l] = 0.0;
+        f[l] = 0.0;
+        plast[l] = 0.0;
+        s0[l] = s1[l] = s2[l] = s3[l] = r[l] = 0.0;
+        status[l] = OES_OK;
+        active[l] = true;
+    }
+
+    // refine the universal eccentric anomaly, psi
+    for (int nit = 1; ; nit++) {
+        bool any_active = false;
+        for (int l = 0; l < count; l++) {
+            active[l] = active[l] && std::fabs(w[l]) >= tol[l];
+            any_active = any_active || active[l];
+        }
+        if (!any_active) {
+            break;
+        }
+
+        // form half angles until beta is small enough
+        for (int l = 0; l < count; l++) {
+            psj[l] = psi[l];
+            psj2[l] = psj[l] * psj[l];
+            beta[l] = alpha[l] * psj2[l];
+            nhalf[l] = 0;
+        }
+        for (bool halving = true; halving; ) {
+            halving = false;
+            for (int l = 0; l < count; l++) {
+                const bool h = active[l] && std::fabs(beta[l]) > 0.7;
+                beta[l] = h? beta[l] / 4.0: beta[l];
+                psj[l] = h? psj[l] / 2.0: psj[l];
+                psj2[l] = h? psj2[l] / 4.0: psj2[l];
+                nhalf[l] += h;
+                halving = halving || h;
+            }
+        }
+
+        // calculate universal variables s0, s1, s2, s3 by nested series
+        double ns0[LANES], ns1[LANES], ns2[LANES], ns3[LANES];
+        for (int l = 0; l < count; l++) {
+            const double b = beta[l];
+            ns3[l] = psj[l] * psj2[l] * ((((((b / 210.0 + 1.0)
+                * b / 156.0 + 1.0)
+                * b / 110.0 + 1.0)
+                * b / 72.0 + 1.0)
+                * b / 42.0 + 1.0)
+                * b / 20.0 + 1.0) / 6.0;
+            ns2[l] = psj2[l] * ((((((b / 182.0 + 1.0)
+                * b / 132.0 + 1.0)
+                * b / 90.0 + 1.0)
+                * b / 56.0 + 1.0)
+                * b / 30.0 + 1.0)
+                * b / 12.0 + 1.0) / 2.0;
+            ns1[l] = psj[l] + alpha[l] * ns3[l];
+            ns0[l] = 1.0 + alpha[l] * ns2[l];
+            tol[l] = active[l]? TEST: tol[l];
+        }
+
+        // undo the angle-halving
+        for (bool undoing = true; undoing; ) {
+            undoing = false;
+            for (int l = 0; l < count; l++) {
+                const bool h = nhalf[l] > 0;
+                ns3[l] = h? 2.0 * (ns0[l] * ns3[l] + psj[l] * ns2[l]): ns3[l];
+                ns2[l] = h? 2.0 * ns1[l] * ns1[l]: ns2[l];
+                ns1[l] = h? 2.0 * ns0[l] * ns1[l]: ns1[l];
+                ns0[l] = h? 2.0 * ns0[l] * ns0[l] - 1.0: ns0[l];
+                psj[l] = h? psj[l] + psj[l]: psj[l];
+                tol[l] = h? tol[l] + tol[l]: tol[l];
+                nhalf[l] -= h;
+                undoing = undoing || h;
+            }
+        }
+
+        // masked update: every lane computes the step, and only active lanes keep its results
+        for (int l = 0; l < count; l++) {
+            const bool a = active[l];
+            s0[l] = a? ns0[l]: s0[l];
+            s1[l] = a? ns1[l]: s1[l];
+            s2[l] = a? ns2[l]: s2[l];
+            s3[l] = a? ns3[l]: s3[l];
+
+            // values of F and F' corresponding to the current value of psi
+            const double ff = r0[l] * ns1[l] + sigma0[l] * ns2[l] + cm[l] * ns3[l] - dt[l];
+            const double rr = r0[l] * ns0[l] + sigma0[l] * ns1[l] + cm[l] * ns2[l];
+            r[l] = a? rr: r[l];
+
+            // if first iteration, use a dummy "last F"
+            const double f_last = nit == 1? ff: f[l];
+
+            // on sign change, get psi adjustment using secant method, otherwise use Newton-Raphson method; the
+            // discarded alternative may divide by zero, which is harmless
+            const bool secant = ff * f_last < 0.0;
+            const bool zero_radius = a && !secant && rr == 0.0;
+            const double ww = secant? ff * (plast[l] - psi[l]) / (f_last - ff): ff / rr;
+
+            // save the last psi and F values, and apply the adjustment to psi
+            const bool update = a && !zero_radius;
+            w[l] = update? ww: w[l];
+            plast[l] = update? psi[l]: plast[l];
+            f[l] = update? ff: f[l];
+            psi[l] = update? psi[l] - ww: psi[l];
+
+            // next iteration, unless failed or too many already
+            const bool exhausted = update && nit > NITMAX;
+            status[l] = zero_radius? OES_ZERO_RADIUS: (exhausted? OES_NO_CONVERGENCE: status[l]);
+            active[l] = update && !exhausted;
+        }
+    }
+
+    for (int l = 0; l < count; l++) {
+        if (status[l] != OES_OK) {
+            continue;
+        }
+
+        // project the position and velocity vectors (scaling velocity to AU/s)
+        const double ww = cm[l] * s2[l];
+        const double ff = 1.0 - ww / r0[l];
+        const double g = dt[l] - cm[l] * s3[l];
+        const double fd = -cm[l] * s1[l] / (r0[l] * r[l]);
+        const double gd = 1.0 - ww / r[l];
+        pv[l].set_x(p0[0][l] * ff + v0[0][l] * g);
+        pv[l].set_y(p0[1][l] * ff + v0[1][l] * g);
+        pv[l].set_z(p0[2][l] * ff + v0[2][l] * g);
+        pv[l].set_dx(CD2S * (p0[0][l] * fd + v0[0][l] * gd));
+        pv[l].set_dy(CD2S * (p0[1][l] * fd + v0[1][l] * gd));
+        pv[l].set_dz(CD2S * (p0[2][l] * fd + v0[2][l] * gd));
+
+        // update the parameters to allow speedy prediction of psi next time
+        t[l] = date;
+        psi_io[l] = psi[l];
+    }
+}
+
+/**
+ * Heliocentric position and velocity of a planet, asteroid or comet, starting from orbital elements in the "universal
+ * variables" form.
+ *
+ * The universal elements are set up by sla::pv2ue() or sla::el2ue(); this function uses, and updates, the date of the
+ * most recent prediction and its universal eccentric anomaly stored in them, so as to speed up subsequent predictions
+ * for nearby dates.
+ *
+ * The algorithm was originally adapted from the EPHSLA program of D.H.P.Jones (private communication, 1996). The
+ * method is based on Stumpff's Universal Variables.
+ *
+ * Reference: Everhart, E. & Pitkin, E.T., Am.J.Phys. 51, 712, 1983.
+ *
+ * Original FORTRAN code by P.T. Wallace.
+ *
+ * @param date TT MJD (JD-2400000.5).
+ * @param u Universal orbital elements (updated on success).
+ * @param pv Return value: heliocentric position (AU) and velocity (AU/s), equatorial, J2000.
+ * @return Status: OES_OK, OES_ZERO_RADIUS, or OES_NO_CONVERGENCE; in the latter two cases, `u` and `pv` are not
+ *   changed.
+ */
+OEStatus ue2pv(double date, UniversalElements& u, VectorPV<double>& pv) {
+    const double* const p0[3] = {&u.ue_p0[0], &u.ue_p0[1], &u.ue_p0[2]};
+    const double* const v0[3] = {&u.ue_v0[0], &u.ue_v0[1], &u.ue_v0[2]};
+    OEStatus status;
+    ue2pv_lanes(1, date, &u.ue_mass, &u.ue_alpha, &u.ue_t0, p0, v0, &u.ue_r0, &u.ue_sigma0,
+        &u.ue_t, &u.ue_psi, &pv, &status);
+    return status;
+}
+
+/**
+ * Sets new number of bodies; elements of bodies that are kept are preserved.
+ *
+ * @param n New number of bodies.
+ */
+void UniversalElementsArray::resize(int n) {
+    for (auto* v: {&uea_mass, &uea_alpha, &uea_t0, &uea_p0[0], &uea_p0[1], &uea_p0[2], &uea_v0[0], &uea_v0[1],
+        &uea_v0[2], &uea_r0, &uea_sigma0, &uea_t, &uea_psi}) {
+        v->resize(n);
+    }
+}
+
+/**
+ * Stores universal elements of a body.
+ *
+ * @param i Index of the body, [0..size()).
+ * @param u Universal elements, as set up by sla::pv2ue() or sla::el2ue().
+ */
+void UniversalElementsArray::set(int i, const UniversalElements& u) {
+    assert(i >= 0 && i < size());
+    uea_mass[i] = u.ue_mass;
+    uea_alpha[i] = u.ue_alpha;
+    uea_t0[i] = u.ue_t0;
+    for (int j = 0; j < 3; j++) {
+        uea_p0[j][i] = u.ue_p0[j];
+        uea_v0[j][i] = u.ue_v0[j];
+    }
+    uea_r0[i] = u.ue_r0;
+    uea_sigma0[i] = u.ue_sigma0;
+    uea_t[i] = u.ue_t;
+    uea_psi[i] = u.ue_psi;
+}
+
+/**
+ * Retrieves universal elements of a body, including the date of the most recent prediction and its universal
+ * eccentric anomaly.
+ *
+ * @param i Index of the body, [0..size()).
+ * @param u Return value: universal elements.
+ */
+void UniversalElementsArray::get(int i, UniversalElements& u) const {
+    assert(i >= 0 && i < size());
+    u.ue_mass = uea_mass[i];
+    u.ue_alpha = uea_alpha[i];
+    u.ue_t0 = uea_t0[i];
+    for (int j = 0; j < 3; j++) {
+        u.ue_p0[j] = uea_p0[j][i];
+        u.ue_v0[j] = uea_v0[j][i];
+    }
+    u.ue_r0 = uea_r0[i];
+    u.ue_sigma0 = uea_sigma0[i];
+    u.ue_t = uea_t[i];
+    u.ue_psi = uea_psi[i];
+}
+
+/**
+ * Heliocentric positions and velocities of many bodies at the same date, starting from their universal elements.
+ *
+ * Results are identical to those of calling sla::ue2pv() for each body. Each thread runs the universal-variable
+ * iteration for groups of bodies in lockstep, in branch-free loops over bodies that compilers can vectorize, and masks
+ * out bodies that have already converged.
+ *
+ * The library has no thread pool: bodies are distributed among threads by sla::parallel_for() (see `parallel.h`),
+ * which starts its threads on each call and joins them before returning. With at least 256 bodies per thread, the
+ * cost of starting threads is small next to the iteration itself; callers that propagate few bodies at many dates
+ * should pass `nthreads` = 1.
+ *
+ * @param date TT MJD (JD-2400000.5).
+ * @param elements Universal orbital elements of the bodies (updated for the bodies that succeed).
+ * @param pv Return value: heliocentric positions (AU) and velocities (AU/s), equatorial, J2000; `elements.size()`
+ *   entries. Entries of bodies that failed are not changed.
+ * @param status Return value: status of each body (see sla::ue2pv()); `elements.size()` entries.
+ * @param nthreads Maximum number of threads to use; zero or negative means "one per hardware thread".
+ */
+void ue2pv_batch(double date, UniversalElementsArray& elements, VectorPV<double>* pv, OEStatus* status,
+    int nthreads) {
+    UniversalElementsArray& u = elements;
+    parallel_for(u.size(), nthreads, [&](int first, int last) {
+        for (int base = first; base < last; base += LANES) {
+            const int count = std::min(LANES, last - base);
+            const double* const p0[3] = {&u.uea_p0[0][base], &u.uea_p0[1][base], &u.uea_p0[2][base]};
+            const double* const v0[3] = {&u.uea_v0[0][base], &u.uea_v0[1][base], &u.uea_v0[2][base]};
+            ue2pv_lanes(count, date, &u.uea_mass[base], &u.uea_alpha[base], &u.uea_t0[base], p0, v0,
+                &u.uea_r0[base], &u.uea_sigma0[base], &u.uea_t[base], &u.uea_psi[base], pv + base, status + base);
+        }
+    }, 256);
+}
+
+/**
+ * Version of sla::ue2pv_batch() that stores results through strided spans of `elements.size()` items (see
+ * sla::StridedSpan); the elements themselves are already held in "structure of arrays" layout.
+ */
+void ue2pv_batch(double date, UniversalElementsArray& elements, StridedSpan<VectorPV<double>> pv,
+    StridedSpan<OEStatus> status, int nthreads) {
+    UniversalElementsArray& u = elements;
+    const int n = u.size();
+    assert(pv.get_size() == n && status.get_size() == n);
+    parallel_for((n + SPAN_TILE - 1) / SPAN_TILE, nthreads, [&](int first_tile, int last_tile) {
+        SpanTile<VectorPV<double>> pv_tile(pv);
+        SpanTile<OEStatus> status_tile(status);
+        for (int tile_index = first_tile; tile_index < last_tile; tile_index++) {
+            const int first = tile_index * SPAN_TILE;
+            const int last = std::min(n, first + SPAN_TILE);
+            VectorPV<double>* const tile_pv = pv_tile.load(first, last - first);
+            OEStatus* const tile_status = status_tile.load(first, last - first);
+            for (int base = first; base < last; base += LANES) {
+                const int count = std::min(LANES, last - base);
+                const double* const p0[3] = {&u.uea_p0[0][base], &u.uea_p0[1][base], &u.uea_p0[2][base]};
+                const double* const v0[3] = {&u.uea_v0[0][base], &u.uea_v0[1][base], &u.uea_v0[2][base]};
+                ue2pv_lanes(count, date, &u.uea_mass[base], &u.uea_alpha[base], &u.uea_t0[base], p0, v0,
+                    &u.uea_r0[base], &u.uea_sigma0[base], &u.uea_t[base], &u.uea_psi[base],
+                    tile_pv + (base - first), tile_status + (base - first));
+            }
+            pv_tile.store(first, last - first);
+            status_tile.store(first, last - first);
+        }
+    }, 1);
+}
+
+}
@@ -0,0 +1,201 @@
+/*
+ * C++ Port of the SLALIB library.
+ * Written by Vadim Sytnikov.
+ * Copyright (C) 2021 CyberHULL, Ltd.
+ * All rights reserved.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ * GNU General Public License for more details.
+ *
+ */
+#include "slalib.h"
+#include "parallel.h"
+#include <cmath>
+
+namespace sla {
+
+// rate of change of hour angle (radians per UT1 day)
+constexpr double SIDEREAL_RATE = 6.283185307179586476925286766559 * 1.00273781191135448;
+
+/**
+ * Creates visibility solver for an observing site; refraction is ignored until sla::VisibilitySolver::set_refraction()
+ * is called.
+ *
+ * @param elong Site longitude (radians, east positive).
+ * @param phi Site latitude (radians, geodetic).
+ * @param min_elevation Minimum elevation at which target is considered to be up (radians); this is the observed
+ *   elevation, i.e. affected by refraction if refraction is enabled.
+ * @param max_airmass Maximum air mass (as calculated by sla::airmas()) at which target is still observable; values
+ *   exceeding air mass at 87 degrees zenith distance effectively disable the air mass limit.
+ */
+VisibilitySolver::VisibilitySolver(double elong, double phi, double min_elevation, double max_airmass) {
+    vs_elong = elong;
+    vs_sin_phi = std::sin(phi);
+    vs_cos_phi = std::cos(phi);
+    vs_min_el = min_elevation;
+    vs_max_am = max_airmass;
+    vs_refa = 0.0;
+    vs_refb = 0.0;
+    setup();
+}
+
+/**
+ * Enables refraction: elevation and air mass limits will be treated as observed values, and converted to in vacuo
+ * altitudes by inverting sla::refz() model.
+ *
+ * @param refa Tan Z coefficient (radians), as returned by sla::refco() or sla::refcoq().
+ * @param refb Tan**3 Z coefficient (radians), as returned by sla::refco() or sla::refcoq().
+ */
+void VisibilitySolver::set_refraction(double refa, double refb) {
+    vs_refa = refa;
+    vs_refb = refb;
+    setup();
+}
+
+/// Converts limits into sines of in vacuo altitudes; this is done once, so it does not matter how fast it is.
+void VisibilitySolver::setup() {
+    constexpr double PI_2 = 1.5707963267948966192313216916398;
+
+    // in vacuo ZD for given observed ZD: sla::refz() is close to identity, so simple iteration converges quickly
+    auto unrefract = [this] (double zobs) -> double {
+        double zu = zobs;
+        if (vs_refa != 0.0 || vs_refb != 0.0) {
+            for (int i = 0; i < 4; i++) {
+                zu += zobs - refz(zu, vs_refa, vs_refb);
+            }
+        }
+        return zu;
+    };
+    vs_sin_el = std::cos(unrefract(PI_2 - vs_min_el));
+
+    // observed ZD for given air mass
+    const double z_am = airmas_zd(vs_max_am);
+    vs_sin_am = z_am < PI_2? std::cos(unrefract(z_am)): -1.0;
+}
+
+/**
+ * Finds the date closest to the given one at which target has the requested hour angle.
+ *
+ * @param date Initial estimate (UT1 MJD).
+ * @param ra Right ascension of the target (radians).
+ * @param ha Requested hour angle (radians).
+ * @return Refined date (UT1 MJD).
+ */
+double VisibilitySolver::polish(double date, double ra, double ha) const {
+    // hour angle is very nearly linear in time, so Newton iterations converge to ~1e-11 days in two steps
+    for (int i = 0; i < 3; i++) {
+        date -= drange(gmst(date) + vs_elong - ra - ha) / SIDEREAL_RATE;
+    }
+    return date;
+}
+
+/**
+ * Calculates hour angle at which target crosses given altitude.
+ *
+ * @param sin_dec Sine of the target declination.
+ * @param cos_dec Cosine of the target declination.
+ * @param sin_alt Sine of the in vacuo altitude.
+ * @param ha Return value: hour angle of setting (radians, range: [0..pi]); only set if VIS_RISES_SETS is returned.
+ * @return Crossing status.
+ */
+VISStatus VisibilitySolver::half_arc(double sin_dec, double cos_dec, double sin_alt, double& ha) const {
+    const double num = sin_alt - vs_sin_phi * sin_dec;
+    const double den = vs_cos_phi * cos_dec;
+    if (num <= -den) {
+        return VIS_ALWAYS_UP;
+    }
+    if (num >= den) {
+        return VIS_NEVER_UP;
+    }
+    ha = std::acos(num / den);
+    return VIS_RISES_SETS;
+}
+
+/**
+ * Calculates transit, rise, and set times, as well as observable window within given time interval for a single
+ * target.
+ *
+ * Transit is the upper transit nearest to the middle of the interval, and rising and setting times are those
+ * immediately preceding and following it; they may lie outside of the interval. The observable window, on the other
+ * hand, is always within the interval; if the interval is long enough to contain more than one window (e.g. target
+ * sets after the start of the night and rises again before its end), the longest one is reported.
+ *
+ * @param start Start of the time interval (UT1 MJD).
+ * @param end End of the time interval (UT1 MJD); must not precede `start` and be less than a day after it.
+ * @param dir Target's apparent (or, with lower accuracy, mean) right ascension and declination (radians).
+ * @param vis Return value: target visibility.
+ */
+void VisibilitySolver::solve(double start, double end, const Spherical<double>& dir, Visibility& vis) const {
+    constexpr double SIDEREAL_DAY = 6.283185307179586476925286766559 / SIDEREAL_RATE;
+    const double ra = dir.get_ra();
+    const double sin_dec = std::sin(dir.get_dec());
+    const double cos_dec = std::cos(dir.get_dec());
+
+    // transit, rising and setting times for an altitude
+    const double transit = polish(0.5 * (start + end), ra, 0.0);
+    auto crossings = [&] (double sin_alt, double& rise, double& set) -> VISStatus {
+        double ha;
+        const VISStatus result = half_arc(sin_dec, cos_dec, sin_alt, ha);
+        if (result == VIS_RISES_SETS) {
+            rise = polish(transit - ha / SIDEREAL_RATE, ra, -ha);
+            set = polish(transit + ha / SIDEREAL_RATE, ra, ha);
+        } else {
+            rise = transit;
+            set = transit;
+        }
+        return result;
+    };
+    vis.v_transit = transit;
+    vis.v_status = crossings(vs_sin_el, vis.v_rise, vis.v_set);
+    vis.v_am_status = crossings(vs_sin_am, vis.v_am_rise, vis.v_am_set);
+
+    // window satisfying both limits: whichever of them is stricter
+    const bool el_stricter = vs_sin_el >= vs_sin_am;
+    const VISStatus status = el_stricter? vis.v_status: vis.v_am_status;
+    vis.v_visible = false;
+    vis.v_start = vis.v_end = start;
+    if (status == VIS_ALWAYS_UP) {
+        vis.v_visible = true;
+        vis.v_end = end;
+    } else if (status == VIS_RISES_SETS) {
+        const double rise = el_stricter? vis.v_rise: vis.v_am_rise;
+        const double set = el_stricter? vis.v_set: vis.v_am_set;
+        for (int k = -1; k <= 1; k++) {
+            const double w_start = std::max(start, rise + k * SIDEREAL_DAY);
+            const double w_end = std::min(end, set + k * SIDEREAL_DAY);
+            if (w_start <= w_end && (!vis.v_visible || w_end - w_start > vis.v_end - vis.v_start)) {
+                vis.v_visible = true;
+                vis.v_start = w_start;
+                vis.v_end = w_end;
+            }
+        }
+    }
+}
+
+/**
+ * Calculates visibility of many targets within the same time interval, in parallel.
+ *
+ * @param start Start of the time interval (UT1 MJD).
+ * @param end End of the time interval (UT1 MJD).
+ * @param n Number of targets.
+ * @param dirs Targets' right ascensions and declinations (radians).
+ * @param vis Return value: array of `n` elements receiving targets' visibility.
+ * @param nthreads Maximum number of threads to use; zero means "one per hardware thread".
+ */
+void VisibilitySolver::solve(double start, double end, int n, const Spherical<double>* dirs, Visibility* vis,
+    int nthreads) const {
+    parallel_for(n, nthreads, [&] (int begin, int end_index) {
+        for (int i = begin; i < end_index; i++) {
+            solve(start, end, dirs[i], vis[i]);
+        }
+    });
+}
+
+}
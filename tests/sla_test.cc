@@ -15,12 +15,14 @@
  * GNU General Public License for more details.
  *
  */
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <cmath>
 
 #include "sla_test.h"
 #include "../src/slalib.h"
+#include "../src/slalib_c.h"
 
 namespace sla {
 
@@ -69,6 +71,40 @@ static void vvd(const double val, const double val_ok, const double tolerance,
     }
 }
 
+// number of stars provided by test_star()
+constexpr int N_TEST_STARS = 9;
+
+// catalogue entry of the `i`-th star of batch tests: the first five stars are spread over the sky, the others are edge
+// cases (the north and south poles, and RAs just either side of the 0/2pi wrap-around); parallaxes include zero
+static void test_star(int i, double& ra, double& dec, double& pmra, double& pmdec, double& px, double& rv) {
+    constexpr double PI_2 = 1.5707963267948966192313216916398;
+    constexpr double PI2 = 6.283185307179586476925286766559;
+    constexpr double EDGES[N_TEST_STARS - 5][2] = {{1.0, PI_2}, {4.0, -PI_2}, {PI2 - 1.0e-9, 0.4}, {-1.0e-9, -0.4}};
+    assert(i >= 0 && i < N_TEST_STARS);
+    ra = i < 5? 0.3 + 1.2 * i: EDGES[i - 5][0];
+    dec = i < 5? -1.2 + 0.6 * i: EDGES[i - 5][1];
+    pmra = 1.0e-6 * (i - 2);
+    pmdec = -3.0e-7 * i;
+    px = 0.1 * (i % 5);
+    rv = -15.0 + 10.0 * (i % 5);
+}
+
+// position of the `i`-th star of batch tests (see the other overload)
+static void test_star(int i, double& ra, double& dec) {
+    double pmra, pmdec, px, rv;
+    test_star(i, ra, dec, pmra, pmdec, px, rv);
+}
+
+// orbital elements of the `i`-th body of batch tests, with epochs a week apart from `epoch`: every third body is a
+// comet, with orbits that are in turn elliptical, near-parabolic (elliptical), parabolic, near-parabolic (hyperbolic),
+// circular, and hyperbolic; other bodies are minor planets
+static OrbitalElements test_body(int i, double epoch) {
+    constexpr double COMET_E[] = {0.5, 1.0 - 1.0e-9, 1.0, 1.0 + 1.0e-9, 0.0, 1.5};
+    const bool comet = i % 3 == 0;
+    return {comet? OEF_COMET: OEF_MINOR_PLANET, epoch + 7.0 * i, 0.05 * i, 0.3 * i, 1.1 + 0.2 * i,
+        comet? 0.9 + 0.05 * i: 1.0 + 0.3 * i, comet? COMET_E[i / 3 % 6]: 0.03 * i, 0.4 * i, 0.0};
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // INDIVIDUAL FUNCTION TESTS
 ///////////////////////////////////////////////////////////////////////////////
@@ -78,6 +114,135 @@ static void t_airmas(bool& status) {
     vvd(airmas(1.2354), 3.015698990074724, 1e-12, "sla::airmas", "", status);
 }
 
+// tests sla::aop(), sla::aoppa(), sla::aoppat(), sla::aopqk(), sla::oap(), sla::oapqk(), and sla::oapqk_batch()
+// functions
+static void t_aop(bool& status) {
+    constexpr double DD2R = 0.017453292519943295769236907;
+    constexpr double DAS2R = 4.848136811095359935899141e-6;
+    constexpr double DS2R = 7.272205216643039903848712e-5;
+    constexpr double dap = -0.1234;
+    constexpr double dut = 25.0;
+    constexpr double elongm = 2.1;
+    constexpr double phim = 0.5;
+    constexpr double hm = 3000.0;
+    constexpr double xp = -0.5e-6;
+    constexpr double yp = 1.0e-6;
+    constexpr double tdk = 280.0;
+    constexpr double pmb = 550.0;
+    constexpr double rh = 0.6;
+    constexpr double tlr = 0.006;
+    double date = 51000.1;
+    double rap = 2.7;
+    double wl = 0.45;
+    double aob, zob, hob, dob, rob;
+
+    aop(rap, dap, date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, aob, zob, hob, dob, rob);
+    vvd(aob, 1.812817787123283034, 1.0e-10, "sla::aop", "lo aob", status);
+    vvd(zob, 1.393860816635714034, 1.0e-8, "sla::aop", "lo zob", status);
+    vvd(hob, -1.297808009092456683, 1.0e-8, "sla::aop", "lo hob", status);
+    vvd(dob, -0.122967060534561, 1.0e-8, "sla::aop", "lo dob", status);
+    vvd(rob, 2.699270287872084, 1.0e-8, "sla::aop", "lo rob", status);
+
+    rap = 2.345;
+    aop(rap, dap, date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, aob, zob, hob, dob, rob);
+    vvd(aob, 2.019928026670621442, 1.0e-10, "sla::aop", "aob/o", status);
+    vvd(zob, 1.101316172427482466, 1.0e-10, "sla::aop", "zob/o", status);
+    vvd(hob, -0.9432923558497740862, 1.0e-10, "sla::aop", "hob/o", status);
+    vvd(dob, -0.1232144708194224, 1.0e-10, "sla::aop", "dob/o", status);
+    vvd(rob, 2.344754634629428, 1.0e-10, "sla::aop", "rob/o", status);
+
+    wl = 1.0e6;
+    aop(rap, dap, date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, aob, zob, hob, dob, rob);
+    vvd(aob, 2.019928026670621442, 1.0e-10, "sla::aop", "aob/r", status);
+    vvd(zob, 1.101267532198003760, 1.0e-10, "sla::aop", "zob/r", status);
+    vvd(hob, -0.9432533138143315937, 1.0e-10, "sla::aop", "hob/r", status);
+    vvd(dob, -0.1231850665614878, 1.0e-10, "sla::aop", "dob/r", status);
+    vvd(rob, 2.344715592593984, 1.0e-10, "sla::aop", "rob/r", status);
+
+    date = 48000.3;
+    wl = 0.45;
+    AOParams params;
+    aoppa(date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, params);
+    vvd(params.ao_phi, 0.4999993892136306, 1.0e-12, "sla::aoppa", "1", status);
+    vvd(params.ao_sin_phi, 0.4794250025886467, 1.0e-12, "sla::aoppa", "2", status);
+    vvd(params.ao_cos_phi, 0.8775828547167932, 1.0e-12, "sla::aoppa", "3", status);
+    vvd(params.ao_diurab, 1.363180872136126e-6, 1.0e-12, "sla::aoppa", "4", status);
+    vvd(params.ao_height, 3000.0, 1.0e-10, "sla::aoppa", "5", status);
+    vvd(params.ao_tdk, 280.0, 1.0e-11, "sla::aoppa", "6", status);
+    vvd(params.ao_pmb, 550.0, 1.0e-11, "sla::aoppa", "7", status);
+    vvd(params.ao_rh, 0.6, 1.0e-13, "sla::aoppa", "8", status);
+    vvd(params.ao_wl, 0.45, 1.0e-13, "sla::aoppa", "9", status);
+    vvd(params.ao_tlr, 0.006, 1.0e-15, "sla::aoppa", "10", status);
+    vvd(params.ao_refa, 0.0001562803328459898, 1.0e-13, "sla::aoppa", "11", status);
+    vvd(params.ao_refb, -1.792293660141e-7, 1.0e-13, "sla::aoppa", "12", status);
+    vvd(params.ao_elong, 2.101874231495843, 1.0e-12, "sla::aoppa", "13", status);
+    vvd(params.ao_lst, 7.601916802079765, 1.0e-8, "sla::aoppa", "14", status);
+
+    double ra, dec;
+    oap('R', 1.6, -1.01, date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, ra, dec);
+    vvd(ra, 1.601197569844787, 1.0e-10, "sla::oap", "rr", status);
+    vvd(dec, -1.012528566544262, 1.0e-10, "sla::oap", "rd", status);
+    oap('H', -1.234, 2.34, date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, ra, dec);
+    vvd(ra, 5.693087688154886463, 1.0e-10, "sla::oap", "hr", status);
+    vvd(dec, 0.8010281167405444, 1.0e-10, "sla::oap", "hd", status);
+    oap('A', 6.1, 1.1, date, dut, elongm, phim, hm, xp, yp, tdk, pmb, rh, wl, tlr, ra, dec);
+    vvd(ra, 5.894305175192448940, 1.0e-10, "sla::oap", "ar", status);
+    vvd(dec, 1.406150707974922, 1.0e-10, "sla::oap", "ad", status);
+
+    oapqk('R', 2.1, -0.345, params, ra, dec);
+    vvd(ra, 2.10023962776202, 1.0e-10, "sla::oapqk", "rr", status);
+    vvd(dec, -0.3452428692888919, 1.0e-10, "sla::oapqk", "rd", status);
+    oapqk('H', -0.01, 1.03, params, ra, dec);
+    vvd(ra, 1.328731933634564995, 1.0e-10, "sla::oapqk", "hr", status);
+    vvd(dec, 1.030091538647746, 1.0e-10, "sla::oapqk", "hd", status);
+    oapqk('A', 4.321, 0.987, params, ra, dec);
+    vvd(ra, 0.4375507112075065923, 1.0e-10, "sla::oapqk", "ar", status);
+    vvd(dec, -0.01520898480744436, 1.0e-10, "sla::oapqk", "ad", status);
+
+    // round trip through observed place must return to the apparent place, all over the sky down to ZD 88 degrees
+    // and for all three types of observed coordinates; both fast and rigorous refraction algorithms are exercised
+    constexpr int N_PLACES = 36 * 35;
+    constexpr double ZD_LIMIT = 88.0 * DD2R;
+    double ras[N_PLACES], decs[N_PLACES];
+    double obs[3][2][N_PLACES];
+    int n = 0;
+    for (int i = 0; i < 36; i++) {
+        for (int j = -17; j <= 17; j++) {
+            const double ra0 = i * 10.0 * DD2R;
+            const double dec0 = j * 5.0 * DD2R;
+            aopqk(ra0, dec0, params, aob, zob, hob, dob, rob);
+            if (zob < ZD_LIMIT) {
+                ras[n] = ra0;
+                decs[n] = dec0;
+                obs[0][0][n] = aob;
+                obs[0][1][n] = zob;
+                obs[1][0][n] = hob;
+                obs[1][1][n] = dob;
+                obs[2][0][n] = rob;
+                obs[2][1][n] = dob;
+                n++;
+            }
+        }
+    }
+    const char types[3] = {'A', 'H', 'R'};
+    double rap_batch[N_PLACES], dap_batch[N_PLACES];
+    for (int t = 0; t < 3; t++) {
+        oapqk_batch(types[t], n, obs[t][0], obs[t][1], params, rap_batch, dap_batch);
+        double max_error = 0.0;
+        for (int i = 0; i < n; i++) {
+            oapqk(types[t], obs[t][0][i], obs[t][1][i], params, ra, dec);
+            vvd(rap_batch[i], ra, 0.0, "sla::oapqk_batch", "ra", status);
+            vvd(dap_batch[i], dec, 0.0, "sla::oapqk_batch", "dec", status);
+            max_error = std::max(max_error, dsep({ras[i], decs[i]}, {ra, dec}));
+        }
+        // complementary functions are self-consistent to better than 1 microarcsecond
+        vvd(max_error, 0.0, 1.0e-6 * DAS2R, "sla::oapqk", "round trip", status);
+    }
+
+    aoppat(date + DS2R, params);
+    vvd(params.ao_lst, 7.602374979243502, 1.0e-8, "sla::aoppat", "", status);
+}
+
 // tests sla::bear(), sla::dbear(), sla::pav(), and sla::dpav() functions
 static void t_bear(bool& status) {
     Vector<float> fv1, fv2;
@@ -521,7 +686,846 @@ static void t_ranorm(bool& status) {
     vvd(dranrm(-0.1), 6.183185307179587, 1.0e-12, "sla::dranrm", "double", status);
 }
 
-// tests sla::refro(), sla::refcoq(), sla::refco(), sla::atmdsp(), sla::dcs2c(), sla::refv(), and sla::refz() functions
+// tests batch versions of the functions sharing templated kernels with their scalar versions: sla::cs2c_batch(),
+// sla::cc2s_batch(), sla::mxv_batch(), sla::imxv_batch(), sla::range_batch(), sla::ranorm_batch(),
+// sla::s2tp_batch(), sla::tp2s_batch(), their double precision counterparts, and sla::dsep_batch()
+static void t_kernel_batch(bool& status) {
+    // odd number of points, so that both SIMD packs and the scalar tail are exercised
+    constexpr int N = 101;
+    double ra[N], dec[N], a[N], b[N], xi[N], eta[N];
+    float fra[N], fdec[N], fa[N], fb[N], fxi[N], feta[N];
+    Vector<double> dv[N], dv2[N];
+    Vector<float> fv[N], fv2[N];
+    TPPStatus tpp[N], ftpp[N];
+    for (int i = 0; i < N; i++) {
+        ra[i] = -7.0 + 0.14 * i;
+        dec[i] = -1.5 + 0.03 * ((i * 37) % N);
+        fra[i] = (float) ra[i];
+        fdec[i] = (float) dec[i];
+    }
+    Matrix<double> dm;
+    Matrix<float> fm;
+    deuler("YZY", 0.1, 0.2, -0.3, dm);
+    for (int i = 0; i < 3; i++) {
+        for (int j = 0; j < 3; j++) {
+            fm[i][j] = (float) dm[i][j];
+        }
+    }
+    const Spherical<double> dtp = {0.3, 0.2};
+    const Spherical<float> ftp = {0.3f, 0.2f};
+
+    // math functions of SIMD packs may differ from those of the C++ library by an ulp
+    dcs2c_batch(N, ra, dec, dv);
+    cs2c_batch(N, fra, fdec, fv);
+    for (int i = 0; i < N; i++) {
+        Vector<double> v;
+        dcs2c({ra[i], dec[i]}, v);
+        Vector<float> w;
+        cs2c({fra[i], fdec[i]}, w);
+        for (int j = 0; j < 3; j++) {
+            vvd(dv[i][j], v[j], 1.0e-15, "sla::dcs2c_batch", "", status);
+            vvd(fv[i][j], w[j], 1.0e-6, "sla::cs2c_batch", "", status);
+        }
+    }
+    dcc2s_batch(N, dv, a, b);
+    cc2s_batch(N, fv, fa, fb);
+    for (int i = 0; i < N; i++) {
+        Spherical<double> s;
+        dcc2s(dv[i], s);
+        vvd(a[i], s.get_longitude(), 1.0e-15, "sla::dcc2s_batch", "a", status);
+        vvd(b[i], s.get_latitude(), 1.0e-15, "sla::dcc2s_batch", "b", status);
+        Spherical<float> fs;
+        cc2s(fv[i], fs);
+        vvd(fa[i], fs.get_longitude(), 1.0e-6, "sla::cc2s_batch", "a", status);
+        vvd(fb[i], fs.get_latitude(), 1.0e-6, "sla::cc2s_batch", "b", status);
+    }
+    dmxv_batch(dm, N, dv, dv2);
+    mxv_batch(fm, N, fv, fv2);
+    for (int i = 0; i < N; i++) {
+        Vector<double> v;
+        dmxv(dm, dv[i], v);
+        Vector<float> w;
+        mxv(fm, fv[i], w);
+        for (int j = 0; j < 3; j++) {
+            vvd(dv2[i][j], v[j], 0.0, "sla::dmxv_batch", "", status);
+            vvd(fv2[i][j], w[j], 0.0, "sla::mxv_batch", "", status);
+        }
+    }
+    dimxv_batch(dm, N, dv2, dv2);
+    imxv_batch(fm, N, fv2, fv2);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < 3; j++) {
+            vvd(dv2[i][j], dv[i][j], 1.0e-15, "sla::dimxv_batch", "", status);
+            vvd(fv2[i][j], fv[i][j], 1.0e-6, "sla::imxv_batch", "", status);
+        }
+    }
+    drange_batch(N, ra, a);
+    dranrm_batch(N, ra, b);
+    range_batch(N, fra, fa);
+    ranorm_batch(N, fra, fb);
+    for (int i = 0; i < N; i++) {
+        vvd(a[i], drange(ra[i]), 0.0, "sla::drange_batch", "", status);
+        vvd(b[i], dranrm(ra[i]), 0.0, "sla::dranrm_batch", "", status);
+        vvd(fa[i], range(fra[i]), 0.0, "sla::range_batch", "", status);
+        vvd(fb[i], ranorm(fra[i]), 0.0, "sla::ranorm_batch", "", status);
+    }
+    dsep_batch(N, ra, dec, dtp, a);
+    for (int i = 0; i < N; i++) {
+        vvd(a[i], dsep({ra[i], dec[i]}, dtp), 1.0e-15, "sla::dsep_batch", "", status);
+    }
+
+    // points on both sides of the tangent plane, and its edges
+    ds2tp_batch(N, ra, dec, dtp, xi, eta, tpp);
+    s2tp_batch(N, fra, fdec, ftp, fxi, feta, ftpp);
+    for (int i = 0; i < N; i++) {
+        double x, y;
+        viv(tpp[i], ds2tp({ra[i], dec[i]}, dtp, x, y), "sla::ds2tp_batch", "status", status);
+        vvd(xi[i], x, 1.0e-13 * std::max(1.0, std::fabs(x)), "sla::ds2tp_batch", "xi", status);
+        vvd(eta[i], y, 1.0e-13 * std::max(1.0, std::fabs(y)), "sla::ds2tp_batch", "eta", status);
+        float fx, fy;
+        viv(ftpp[i], s2tp({fra[i], fdec[i]}, ftp, fx, fy), "sla::s2tp_batch", "status", status);
+        if (ftpp[i] == TPP_OK) {
+            vvd(fxi[i], fx, 1.0e-5 * std::max(1.0f, std::fabs(fx)), "sla::s2tp_batch", "xi", status);
+            vvd(feta[i], fy, 1.0e-5 * std::max(1.0f, std::fabs(fy)), "sla::s2tp_batch", "eta", status);
+        }
+    }
+    for (int i = 0; i < N; i++) {
+        xi[i] = 0.01 * (i - N / 2);
+        eta[i] = 0.007 * (N / 2 - i);
+        fxi[i] = (float) xi[i];
+        feta[i] = (float) eta[i];
+    }
+    dtp2s_batch(N, xi, eta, dtp, a, b);
+    tp2s_batch(N, fxi, feta, ftp, fa, fb);
+    for (int i = 0; i < N; i++) {
+        Spherical<double> s;
+        dtp2s(xi[i], eta[i], dtp, s);
+        vvd(a[i], s.get_ra(), 1.0e-15, "sla::dtp2s_batch", "ra", status);
+        vvd(b[i], s.get_dec(), 1.0e-15, "sla::dtp2s_batch", "dec", status);
+        Spherical<float> fs;
+        tp2s(fxi[i], feta[i], ftp, fs);
+        vvd(fa[i], fs.get_ra(), 1.0e-6, "sla::tp2s_batch", "ra", status);
+        vvd(fb[i], fs.get_dec(), 1.0e-6, "sla::tp2s_batch", "dec", status);
+    }
+}
+
+// tests sla::StridedSpan class, and batch functions accepting strided spans: sla::fk52h_batch(), sla::addet_batch(),
+// sla::dcs2c_batch(), sla::dmxv_batch(), sla::ds2tp_batch(), sla::drange_batch(), sla::planet_batch(), and
+// sla::planel_batch()
+static void t_strided_span(bool& status) {
+    // catalogue records, with fields in no particular order; there are enough of them to span several tiles
+    struct Star {
+        int st_id;
+        double st_ra, st_pmra;
+        float st_mag;
+        double st_dec, st_pmdec;
+        Vector<double> st_vec;
+        double st_xi, st_eta;
+        TPPStatus st_tpp;
+    };
+    constexpr int N = 600;
+    static Star stars[N];
+    static double ra[N], dec[N], pmra[N], pmdec[N], rh[N], dh[N], drh[N], ddh[N];
+    for (int i = 0; i < N; i++) {
+        stars[i].st_id = i;
+        stars[i].st_ra = ra[i] = 0.0105 * i;
+        stars[i].st_dec = dec[i] = 1.5 * std::sin(0.37 * i);
+        stars[i].st_pmra = pmra[i] = 1.0e-7 * (i % 17 - 8);
+        stars[i].st_pmdec = pmdec[i] = -2.0e-7 * (i % 11 - 5);
+        stars[i].st_mag = 0.0f;
+    }
+
+    // view by member pointer, and by explicit pointer and stride
+    const StridedSpan<const double> sra(stars, N, &Star::st_ra);
+    const StridedSpan<const double> sdec(&stars[0].st_dec, N, sizeof(Star));
+    viv((int) sra.get_stride(), (int) sizeof(Star), "sla::StridedSpan", "stride", status);
+    viv(sra.is_contiguous(), false, "sla::StridedSpan", "is_contiguous", status);
+    vvd(sdec[N - 1], dec[N - 1], 0.0, "sla::StridedSpan", "operator[]", status);
+
+    // inputs and outputs in records must match arrays
+    fk52h_batch(N, ra, dec, pmra, pmdec, rh, dh, drh, ddh);
+    fk52h_batch(sra, sdec, StridedSpan<const double>(stars, N, &Star::st_pmra),
+        StridedSpan<const double>(stars, N, &Star::st_pmdec), StridedSpan<double>(stars, N, &Star::st_ra),
+        StridedSpan<double>(stars, N, &Star::st_dec), StridedSpan<double>(stars, N, &Star::st_pmra),
+        StridedSpan<double>(stars, N, &Star::st_pmdec));
+    for (int i = 0; i < N; i++) {
+        vvd(stars[i].st_ra, rh[i], 0.0, "sla::fk52h_batch", "rh", status);
+        vvd(stars[i].st_dec, dh[i], 0.0, "sla::fk52h_batch", "dh", status);
+        vvd(stars[i].st_pmra, drh[i], 0.0, "sla::fk52h_batch", "drh", status);
+        vvd(stars[i].st_pmdec, ddh[i], 0.0, "sla::fk52h_batch", "ddh", status);
+    }
+
+    // in-place update of records
+    addet_batch(N, rh, dh, 1950.0, ra, dec);
+    addet_batch(sra, sdec, 1950.0, StridedSpan<double>(stars, N, &Star::st_ra),
+        StridedSpan<double>(stars, N, &Star::st_dec));
+    for (int i = 0; i < N; i++) {
+        vvd(stars[i].st_ra, ra[i], 0.0, "sla::addet_batch", "era", status);
+        vvd(stars[i].st_dec, dec[i], 0.0, "sla::addet_batch", "edec", status);
+    }
+
+    // arrays as fields
+    static Vector<double> vecs[N];
+    Matrix<double> rmat;
+    prec(2000.0, 2050.0, rmat);
+    dcs2c_batch(N, ra, dec, vecs);
+    dmxv_batch(rmat, N, vecs, vecs);
+    const StridedSpan<Vector<double>> svec(stars, N, &Star::st_vec);
+    dcs2c_batch(sra, sdec, svec);
+    dmxv_batch(rmat, svec, svec);
+    for (int i = 0; i < N; i++) {
+        for (int j = 0; j < 3; j++) {
+            vvd(stars[i].st_vec[j], vecs[i][j], 0.0, "sla::dmxv_batch", "", status);
+        }
+    }
+
+    // enumerations as fields
+    static TPPStatus tpp[N];
+    const Spherical<double> tangent = {1.0, 0.5};
+    ds2tp_batch(N, ra, dec, tangent, rh, dh, tpp);
+    ds2tp_batch(sra, sdec, tangent, StridedSpan<double>(stars, N, &Star::st_xi),
+        StridedSpan<double>(stars, N, &Star::st_eta), StridedSpan<TPPStatus>(stars, N, &Star::st_tpp));
+    for (int i = 0; i < N; i++) {
+        vvd(stars[i].st_xi, rh[i], 0.0, "sla::ds2tp_batch", "xi", status);
+        vvd(stars[i].st_eta, dh[i], 0.0, "sla::ds2tp_batch", "eta", status);
+        viv(stars[i].st_tpp, tpp[i], "sla::ds2tp_batch", "status", status);
+        viv(stars[i].st_id, i, "sla::StridedSpan", "record", status);
+    }
+
+    // contiguous spans are accessed in place
+    const StridedSpan<double> sdh(dh, N);
+    viv(sdh.is_contiguous(), true, "sla::StridedSpan", "is_contiguous", status);
+    drange_batch(N, ra, rh);
+    drange_batch(StridedSpan<const double>(ra, N), sdh);
+    for (int i = 0; i < N; i++) {
+        vvd(dh[i], rh[i], 0.0, "sla::drange_batch", "", status);
+    }
+
+    // nine results per date, in tiles bigger and smaller than those of the dates
+    constexpr int N_DATES = 300;
+    struct Epoch {
+        double ep_date;
+        int ep_flags;
+    };
+    struct PlanetState {
+        VectorPV<double> ps_pv;
+        PLStatus ps_status;
+    };
+    static Epoch epochs[N_DATES];
+    static double dates[N_DATES];
+    static VectorPV<double> ppv[9 * N_DATES], spv[9 * N_DATES];
+    static PLStatus pstatus[9 * N_DATES];
+    static PlanetState states[9 * N_DATES];
+    for (int i = 0; i < N_DATES; i++) {
+        epochs[i].ep_date = dates[i] = 40000.0 + 71.3 * i;
+    }
+    planet_batch(N_DATES, dates, ppv, pstatus);
+    const StridedSpan<const double> sdates(epochs, N_DATES, &Epoch::ep_date);
+    planet_batch(sdates, StridedSpan<VectorPV<double>>(spv, 9 * N_DATES),
+        StridedSpan<PLStatus>(states, 9 * N_DATES, &PlanetState::ps_status));
+    planet_batch(sdates, StridedSpan<VectorPV<double>>(states, 9 * N_DATES, &PlanetState::ps_pv),
+        StridedSpan<PLStatus>(states, 9 * N_DATES, &PlanetState::ps_status));
+    for (int i = 0; i < 9 * N_DATES; i++) {
+        viv(states[i].ps_status, pstatus[i], "sla::planet_batch", "status", status);
+        vvd(spv[i].get_x(), ppv[i].get_x(), 0.0, "sla::planet_batch", "x", status);
+        vvd(spv[i].get_dz(), ppv[i].get_dz(), 0.0, "sla::planet_batch", "dz", status);
+        vvd(states[i].ps_pv.get_y(), ppv[i].get_y(), 0.0, "sla::planet_batch", "y", status);
+        vvd(states[i].ps_pv.get_dx(), ppv[i].get_dx(), 0.0, "sla::planet_batch", "dx", status);
+    }
+
+    // tiles processed concurrently
+    struct Body {
+        OrbitalElements bd_elements;
+        VectorPV<double> bd_pv;
+        OEStatus bd_status;
+    };
+    static Body bodies[N];
+    static OrbitalElements els[N];
+    static OEStatus oestatus[N];
+    for (int i = 0; i < N; i++) {
+        els[i] = bodies[i].bd_elements = {OEF_MINOR_PLANET, 50500.0, 0.001 * i, 0.3, 1.1 + 0.005 * i, 0.2, 0.03, 0.4,
+            0.0};
+    }
+    planel_batch(50600.0, N, els, spv, oestatus, 1);
+    planel_batch(50600.0, StridedSpan<const OrbitalElements>(bodies, N, &Body::bd_elements),
+        StridedSpan<VectorPV<double>>(bodies, N, &Body::bd_pv), StridedSpan<OEStatus>(bodies, N, &Body::bd_status), 3);
+    for (int i = 0; i < N; i++) {
+        viv(bodies[i].bd_status, oestatus[i], "sla::planel_batch", "status", status);
+        vvd(bodies[i].bd_pv.get_z(), spv[i].get_z(), 0.0, "sla::planel_batch", "z", status);
+        vvd(bodies[i].bd_pv.get_dy(), spv[i].get_dy(), 0.0, "sla::planel_batch", "dy", status);
+    }
+
+    // batch methods of classes
+    const HorizonFrame<double> frame(-0.7);
+    frame.e2h(N, ra, dec, rh, dh);
+    frame.e2h(sra, sdec, StridedSpan<double>(stars, N, &Star::st_xi), StridedSpan<double>(stars, N, &Star::st_eta));
+    frame.zd(N, ra, dec, drh);
+    frame.pa(N, ra, dec, ddh);
+    frame.h2e(N, rh, dh, ra, dec);
+    for (int i = 0; i < N; i++) {
+        vvd(stars[i].st_xi, rh[i], 0.0, "sla::HorizonFrame::e2h", "azimuth", status);
+        vvd(stars[i].st_eta, dh[i], 0.0, "sla::HorizonFrame::e2h", "elevation", status);
+    }
+    frame.zd(sra, sdec, StridedSpan<double>(stars, N, &Star::st_xi));
+    frame.pa(sra, sdec, StridedSpan<double>(stars, N, &Star::st_eta));
+    for (int i = 0; i < N; i++) {
+        vvd(stars[i].st_xi, drh[i], 0.0, "sla::HorizonFrame::zd", "", status);
+        vvd(stars[i].st_eta, ddh[i], 0.0, "sla::HorizonFrame::pa", "", status);
+        stars[i].st_xi = rh[i];
+        stars[i].st_eta = dh[i];
+    }
+    frame.h2e(StridedSpan<const double>(stars, N, &Star::st_xi), StridedSpan<const double>(stars, N, &Star::st_eta),
+        StridedSpan<double>(stars, N, &Star::st_ra), StridedSpan<double>(stars, N, &Star::st_dec));
+    for (int i = 0; i < N; i++) {
+        vvd(stars[i].st_ra, ra[i], 0.0, "sla::HorizonFrame::h2e", "ha", status);
+        vvd(stars[i].st_dec, dec[i], 0.0, "sla::HorizonFrame::h2e", "dec", status);
+    }
+
+    struct Sample {
+        double sa_time;
+        AltazMount sa_mount;
+    };
+    static Sample samples[N];
+    static AltazMount mounts[N];
+    AltazTracker tracker({0.7, -0.7}, -0.65, 1.0e-3), span_tracker({0.7, -0.7}, -0.65, 1.0e-3);
+    tracker.track(N, mounts);
+    span_tracker.track(StridedSpan<AltazMount>(samples, N, &Sample::sa_mount));
+    vvd(span_tracker.get_ha(), tracker.get_ha(), 1.0e-12, "sla::AltazTracker::track", "ha", status);
+    for (int i = 0; i < N; i++) {
+        vvd(samples[i].sa_mount.get_azimuth(), mounts[i].get_azimuth(), 1.0e-12, "sla::AltazTracker::track",
+            "azimuth", status);
+        vvd(samples[i].sa_mount.get_pa_acceleration(), mounts[i].get_pa_acceleration(), 1.0e-12,
+            "sla::AltazTracker::track", "pa_acceleration", status);
+    }
+
+    struct EarthState {
+        VectorPV<double> es_hpv, es_bpv;
+        EEBackend es_backend;
+    };
+    static EarthState earth[N_DATES];
+    static EEBackend backends[N_DATES];
+    const EarthEphemeris ephemeris(20.0, 10.0);
+    ephemeris.get(N_DATES, dates, ppv, spv, backends);
+    ephemeris.get(sdates, StridedSpan<VectorPV<double>>(earth, N_DATES, &EarthState::es_hpv),
+        StridedSpan<VectorPV<double>>(earth, N_DATES, &EarthState::es_bpv),
+        StridedSpan<EEBackend>(earth, N_DATES, &EarthState::es_backend));
+    for (int i = 0; i < N_DATES; i++) {
+        viv(earth[i].es_backend, backends[i], "sla::EarthEphemeris::get", "backend", status);
+        vvd(earth[i].es_hpv.get_x(), ppv[i].get_x(), 0.0, "sla::EarthEphemeris::get", "hpv", status);
+        vvd(earth[i].es_bpv.get_dz(), spv[i].get_dz(), 0.0, "sla::EarthEphemeris::get", "bpv", status);
+    }
+
+    struct Place {
+        double pl_ra, pl_dec, pl_r;
+        OEStatus pl_status;
+    };
+    static Place places[N];
+    UniversalElementsArray uelements(N);
+    for (int i = 0; i < N; i++) {
+        UniversalElements u;
+        el2ue(50550.0, els[i], u);
+        uelements.set(i, u);
+    }
+    const TopocentricContext context(50600.0, -1.23, 0.456);
+    const StridedSpan<double> pra(places, N, &Place::pl_ra), pdec(places, N, &Place::pl_dec),
+        pr(places, N, &Place::pl_r);
+    const StridedSpan<OEStatus> pstatus_span(places, N, &Place::pl_status);
+    context.plante(N, els, ra, dec, rh, oestatus, 1);
+    context.plante(StridedSpan<const OrbitalElements>(bodies, N, &Body::bd_elements), pra, pdec, pr, pstatus_span, 3);
+    for (int i = 0; i < N; i++) {
+        viv(places[i].pl_status, oestatus[i], "sla::TopocentricContext::plante", "status", status);
+        vvd(places[i].pl_ra, ra[i], 0.0, "sla::TopocentricContext::plante", "ra", status);
+        vvd(places[i].pl_r, rh[i], 0.0, "sla::TopocentricContext::plante", "r", status);
+    }
+    UniversalElementsArray uelements2 = uelements;
+    UniversalElementsArray uelements3 = uelements, uelements4 = uelements;
+    ue2pv_batch(50600.0, uelements3, ppv, oestatus, 1);
+    ue2pv_batch(50600.0, uelements4, StridedSpan<VectorPV<double>>(bodies, N, &Body::bd_pv),
+        StridedSpan<OEStatus>(bodies, N, &Body::bd_status), 3);
+    for (int i = 0; i < N; i++) {
+        viv(bodies[i].bd_status, oestatus[i], "sla::ue2pv_batch", "status", status);
+        vvd(bodies[i].bd_pv.get_y(), ppv[i].get_y(), 0.0, "sla::ue2pv_batch", "y", status);
+        vvd(bodies[i].bd_pv.get_dz(), ppv[i].get_dz(), 0.0, "sla::ue2pv_batch", "dz", status);
+    }
+    context.plantu(uelements, ra, dec, rh, oestatus, 1);
+    context.plantu(uelements2, pra, pdec, pr, pstatus_span, 3);
+    for (int i = 0; i < N; i++) {
+        viv(places[i].pl_status, oestatus[i], "sla::TopocentricContext::plantu", "status", status);
+        vvd(places[i].pl_dec, dec[i], 0.0, "sla::TopocentricContext::plantu", "dec", status);
+        vvd(places[i].pl_r, rh[i], 0.0, "sla::TopocentricContext::plantu", "r", status);
+    }
+}
+
+// tests run-time dispatch: sla::cpu_isa_level(), sla::set_isa_limit(), sla::get_dispatched_kernels(), sla::isa_name()
+static void t_dispatch(bool& status) {
+    constexpr int N = 100;
+    constexpr int M = 8;
+    static double dates[N], ra[N], dec[N], rh[N], dh[N], psi[N], eps[N], eps0[N], svd_a[M * M], svd_w[M];
+    static Vector<double> bvelo[N], bpos[N], hvelo[N], hpos[N];
+    static VectorPV<double> dmoon_pv[N], planet_pv[9 * N];
+    static PLStatus planet_status[9 * N];
+    static double ref_rh[N], ref_dh[N], ref_psi[N], ref_bpos[N], ref_hvelo[N], ref_moon[N], ref_planet[N], ref_w[M];
+
+    // every variant the CPU supports must produce results identical to those of the baseline variant
+    const ISALevel cpu_level = cpu_isa_level();
+    for (int level = ISA_SSE2; level <= cpu_level; level++) {
+        set_isa_limit(ISALevel(level));
+        for (int i = 0; i < N; i++) {
+            dates[i] = 40000.0 + 401.3 * i;
+            ra[i] = 0.0628 * i;
+            dec[i] = 1.5 * std::sin(0.41 * i);
+            nutc(dates[i], psi[i], eps[i], eps0[i]);
+        }
+        evp_batch(N, dates, 2000.0, bvelo, bpos, hvelo, hpos);
+        dmoon_batch(N, dates, dmoon_pv);
+        planet_batch(N, dates, planet_pv, planet_status);
+        fk5hz_batch(N, ra, dec, 2000.0, rh, dh);
+        for (int i = 0; i < M * M; i++) {
+            svd_a[i] = std::sin(1.3 * i + 0.2) + (i % (M + 1) == 0? 2.0: 0.0);
+        }
+        double svd_v[M * M], svd_ws[M];
+        viv(svd(M, M, M, M, svd_a, svd_w, svd_v, svd_ws), 0, "sla::svd", "j", status);
+        for (int i = 0; i < N; i++) {
+            if (level == ISA_SSE2) {
+                ref_rh[i] = rh[i];
+                ref_dh[i] = dh[i];
+                ref_psi[i] = psi[i];
+                ref_bpos[i] = bpos[i][0];
+                ref_hvelo[i] = hvelo[i][2];
+                ref_moon[i] = dmoon_pv[i].get_y();
+                ref_planet[i] = planet_pv[9 * i + 4].get_dy();
+            }
+            vvd(rh[i], ref_rh[i], 0.0, "sla::fk5hz_batch", "rh", status);
+            vvd(dh[i], ref_dh[i], 0.0, "sla::fk5hz_batch", "dh", status);
+            vvd(psi[i], ref_psi[i], 0.0, "sla::nutc", "psi", status);
+            vvd(bpos[i][0], ref_bpos[i], 0.0, "sla::evp_batch", "bpos", status);
+            vvd(hvelo[i][2], ref_hvelo[i], 0.0, "sla::evp_batch", "hvelo", status);
+            vvd(dmoon_pv[i].get_y(), ref_moon[i], 0.0, "sla::dmoon_batch", "pv", status);
+            vvd(planet_pv[9 * i + 4].get_dy(), ref_planet[i], 0.0, "sla::planet_batch", "pv", status);
+        }
+        for (int i = 0; i < M; i++) {
+            if (level == ISA_SSE2) {
+                ref_w[i] = svd_w[i];
+            }
+            vvd(svd_w[i], ref_w[i], 0.0, "sla::svd", "w", status);
+        }
+
+        // all dispatched functions must report the level in effect
+        KernelISA kernels[32];
+        const int count = get_dispatched_kernels(kernels, 32);
+        viv(count >= 14 && count <= 32, true, "sla::get_dispatched_kernels", "count", status);
+        for (int i = 0; i < count && i < 32; i++) {
+            viv(kernels[i].ki_isa, level, "sla::get_dispatched_kernels", kernels[i].ki_kernel, status);
+        }
+    }
+    set_isa_limit(ISA_AVX512);
+    viv(std::strcmp(isa_name(ISA_AVX2), "avx2"), 0, "sla::isa_name", "", status);
+}
+
+// tests the flat C interface (slalib_c.h) against the C++ functions
+static void t_c_api(bool& status) {
+    constexpr int N = 50;
+    double utc[N], ra[N], dec[N], pmra[N], pmdec[N], px[N], rv[N], a[N], b[N], v[3 * N];
+    int tpp[N];
+    for (int i = 0; i < N; i++) {
+        utc[i] = 41317.0 + 397.1 * i;
+        ra[i] = 0.1253 * i;
+        dec[i] = 1.4 * std::sin(0.73 * i);
+        pmra[i] = 1.0e-7 * (i % 7 - 3);
+        pmdec[i] = -1.5e-7 * (i % 5 - 2);
+        px[i] = 0.01 * (i % 3);
+        rv[i] = 5.0 * (i % 9) - 20.0;
+    }
+
+    // time scales
+    sla_dtt_batch(N, utc, a);
+    sla_gmst_batch(N, utc, b);
+    for (int i = 0; i < N; i++) {
+        vvd(a[i], dtt(utc[i]), 0.0, "sla_dtt_batch", "", status);
+        vvd(b[i], gmst(utc[i]), 0.0, "sla_gmst_batch", "", status);
+    }
+
+    // precession: in place, and through a matrix
+    std::memcpy(a, ra, sizeof a);
+    std::memcpy(b, dec, sizeof b);
+    sla_preces_batch(SLA_CAT_FK5, 2000.0, 2050.0, N, a, b);
+    double mat[9];
+    sla_prec(2000.0, 2050.0, mat);
+    sla_dcs2c_batch(N, ra, dec, v);
+    sla_dmxv_batch(mat, N, v, v);
+    Matrix<double> rmat;
+    prec(2000.0, 2050.0, rmat);
+    for (int i = 0; i < N; i++) {
+        Spherical<double> pos = {ra[i], dec[i]};
+        preces(CAT_FK5, 2000.0, 2050.0, pos);
+        vvd(a[i], pos.get_ra(), 0.0, "sla_preces_batch", "ra", status);
+        vvd(b[i], pos.get_dec(), 0.0, "sla_preces_batch", "dec", status);
+        Vector<double> v1, v2;
+        dcs2c_batch(1, &ra[i], &dec[i], &v1);
+        dmxv(rmat, v1, v2);
+        for (int j = 0; j < 3; j++) {
+            vvd(v[3 * i + j], v2[j], 1.0e-15, "sla_dmxv_batch", "", status);
+        }
+    }
+
+    // frame changes
+    sla_eqgal_batch(N, ra, dec, a, b);
+    for (int i = 0; i < N; i++) {
+        Spherical<double> gal;
+        eqgal({ra[i], dec[i]}, gal);
+        vvd(a[i], gal.get_longitude(), 0.0, "sla_eqgal_batch", "l", status);
+        vvd(b[i], gal.get_latitude(), 0.0, "sla_eqgal_batch", "b", status);
+    }
+
+    // tangent plane
+    sla_ds2tp_batch(N, ra, dec, 0.5, 0.3, a, b, tpp);
+    for (int i = 0; i < N; i++) {
+        double xi, eta;
+        const TPPStatus j = ds2tp({ra[i], dec[i]}, {0.5, 0.3}, xi, eta);
+        viv(tpp[i], j, "sla_ds2tp_batch", "status", status);
+        viv(tpp[i] == SLA_TPP_OK, j == TPP_OK, "sla_ds2tp_batch", "SLA_TPP_OK", status);
+        if (j == TPP_OK) {
+            vvd(a[i], xi, 1.0e-15, "sla_ds2tp_batch", "xi", status);
+            vvd(b[i], eta, 1.0e-15, "sla_ds2tp_batch", "eta", status);
+        }
+    }
+    // more points than fit into one tile of statuses
+    constexpr int N_LONG = 300;
+    static double l_ra[N_LONG], l_dec[N_LONG], l_xi[N_LONG], l_eta[N_LONG];
+    static int l_tpp[N_LONG];
+    for (int i = 0; i < N_LONG; i++) {
+        l_ra[i] = i * 0.021;
+        l_dec[i] = -1.5 + i * 0.01;
+    }
+    sla_ds2tp_batch(N_LONG, l_ra, l_dec, 0.5, 0.3, l_xi, l_eta, l_tpp);
+    int nbad = 0, nok = 0;
+    for (int i = 0; i < N_LONG; i++) {
+        double xi, eta;
+        const TPPStatus j = ds2tp({l_ra[i], l_dec[i]}, {0.5, 0.3}, xi, eta);
+        const double tolerance = 1.0e-12 * (1.0 + std::fabs(xi) + std::fabs(eta));
+        nbad += l_tpp[i] != j ||
+            (j == TPP_OK && (std::fabs(l_xi[i] - xi) > tolerance || std::fabs(l_eta[i] - eta) > tolerance));
+        nok += j == TPP_OK;
+    }
+    viv(nbad, 0, "sla_ds2tp_batch", "long", status);
+    viv(nok > 0 && nok < N_LONG, true, "sla_ds2tp_batch", "long: mixed statuses", status);
+
+    // proper motion
+    sla_pm_batch(N, ra, dec, pmra, pmdec, px, rv, 2000.0, 2030.0, a, b);
+    for (int i = 0; i < N; i++) {
+        Spherical<double> dir;
+        pm({ra[i], dec[i]}, {pmra[i], pmdec[i]}, px[i], rv[i], 2000.0, 2030.0, dir);
+        vvd(a[i], dir.get_ra(), 0.0, "sla_pm_batch", "ra", status);
+        vvd(b[i], dir.get_dec(), 0.0, "sla_pm_batch", "dec", status);
+    }
+
+    // horizon coordinates, in place
+    std::memcpy(a, ra, sizeof a);
+    std::memcpy(b, dec, sizeof b);
+    sla_de2h_batch(N, a, b, -0.7, a, b);
+    sla_dh2e_batch(N, a, b, -0.7, a, b);
+    for (int i = 0; i < N; i++) {
+        double az, el;
+        de2h({ra[i], dec[i]}, -0.7, az, el);
+        Spherical<double> dir;
+        dh2e(az, el, -0.7, dir);
+        vvd(a[i], dir.get_ha(), 1.0e-12, "sla_dh2e_batch", "ha", status);
+        vvd(b[i], dir.get_dec(), 1.0e-12, "sla_dh2e_batch", "dec", status);
+    }
+    sla_zd_batch(N, ra, dec, -0.7, a);
+    sla_pa_batch(N, ra, dec, -0.7, b);
+    for (int i = 0; i < N; i++) {
+        vvd(a[i], zd({ra[i], dec[i]}, -0.7), 1.0e-12, "sla_zd_batch", "", status);
+        vvd(b[i], pa({ra[i], dec[i]}, -0.7), 1.0e-12, "sla_pa_batch", "", status);
+    }
+}
+
+// compares results of a sky index search to those of brute-force scan
+static void check_sky_search(std::vector<int>& found, const std::vector<int>& expected, const char* test,
+    bool& status) {
+    std::sort(found.begin(), found.end());
+    const bool same = found == expected;
+    viv(same, true, "sla::SkyIndex", test, status);
+}
+
+// tests sla::SkyIndex class
+static void t_sky_index(bool& status) {
+    constexpr int N = 20000;
+    constexpr int DEPTH = 8;
+    static double ra[N], dec[N];
+    static Vector<double> vecs[N];
+    for (int i = 0; i < N; i++) {
+        double unused;
+        ra[i] = 6.283185307179586 * std::modf(0.6180339887498949 * i, &unused);
+        dec[i] = std::asin(2.0 * std::modf(0.7548776662466927 * i + 0.1, &unused) - 1.0);
+        dcs2c({ra[i], dec[i]}, vecs[i]);
+    }
+
+    // cells: ids of parent cells are those of children divided by 4, and points lie within their cells
+    SkyIndex index(DEPTH);
+    for (int i = 0; i < N; i += 97) {
+        const std::uint64_t cell = index.get_cell(vecs[i]);
+        viv(cell < (8u << (2 * DEPTH)), true, "sla::SkyIndex::get_cell", "range", status);
+        viv(SkyIndex::get_cell(vecs[i], DEPTH - 1) == cell / 4, true, "sla::SkyIndex::get_cell", "parent",
+            status);
+        std::vector<SkyCellRange> ranges;
+        index.query_cone(vecs[i], 1.0e-9, ranges);
+        bool covered = false;
+        for (const SkyCellRange& range: ranges) {
+            covered = covered || (cell >= range.scr_first && cell <= range.scr_last);
+        }
+        viv(covered, true, "sla::SkyIndex::query_cone", "point", status);
+    }
+
+    // cone searches; the index is built from angles, and searched with vectors
+    index.build(N, ra, dec, 3);
+    viv(index.get_size(), N, "sla::SkyIndex::build", "size", status);
+    const double cones[][3] = {{0.3, 0.2, 0.05}, {2.0, -1.2, 0.3}, {4.5, 1.5, 0.2}, {1.0, 0.0, 2.5}, {0.0, 0.0, 4.0}};
+    for (const auto& cone: cones) {
+        Vector<double> center;
+        dcs2c({cone[0], cone[1]}, center);
+        std::vector<int> found, expected;
+        for (int i = 0; i < N; i++) {
+            if (dsepv(vecs[i], center) <= cone[2]) {
+                expected.push_back(i);
+            }
+        }
+        index.search_cone(center, cone[2], found);
+        check_sky_search(found, expected, "search_cone", status);
+    }
+
+    // polygon searches; the index is built from vectors
+    SkyIndex vindex(DEPTH);
+    vindex.build(N, vecs, 0);
+    Vector<double> quad[4];
+    dcs2c({0.5, -0.3}, quad[0]);
+    dcs2c({1.1, -0.2}, quad[1]);
+    dcs2c({1.0, 0.4}, quad[2]);
+    dcs2c({0.4, 0.35}, quad[3]);
+    std::vector<int> found, expected;
+    for (int i = 0; i < N; i++) {
+        bool inside = true;
+        for (int j = 0; j < 4; j++) {
+            Vector<double> normal;
+            dvxv(quad[j], quad[(j + 1) % 4], normal);
+            inside = inside && dvdv(normal, vecs[i]) >= 0.0;
+        }
+        if (inside) {
+            expected.push_back(i);
+        }
+    }
+    viv(vindex.search_polygon(4, quad, found), true, "sla::SkyIndex::search_polygon", "status", status);
+    check_sky_search(found, expected, "search_polygon", status);
+    viv(expected.size() > 100, true, "sla::SkyIndex::search_polygon", "count", status);
+    const Vector<double> clockwise[3] = {{1.0, 0.0, 0.0}, {0.0, 0.0, 1.0}, {0.0, 1.0, 0.0}};
+    viv(vindex.search_polygon(3, clockwise, found), false, "sla::SkyIndex::search_polygon", "clockwise", status);
+
+    // on-disk form
+    const char* path = "sla_test_skyindex.tmp";
+    viv(vindex.save(path), true, "sla::SkyIndex::save", "", status);
+    SkyIndex loaded;
+    viv(loaded.load(path), true, "sla::SkyIndex::load", "", status);
+    viv(loaded.get_depth(), DEPTH, "sla::SkyIndex::load", "depth", status);
+    viv(loaded.get_size(), N, "sla::SkyIndex::load", "size", status);
+    loaded.search_polygon(4, quad, found);
+    check_sky_search(found, expected, "load", status);
+
+    // truncated file: its point count promises more data than there is
+    std::FILE* file = std::fopen(path, "rb");
+    std::vector<char> bytes((std::size_t) N * 64);
+    const std::size_t n_bytes = file != nullptr? std::fread(bytes.data(), 1, bytes.size(), file): 0;
+    if (file != nullptr) {
+        std::fclose(file);
+    }
+    file = std::fopen(path, "wb");
+    if (file != nullptr) {
+        std::fwrite(bytes.data(), 1, n_bytes - 8, file);
+        std::fclose(file);
+    }
+    viv(loaded.load(path), false, "sla::SkyIndex::load", "truncated", status);
+    viv(loaded.get_size(), 0, "sla::SkyIndex::load", "truncated:empty", status);
+    std::remove(path);
+    viv(loaded.load(path), false, "sla::SkyIndex::load", "missing", status);
+    viv(loaded.get_size(), 0, "sla::SkyIndex::load", "empty", status);
+}
+
+// sink of sla::cross_match() that appends matches to a vector
+static void store_matches(int n, const CrossMatch* matches, void* context) {
+    auto* all = static_cast<std::vector<CrossMatch>*>(context);
+    all->insert(all->end(), matches, matches + n);
+}
+
+// tests sla::cross_match() function
+static void t_cross_match(bool& status) {
+    constexpr int NS = 2000;
+    constexpr int NR = 3000;
+    constexpr double RADIUS = 0.05;
+    static double ra[NR], dec[NR];
+    for (int i = 0; i < NR; i++) {
+        double unused;
+        ra[i] = 6.283185307179586 * std::modf(0.6180339887498949 * i, &unused);
+        dec[i] = std::asin(2.0 * std::modf(0.7548776662466927 * i + 0.1, &unused) - 1.0);
+    }
+    // sources: the first reference points, displaced
+    static Vector<double> svecs[NS], rvecs[NR];
+    for (int i = 0; i < NR; i++) {
+        dcs2c({ra[i], dec[i]}, rvecs[i]);
+    }
+    for (int i = 0; i < NS; i++) {
+        dcs2c({ra[i] + 0.01 * std::sin(1.7 * i), dec[i] + 0.01 * std::cos(2.3 * i)}, svecs[i]);
+    }
+    SkyIndex sources(5), reference(6);
+    sources.build(NS, svecs);
+    reference.build(NR, ra, dec);
+
+    // brute force: all pairs within the radius, and the nearest reference point of every source
+    std::vector<std::pair<int, int>> expected;
+    int nearest[NS], nsources = 0, ntwo = 0;
+    for (int i = 0; i < NS; i++) {
+        double best = RADIUS;
+        int count = 0;
+        nearest[i] = -1;
+        for (int j = 0; j < NR; j++) {
+            const double separation = dsepv(svecs[i], rvecs[j]);
+            if (separation <= RADIUS) {
+                expected.emplace_back(i, j);
+                count++;
+                if (separation < best || nearest[i] < 0) {
+                    best = separation;
+                    nearest[i] = j;
+                }
+            }
+        }
+        nsources += count > 0;
+        ntwo += std::min(count, 2);
+    }
+
+    // all matches within the radius, on one thread and on several
+    std::vector<CrossMatch> all, all1;
+    const std::int64_t total = cross_match(sources, reference, RADIUS, 0, store_matches, &all, 4);
+    viv((int) total, (int) expected.size(), "sla::cross_match", "all", status);
+    viv((int) all.size(), (int) expected.size(), "sla::cross_match", "all size", status);
+    cross_match(sources, reference, RADIUS, 0, store_matches, &all1, 1);
+    bool same = all.size() == all1.size();
+    for (std::size_t k = 0; same && k < all.size(); k++) {
+        same = all[k].cm_source == all1[k].cm_source && all[k].cm_reference == all1[k].cm_reference &&
+            all[k].cm_separation == all1[k].cm_separation;
+    }
+    viv(same, true, "sla::cross_match", "threads", status);
+    std::vector<std::pair<int, int>> pairs;
+    for (const CrossMatch& match: all) {
+        pairs.emplace_back(match.cm_source, match.cm_reference);
+        vvd(match.cm_separation, dsepv(svecs[match.cm_source], rvecs[match.cm_reference]), 1.0e-12,
+            "sla::cross_match", "separation", status);
+    }
+    std::sort(pairs.begin(), pairs.end());
+    viv(pairs == expected, true, "sla::cross_match", "pairs", status);
+
+    // best and two nearest matches
+    std::vector<CrossMatch> best;
+    cross_match(sources, reference, RADIUS, 1, store_matches, &best);
+    viv((int) best.size(), nsources, "sla::cross_match", "best", status);
+    for (const CrossMatch& match: best) {
+        viv(match.cm_reference, nearest[match.cm_source], "sla::cross_match", "nearest", status);
+    }
+    const std::int64_t two = cross_match(sources, reference, RADIUS, 2, nullptr, nullptr);
+    viv((int) two, ntwo, "sla::cross_match", "two", status);
+}
+
+// tests sla::hilbert_key(), sla::hilbert_key_batch(), sla::radix_sort_keys(), sla::hilbert_order(),
+// sla::gather_batch(), and sla::scatter_batch() functions
+static void t_sky_order(bool& status) {
+    constexpr int N = 200000;
+    static double ra[N], dec[N], column[N], sorted[N], restored[N];
+    static std::uint64_t keys[N];
+    static int order[N], ids[N], sorted_ids[N], restored_ids[N];
+    for (int i = 0; i < N; i++) {
+        double unused;
+        ra[i] = 6.283185307179586 * std::modf(0.6180339887498949 * i, &unused);
+        dec[i] = std::asin(2.0 * std::modf(0.7548776662466927 * i + 0.1, &unused) - 1.0);
+        column[i] = 0.5 * i;
+        ids[i] = 3 * i;
+    }
+
+    // keys, and order of directions along the curve
+    hilbert_key_batch(N, ra, dec, keys, 3);
+    for (int i = 0; i < N; i += 1009) {
+        Vector<double> vec;
+        dcs2c({ra[i], dec[i]}, vec);
+        viv(hilbert_key(vec) == keys[i], true, "sla::hilbert_key_batch", "", status);
+        viv(keys[i] < ((std::uint64_t) 6 << 56), true, "sla::hilbert_key", "range", status);
+    }
+    hilbert_order(N, ra, dec, order, 4);
+    bool ascending = true;
+    for (int i = 1; i < N; i++) {
+        ascending = ascending && keys[order[i - 1]] <= keys[order[i]];
+    }
+    viv(ascending, true, "sla::hilbert_order", "ascending", status);
+
+    // neighbours along the curve are much closer on the sky than neighbours in the original order
+    gather_batch(N, order, ra, sorted, 2);
+    gather_batch(N, order, dec, restored, 2);
+    double original_step = 0.0, sorted_step = 0.0;
+    for (int i = 1; i < N; i++) {
+        original_step += dsep({ra[i - 1], dec[i - 1]}, {ra[i], dec[i]});
+        sorted_step += dsep({sorted[i - 1], restored[i - 1]}, {sorted[i], restored[i]});
+    }
+    viv(sorted_step < 0.01 * original_step, true, "sla::hilbert_order", "locality", status);
+
+    // columns survive the round trip
+    gather_batch(N, order, column, sorted, 3);
+    scatter_batch(N, order, sorted, restored, 3);
+    gather_batch(N, order, ids, sorted_ids);
+    scatter_batch(N, order, sorted_ids, restored_ids);
+    bool same = true;
+    for (int i = 0; i < N; i++) {
+        same = same && restored[i] == column[i] && restored_ids[i] == ids[i] && sorted[i] == column[order[i]];
+    }
+    viv(same, true, "sla::scatter_batch", "", status);
+
+    // catalogue records, reordered through strided spans
+    struct Entry {
+        int en_id;
+        double en_ra, en_dec, en_column;
+        float en_mag;
+        std::uint64_t en_key;
+    };
+    static Entry entries[N], sorted_entries[N];
+    for (int i = 0; i < N; i++) {
+        entries[i] = {ids[i], ra[i], dec[i], column[i], (float) (0.001 * i), 0};
+    }
+    const StridedSpan<const double> sra(entries, N, &Entry::en_ra), sdec(entries, N, &Entry::en_dec);
+    hilbert_key_batch(sra, sdec, StridedSpan<std::uint64_t>(entries, N, &Entry::en_key), 3);
+    static int span_order[N];
+    hilbert_order(sra, sdec, span_order, 2);
+    gather_batch(span_order, StridedSpan<const double>(entries, N, &Entry::en_column),
+        StridedSpan<double>(sorted_entries, N, &Entry::en_column), 2);
+    gather_batch(span_order, StridedSpan<const int>(entries, N, &Entry::en_id),
+        StridedSpan<int>(sorted_entries, N, &Entry::en_id));
+    gather_batch(span_order, StridedSpan<const float>(entries, N, &Entry::en_mag),
+        StridedSpan<float>(sorted_entries, N, &Entry::en_mag));
+    scatter_batch(span_order, StridedSpan<const double>(sorted_entries, N, &Entry::en_column),
+        StridedSpan<double>(restored, N), 3);
+    same = std::equal(span_order, span_order + N, order);
+    for (int i = 0; i < N; i++) {
+        same = same && entries[i].en_key == keys[i] && sorted_entries[i].en_column == sorted[i] &&
+            sorted_entries[i].en_id == sorted_ids[i] && sorted_entries[i].en_mag == entries[order[i]].en_mag &&
+            restored[i] == column[i];
+    }
+    viv(same, true, "sla::gather_batch", "StridedSpan", status);
+
+    // stability of the sort, with many equal keys, compared to std::stable_sort()
+    for (int i = 0; i < N; i++) {
+        keys[i] = ((std::uint64_t) (i * 7919 % 1000) << 40) | (std::uint64_t) (i % 3);
+        ids[i] = i;
+    }
+    radix_sort_keys(N, keys, order, 4);
+    std::stable_sort(ids, ids + N, [](int i, int j) { return keys[i] < keys[j]; });
+    viv(std::equal(order, order + N, ids), true, "sla::radix_sort_keys", "", status);
+}
+
+// tests sla::refro(), sla::refro_rt(), sla::refcoq(), sla::refco(), sla::refco_rt(), sla::atmdsp(), sla::dcs2c(),
+// sla::refv(), and sla::refz() functions
 static void t_ref(bool& status) {
     double ref = refro(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006, 1.0e-9);
     vvd(ref, 0.00106715763018568, 1.0e-12, "sla::refro", "optical", status);
@@ -529,6 +1533,18 @@ static void t_ref(bool& status) {
     ref = refro(1.4, 3456.7, 280.0, 678.9, 0.9, 1000.0, -0.3, 0.006, 1.0e-9);
     vvd(ref, 0.001296416185295403, 1.0e-12, "sla::refro", "radio", status);
 
+    ref = refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006);
+    vvd(ref, 0.00106715763018568, 3.0e-9, "sla::refro_rt", "optical", status);
+
+    ref = refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 1000.0, -0.3, 0.006);
+    vvd(ref, 0.001296416185295403, 3.0e-9, "sla::refro_rt", "radio", status);
+    vvd(refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006, 63),
+        refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006, 64), 0.0, "sla::refro_rt", "odd", status);
+    vvd(refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006, -5),
+        refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006, 2), 0.0, "sla::refro_rt", "negative", status);
+    vvd(refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006, 0x7fffffff),
+        refro_rt(1.4, 3456.7, 280.0, 678.9, 0.9, 0.55, -0.3, 0.006, 16384), 0.0, "sla::refro_rt", "huge", status);
+
     double refa, refb;
     refcoq(275.9, 709.3, 0.9, 101.0, refa, refb);
     vvd(refa, 2.324736903790639e-4, 1.0e-12, "sla::refcoq", "a/r", status);
@@ -538,6 +1554,10 @@ static void t_ref(bool& status) {
     vvd(refa, 2.324673985217244e-4, 1.0e-12, "sla::refco", "a/r", status);
     vvd(refb, -2.265040682496e-7, 1.0e-15, "sla::refco", "b/r", status);
 
+    refco_rt(2111.1, 275.9, 709.3, 0.9, 101.0, -1.03, 0.0067, refa, refb);
+    vvd(refa, 2.324673985217244e-4, 2.0e-9, "sla::refco_rt", "a/r", status);
+    vvd(refb, -2.265040682496e-7, 1.0e-10, "sla::refco_rt", "b/r", status);
+
     refcoq(275.9, 709.3, 0.9, 0.77, refa, refb);
     vvd(refa, 2.007406521596588e-4, 1.0e-12, "sla::refcoq", "a", status);
     vvd(refb, -2.264210092590e-7, 1.0e-15, "sla::refcoq", "b", status);
@@ -743,7 +1763,7 @@ static void t_svd(bool& status) {
     vvd(c[3][3],  180.56719842359560, 1.0e-10, "sla::svdcov", "c33", status);
 }
 
-// tests sla::altaz() function
+// tests sla::altaz() function and sla::AltazTracker class
 static void t_altaz(bool& status) {
     AltazMount am;
     altaz({0.7, -0.7}, -0.65, am);
@@ -757,6 +1777,27 @@ static void t_altaz(bool& status) {
     vvd(am.get_pangle(), 1.707639969653937, 1.0e-12, "sla::altaz", "pangle", status);
     vvd(am.get_pa_velocity(), 0.4717832355365627, 1.0e-13, "sla::altaz", "pa_vel", status);
     vvd(am.get_pa_acceleration(), -0.2957914128185515, 1.0e-13, "sla::altaz", "pa_accel", status);
+
+    // tracker must reproduce results of the scalar function along the whole block
+    constexpr int N_SAMPLES = 1000;
+    constexpr double STEP = 0.001;
+    static AltazMount track[N_SAMPLES];
+    AltazTracker tracker({0.7, -0.7}, -0.65, STEP);
+    tracker.track(N_SAMPLES / 2, track);
+    tracker.track(N_SAMPLES / 2, track + N_SAMPLES / 2);
+    vvd(tracker.get_ha(), 0.7 + N_SAMPLES * STEP, 1.0e-12, "sla::AltazTracker", "ha", status);
+    for (int i = 0; i < N_SAMPLES; i += 111) {
+        altaz({0.7 + i * STEP, -0.7}, -0.65, am);
+        vvd(track[i].get_azimuth(), am.get_azimuth(), 1.0e-12, "sla::AltazTracker", "azimuth", status);
+        vvd(track[i].get_az_velocity(), am.get_az_velocity(), 1.0e-12, "sla::AltazTracker", "az_vel", status);
+        vvd(track[i].get_az_acceleration(), am.get_az_acceleration(), 1.0e-12, "sla::AltazTracker", "az_accel", status);
+        vvd(track[i].get_elevation(), am.get_elevation(), 1.0e-12, "sla::AltazTracker", "elevation", status);
+        vvd(track[i].get_el_velocity(), am.get_el_velocity(), 1.0e-12, "sla::AltazTracker", "el_vel", status);
+        vvd(track[i].get_el_acceleration(), am.get_el_acceleration(), 1.0e-12, "sla::AltazTracker", "el_accel", status);
+        vvd(track[i].get_pangle(), am.get_pangle(), 1.0e-12, "sla::AltazTracker", "pangle", status);
+        vvd(track[i].get_pa_velocity(), am.get_pa_velocity(), 1.0e-12, "sla::AltazTracker", "pa_vel", status);
+        vvd(track[i].get_pa_acceleration(), am.get_pa_acceleration(), 1.0e-12, "sla::AltazTracker", "pa_accel", status);
+    }
 }
 
 // tests sla::nut(), sla::nutc(), and sla::nutc80() functions
@@ -879,6 +1920,203 @@ static void t_pa(bool& status) {
     vvd(pa({0.0, 0.789}, 0.789), 0.0, 0.0, "sla::pa", "zenith", status);
 }
 
+// tests sla::HorizonFrame class against sla::e2h(), sla::de2h(), sla::dh2e(), sla::zd(), and sla::pa() functions
+static void t_hframe(bool& status) {
+    constexpr int N_TARGETS = 5;
+    const double phi = -0.7;
+    const double ha[N_TARGETS] = {-0.3, -1.567, 0.0, 2.5, 3.1};
+    const double dec[N_TARGETS] = {-1.1, 1.5123, -0.7, 0.3, -0.2};
+    double azimuth[N_TARGETS], elevation[N_TARGETS], d_ha[N_TARGETS], d_dec[N_TARGETS];
+    double d_zd[N_TARGETS], d_pa[N_TARGETS];
+
+    const HorizonFrame<double> d_frame(phi);
+    d_frame.e2h(N_TARGETS, ha, dec, azimuth, elevation);
+    d_frame.h2e(N_TARGETS, azimuth, elevation, d_ha, d_dec);
+    d_frame.zd(N_TARGETS, ha, dec, d_zd);
+    d_frame.pa(N_TARGETS, ha, dec, d_pa);
+
+    float f_ha[N_TARGETS], f_dec[N_TARGETS], f_azimuth[N_TARGETS], f_elevation[N_TARGETS];
+    for (int i = 0; i < N_TARGETS; i++) {
+        f_ha[i] = (float) ha[i];
+        f_dec[i] = (float) dec[i];
+    }
+    const HorizonFrame<float> f_frame((float) phi);
+    f_frame.e2h(N_TARGETS, f_ha, f_dec, f_azimuth, f_elevation);
+
+    for (int i = 0; i < N_TARGETS; i++) {
+        double azimuth_ok, elevation_ok;
+        de2h({ha[i], dec[i]}, phi, azimuth_ok, elevation_ok);
+        vvd(azimuth[i], azimuth_ok, 1.0e-12, "sla::HorizonFrame::e2h", "d:azimuth", status);
+        vvd(elevation[i], elevation_ok, 1.0e-12, "sla::HorizonFrame::e2h", "d:elevation", status);
+        vvd(f_azimuth[i], azimuth_ok, 1.0e-5, "sla::HorizonFrame::e2h", "f:azimuth", status);
+        vvd(f_elevation[i], elevation_ok, 1.0e-5, "sla::HorizonFrame::e2h", "f:elevation", status);
+
+        Spherical<double> dir;
+        dh2e(azimuth[i], elevation[i], phi, dir);
+        vvd(d_ha[i], dir.get_ha(), 1.0e-12, "sla::HorizonFrame::h2e", "ha", status);
+        vvd(d_dec[i], dir.get_dec(), 1.0e-12, "sla::HorizonFrame::h2e", "dec", status);
+
+        vvd(d_zd[i], zd({ha[i], dec[i]}, phi), 1.0e-12, "sla::HorizonFrame::zd", "", status);
+        vvd(d_pa[i], pa({ha[i], dec[i]}, phi), 1.0e-12, "sla::HorizonFrame::pa", "", status);
+    }
+
+    // a grid covering all quadrants, the zenith, and the meridian, wide enough to fill whole packs
+    constexpr int N_GRID = 13 * 7;
+    double g_ha[N_GRID], g_dec[N_GRID], g_azimuth[N_GRID], g_elevation[N_GRID];
+    double g_zd[N_GRID], g_pa[N_GRID];
+    float fg_ha[N_GRID], fg_dec[N_GRID], fg_zd[N_GRID], fg_pa[N_GRID];
+    for (int i = 0; i < N_GRID; i++) {
+        g_ha[i] = (i % 13 - 6) * 0.5;
+        g_dec[i] = i / 13 == 0? phi: (i / 13 - 3) * 0.5;
+        fg_ha[i] = (float) g_ha[i];
+        fg_dec[i] = (float) g_dec[i];
+    }
+    d_frame.e2h(N_GRID, g_ha, g_dec, g_azimuth, g_elevation);
+    d_frame.zd(N_GRID, g_ha, g_dec, g_zd);
+    d_frame.pa(N_GRID, g_ha, g_dec, g_pa);
+    f_frame.zd(N_GRID, fg_ha, fg_dec, fg_zd);
+    f_frame.pa(N_GRID, fg_ha, fg_dec, fg_pa);
+    for (int i = 0; i < N_GRID; i++) {
+        double azimuth_ok, elevation_ok;
+        de2h({g_ha[i], g_dec[i]}, phi, azimuth_ok, elevation_ok);
+        vvd(g_azimuth[i], azimuth_ok, 1.0e-12, "sla::HorizonFrame::e2h", "grid:azimuth", status);
+        vvd(g_elevation[i], elevation_ok, 1.0e-12, "sla::HorizonFrame::e2h", "grid:elevation", status);
+        vvd(g_zd[i], zd({g_ha[i], g_dec[i]}, phi), 1.0e-12, "sla::HorizonFrame::zd", "grid", status);
+        vvd(g_pa[i], pa({g_ha[i], g_dec[i]}, phi), 1.0e-12, "sla::HorizonFrame::pa", "grid", status);
+        vvd(fg_zd[i], zd({g_ha[i], g_dec[i]}, phi), 1.0e-5, "sla::HorizonFrame::zd", "f:grid", status);
+        vvd(fg_pa[i], pa({g_ha[i], g_dec[i]}, phi), 1.0e-5, "sla::HorizonFrame::pa", "f:grid", status);
+    }
+}
+
+// tests sla::VisibilitySolver class against sla::gmst(), sla::de2h(), sla::airmas(), and sla::refz() functions
+static void t_visib(bool& status) {
+    constexpr double ELONG = -2.713545757918895;
+    constexpr double PHI = 0.3460280563536619;
+    constexpr double MIN_EL = 0.3;
+    constexpr double MAX_AM = 1.5;
+    constexpr double START = 60000.2;
+    constexpr double END = 60000.7;
+    constexpr double PI_2 = 1.5707963267948966192313216916398;
+    constexpr int N_TARGETS = 4;
+    const Spherical<double> dirs[N_TARGETS] = {{1.0, 0.2}, {4.0, -0.5}, {2.5, -1.2}, {0.5, 1.55}};
+    Visibility vis[N_TARGETS];
+
+    // elevation and zenith distance of a target at given date
+    auto elevation = [&] (const Spherical<double>& dir, double date) -> double {
+        double azimuth, el;
+        de2h({gmst(date) + ELONG - dir.get_ra(), dir.get_dec()}, PHI, azimuth, el);
+        return el;
+    };
+
+    VisibilitySolver solver(ELONG, PHI, MIN_EL, MAX_AM);
+    solver.solve(START, END, N_TARGETS, dirs, vis);
+    vvd(elevation(dirs[0], vis[0].v_rise), MIN_EL, 1.0e-9, "sla::VisibilitySolver", "rise", status);
+    vvd(elevation(dirs[0], vis[0].v_set), MIN_EL, 1.0e-9, "sla::VisibilitySolver", "set", status);
+    vvd(airmas(PI_2 - elevation(dirs[0], vis[0].v_am_rise)), MAX_AM, 1.0e-9,
+        "sla::VisibilitySolver", "am_rise", status);
+    vvd(airmas(PI_2 - elevation(dirs[0], vis[0].v_am_set)), MAX_AM, 1.0e-9,
+        "sla::VisibilitySolver", "am_set", status);
+    vvd(drange(gmst(vis[0].v_transit) + ELONG - dirs[0].get_ra()), 0.0, 1.0e-10,
+        "sla::VisibilitySolver", "transit", status);
+    viv(vis[0].v_status, VIS_RISES_SETS, "sla::VisibilitySolver", "status", status);
+    viv(vis[0].v_visible, true, "sla::VisibilitySolver", "visible", status);
+    vvd(vis[0].v_start, std::max(START, vis[0].v_am_rise), 1.0e-12, "sla::VisibilitySolver", "start", status);
+    vvd(vis[0].v_end, std::min(END, vis[0].v_am_set), 1.0e-12, "sla::VisibilitySolver", "end", status);
+    viv(vis[2].v_status, VIS_NEVER_UP, "sla::VisibilitySolver", "never up", status);
+    viv(vis[2].v_visible, false, "sla::VisibilitySolver", "invisible", status);
+    viv(vis[3].v_status, VIS_ALWAYS_UP, "sla::VisibilitySolver", "circumpolar", status);
+
+    // observable window: target must satisfy both limits inside, but not just outside of it
+    for (int i = 0; i < N_TARGETS; i++) {
+        if (vis[i].v_visible) {
+            const double mid_el = elevation(dirs[i], 0.5 * (vis[i].v_start + vis[i].v_end));
+            viv(mid_el > MIN_EL && airmas(PI_2 - mid_el) < MAX_AM, true, "sla::VisibilitySolver", "window", status);
+        }
+    }
+
+    // with refraction, limits apply to observed elevation
+    double refa, refb;
+    refco(4160.0, 275.0, 620.0, 0.3, 0.55, PHI, 0.0065, 1.0e-10, refa, refb);
+    solver.set_refraction(refa, refb);
+    solver.solve(START, END, dirs[1], vis[1]);
+    vvd(PI_2 - refz(PI_2 - elevation(dirs[1], vis[1].v_rise), refa, refb), MIN_EL, 1.0e-9,
+        "sla::VisibilitySolver", "refracted rise", status);
+}
+
+// tests sla::ScheduleEvaluator class against sla::dmoon(), sla::evp(), sla::dsep(), sla::de2h(), and sla::airmas()
+static void t_sched(bool& status) {
+    constexpr double ELONG = -2.713545757918895;
+    constexpr double PHI = 0.3460280563536619;
+    constexpr double HEIGHT = 4160.0;
+    constexpr double MIN_EL = 0.5;
+    constexpr double MAX_AM = 1.5;
+    constexpr double MIN_MOON = 0.5;
+    constexpr double MAX_SUN = -0.2;
+    constexpr double PI_2 = 1.5707963267948966192313216916398;
+    constexpr int N_NIGHTS = 3;
+    constexpr int N_STEPS = 12;
+    constexpr double INTERVAL = 1.0 / 24.0;
+    constexpr int N_TARGETS = 70;
+    const double starts[N_NIGHTS] = {60000.0, 60007.0, 60014.0};
+    Spherical<double> dirs[N_TARGETS];
+    for (int i = 0; i < N_TARGETS; i++) {
+        dirs[i] = {i * 0.09, 1.2 - i * 0.03};
+    }
+    const int row_size = ScheduleEvaluator::get_row_size(N_TARGETS);
+    static std::uint64_t bits[N_NIGHTS * N_STEPS * 2];
+    viv(row_size, 2, "sla::ScheduleEvaluator", "row size", status);
+
+    const ScheduleEvaluator evaluator(ELONG, PHI, HEIGHT, MIN_EL, MAX_AM, MIN_MOON, MAX_SUN);
+    evaluator.evaluate(N_NIGHTS, starts, N_STEPS, INTERVAL, N_TARGETS, dirs, bits);
+
+    // brute force evaluation; cells too close to limits are skipped
+    int nset = 0, nbad = 0;
+    for (int night = 0; night < N_NIGHTS; night++) {
+        Matrix<double> pmat;
+        const double tt_offset = dtt(starts[night]) / 86400.0;
+        prec(2000.0, epj(starts[night] + tt_offset + 0.5 * INTERVAL * (N_STEPS - 1)), pmat);
+        for (int step = 0; step < N_STEPS; step++) {
+            const double date = starts[night] + step * INTERVAL;
+            const double lst = gmst(date) + ELONG;
+            Vector<double> bvelo, bpos, hvelo, hpos;
+            evp(date + tt_offset, 0.0, bvelo, bpos, hvelo, hpos);
+            Spherical<double> sun;
+            dcc2s(hpos, sun);
+            double azimuth, sun_el;
+            de2h({lst - sun.get_ra() - 3.1415926535897932384626433832795, -sun.get_dec()}, PHI, azimuth, sun_el);
+            VectorPV<double> moon, observer;
+            dmoon(date + tt_offset, moon);
+            pvobs(PHI, HEIGHT, lst, observer);
+            Vector<double> mv = {
+                moon.get_x() - observer.get_x(), moon.get_y() - observer.get_y(), moon.get_z() - observer.get_z()
+            };
+            Spherical<double> moon_dir;
+            dcc2s(mv, moon_dir);
+            const std::uint64_t* row = bits + (night * N_STEPS + step) * row_size;
+            for (int i = 0; i < N_TARGETS; i++) {
+                Vector<double> v2000, vdate;
+                dcs2c(dirs[i], v2000);
+                dmxv(pmat, v2000, vdate);
+                Spherical<double> dir;
+                dcc2s(vdate, dir);
+                double el;
+                de2h({lst - dir.get_ra(), dir.get_dec()}, PHI, azimuth, el);
+                const double sep = dsep(dir, moon_dir);
+                const double am = airmas(PI_2 - el);
+                if (std::fabs(el - MIN_EL) < 1.0e-9 || std::fabs(am - MAX_AM) < 1.0e-9 ||
+                    std::fabs(sep - MIN_MOON) < 1.0e-9 || std::fabs(sun_el - MAX_SUN) < 1.0e-9) {
+                    continue;
+                }
+                const bool ok = el >= MIN_EL && am <= MAX_AM && sep >= MIN_MOON && sun_el <= MAX_SUN;
+                nset += ok;
+                nbad += ok != ScheduleEvaluator::is_set(row, i);
+            }
+        }
+    }
+    viv(nbad, 0, "sla::ScheduleEvaluator", "mismatches", status);
+    viv(nset > 0, true, "sla::ScheduleEvaluator", "non-trivial", status);
+}
+
 // tests sla::rcc() function
 static void t_rcc(bool& status) {
     vvd(rcc(48939.123, 0.76543, 5.0123, 5525.242, 3190.0),
@@ -906,7 +2144,7 @@ static void t_prebn(bool& status) {
     vvd(mat[2][2],  9.999881978224798e-1, 1.0e-12, "sla::prebn", "22", status);
 }
 
-// tests sla::rcc() function
+// tests sla::preces() and sla::preces_batch() functions
 static void t_preces(bool& status) {
     Spherical<double> pos = {6.28, -1.123};
     preces(CAT_FK4, 1925.0, 1950.0, pos);
@@ -918,6 +2156,23 @@ static void t_preces(bool& status) {
     preces(CAT_FK5, 2050.0, 1990.0, pos);
     vvd(pos.get_ra(), 6.282003602708382, 1.0e-12, "sla::preces", "ra", status);
     vvd(pos.get_dec(), 1.092870326188383, 1.0e-12, "sla::preces", "dec", status);
+
+    // batch version must agree with the scalar one, both in whole SIMD packs and in the tail
+    constexpr int N_DIRS = 11;
+    double ra[N_DIRS], dec[N_DIRS], pra[N_DIRS], pdec[N_DIRS];
+    for (int i = 0; i < N_DIRS; i++) {
+        ra[i] = 0.1 + 0.6 * i;
+        dec[i] = -1.5 + 0.3 * i;
+    }
+    for (const Catalogue system: {CAT_FK4, CAT_FK5, CAT_FK6}) {
+        preces_batch(system, 1925.0, 2050.0, N_DIRS, ra, dec, pra, pdec);
+        for (int i = 0; i < N_DIRS; i++) {
+            pos = {ra[i], dec[i]};
+            preces(system, 1925.0, 2050.0, pos);
+            vvd(pra[i], pos.get_ra(), 0.0, "sla::preces_batch", "ra", status);
+            vvd(pdec[i], pos.get_dec(), 0.0, "sla::preces_batch", "dec", status);
+        }
+    }
 }
 
 // tests sla::rcc() function
@@ -930,13 +2185,37 @@ static void t_supgal(bool& status) {
     vvd(gal.get_latitude(), -0.1397070490669407, 1.0e-12, "sla::supgal", "latitude", status);
 }
 
-// tests sla::rverot(), sla::rvgalc(), sla::rvlg(), sla::rvlsrd(), and sla::rvlsrk() functions
+// tests sla::rverot(), sla::rvgalc(), sla::rvlg(), sla::rvlsrd(), sla::rvlsrk(), and sla::rvcor_batch() functions
 static void t_rv(bool& status) {
     vvd(rverot(-0.777, {5.67, -0.3}, 3.19), -0.1948098355075913, 1.0e-6, "sla::rverot", "", status);
     vvd(rvgalc({1.11, -0.99}), 158.9630759840254, 1.0e-3, "sla::rvgalc", "", status);
     vvd(rvlg({3.97, 1.09}), -197.818762175363, 1.0e-3, "sla::rvlg", "", status);
     vvd(rvlsrd({6.01, 0.1}), -4.082811335150567, 1.0e-4, "sla::rvlsrd", "", status);
     vvd(rvlsrk({6.01, 0.1}), -5.925180579830265, 1.0e-4, "sla::rvlsrk", "", status);
+
+    // batch version must agree with individual functions; the first three spectra are taken simultaneously
+    constexpr int N_SPECTRA = 5;
+    const Spherical<float> dirs[N_SPECTRA] = {{2.345f, -0.567f}, {5.67f, -0.3f}, {1.11f, -0.99f}, {3.97f, 1.09f},
+        {6.01f, 0.1f}};
+    const Spherical<float> dirs2000[N_SPECTRA] = {{2.34f, -0.566f}, {5.669f, -0.301f}, {1.111f, -0.99f},
+        {3.97f, 1.091f}, {6.011f, 0.1f}};
+    const int years[N_SPECTRA] = {1995, 1995, 1995, 1995, 2021};
+    const int days[N_SPECTRA] = {306, 306, 306, 307, 11};
+    const float fractions[N_SPECTRA] = {0.037f, 0.037f, 0.037f, 0.037f, 0.5f};
+    const float stimes[N_SPECTRA] = {3.19f, 3.19f, 3.19f, 0.1f, 5.5f};
+    RVCorrections corr[N_SPECTRA];
+    rvcor_batch(-0.777f, N_SPECTRA, dirs, dirs2000, years, days, fractions, stimes, corr);
+    for (int i = 0; i < N_SPECTRA; i++) {
+        float velocity, lt;
+        ecor(dirs[i], years[i], days[i], fractions[i], velocity, lt);
+        vvd(corr[i].rv_erot, rverot(-0.777f, dirs[i], stimes[i]), 1.0e-6, "sla::rvcor_batch", "erot", status);
+        vvd(corr[i].rv_eorb, velocity, 1.0e-4, "sla::rvcor_batch", "eorb", status);
+        vvd(corr[i].rv_lt, lt, 1.0e-3, "sla::rvcor_batch", "lt", status);
+        vvd(corr[i].rv_lsrk, rvlsrk(dirs2000[i]), 1.0e-5, "sla::rvcor_batch", "lsrk", status);
+        vvd(corr[i].rv_lsrd, rvlsrd(dirs2000[i]), 1.0e-5, "sla::rvcor_batch", "lsrd", status);
+        vvd(corr[i].rv_galc, rvgalc(dirs2000[i]), 1.0e-4, "sla::rvcor_batch", "galc", status);
+        vvd(corr[i].rv_lg, rvlg(dirs2000[i]), 1.0e-4, "sla::rvcor_batch", "lg", status);
+    }
 }
 
 // tests sla::cc62s() and sla::dc62s() functions
@@ -992,7 +2271,7 @@ static void t_etrms(bool& status) {
     vvd(et[2], -1.435296627515719e-7, 1.0e-18, "sla::etrms", "z", status);
 }
 
-// tests sla::addet() and sla::subet() functions
+// tests sla::addet(), sla::addet_batch(), sla::subet(), sla::subet_batch(), and sla::subetv_batch() functions
 static void t_addet(bool& status) {
     const Spherical<double> dir {2.0, -1.0};
     Spherical<double> dir1, dir2;
@@ -1005,6 +2284,224 @@ static void t_addet(bool& status) {
     subet(dir1, be, dir2);
     vvd(dir2.get_ra() - dir.get_ra(), 0.0, 1.0e-12, "sla::subet", "ra", status);
     vvd(dir2.get_dec() - dir.get_dec(), 0.0, 1.0e-12, "sla::subet", "dec", status);
+
+    // batch versions must agree with scalar ones, both in whole SIMD packs and in the tail
+    constexpr int N_DIRS = 11;
+    double ra[N_DIRS], dec[N_DIRS], era[N_DIRS], edec[N_DIRS], sra[N_DIRS], sdec[N_DIRS];
+    Vector<double> evecs[N_DIRS];
+    for (int i = 0; i < N_DIRS; i++) {
+        ra[i] = 0.1 + 0.8 * i;
+        dec[i] = -1.4 + 0.4 * i;
+    }
+    addet_batch(N_DIRS, ra, dec, be, era, edec);
+    for (int i = 0; i < N_DIRS; i++) {
+        addet({ra[i], dec[i]}, be, dir1);
+        vvd(era[i], dir1.get_ra(), 0.0, "sla::addet_batch", "ra", status);
+        vvd(edec[i], dir1.get_dec(), 0.0, "sla::addet_batch", "dec", status);
+        dcs2c(dir1, evecs[i]);
+        subet(dir1, be, dir2);
+        sra[i] = dir2.get_ra();
+        sdec[i] = dir2.get_dec();
+    }
+    subet_batch(N_DIRS, era, edec, be, era, edec);
+    subetv_batch(N_DIRS, evecs, be, evecs);
+    for (int i = 0; i < N_DIRS; i++) {
+        vvd(era[i], sra[i], 0.0, "sla::subet_batch", "ra", status);
+        vvd(edec[i], sdec[i], 0.0, "sla::subet_batch", "dec", status);
+        Vector<double> v;
+        dcs2c({ra[i], dec[i]}, v);
+        vvd(evecs[i][0], v[0], 1.0e-12, "sla::subetv_batch", "x", status);
+        vvd(evecs[i][1], v[1], 1.0e-12, "sla::subetv_batch", "y", status);
+        vvd(evecs[i][2], v[2], 1.0e-12, "sla::subetv_batch", "z", status);
+    }
+}
+
+// tests sla::fk425() and sla::fk425_batch() functions
+static void t_fk425(bool& status) {
+    Spherical<double> dir2000, pm2000;
+    double px2000, rv2000;
+
+    fk425({1.234, -0.123}, {-1.0e-5, 2.0e-6}, 0.5, 20.0, dir2000, pm2000, px2000, rv2000);
+    vvd(dir2000.get_ra(), 1.244117554618727, 1.0e-12, "sla::fk425", "r", status);
+    vvd(dir2000.get_dec(), -0.1213164254458709, 1.0e-12, "sla::fk425", "d", status);
+    vvd(pm2000.get_ra(), -9.964265838268711e-6, 1.0e-17, "sla::fk425", "dr", status);
+    vvd(pm2000.get_dec(), 2.038065265773541e-6, 1.0e-17, "sla::fk425", "dd", status);
+    vvd(px2000, 0.4997443812415410, 1.0e-12, "sla::fk425", "p", status);
+    vvd(rv2000, 20.01046091542101, 1.0e-11, "sla::fk425", "v", status);
+
+    // batch version must agree with scalar one (inputs include zero parallax, poles, and RA wrap-around)
+    double r[N_TEST_STARS], d[N_TEST_STARS], dr[N_TEST_STARS], dd[N_TEST_STARS], p[N_TEST_STARS], v[N_TEST_STARS];
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        test_star(i, r[i], d[i], dr[i], dd[i], p[i], v[i]);
+    }
+    fk425_batch(N_TEST_STARS, r, d, dr, dd, p, v, r, d, dr, dd, p, v);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0, dr0, dd0, p0, v0;
+        test_star(i, r0, d0, dr0, dd0, p0, v0);
+        fk425({r0, d0}, {dr0, dd0}, p0, v0, dir2000, pm2000, px2000, rv2000);
+        vvd(r[i], dir2000.get_ra(), 0.0, "sla::fk425_batch", "r", status);
+        vvd(d[i], dir2000.get_dec(), 0.0, "sla::fk425_batch", "d", status);
+        vvd(dr[i], pm2000.get_ra(), 0.0, "sla::fk425_batch", "dr", status);
+        vvd(dd[i], pm2000.get_dec(), 0.0, "sla::fk425_batch", "dd", status);
+        vvd(p[i], px2000, 0.0, "sla::fk425_batch", "p", status);
+        vvd(v[i], rv2000, 0.0, "sla::fk425_batch", "v", status);
+    }
+}
+
+// tests sla::fk45z() and sla::fk45z_batch() functions
+static void t_fk45z(bool& status) {
+    Spherical<double> dir2000;
+
+    fk45z({1.234, -0.987}, 1980.0, dir2000);
+    vvd(dir2000.get_ra(), 1.238245078885321, 1.0e-12, "sla::fk45z", "r", status);
+    vvd(dir2000.get_dec(), -0.9854033829890103, 1.0e-12, "sla::fk45z", "d", status);
+
+    // batch version must agree with scalar one (inputs include poles and RA wrap-around)
+    double r[N_TEST_STARS], d[N_TEST_STARS];
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        test_star(i, r[i], d[i]);
+    }
+    fk45z_batch(N_TEST_STARS, r, d, 1980.0, r, d);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0;
+        test_star(i, r0, d0);
+        fk45z({r0, d0}, 1980.0, dir2000);
+        vvd(r[i], dir2000.get_ra(), 0.0, "sla::fk45z_batch", "r", status);
+        vvd(d[i], dir2000.get_dec(), 0.0, "sla::fk45z_batch", "d", status);
+    }
+}
+
+// tests sla::fk524() and sla::fk524_batch() functions
+static void t_fk524(bool& status) {
+    Spherical<double> dir1950, pm1950;
+    double px1950, rv1950;
+
+    fk524({4.567, -1.23}, {-3.0e-5, 8.0e-6}, 0.29, -35.0, dir1950, pm1950, px1950, rv1950);
+    vvd(dir1950.get_ra(), 4.543778603272084, 1.0e-12, "sla::fk524", "r", status);
+    vvd(dir1950.get_dec(), -1.229642790187574, 1.0e-12, "sla::fk524", "d", status);
+    vvd(pm1950.get_ra(), -2.957873121769244e-5, 1.0e-17, "sla::fk524", "dr", status);
+    vvd(pm1950.get_dec(), 8.117725309659079e-6, 1.0e-17, "sla::fk524", "dd", status);
+    vvd(px1950, 0.2898494999992917, 1.0e-12, "sla::fk524", "p", status);
+    vvd(rv1950, -35.02686282425268, 1.0e-11, "sla::fk524", "v", status);
+
+    // batch version must agree with scalar one (inputs include zero parallax, poles, and RA wrap-around)
+    double r[N_TEST_STARS], d[N_TEST_STARS], dr[N_TEST_STARS], dd[N_TEST_STARS], p[N_TEST_STARS], v[N_TEST_STARS];
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        test_star(i, r[i], d[i], dr[i], dd[i], p[i], v[i]);
+    }
+    fk524_batch(N_TEST_STARS, r, d, dr, dd, p, v, r, d, dr, dd, p, v);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0, dr0, dd0, p0, v0;
+        test_star(i, r0, d0, dr0, dd0, p0, v0);
+        fk524({r0, d0}, {dr0, dd0}, p0, v0, dir1950, pm1950, px1950, rv1950);
+        vvd(r[i], dir1950.get_ra(), 0.0, "sla::fk524_batch", "r", status);
+        vvd(d[i], dir1950.get_dec(), 0.0, "sla::fk524_batch", "d", status);
+        vvd(dr[i], pm1950.get_ra(), 0.0, "sla::fk524_batch", "dr", status);
+        vvd(dd[i], pm1950.get_dec(), 0.0, "sla::fk524_batch", "dd", status);
+        vvd(p[i], px1950, 0.0, "sla::fk524_batch", "p", status);
+        vvd(v[i], rv1950, 0.0, "sla::fk524_batch", "v", status);
+    }
+}
+
+// tests sla::fk52h(), sla::fk5hz(), sla::h2fk5(), sla::hfk5z() functions, and their batch versions
+static void t_fk52h(bool& status) {
+    Spherical<double> dir, pm;
+
+    fk52h({1.234, -0.987}, {1.0e-6, -2.0e-6}, dir, pm);
+    vvd(dir.get_ra(), 1.234000000272122558, 1.0e-13, "sla::fk52h", "r", status);
+    vvd(dir.get_dec(), -0.9869999235218543959, 1.0e-13, "sla::fk52h", "d", status);
+    vvd(pm.get_ra(), 0.9931782941980623e-6, 1.0e-17, "sla::fk52h", "dr", status);
+    vvd(pm.get_dec(), -0.1997665915005268e-5, 1.0e-17, "sla::fk52h", "dd", status);
+
+    fk5hz({1.234, -0.987}, 1980.0, dir);
+    vvd(dir.get_ra(), 1.234000136713611301, 1.0e-13, "sla::fk5hz", "r", status);
+    vvd(dir.get_dec(), -0.9869999702020807601, 1.0e-13, "sla::fk5hz", "d", status);
+
+    h2fk5({1.234, -0.987}, {1.0e-6, -2.0e-6}, dir, pm);
+    vvd(dir.get_ra(), 1.233999999727859009, 1.0e-13, "sla::h2fk5", "r", status);
+    vvd(dir.get_dec(), -0.9870000764781454716, 1.0e-13, "sla::h2fk5", "d", status);
+    vvd(pm.get_ra(), 0.1006821706595901e-5, 1.0e-17, "sla::h2fk5", "dr", status);
+    vvd(pm.get_dec(), -0.2002334085496894e-5, 1.0e-17, "sla::h2fk5", "dd", status);
+
+    hfk5z({1.234, -0.987}, 1980.0, dir, pm);
+    vvd(dir.get_ra(), 1.233999863286370902, 1.0e-13, "sla::hfk5z", "r", status);
+    vvd(dir.get_dec(), -0.9870000297979030224, 1.0e-13, "sla::hfk5z", "d", status);
+    vvd(pm.get_ra(), 0.6822073986198100e-8, 1.0e-17, "sla::hfk5z", "dr", status);
+    vvd(pm.get_dec(), -0.2334012283921378e-8, 1.0e-17, "sla::hfk5z", "dd", status);
+
+    // batch versions must agree with scalar ones (inputs include poles and RA wrap-around), and undo each other; after
+    // a round trip, positions are compared as directions, since RAs are normalized and are arbitrary at the poles
+    double r[N_TEST_STARS], d[N_TEST_STARS], dr[N_TEST_STARS], dd[N_TEST_STARS], p, v;
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        test_star(i, r[i], d[i], dr[i], dd[i], p, v);
+    }
+    fk52h_batch(N_TEST_STARS, r, d, dr, dd, r, d, dr, dd);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0, dr0, dd0;
+        test_star(i, r0, d0, dr0, dd0, p, v);
+        fk52h({r0, d0}, {dr0, dd0}, dir, pm);
+        vvd(r[i], dir.get_ra(), 0.0, "sla::fk52h_batch", "r", status);
+        vvd(d[i], dir.get_dec(), 0.0, "sla::fk52h_batch", "d", status);
+        vvd(dr[i], pm.get_ra(), 0.0, "sla::fk52h_batch", "dr", status);
+        vvd(dd[i], pm.get_dec(), 0.0, "sla::fk52h_batch", "dd", status);
+    }
+    h2fk5_batch(N_TEST_STARS, r, d, dr, dd, r, d, dr, dd);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0, dr0, dd0;
+        test_star(i, r0, d0, dr0, dd0, p, v);
+        vvd(dsep({r[i], d[i]}, {r0, d0}), 0.0, 1.0e-12, "sla::h2fk5_batch", "r,d", status);
+        // proper motions do not survive the round trip at the poles, where RA is undefined
+        if (std::fabs(d0) < 1.5) {
+            vvd(dr[i], dr0, 1.0e-17, "sla::h2fk5_batch", "dr", status);
+            vvd(dd[i], dd0, 1.0e-17, "sla::h2fk5_batch", "dd", status);
+        }
+    }
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        test_star(i, r[i], d[i]);
+    }
+    hfk5z_batch(N_TEST_STARS, r, d, 1980.0, r, d, dr, dd);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0;
+        test_star(i, r0, d0);
+        hfk5z({r0, d0}, 1980.0, dir, pm);
+        vvd(r[i], dir.get_ra(), 0.0, "sla::hfk5z_batch", "r", status);
+        vvd(d[i], dir.get_dec(), 0.0, "sla::hfk5z_batch", "d", status);
+        vvd(dr[i], pm.get_ra(), 0.0, "sla::hfk5z_batch", "dr", status);
+        vvd(dd[i], pm.get_dec(), 0.0, "sla::hfk5z_batch", "dd", status);
+    }
+    fk5hz_batch(N_TEST_STARS, r, d, 1980.0, r, d);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0;
+        test_star(i, r0, d0);
+        vvd(dsep({r[i], d[i]}, {r0, d0}), 0.0, 1.0e-12, "sla::fk5hz_batch", "r,d", status);
+    }
+}
+
+// tests sla::fk54z() and sla::fk54z_batch() functions
+static void t_fk54z(bool& status) {
+    Spherical<double> dir1950, pm1950;
+
+    fk54z({0.001, -1.55}, 1900.0, dir1950, pm1950);
+    vvd(dir1950.get_ra(), 6.271585543439484, 1.0e-12, "sla::fk54z", "r", status);
+    vvd(dir1950.get_dec(), -1.554861715330319, 1.0e-12, "sla::fk54z", "d", status);
+    vvd(pm1950.get_ra(), -4.175410876044923e-8, 1.0e-20, "sla::fk54z", "dr", status);
+    vvd(pm1950.get_dec(), 2.118595098308530e-8, 1.0e-20, "sla::fk54z", "dd", status);
+
+    // batch version must agree with scalar one (inputs include poles and RA wrap-around)
+    double r[N_TEST_STARS], d[N_TEST_STARS], dr[N_TEST_STARS], dd[N_TEST_STARS];
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        test_star(i, r[i], d[i]);
+    }
+    fk54z_batch(N_TEST_STARS, r, d, 1900.0, r, d, dr, dd);
+    for (int i = 0; i < N_TEST_STARS; i++) {
+        double r0, d0;
+        test_star(i, r0, d0);
+        fk54z({r0, d0}, 1900.0, dir1950, pm1950);
+        vvd(r[i], dir1950.get_ra(), 0.0, "sla::fk54z_batch", "r", status);
+        vvd(d[i], dir1950.get_dec(), 0.0, "sla::fk54z_batch", "d", status);
+        vvd(dr[i], pm1950.get_ra(), 0.0, "sla::fk54z_batch", "dr", status);
+        vvd(dd[i], pm1950.get_dec(), 0.0, "sla::fk54z_batch", "dd", status);
+    }
 }
 
 // tests sla::pvobs() and (indirectly) sla::geoc() functions
@@ -1157,7 +2654,7 @@ static void t_pm(bool& status) {
     vvd(dir.get_dec(), -0.8696617307805072, 1.0e-12, "sla::pm", "dec", status);
 }
 
-// tests sla::earth() function
+// tests sla::earth() and sla::earth_batch() functions
 static void t_earth(bool& status) {
     VectorPV<float> pv;
     earth(1978, 174, 0.87f, pv);
@@ -1168,6 +2665,27 @@ static void t_earth(bool& status) {
     vvd(pv.get_dx(), 1.956930055e-7, 1.0e-13, "sla::earth", "dx", status);
     vvd(pv.get_dy(), 5.743797400e-9, 1.0e-13, "sla::earth", "dy", status);
     vvd(pv.get_dz(), 2.512001677e-9, 1.0e-13, "sla::earth", "dz", status);
+
+    // batch version must agree with the scalar one to within a few float ulps
+    constexpr int N_DATES = 40;
+    int years[N_DATES], days[N_DATES];
+    float fractions[N_DATES];
+    VectorPV<float> batch[N_DATES];
+    for (int i = 0; i < N_DATES; i++) {
+        years[i] = 1950 + i * 3;
+        days[i] = 1 + i * 9;
+        fractions[i] = 0.025f * (float) i;
+    }
+    earth_batch(N_DATES, years, days, fractions, batch);
+    for (int i = 0; i < N_DATES; i++) {
+        earth(years[i], days[i], fractions[i], pv);
+        vvd(batch[i].get_x(), pv.get_x(), 1.0e-6, "sla::earth_batch", "x", status);
+        vvd(batch[i].get_y(), pv.get_y(), 1.0e-6, "sla::earth_batch", "y", status);
+        vvd(batch[i].get_z(), pv.get_z(), 1.0e-6, "sla::earth_batch", "z", status);
+        vvd(batch[i].get_dx(), pv.get_dx(), 1.0e-13, "sla::earth_batch", "dx", status);
+        vvd(batch[i].get_dy(), pv.get_dy(), 1.0e-13, "sla::earth_batch", "dy", status);
+        vvd(batch[i].get_dz(), pv.get_dz(), 1.0e-13, "sla::earth_batch", "dz", status);
+    }
 }
 
 // tests sla::ecor() function
@@ -1338,7 +2856,7 @@ static void t_percom(bool& status) {
     viv(order[3], 1, "sla::permut", "order:3", status);
 }
 
-// tests sla::evp() and sla::epv() functions
+// tests sla::evp(), sla::evp_batch(), and sla::epv() functions, and sla::EarthEphemeris class
 static void t_evp(bool& status) {
     Vector<double> bvelo, bpos, hvelo, hpos;
 
@@ -1356,6 +2874,24 @@ static void t_evp(bool& status) {
     vvd(hpos[1],  0.8036439916076232, 1e-7, "sla::evp", "hpos:y", status);
     vvd(hpos[2],  0.3484298459102053, 1e-7, "sla::evp", "hpos:z", status);
 
+    // batch version must agree with the scalar one to within a few float ulps of the single precision terms
+    constexpr int N_DATES = 40;
+    double dates[N_DATES];
+    Vector<double> bvelos[N_DATES], bposs[N_DATES], hvelos[N_DATES], hposs[N_DATES];
+    for (int i = 0; i < N_DATES; i++) {
+        dates[i] = 50100.0 + i * 193.7;
+    }
+    evp_batch(N_DATES, dates, 1990.0, bvelos, bposs, hvelos, hposs);
+    for (int i = 0; i < N_DATES; i++) {
+        evp(dates[i], 1990.0, bvelo, bpos, hvelo, hpos);
+        for (int k = 0; k < 3; k++) {
+            vvd(bvelos[i][k], bvelo[k], 1e-14, "sla::evp_batch", "bvelo", status);
+            vvd(bposs[i][k], bpos[k], 1e-7, "sla::evp_batch", "bpos", status);
+            vvd(hvelos[i][k], hvelo[k], 1e-14, "sla::evp_batch", "hvelo", status);
+            vvd(hposs[i][k], hpos[k], 1e-7, "sla::evp_batch", "hpos", status);
+        }
+    }
+
     epv(53411.52501161, hpos, hvelo, bpos, bvelo);
     vvd(hpos[0], -0.7757238809297653, 1.0e-12, "sla::epv", "hpos:x", status);
     vvd(hpos[1], +0.5598052241363390, 1.0e-12, "sla::epv", "hpos:y", status);
@@ -1369,6 +2905,39 @@ static void t_evp(bool& status) {
     vvd(bvelo[0], -0.0109187426811683, 1.0e-12, "sla::epv", "bvelo:x", status);
     vvd(bvelo[1], -0.0124652546173285, 1.0e-12, "sla::epv", "bvelo:y", status);
     vvd(bvelo[2], -0.0054047731809662, 1.0e-12, "sla::epv", "bvelo:z", status);
+
+    // low accuracy requirements are met by sla::evp() alone
+    VectorPV<double> hpv, bpv;
+    EarthEphemeris coarse(10000.0, 500.0);
+    viv(coarse.get(50100.0, hpv, bpv), EE_EVP, "sla::EarthEphemeris", "evp", status);
+    evp(50100.0, 2000.0, bvelo, bpos, hvelo, hpos);
+    vvd(hpv.get_x(), hpos[0], 0.0, "sla::EarthEphemeris", "evp:hpos", status);
+    vvd(bpv.get_dz(), bvelo[2] * 86400.0, 0.0, "sla::EarthEphemeris", "evp:bvelo", status);
+
+    // high accuracy requirements are met by the table where it exists, and by sla::epv() elsewhere
+    EarthEphemeris fine(20.0, 10.0);
+    viv(fine.get_backend(53411.5), EE_EPV, "sla::EarthEphemeris", "no table", status);
+    viv(fine.tabulate(53410.0, 53420.0), true, "sla::EarthEphemeris", "tabulate", status);
+    viv(fine.get_position_error(EE_TABLE) < 20.0 && fine.get_velocity_error(EE_TABLE) < 10.0, true,
+        "sla::EarthEphemeris", "bounds", status);
+    const double pos_tol = (fine.get_position_error(EE_TABLE) - fine.get_position_error(EE_EPV)) / 149597870.7;
+    const double vel_tol = (fine.get_velocity_error(EE_TABLE) - fine.get_velocity_error(EE_EPV)) / 1731456836.8;
+    constexpr int N_EDATES = 6;
+    const double edates[N_EDATES] = {53409.0, 53410.0, 53411.52501161, 53415.3, 53420.0, 53421.0};
+    const EEBackend expected[N_EDATES] = {EE_EPV, EE_TABLE, EE_TABLE, EE_TABLE, EE_TABLE, EE_EPV};
+    VectorPV<double> hpvs[N_EDATES], bpvs[N_EDATES];
+    EEBackend backends[N_EDATES];
+    fine.get(N_EDATES, edates, hpvs, bpvs, backends);
+    for (int i = 0; i < N_EDATES; i++) {
+        viv(backends[i], expected[i], "sla::EarthEphemeris", "backend", status);
+        epv(edates[i], hpos, hvelo, bpos, bvelo);
+        for (int k = 0; k < 3; k++) {
+            vvd(hpvs[i].get_position()[k], hpos[k], pos_tol, "sla::EarthEphemeris", "hpos", status);
+            vvd(hpvs[i].get_velocity()[k], hvelo[k], vel_tol, "sla::EarthEphemeris", "hvelo", status);
+            vvd(bpvs[i].get_position()[k], bpos[k], pos_tol, "sla::EarthEphemeris", "bpos", status);
+            vvd(bpvs[i].get_velocity()[k], bvelo[k], vel_tol, "sla::EarthEphemeris", "bvelo", status);
+        }
+    }
 }
 
 // tests sla::eg50() function
@@ -1411,7 +2980,7 @@ static void t_pda2h(bool& status) {
     viv(ha2_valid, true, "sla::pda2h", "ha2_v", status);
 }
 
-// tests sla::moon() and sla::dmoon() functions
+// tests sla::moon(), sla::moon_batch(), sla::dmoon(), and sla::dmoon_batch() functions, and sla::MoonEphemeris class
 static void t_moon(bool& status) {
     VectorPV<float> pv;
     moon(1999, 365, 0.9f, pv);
@@ -1422,6 +2991,27 @@ static void t_moon(bool& status) {
     vvd(pv.get_dy(), -4.989667166259157e-9, 1.0e-12, "sla::moon", "dy", status);
     vvd(pv.get_dz(), -2.160752457288307e-9, 1.0e-12, "sla::moon", "dz", status);
 
+    // batch version must agree with the scalar one to within a few float ulps
+    constexpr int N_FDATES = 40;
+    int years[N_FDATES], days[N_FDATES];
+    float fractions[N_FDATES];
+    VectorPV<float> fbatch[N_FDATES];
+    for (int i = 0; i < N_FDATES; i++) {
+        years[i] = 1960 + i * 2;
+        days[i] = 1 + i * 9;
+        fractions[i] = 0.025f * (float) i;
+    }
+    moon_batch(N_FDATES, years, days, fractions, fbatch);
+    for (int i = 0; i < N_FDATES; i++) {
+        moon(years[i], days[i], fractions[i], pv);
+        vvd(fbatch[i].get_x(), pv.get_x(), 1.0e-8, "sla::moon_batch", "x", status);
+        vvd(fbatch[i].get_y(), pv.get_y(), 1.0e-8, "sla::moon_batch", "y", status);
+        vvd(fbatch[i].get_z(), pv.get_z(), 1.0e-8, "sla::moon_batch", "z", status);
+        vvd(fbatch[i].get_dx(), pv.get_dx(), 1.0e-14, "sla::moon_batch", "dx", status);
+        vvd(fbatch[i].get_dy(), pv.get_dy(), 1.0e-14, "sla::moon_batch", "dy", status);
+        vvd(fbatch[i].get_dz(), pv.get_dz(), 1.0e-14, "sla::moon_batch", "dz", status);
+    }
+
     /*
      * The original FORTRAN implementation of the `T_MOON` subroutine was missing test for the `sla_DMOON`
      * subroutine, even though it was mentioned in its comment ("Test sla_MOON and sla_DMOON routines.").
@@ -1442,6 +3032,422 @@ static void t_moon(bool& status) {
     vvd(dpv.get_dx(), 3.629209419071314e-9, 1.0e-11 , "sla::dmoon", "dx", status);
     vvd(dpv.get_dy(), -4.989667166259157e-9, 1.0e-11, "sla::dmoon", "dy", status);
     vvd(dpv.get_dz(), -2.160752457288307e-9, 1.0e-11, "sla::dmoon", "dz", status);
+
+    // batch version must give identical results, and cached interpolation must stay within its error bound
+    constexpr int N_DATES = 40;
+    double dates[N_DATES];
+    VectorPV<double> batch[N_DATES];
+    for (int i = 0; i < N_DATES; i++) {
+        dates[i] = 51543.9 + i * 0.37;
+    }
+    dmoon_batch(N_DATES, dates, batch);
+    MoonEphemeris ephemeris;
+    viv(std::isnan(ephemeris.get_velocity_error_estimate()), true, "sla::MoonEphemeris", "no estimate before get()",
+        status);
+    for (int i = 0; i < N_DATES; i++) {
+        dmoon(dates[i], dpv);
+        vvd(batch[i].get_x(), dpv.get_x(), 0.0, "sla::dmoon_batch", "x", status);
+        vvd(batch[i].get_y(), dpv.get_y(), 0.0, "sla::dmoon_batch", "y", status);
+        vvd(batch[i].get_z(), dpv.get_z(), 0.0, "sla::dmoon_batch", "z", status);
+        vvd(batch[i].get_dx(), dpv.get_dx(), 0.0, "sla::dmoon_batch", "dx", status);
+        vvd(batch[i].get_dy(), dpv.get_dy(), 0.0, "sla::dmoon_batch", "dy", status);
+        vvd(batch[i].get_dz(), dpv.get_dz(), 0.0, "sla::dmoon_batch", "dz", status);
+
+        VectorPV<double> ipv;
+        const double bound = ephemeris.get(dates[i], ipv);
+        const double vbound = ephemeris.get_velocity_error_estimate();
+        viv(bound < 1.0e-13 && vbound < 1.0e-18, true, "sla::MoonEphemeris", "estimates", status);
+        vvd(ipv.get_x(), dpv.get_x(), bound, "sla::MoonEphemeris", "x", status);
+        vvd(ipv.get_y(), dpv.get_y(), bound, "sla::MoonEphemeris", "y", status);
+        vvd(ipv.get_z(), dpv.get_z(), bound, "sla::MoonEphemeris", "z", status);
+        vvd(ipv.get_dx(), dpv.get_dx(), vbound, "sla::MoonEphemeris", "dx", status);
+        vvd(ipv.get_dy(), dpv.get_dy(), vbound, "sla::MoonEphemeris", "dy", status);
+        vvd(ipv.get_dz(), dpv.get_dz(), vbound, "sla::MoonEphemeris", "dz", status);
+    }
+}
+
+// tests sla::el2ue(), sla::pv2el(), sla::pv2ue(), sla::ue2el(), sla::ue2pv(), sla::ue2pv_batch(), sla::planet(),
+// sla::planet_batch(), and sla::rdplan() functions
+static void t_planet(bool& status) {
+    UniversalElements u;
+    OrbitalElements el = {OEF_MAJOR_PLANET, 49000.0, 0.1, 2.0, 0.2, 3.0, 0.05, 3.0, 0.003312};
+    VectorPV<double> pv;
+
+    viv(el2ue(50000.0, el, u), OES_OK, "sla::el2ue", "j", status);
+    vvd(u.ue_mass, 1.000878908362435284, 1.0e-12, "sla::el2ue", "u(1)", status);
+    vvd(u.ue_alpha, -0.3336263027874777288, 1.0e-12, "sla::el2ue", "u(2)", status);
+    vvd(u.ue_t0, 50000.0, 1.0e-12, "sla::el2ue", "u(3)", status);
+    vvd(u.ue_p0[0], 2.840425801310305210, 1.0e-12, "sla::el2ue", "u(4)", status);
+    vvd(u.ue_p0[1], 0.1264380368035014224, 1.0e-12, "sla::el2ue", "u(5)", status);
+    vvd(u.ue_p0[2], -0.2287711835229143197, 1.0e-12, "sla::el2ue", "u(6)", status);
+    vvd(u.ue_v0[0], -0.01301062595106185195, 1.0e-12, "sla::el2ue", "u(7)", status);
+    vvd(u.ue_v0[1], 0.5657102158104651697, 1.0e-12, "sla::el2ue", "u(8)", status);
+    vvd(u.ue_v0[2], 0.2189745287281794885, 1.0e-12, "sla::el2ue", "u(9)", status);
+    vvd(u.ue_r0, 2.852427310959998500, 1.0e-12, "sla::el2ue", "u(10)", status);
+    vvd(u.ue_sigma0, -0.01552349065435120900, 1.0e-12, "sla::el2ue", "u(11)", status);
+    vvd(u.ue_t, 50000.0, 1.0e-12, "sla::el2ue", "u(12)", status);
+    vvd(u.ue_psi, 0.0, 1.0e-12, "sla::el2ue", "u(13)", status);
+
+    viv(ue2pv(50010.0, u, pv), OES_OK, "sla::ue2pv", "j", status);
+    vvd(pv.get_x(), 2.836375402820674, 1.0e-12, "sla::ue2pv", "x", status);
+    vvd(pv.get_y(), 0.2236506683904174, 1.0e-12, "sla::ue2pv", "y", status);
+    vvd(pv.get_z(), -0.1909649804056073, 1.0e-12, "sla::ue2pv", "z", status);
+    vvd(pv.get_dx(), -6.785153059285476e-9, 1.0e-19, "sla::ue2pv", "xd", status);
+    vvd(pv.get_dy(), 1.123732786996787e-7, 1.0e-19, "sla::ue2pv", "yd", status);
+    vvd(pv.get_dz(), 4.390762271597043e-8, 1.0e-19, "sla::ue2pv", "zd", status);
+    vvd(u.ue_t, 50010.0, 1.0e-12, "sla::ue2pv", "u(12)", status);
+
+    viv(ue2el(u, OEF_MAJOR_PLANET, el), OES_OK, "sla::ue2el", "j", status);
+    viv(el.oe_form, OEF_MAJOR_PLANET, "sla::ue2el", "jform", status);
+    vvd(el.oe_epoch, 50000.0, 1.0e-10, "sla::ue2el", "epoch", status);
+    vvd(el.oe_orbinc, 0.1, 1.0e-12, "sla::ue2el", "orbinc", status);
+    vvd(el.oe_anode, 2.0, 1.0e-12, "sla::ue2el", "anode", status);
+    vvd(el.oe_perih, 0.2, 1.0e-12, "sla::ue2el", "perih", status);
+    vvd(el.oe_aorq, 3.0, 1.0e-12, "sla::ue2el", "aorq", status);
+    vvd(el.oe_e, 0.05, 1.0e-12, "sla::ue2el", "e", status);
+    vvd(el.oe_aorl, 0.02881469282043303, 1.0e-12, "sla::ue2el", "aorl", status);
+    vvd(el.oe_dm, 0.003312, 1.0e-12, "sla::ue2el", "dm", status);
+
+    viv(pv2ue(pv, 50010.0, 0.00006, u), OES_OK, "sla::pv2ue", "j", status);
+    vvd(u.ue_mass, 1.00006, 1.0e-12, "sla::pv2ue", "u(1)", status);
+    vvd(u.ue_alpha, -0.33305194881373, 1.0e-12, "sla::pv2ue", "u(2)", status);
+    vvd(u.ue_sigma0, -0.01254505847833055, 1.0e-12, "sla::pv2ue", "u(11)", status);
+    viv(pv2ue(pv, 50010.0, -1.0, u), OES_BAD_MASS, "sla::pv2ue", "j(mass)", status);
+
+    viv(pv2el(pv, 50010.0, 0.0, OEF_COMET, el), OES_OK, "sla::pv2el", "j", status);
+    viv(el.oe_form, OEF_COMET, "sla::pv2el", "jform", status);
+    vvd(el.oe_epoch, 50050.97006820897, 1.0e-8, "sla::pv2el", "epoch", status);
+    vvd(el.oe_orbinc, 0.1, 1.0e-12, "sla::pv2el", "orbinc", status);
+    vvd(el.oe_anode, 2.0, 1.0e-12, "sla::pv2el", "anode", status);
+    vvd(el.oe_perih, 4.480558909680749, 1.0e-10, "sla::pv2el", "perih", status);
+    vvd(el.oe_aorq, 2.850027270639728, 1.0e-12, "sla::pv2el", "aorq", status);
+    vvd(el.oe_e, 0.05091279796852357, 1.0e-12, "sla::pv2el", "e", status);
+
+    // batch version must agree with scalar one; bodies include elliptical, near-parabolic, parabolic and hyperbolic
+    // orbits
+    constexpr int N_BODIES = 20;
+    UniversalElementsArray elements(N_BODIES);
+    UniversalElements ue[N_BODIES];
+    for (int i = 0; i < N_BODIES; i++) {
+        el = test_body(i, 49900.0);
+        viv(el2ue(50000.0, el, ue[i]), OES_OK, "sla::el2ue", "j(batch)", status);
+        elements.set(i, ue[i]);
+    }
+    VectorPV<double> pvs[N_BODIES];
+    OEStatus statuses[N_BODIES];
+    for (double date: {50000.0, 50123.4, 49000.0}) {
+        ue2pv_batch(date, elements, pvs, statuses, 2);
+        for (int i = 0; i < N_BODIES; i++) {
+            viv(ue2pv(date, ue[i], pv), statuses[i], "sla::ue2pv_batch", "j", status);
+            for (int j = 0; j < 3; j++) {
+                vvd(pvs[i].get_position()[j], pv.get_position()[j], 0.0, "sla::ue2pv_batch", "p", status);
+                vvd(pvs[i].get_velocity()[j], pv.get_velocity()[j], 0.0, "sla::ue2pv_batch", "v", status);
+            }
+            elements.get(i, u);
+            vvd(u.ue_t, ue[i].ue_t, 0.0, "sla::ue2pv_batch", "u(12)", status);
+            vvd(u.ue_psi, ue[i].ue_psi, 0.0, "sla::ue2pv_batch", "u(13)", status);
+        }
+    }
+
+    // a grossly wrong anomaly of the previous prediction makes the iteration fail to converge for hyperbolic orbits;
+    // lanes that fail must leave their elements and results unchanged, and must not disturb other lanes
+    for (int i = 0; i < N_BODIES; i++) {
+        ue[i].ue_psi = (i % 3 == 0)? -50.0: ue[i].ue_psi;
+        elements.set(i, ue[i]);
+        pvs[i] = {};
+    }
+    ue2pv_batch(50200.0, elements, pvs, statuses, 1);
+    int nfailed = 0;
+    for (int i = 0; i < N_BODIES; i++) {
+        const UniversalElements ue_before = ue[i];
+        viv(ue2pv(50200.0, ue[i], pv), statuses[i], "sla::ue2pv_batch", "j(stale)", status);
+        elements.get(i, u);
+        if (statuses[i] == OES_OK) {
+            vvd(pvs[i].get_x(), pv.get_x(), 0.0, "sla::ue2pv_batch", "x(stale)", status);
+            vvd(u.ue_psi, ue[i].ue_psi, 0.0, "sla::ue2pv_batch", "u(13)(stale)", status);
+        } else {
+            nfailed++;
+            viv(statuses[i], OES_NO_CONVERGENCE, "sla::ue2pv_batch", "j(stale)", status);
+            vvd(pvs[i].get_x(), 0.0, 0.0, "sla::ue2pv_batch", "x(failed)", status);
+            vvd(u.ue_psi, ue_before.ue_psi, 0.0, "sla::ue2pv_batch", "u(13)(failed)", status);
+        }
+    }
+    viv(nfailed > 0 && nfailed < N_BODIES / 3, true, "sla::ue2pv_batch", "some lanes fail", status);
+
+    viv(planet(1.0e6, 0, pv), PLS_BAD_PLANET, "sla::planet", "j 1", status);
+    viv(planet(1.0e6, 10, pv), PLS_BAD_PLANET, "sla::planet", "j 2", status);
+
+    viv(planet(-320000.0, 3, pv), PLS_DATE_WARNING, "sla::planet", "j 3", status);
+    vvd(pv.get_x(), 0.9308038666827242603, 1.0e-11, "sla::planet", "pv 1", status);
+    vvd(pv.get_y(), 0.3258319040252137618, 1.0e-11, "sla::planet", "pv 2", status);
+    vvd(pv.get_z(), 0.1422794544477122021, 1.0e-11, "sla::planet", "pv 3", status);
+    vvd(pv.get_dx(), -7.441503423889371696e-8, 1.0e-17, "sla::planet", "pv 4", status);
+    vvd(pv.get_dy(), 1.699734557528650689e-7, 1.0e-17, "sla::planet", "pv 5", status);
+    vvd(pv.get_dz(), 7.415505123001430864e-8, 1.0e-17, "sla::planet", "pv 6", status);
+
+    viv(planet(43999.9, 1, pv), PLS_OK, "sla::planet", "j 4", status);
+    vvd(pv.get_x(), 0.2945293959257430832, 1.0e-11, "sla::planet", "pv 7", status);
+    vvd(pv.get_y(), -0.2452204176601049596, 1.0e-11, "sla::planet", "pv 8", status);
+    vvd(pv.get_z(), -0.1615427700571978153, 1.0e-11, "sla::planet", "pv 9", status);
+    vvd(pv.get_dx(), 1.636421147459047057e-7, 1.0e-17, "sla::planet", "pv 10", status);
+    vvd(pv.get_dy(), 2.252949422574889753e-7, 1.0e-17, "sla::planet", "pv 11", status);
+    vvd(pv.get_dz(), 1.033542799062371839e-7, 1.0e-17, "sla::planet", "pv 12", status);
+
+    // Pluto: Meeus, "Astronomical Algorithms", example 37.a (heliocentric ecliptic coordinates, J2000)
+    constexpr double D2R = 0.017453292519943295769236907;
+    viv(planet(48908.0, 9, pv), PLS_OK, "sla::planet", "j 5", status);
+    Spherical<double> ecl;
+    Vector<double> p;
+    Matrix<double> rmat;
+    deuler("x", 0.4090928042223289, 0.0, 0.0, rmat);
+    dmxv(rmat, pv.get_position(), p);
+    dcc2s(p, ecl);
+    vvd(dranrm(ecl.get_ra()), 232.74071 * D2R, 1.0e-6, "sla::planet", "l", status);
+    vvd(ecl.get_dec(), 14.58782 * D2R, 1.0e-6, "sla::planet", "b", status);
+    vvd(dvn(p, p), 29.711111, 1.0e-5, "sla::planet", "r", status);
+
+    double ra, dec, diam;
+    rdplan(40999.9, 0, 0.1, -0.9, ra, dec, diam);
+    vvd(ra, 5.772270359389275837, 1.0e-6, "sla::rdplan", "ra 0", status);
+    vvd(dec, -0.2089207338795416, 1.0e-7, "sla::rdplan", "dec 0", status);
+    vvd(diam, 9.415338935229717875e-3, 1.0e-14, "sla::rdplan", "diam 0", status);
+    rdplan(41999.9, 1, 1.1, -0.9, ra, dec, diam);
+    vvd(ra, 3.866363420052936653, 1.0e-6, "sla::rdplan", "ra 1", status);
+    vvd(dec, -0.2594430577550113130, 1.0e-7, "sla::rdplan", "dec 1", status);
+    vvd(diam, 4.638468996795023071e-5, 1.0e-14, "sla::rdplan", "diam 1", status);
+    rdplan(42999.9, 2, 2.1, 0.9, ra, dec, diam);
+    vvd(ra, 2.695383203184077378, 1.0e-6, "sla::rdplan", "ra 2", status);
+    vvd(dec, 0.2124044506294805126, 1.0e-7, "sla::rdplan", "dec 2", status);
+    vvd(diam, 4.892222838681000389e-5, 1.0e-14, "sla::rdplan", "diam 2", status);
+    rdplan(43999.9, 3, 3.1, 0.9, ra, dec, diam);
+    vvd(ra, 2.908326678461540165, 1.0e-6, "sla::rdplan", "ra 3", status);
+    vvd(dec, 0.08729783126905579385, 1.0e-7, "sla::rdplan", "dec 3", status);
+    vvd(diam, 8.581305866034962476e-3, 1.0e-14, "sla::rdplan", "diam 3", status);
+    rdplan(44999.9, 4, -0.1, 1.1, ra, dec, diam);
+    vvd(ra, 3.429840787472851721, 1.0e-6, "sla::rdplan", "ra 4", status);
+    vvd(dec, -0.06979851055261161013, 1.0e-7, "sla::rdplan", "dec 4", status);
+    vvd(diam, 4.540536678439300199e-5, 1.0e-14, "sla::rdplan", "diam 4", status);
+    rdplan(45999.9, 5, -1.1, 0.1, ra, dec, diam);
+    vvd(ra, 4.864669466449422548, 1.0e-6, "sla::rdplan", "ra 5", status);
+    vvd(dec, -0.4077714497908953354, 1.0e-7, "sla::rdplan", "dec 5", status);
+    vvd(diam, 1.727945579027815576e-4, 1.0e-14, "sla::rdplan", "diam 5", status);
+    rdplan(46999.9, 6, -2.1, -0.1, ra, dec, diam);
+    vvd(ra, 4.432929829176388766, 1.0e-6, "sla::rdplan", "ra 6", status);
+    vvd(dec, -0.3682820877854730530, 1.0e-7, "sla::rdplan", "dec 6", status);
+    vvd(diam, 8.670829016099083311e-5, 1.0e-14, "sla::rdplan", "diam 6", status);
+    rdplan(47999.9, 7, -3.1, -1.1, ra, dec, diam);
+    vvd(ra, 4.894972492286818487, 1.0e-6, "sla::rdplan", "ra 7", status);
+    vvd(dec, -0.4084068901053653125, 1.0e-7, "sla::rdplan", "dec 7", status);
+    vvd(diam, 1.793916783975974163e-5, 1.0e-14, "sla::rdplan", "diam 7", status);
+    rdplan(48999.9, 8, 0.0, 0.0, ra, dec, diam);
+    vvd(ra, 5.066050284760144000, 1.0e-6, "sla::rdplan", "ra 8", status);
+    vvd(dec, -0.3744690779683850609, 1.0e-7, "sla::rdplan", "dec 8", status);
+    vvd(diam, 1.062210086082700563e-5, 1.0e-14, "sla::rdplan", "diam 8", status);
+    rdplan(48999.9, 9, -1.1, 0.6, ra, dec, diam);
+    vvd(ra, 4.119148420083072359, 1.0e-6, "sla::rdplan", "ra 9", status);
+    vvd(dec, -0.08995447580466194026, 1.0e-7, "sla::rdplan", "dec 9", status);
+    vvd(diam, 5.092522417204559571e-7, 1.0e-14, "sla::rdplan", "diam 9", status);
+
+    // Pluto again at the date of Meeus example 37.a; precessed back to J2000, the apparent place must agree with the
+    // astrometric 15h31m43.7s -4d27m29s to within aberration and nutation
+    rdplan(48908.0, 9, 0.0, 0.0, ra, dec, diam);
+    Spherical<double> pluto;
+    pluto.set_ra(ra);
+    pluto.set_dec(dec);
+    preces(CAT_FK5, epj(48908.0), 2000.0, pluto);
+    const double meeus_dec = -(4.0 + 27.0 / 60.0 + 29.0 / 3600.0) * D2R;
+    vvd((pluto.get_ra() - (15.0 + 31.0 / 60.0 + 43.7 / 3600.0) * 15.0 * D2R) * std::cos(meeus_dec), 0.0, 5.0e-5,
+        "sla::rdplan", "Meeus ra", status);
+    vvd(pluto.get_dec(), meeus_dec, 5.0e-5, "sla::rdplan", "Meeus dec", status);
+
+    // batch version must agree with scalar one, for all planets and for dates both within and outside valid ranges
+    constexpr int N_DATES = 41;
+    double dates[N_DATES];
+    for (int i = 0; i < N_DATES; i++) {
+        dates[i] = -400000.0 + 21000.0 * i;
+    }
+    VectorPV<double> ppvs[9 * N_DATES];
+    PLStatus pstatuses[9 * N_DATES];
+    planet_batch(N_DATES, dates, ppvs, pstatuses);
+    for (int i = 0; i < N_DATES; i++) {
+        for (int np = 1; np <= 9; np++) {
+            const int index = 9 * i + np - 1;
+            viv(planet(dates[i], np, pv), pstatuses[index], "sla::planet_batch", "j", status);
+            for (int j = 0; j < 3; j++) {
+                vvd(ppvs[index].get_position()[j], pv.get_position()[j], 0.0, "sla::planet_batch", "p", status);
+                vvd(ppvs[index].get_velocity()[j], pv.get_velocity()[j], 0.0, "sla::planet_batch", "v", status);
+            }
+        }
+    }
+}
+
+// tests sla::planel(), sla::planel_batch(), sla::plante(), sla::plantu(), and sla::TopocentricContext class
+static void t_plante(bool& status) {
+    const OrbitalElements el = {OEF_MINOR_PLANET, 50500.0, 0.1, 3.0, 5.0, 2.0, 0.3, 4.0, 0.0};
+    VectorPV<double> pv;
+    viv(planel(50600.0, el, pv), OES_OK, "sla::planel", "j", status);
+    vvd(pv.get_x(), 1.947628959288897677, 1.0e-12, "sla::planel", "pv 1", status);
+    vvd(pv.get_y(), -1.013736058752235271, 1.0e-12, "sla::planel", "pv 2", status);
+    vvd(pv.get_z(), -0.3536409947732733647, 1.0e-12, "sla::planel", "pv 3", status);
+    vvd(pv.get_dx(), 2.742247411571786194e-8, 1.0e-19, "sla::planel", "pv 4", status);
+    vvd(pv.get_dy(), 1.170467244079075911e-7, 1.0e-19, "sla::planel", "pv 5", status);
+    vvd(pv.get_dz(), 3.709878268217564005e-8, 1.0e-19, "sla::planel", "pv 6", status);
+
+    double ra, dec, r;
+    viv(plante(50600.0, -1.23, 0.456, el, ra, dec, r), OES_OK, "sla::plante", "j", status);
+    vvd(ra, 6.222958101333794007, 1.0e-10, "sla::plante", "ra", status);
+    vvd(dec, 0.01142220305739771601, 1.0e-10, "sla::plante", "dec", status);
+    vvd(r, 2.288902494080167624, 1.0e-8, "sla::plante", "r", status);
+    OrbitalElements bad = el;
+    bad.oe_e = -0.1;
+    viv(plante(50600.0, -1.23, 0.456, bad, ra, dec, r), OES_BAD_ECCENTRICITY, "sla::plante", "j(e)", status);
+
+    // universal elements must give the same place as the conventional ones they were derived from
+    UniversalElements u;
+    double ra_u, dec_u, r_u;
+    viv(el2ue(50600.0, el, u), OES_OK, "sla::el2ue", "j", status);
+    viv(plantu(50600.0, -1.23, 0.456, u, ra_u, dec_u, r_u), OES_OK, "sla::plantu", "j", status);
+    vvd(ra_u, ra, 1.0e-12, "sla::plantu", "ra", status);
+    vvd(dec_u, dec, 1.0e-12, "sla::plantu", "dec", status);
+    vvd(r_u, r, 1.0e-12, "sla::plantu", "r", status);
+
+    // batch methods of the context must agree with scalar functions
+    constexpr int N_BODIES = 20;
+    OrbitalElements els[N_BODIES];
+    UniversalElements ue[N_BODIES];
+    UniversalElementsArray elements(N_BODIES);
+    for (int i = 0; i < N_BODIES; i++) {
+        els[i] = test_body(i, 50500.0);
+        viv(el2ue(50550.0, els[i], ue[i]), OES_OK, "sla::el2ue", "j(batch)", status);
+        elements.set(i, ue[i]);
+    }
+    els[7].oe_aorq = -1.0;
+    const TopocentricContext context(50600.0, -1.23, 0.456);
+    double ras[N_BODIES], decs[N_BODIES], rs[N_BODIES];
+    OEStatus statuses[N_BODIES];
+    VectorPV<double> pvs[N_BODIES];
+    planel_batch(50600.0, N_BODIES, els, pvs, statuses, 2);
+    for (int i = 0; i < N_BODIES; i++) {
+        viv(planel(50600.0, els[i], pv), statuses[i], "sla::planel_batch", "j", status);
+        if (statuses[i] == OES_OK) {
+            for (int j = 0; j < 3; j++) {
+                vvd(pvs[i].get_position()[j], pv.get_position()[j], 0.0, "sla::planel_batch", "p", status);
+                vvd(pvs[i].get_velocity()[j], pv.get_velocity()[j], 0.0, "sla::planel_batch", "v", status);
+            }
+        }
+    }
+    context.plante(N_BODIES, els, ras, decs, rs, statuses, 2);
+    for (int i = 0; i < N_BODIES; i++) {
+        const OEStatus j = plante(50600.0, -1.23, 0.456, els[i], ra, dec, r);
+        viv(j, statuses[i], "sla::TopocentricContext::plante", "j", status);
+        if (j == OES_OK) {
+            vvd(ras[i], ra, 0.0, "sla::TopocentricContext::plante", "ra", status);
+            vvd(decs[i], dec, 0.0, "sla::TopocentricContext::plante", "dec", status);
+            vvd(rs[i], r, 0.0, "sla::TopocentricContext::plante", "r", status);
+        }
+    }
+    context.plantu(elements, ras, decs, rs, statuses, 2);
+    for (int i = 0; i < N_BODIES; i++) {
+        viv(plantu(50600.0, -1.23, 0.456, ue[i], ra, dec, r), statuses[i], "sla::TopocentricContext::plantu", "j",
+            status);
+        vvd(ras[i], ra, 0.0, "sla::TopocentricContext::plantu", "ra", status);
+        vvd(decs[i], dec, 0.0, "sla::TopocentricContext::plantu", "dec", status);
+        vvd(rs[i], r, 0.0, "sla::TopocentricContext::plantu", "r", status);
+    }
+}
+
+// tests sla::pertel(), sla::pertue(), and sla::pertue_batch() functions
+static void t_pertel(bool& status) {
+    OrbitalElements el0 = {OEF_MINOR_PLANET, 43000.0, 0.2, 3.0, 4.0, 5.0, 0.02, 6.0, 0.0};
+    OrbitalElements el1;
+    viv(pertel(43000.0, 43200.0, el0, el1), OES_OK, "sla::pertel", "j", status);
+    viv(el1.oe_form, OEF_MINOR_PLANET, "sla::pertel", "jform", status);
+    vvd(el1.oe_epoch, 43200.0, 1.0e-10, "sla::pertel", "epoch", status);
+    vvd(el1.oe_orbinc, 0.1995661466545422381, 1.0e-7, "sla::pertel", "orbinc", status);
+    vvd(el1.oe_anode, 2.998052737821591215, 1.0e-7, "sla::pertel", "anode", status);
+    vvd(el1.oe_perih, 4.009516448441143636, 1.0e-6, "sla::pertel", "perih", status);
+    vvd(el1.oe_aorq, 5.014216294790922323, 1.0e-7, "sla::pertel", "aorq", status);
+    vvd(el1.oe_e, 0.02281386258309823607, 1.0e-7, "sla::pertel", "e", status);
+    vvd(el1.oe_aorl, 0.01735248648779583748, 1.0e-6, "sla::pertel", "am", status);
+
+    el0.oe_form = OEF_MAJOR_PLANET;
+    viv(pertel(43000.0, 43200.0, el0, el1), OES_BAD_FORM, "sla::pertel", "j(form)", status);
+    el0.oe_form = OEF_MINOR_PLANET;
+    el0.oe_e = 1.5;
+    viv(pertel(43000.0, 43200.0, el0, el1), OES_BAD_ECCENTRICITY, "sla::pertel", "j(e)", status);
+    el0.oe_e = 0.02;
+    el0.oe_aorq = 0.0;
+    viv(pertel(43000.0, 43200.0, el0, el1), OES_BAD_DISTANCE, "sla::pertel", "j(aorq)", status);
+
+    // integrating forth and back must return the body to where it started
+    UniversalElements u, u0;
+    VectorPV<double> pv, pv0;
+    viv(el2ue(50000.0, {OEF_COMET, 50100.0, 0.3, 1.0, 2.0, 1.2, 0.9, 0.0, 0.0}, u0), OES_OK, "sla::el2ue", "j", status);
+    u = u0;
+    viv(pertue(51000.0, u), OES_OK, "sla::pertue", "j 1", status);
+    vvd(u.ue_t0, 51000.0, 0.0, "sla::pertue", "u(3)", status);
+    viv(pertue(50000.0, u), OES_OK, "sla::pertue", "j 2", status);
+    ue2pv(50000.0, u, pv);
+    ue2pv(50000.0, u0, pv0);
+    for (int i = 0; i < 3; i++) {
+        vvd(pv.get_position()[i], pv0.get_position()[i], 1.0e-7, "sla::pertue", "p", status);
+        vvd(pv.get_velocity()[i], pv0.get_velocity()[i], 1.0e-14, "sla::pertue", "v", status);
+    }
+
+    // the integrator is of the fourth order: halving the timestep must reduce the error well over four times (the
+    // error of a second order scheme would only be reduced four times), relative to a much smaller timestep
+    viv(el2ue(50000.0, {OEF_MINOR_PLANET, 50000.0, 0.2, 3.0, 4.0, 5.0, 0.02, 6.0, 0.0}, u0), OES_OK, "sla::el2ue",
+        "j(order)", status);
+    const double factors[3] = {1.0, 0.5, 0.0625};
+    VectorPV<double> pvs[3];
+    for (int k = 0; k < 3; k++) {
+        u = u0;
+        viv(pertue(51000.0, u, factors[k]), OES_OK, "sla::pertue", "j(order)", status);
+        ue2pv(51000.0, u, pvs[k]);
+    }
+    auto error = [&pvs](int k) {
+        double sum = 0.0;
+        for (int i = 0; i < 3; i++) {
+            const double diff = pvs[k].get_position()[i] - pvs[2].get_position()[i];
+            sum += diff * diff;
+        }
+        return std::sqrt(sum);
+    };
+    const double error1 = error(0);
+    const double error2 = error(1);
+    viv(error1 < 1.0e-7, true, "sla::pertue", "error", status);
+    viv(error1 > 10.0 * error2, true, "sla::pertue", "order", status);
+
+    // batch version must agree with scalar one; bodies have different epochs, orbits include near-parabolic ones, and
+    // some of them pass near the Earth
+    constexpr int N_BODIES = 12;
+    UniversalElementsArray elements(N_BODIES);
+    UniversalElements ue[N_BODIES];
+    for (int i = 0; i < N_BODIES; i++) {
+        viv(el2ue(50000.0 - 15.0 * i, test_body(i, 50000.0), ue[i]), OES_OK, "sla::el2ue", "j(batch)", status);
+        elements.set(i, ue[i]);
+    }
+    OEStatus statuses[N_BODIES];
+    UniversalElementsArray span_elements = elements;
+    pertue_batch(50400.0, elements, statuses, 3);
+    struct Record {
+        int rc_id;
+        OEStatus rc_status;
+    } records[N_BODIES];
+    pertue_batch(50400.0, span_elements, StridedSpan<OEStatus>(records, N_BODIES, &Record::rc_status), 2);
+    for (int i = 0; i < N_BODIES; i++) {
+        viv(pertue(50400.0, ue[i]), statuses[i], "sla::pertue_batch", "j", status);
+        viv(records[i].rc_status, statuses[i], "sla::pertue_batch", "j(span)", status);
+        elements.get(i, u);
+        vvd(u.ue_alpha, ue[i].ue_alpha, 0.0, "sla::pertue_batch", "u(2)", status);
+        vvd(u.ue_t0, ue[i].ue_t0, 0.0, "sla::pertue_batch", "u(3)", status);
+        for (int j = 0; j < 3; j++) {
+            vvd(u.ue_p0[j], ue[i].ue_p0[j], 0.0, "sla::pertue_batch", "p0", status);
+            vvd(u.ue_v0[j], ue[i].ue_v0[j], 0.0, "sla::pertue_batch", "v0", status);
+        }
+        span_elements.get(i, u);
+        vvd(u.ue_p0[0], ue[i].ue_p0[0], 0.0, "sla::pertue_batch", "p0(span)", status);
+    }
 }
 
 // tests sla::obs() function
@@ -1482,6 +3488,7 @@ static void t_obs(bool& status) {
 bool sla_test() {
     bool status = true;
     t_airmas(status);
+    t_aop(status);
     t_bear(status);
     t_caf2r(status);
     t_caldj(status);
@@ -1493,6 +3500,9 @@ bool sla_test() {
     t_vecmat(status);
     t_zd(status);
     t_pa(status);
+    t_hframe(status);
+    t_visib(status);
+    t_sched(status);
     t_cd2tf(status);
     t_cr2af(status);
     t_cr2tf(status);
@@ -1501,6 +3511,13 @@ bool sla_test() {
     t_dat(status);
     t_range(status);
     t_ranorm(status);
+    t_kernel_batch(status);
+    t_strided_span(status);
+    t_dispatch(status);
+    t_c_api(status);
+    t_sky_index(status);
+    t_cross_match(status);
+    t_sky_order(status);
     t_ref(status);
     t_ecmat(status);
     t_dmat(status);
@@ -1526,6 +3543,11 @@ bool sla_test() {
     t_cs2c6(status);
     t_etrms(status);
     t_addet(status);
+    t_fk425(status);
+    t_fk45z(status);
+    t_fk524(status);
+    t_fk52h(status);
+    t_fk54z(status);
     t_pvobs(status);
     t_pcd(status);
     t_eqeqx(status);
@@ -1548,6 +3570,9 @@ bool sla_test() {
     t_pdq2h(status);
     t_pda2h(status);
     t_moon(status);
+    t_planet(status);
+    t_pertel(status);
+    t_plante(status);
     t_obs(status);
     return status;
 }